@@ -30,6 +30,7 @@
 
 #include <Thread.h>
 #include <LSFSemaphore.h>
+#include <Mutex.h>
 #include <signal.h>
 
 #include <alljoyn/Status.h>
@@ -55,7 +56,7 @@ class AlarmListener {
 
 /**
  * Class used to implement an Alarm that is
- * capable of handling time in seconds.
+ * capable of handling time in milliseconds.
  */
 class Alarm : public Thread {
   public:
@@ -77,6 +78,13 @@ class Alarm : public Thread {
      */
     void SetAlarm(uint8_t timeInSecs);
 
+    /**
+     * Set an Alarm
+     *
+     * @param timeInMs Alarm time in milliseconds. 0 cancels the Alarm
+     */
+    void SetAlarmInMs(uint32_t timeInMs);
+
     /**
      * Start the Alarm thread
      */
@@ -105,19 +113,19 @@ class Alarm : public Thread {
     AlarmListener* alarmListener;
 
     /*
-     * Internal variable used to track progress in time
+     * Protects expiryTimestamp
      */
-    volatile sig_atomic_t progressInTime;
+    Mutex alarmLock;
 
     /*
-     * Internal holder of the Alarm time
+     * Time in ms at which the Alarm fires. 0 if the Alarm is not set
      */
-    volatile sig_atomic_t timeToTrack;
+    uint64_t expiryTimestamp;
 
     /*
-     * Indicates if the Alarm time is reset
+     * Posted when the Alarm is set, cancelled or stopped
      */
-    volatile sig_atomic_t alarmReset;
+    LSFSemaphore wakeSem;
 };
 
 }
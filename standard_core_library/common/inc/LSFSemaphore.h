@@ -26,7 +26,6 @@
  * \ingroup Common
  */
 #include <pthread.h>
-#include <semaphore.h>
 #include <stdint.h>
 #include <Mutex.h>
 
@@ -54,6 +53,16 @@ class LSFSemaphore {
      */
     void Wait(void);
 
+    /**
+     * Wait on a Semaphore for at most the given time. \n
+     * The time is measured on the monotonic clock, so changes to the
+     * wall clock do not shorten or extend the wait
+     *
+     * @param msec  Maximum time to wait in milliseconds
+     * @return true if the Semaphore was posted, false on timeout
+     */
+    bool TimedWait(uint32_t msec);
+
     /**
      * Post to a Semaphore
      */
@@ -64,7 +73,17 @@ class LSFSemaphore {
     /**
      * Mutex associated with the Semaphore
      */
-    sem_t mutex;
+    pthread_mutex_t mutex;
+
+    /**
+     * Condition signalled on Post, timed on the monotonic clock
+     */
+    pthread_cond_t condition;
+
+    /**
+     * Number of Posts not yet consumed by a Wait
+     */
+    uint32_t count;
 };
 
 
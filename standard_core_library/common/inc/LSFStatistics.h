@@ -0,0 +1,185 @@
+#ifndef _LSF_STATISTICS_H_
+#define _LSF_STATISTICS_H_
+/**
+ * \ingroup Common
+ */
+/**
+ * \file  common/inc/LSFStatistics.h
+ * This file provides definitions for the LSF statistics registry
+ */
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+/**
+ * \ingroup Common
+ */
+#include <stdint.h>
+#include <string>
+
+#include <alljoyn/Status.h>
+
+#include <Mutex.h>
+
+namespace lsf {
+
+/**
+ * Maximum number of statistics that can be registered
+ */
+#define LSF_MAX_STATISTICS 64
+
+/**
+ * Number of histogram buckets. Bucket i counts samples less than 2^i
+ */
+#define LSF_STATISTIC_HISTOGRAM_BUCKETS 16
+
+/**
+ * Statistic types
+ */
+typedef enum {
+    LSF_STATISTIC_COUNTER,   /**< Monotonic count of events */
+    LSF_STATISTIC_GAUGE,     /**< Current level of something, e.g. a queue depth */
+    LSF_STATISTIC_HISTOGRAM  /**< Distribution of samples, e.g. latencies in ms */
+} LSFStatisticType;
+
+/**
+ * A single named statistic. \n
+ * All updates and reads are lock free and may be done from any thread. The
+ * value is 64 bit so that counters do not wrap
+ */
+class LSFStatistic {
+  public:
+    /**
+     * Constructor
+     */
+    LSFStatistic();
+
+    /**
+     * Increment a counter or gauge by one
+     */
+    void Increment(void);
+
+    /**
+     * Decrement a gauge by one
+     */
+    void Decrement(void);
+
+    /**
+     * Add to a counter or gauge
+     * @param delta  Value to add
+     */
+    void Add(int64_t delta);
+
+    /**
+     * Set the value of a gauge
+     * @param newValue  New value
+     */
+    void Set(int64_t newValue);
+
+    /**
+     * Record a histogram sample
+     * @param sample  The sample
+     */
+    void Record(uint32_t sample);
+
+    /**
+     * Get the name of the statistic
+     */
+    const char* GetName(void) const { return name.c_str(); }
+
+    /**
+     * Get the type of the statistic
+     */
+    LSFStatisticType GetType(void) const { return type; }
+
+    /**
+     * Get the value of a counter or gauge, or the number of samples of a histogram
+     */
+    int64_t GetValue(void) const;
+
+    /**
+     * Get the percentiles of a histogram. \n
+     * Percentiles are reported as the upper bound of a power of two bucket
+     * @param p50       50th percentile
+     * @param p99       99th percentile
+     * @param maxValue  Highest sample
+     */
+    void GetPercentiles(uint32_t& p50, uint32_t& p99, uint32_t& maxValue) const;
+
+  private:
+    friend class LSFStatisticsRegistry;
+
+    std::string name;
+    LSFStatisticType type;
+    volatile int64_t value __attribute__((aligned(8)));
+    volatile int32_t maxSample;
+    volatile int32_t buckets[LSF_STATISTIC_HISTOGRAM_BUCKETS];
+};
+
+/**
+ * A fixed size registry of statistics. \n
+ * Registration takes a lock and is expected to happen at start up. Statistics
+ * are never unregistered, so the pointers handed out remain valid for the
+ * lifetime of the registry and can be updated without locking
+ */
+class LSFStatisticsRegistry {
+  public:
+    /**
+     * Constructor
+     */
+    LSFStatisticsRegistry();
+
+    /**
+     * Register a statistic. \n
+     * Registering a name that is already known returns the existing statistic.
+     * If the registry is full, a statistic that is never reported is returned
+     * @param name  Name of the statistic
+     * @param type  Type of the statistic
+     * @return The statistic
+     */
+    LSFStatistic* Register(const char* name, LSFStatisticType type);
+
+    /**
+     * Get the number of registered statistics
+     */
+    size_t GetNumStatistics(void) const;
+
+    /**
+     * Get a registered statistic
+     * @param index  Index between 0 and GetNumStatistics() - 1
+     */
+    const LSFStatistic& GetStatistic(size_t index) const { return statistics[index]; }
+
+    /**
+     * Write all the statistics to a file, one per line
+     * @param filePath  The file to write. It is replaced if it exists
+     * @return ER_OK on success
+     */
+    QStatus DumpToFile(const std::string& filePath) const;
+
+  private:
+    Mutex registerLock;
+    LSFStatistic statistics[LSF_MAX_STATISTICS];
+    LSFStatistic overflow;
+    volatile int32_t numStatistics;
+};
+
+/**
+ * Get the string representation of a statistic type
+ */
+const char* LSFStatisticTypeText(LSFStatisticType type);
+
+}
+
+#endif
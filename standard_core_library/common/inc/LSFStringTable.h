@@ -0,0 +1,70 @@
+#ifndef _LSF_STRING_TABLE_H_
+#define _LSF_STRING_TABLE_H_
+/**
+ * \ingroup Common
+ */
+/**
+ * \file  common/inc/LSFStringTable.h
+ * This file provides definitions for the LSF string table
+ */
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+/**
+ * \ingroup Common
+ */
+#include <stddef.h>
+
+#include <LSFTypes.h>
+
+namespace lsf {
+
+/**
+ * Handle of an interned string. \n
+ * Two handles are equal if and only if their strings are equal, and the
+ * string is read by dereferencing the handle. A handle stays valid for the
+ * lifetime of the process
+ */
+typedef const LSFString* LSFStringHandle;
+
+/**
+ * Process wide table of interned strings. \n
+ * Used for the lamp IDs and method names that are carried with every lamp
+ * method call, so that they are not copied for each call. Strings are never
+ * removed, so only strings from a bounded set should be interned
+ */
+class LSFStringTable {
+  public:
+    /**
+     * Intern a string
+     * @param str  The string
+     * @return The handle of the string
+     */
+    static LSFStringHandle Intern(const LSFString& str);
+
+    /**
+     * Get the number of interned strings
+     */
+    static size_t GetNumStrings(void);
+
+    /**
+     * Get the number of bytes held by the interned strings
+     */
+    static size_t GetNumBytes(void);
+};
+
+}
+
+#endif
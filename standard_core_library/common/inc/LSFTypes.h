@@ -25,6 +25,7 @@
 /**
  * \ingroup Common
  */
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <string.h>
@@ -135,6 +136,11 @@ extern const char* ControllerServiceMasterSceneInterfaceName;
  */
 extern const char* ControllerServiceDataSetInterfaceName;
 
+/**
+ * Controller Service Statistics Interface Name
+ */
+extern const char* ControllerServiceStatisticsInterfaceName;
+
 /**
  * Controller Service Session Port
  */
@@ -200,6 +206,11 @@ extern const uint32_t ControllerServiceLeaderElectionAndStateSyncInterfaceVersio
  */
 extern const uint32_t ControllerServiceDataSetInterfaceVersion;
 
+/**
+ * Controller Service Statistics Interface Version
+ */
+extern const uint32_t ControllerServiceStatisticsInterfaceVersion;
+
 /**
  * Lamp Service Object Path
  */
@@ -280,6 +291,11 @@ extern const char* ApplySceneEventActionObjectPath;
  */
 uint64_t GetTimestampInMs(void);
 
+/**
+ * Returns the current system timestamp in us
+ */
+uint64_t GetTimestampInUs(void);
+
 /**
  * Returns the current system timestamp in seconds
  */
@@ -402,11 +418,6 @@ class LampState {
      */
     void Get(ajn::MsgArg* arg, bool ownership = false) const;
 
-    /**
-     * ON/OFF
-     */
-    bool onOff;
-
     /**
      * Hue
      */
@@ -427,6 +438,11 @@ class LampState {
      */
     uint32_t brightness;
 
+    /**
+     * ON/OFF. Kept next to nullState so that the state packs into five words
+     */
+    bool onOff;
+
     /**
      * Indicates if the state is a NULL state
      */
@@ -443,6 +459,12 @@ class LampState {
  */
 typedef std::map<LSFString, std::pair<LSFString, LampState> > PresetMap;
 
+/**
+ * Typedef for LampStateMap type. \n
+ * The key of the map is the lamp id and the value is the state of the lamp
+ */
+typedef std::map<LSFString, LampState> LampStateMap;
+
 /**
  * Class defining the Lamp Parameters \n
  * Lamp parameters are read-only volatile parameters that are read from the Lamp hardware. This consists of parameters like Lamp Output and Power Draw.
@@ -737,6 +759,16 @@ class LampGroup {
      */
     void Get(ajn::MsgArg* lampList, ajn::MsgArg* lampGroupList) const;
 
+    /**
+     * Exchange the contents with another Lamp Group without copying the lists
+     *
+     * @param other Lamp Group to exchange with
+     */
+    void Swap(LampGroup& other) {
+        lamps.swap(other.lamps);
+        lampGroups.swap(other.lampGroups);
+    }
+
     /**
      * Return true if the Lamp Group contains the specified lampGroupID
      *
@@ -761,6 +793,16 @@ class LampGroup {
  */
 typedef std::map<LSFString, std::pair<LSFString, LampGroup> > LampGroupMap;
 
+/**
+ * Kind of the effect referenced by a Scene Element
+ */
+typedef enum {
+    LSF_EFFECT_UNKNOWN,     /**< Effect ID of an unknown kind */
+    LSF_EFFECT_TRANSITION,  /**< Transition Effect */
+    LSF_EFFECT_PULSE,       /**< Pulse Effect */
+    LSF_EFFECT_PRESET       /**< Preset */
+} LSFEffectType;
+
 /**
  * Class defining a Effect ID component of a Scene
  */
@@ -770,7 +812,7 @@ class SceneElement {
      * Default Constructor
      */
     SceneElement() :
-        invalidArgs(true)
+        effectType(LSF_EFFECT_UNKNOWN), invalidArgs(true)
     {
         lamps.clear();
         lampGroups.clear();
@@ -842,6 +884,19 @@ class SceneElement {
      */
     void Get(ajn::MsgArg* lampList, ajn::MsgArg* lampGroupList, ajn::MsgArg* effectId) const;
 
+    /**
+     * Exchange the contents with another Scene Element without copying the lists
+     *
+     * @param other Scene Element to exchange with
+     */
+    void Swap(SceneElement& other) {
+        lamps.swap(other.lamps);
+        lampGroups.swap(other.lampGroups);
+        effectID.swap(other.effectID);
+        std::swap(effectType, other.effectType);
+        std::swap(invalidArgs, other.invalidArgs);
+    }
+
     /**
      * Check if there a scene element that depends on specific lamp group
      * @param lampGroupID - the lamp group id
@@ -858,6 +913,14 @@ class SceneElement {
      */
     LSFResponseCode IsDependentOnEffect(LSFString& effectId);
 
+    /**
+     * Get the kind of effect an Effect ID refers to. \n
+     * The kind is encoded in the ID when the effect is created
+     * @param effectId - the effect id
+     * @return the kind of effect
+     */
+    static LSFEffectType GetEffectType(const LSFString& effectId);
+
     /**
      * List of Lamps
      */
@@ -873,6 +936,13 @@ class SceneElement {
      */
     LSFString effectID;
 
+    /**
+     * Kind of the effect, resolved from effectID when the Scene Element is
+     * constructed, Set or assigned. Code that assigns effectID directly must
+     * update it with GetEffectType
+     */
+    LSFEffectType effectType;
+
     /**
      * Indicated invalid arguments
      */
@@ -1634,6 +1704,15 @@ class MasterScene {
      * get scene list
      */
     void Get(ajn::MsgArg* sceneList) const;
+
+    /**
+     * Exchange the contents with another Master Scene without copying the lists
+     *
+     * @param other Master Scene to exchange with
+     */
+    void Swap(MasterScene& other) {
+        scenes.swap(other.scenes);
+    }
     /**
      * is master scene dependent of scene
      */
@@ -1692,6 +1771,15 @@ class SceneWithSceneElements {
      * get scene list
      */
     void Get(ajn::MsgArg* sceneElementsList) const;
+
+    /**
+     * Exchange the contents with another Scene without copying the lists
+     *
+     * @param other Scene to exchange with
+     */
+    void Swap(SceneWithSceneElements& other) {
+        sceneElements.swap(other.sceneElements);
+    }
     /**
      * is scene element dependent of scene
      */
@@ -15,6 +15,7 @@
  ******************************************************************************/
 
 #include <Alarm.h>
+#include <LSFTypes.h>
 #include <qcc/Debug.h>
 
 using namespace lsf;
@@ -24,9 +25,7 @@ using namespace lsf;
 Alarm::Alarm(AlarmListener* alarmListener) :
     isRunning(true),
     alarmListener(alarmListener),
-    progressInTime(0),
-    timeToTrack(0),
-    alarmReset(false)
+    expiryTimestamp(0)
 {
     QCC_DbgPrintf(("%s", __func__));
     Thread::Start();
@@ -42,22 +41,33 @@ void Alarm::Run()
     QCC_DbgPrintf(("%s", __func__));
 
     while (isRunning) {
-        QCC_DbgPrintf(("%s", __func__));
-        usleep(1000000);
-        if (alarmReset) {
-            QCC_DbgPrintf(("%s: Alarm Reloaded", __func__));
-            progressInTime = 0;
-            alarmReset = false;
-        } else {
-            if (timeToTrack) {
-                progressInTime++;
-                if (progressInTime == timeToTrack) {
-                    QCC_DbgPrintf(("%s: Calling AlarmTriggered", __func__));
-                    progressInTime = 0;
-                    timeToTrack = 0;
-                    alarmListener->AlarmTriggered();
-                }
-            }
+        alarmLock.Lock();
+        uint64_t expiry = expiryTimestamp;
+        alarmLock.Unlock();
+
+        if (!expiry) {
+            wakeSem.Wait();
+            continue;
+        }
+
+        uint64_t now = GetTimestampInMs();
+        if (now < expiry) {
+            wakeSem.TimedWait(static_cast<uint32_t>(expiry - now));
+            continue;
+        }
+
+        bool fire = false;
+        alarmLock.Lock();
+        // The Alarm may have been reloaded or cancelled while we were waiting
+        if (expiryTimestamp == expiry) {
+            expiryTimestamp = 0;
+            fire = true;
+        }
+        alarmLock.Unlock();
+
+        if (fire && isRunning) {
+            QCC_DbgPrintf(("%s: Calling AlarmTriggered", __func__));
+            alarmListener->AlarmTriggered();
         }
     }
 }
@@ -71,13 +81,22 @@ void Alarm::Join()
 void Alarm::Stop()
 {
     isRunning = false;
-    progressInTime = 0;
-    timeToTrack = 0;
-    alarmReset = false;
+    alarmLock.Lock();
+    expiryTimestamp = 0;
+    alarmLock.Unlock();
+    wakeSem.Post();
 }
 
 void Alarm::SetAlarm(uint8_t timeInSecs)
 {
-    timeToTrack = timeInSecs;
-    alarmReset = true;
+    SetAlarmInMs(static_cast<uint32_t>(timeInSecs) * 1000);
+}
+
+void Alarm::SetAlarmInMs(uint32_t timeInMs)
+{
+    QCC_DbgPrintf(("%s: timeInMs=%u", __func__, timeInMs));
+    alarmLock.Lock();
+    expiryTimestamp = (timeInMs) ? (GetTimestampInMs() + timeInMs) : 0;
+    alarmLock.Unlock();
+    wakeSem.Post();
 }
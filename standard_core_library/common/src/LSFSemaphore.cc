@@ -18,31 +18,77 @@
 #include <qcc/Debug.h>
 
 #include <time.h>
+#include <errno.h>
 
 using namespace lsf;
 
 #define QCC_MODULE "LSF_SEMAPHORE"
 
-LSFSemaphore::LSFSemaphore()
+LSFSemaphore::LSFSemaphore() : count(0)
 {
     QCC_DbgPrintf(("%s", __func__));
-    sem_init(&mutex, 0, 0);
+    pthread_mutex_init(&mutex, NULL);
+
+    /*
+     * sem_timedwait only takes a CLOCK_REALTIME deadline, so the Semaphore
+     * is built on a condition that waits on the monotonic clock
+     */
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&condition, &attr);
+    pthread_condattr_destroy(&attr);
 }
 
 LSFSemaphore::~LSFSemaphore()
 {
     QCC_DbgPrintf(("%s", __func__));
-    sem_destroy(&mutex);
+    pthread_cond_destroy(&condition);
+    pthread_mutex_destroy(&mutex);
 }
 
 void LSFSemaphore::Wait(void)
 {
     QCC_DbgPrintf(("%s", __func__));
-    sem_wait(&mutex);
+    pthread_mutex_lock(&mutex);
+    while (count == 0) {
+        pthread_cond_wait(&condition, &mutex);
+    }
+    count--;
+    pthread_mutex_unlock(&mutex);
+}
+
+bool LSFSemaphore::TimedWait(uint32_t msec)
+{
+    QCC_DbgPrintf(("%s: msec=%u", __func__, msec));
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ts.tv_sec += msec / 1000;
+    ts.tv_nsec += (msec % 1000) * 1000000;
+    if (ts.tv_nsec >= 1000000000) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&mutex);
+    int ret = 0;
+    while ((count == 0) && (ret != ETIMEDOUT)) {
+        ret = pthread_cond_timedwait(&condition, &mutex, &ts);
+    }
+    bool posted = (count > 0);
+    if (posted) {
+        count--;
+    }
+    pthread_mutex_unlock(&mutex);
+
+    return posted;
 }
 
 void LSFSemaphore::Post(void)
 {
     QCC_DbgPrintf(("%s", __func__));
-    sem_post(&mutex);
+    pthread_mutex_lock(&mutex);
+    count++;
+    pthread_cond_signal(&condition);
+    pthread_mutex_unlock(&mutex);
 }
@@ -0,0 +1,219 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <LSFStatistics.h>
+#include <LSFTypes.h>
+#include <qcc/Debug.h>
+#include <qcc/atomic.h>
+
+#include <stdio.h>
+#include <fstream>
+
+using namespace lsf;
+
+#define QCC_MODULE "LSF_STATISTICS"
+
+LSFStatistic::LSFStatistic() :
+    type(LSF_STATISTIC_COUNTER),
+    value(0),
+    maxSample(0)
+{
+    for (size_t i = 0; i < LSF_STATISTIC_HISTOGRAM_BUCKETS; i++) {
+        buckets[i] = 0;
+    }
+}
+
+void LSFStatistic::Increment(void)
+{
+    Add(1);
+}
+
+void LSFStatistic::Decrement(void)
+{
+    Add(-1);
+}
+
+void LSFStatistic::Add(int64_t delta)
+{
+    __sync_fetch_and_add(&value, delta);
+}
+
+void LSFStatistic::Set(int64_t newValue)
+{
+    /*
+     * A plain 64 bit store is not atomic on 32 bit targets, and
+     * __sync_lock_test_and_set may only store the constant 1 on some of them
+     */
+    int64_t oldValue;
+    do {
+        oldValue = value;
+    } while (!__sync_bool_compare_and_swap(&value, oldValue, newValue));
+}
+
+int64_t LSFStatistic::GetValue(void) const
+{
+    return __sync_fetch_and_add(const_cast<volatile int64_t*>(&value), 0);
+}
+
+void LSFStatistic::Record(uint32_t sample)
+{
+    size_t bucket = 0;
+    while ((bucket < (LSF_STATISTIC_HISTOGRAM_BUCKETS - 1)) && (sample >= (static_cast<uint32_t>(1) << bucket))) {
+        bucket++;
+    }
+    qcc::IncrementAndFetch(&buckets[bucket]);
+    Add(1);
+
+    int32_t oldMax;
+    do {
+        oldMax = maxSample;
+        if (static_cast<uint32_t>(oldMax) >= sample) {
+            break;
+        }
+    } while (!qcc::CompareAndExchange(&maxSample, oldMax, static_cast<int32_t>(sample)));
+}
+
+void LSFStatistic::GetPercentiles(uint32_t& p50, uint32_t& p99, uint32_t& maxValue) const
+{
+    p50 = 0;
+    p99 = 0;
+    maxValue = static_cast<uint32_t>(maxSample);
+
+    /*
+     * The buckets are read one at a time while samples may still be recorded,
+     * so total them first instead of trusting the sample count
+     */
+    uint64_t counts[LSF_STATISTIC_HISTOGRAM_BUCKETS];
+    uint64_t total = 0;
+    for (size_t i = 0; i < LSF_STATISTIC_HISTOGRAM_BUCKETS; i++) {
+        counts[i] = static_cast<uint32_t>(buckets[i]);
+        total += counts[i];
+    }
+
+    uint64_t seen = 0;
+    bool p50Found = false;
+    for (size_t i = 0; (i < LSF_STATISTIC_HISTOGRAM_BUCKETS) && total; i++) {
+        seen += counts[i];
+        uint32_t upperBound = static_cast<uint32_t>(1) << i;
+        if (!p50Found && ((seen * 100) >= (total * 50))) {
+            p50 = upperBound;
+            p50Found = true;
+        }
+        if ((seen * 100) >= (total * 99)) {
+            p99 = upperBound;
+            break;
+        }
+    }
+
+    if (p50 > maxValue) {
+        p50 = maxValue;
+    }
+    if (p99 > maxValue) {
+        p99 = maxValue;
+    }
+}
+
+LSFStatisticsRegistry::LSFStatisticsRegistry() :
+    numStatistics(0)
+{
+    QCC_DbgTrace(("%s", __func__));
+}
+
+LSFStatistic* LSFStatisticsRegistry::Register(const char* name, LSFStatisticType type)
+{
+    QCC_DbgTrace(("%s: name=%s type=%s", __func__, name, LSFStatisticTypeText(type)));
+    LSFStatistic* statistic = NULL;
+
+    registerLock.Lock();
+    for (int32_t i = 0; i < numStatistics; i++) {
+        if (statistics[i].name == name) {
+            statistic = &statistics[i];
+            break;
+        }
+    }
+
+    if (!statistic) {
+        if (numStatistics < LSF_MAX_STATISTICS) {
+            statistic = &statistics[numStatistics];
+            statistic->name = name;
+            statistic->type = type;
+            /*
+             * Publish the entry only after it is filled in. Readers do not
+             * take the lock and only look at the first numStatistics entries
+             */
+            qcc::IncrementAndFetch(&numStatistics);
+        } else {
+            QCC_LogError(ER_OUT_OF_MEMORY, ("%s: No room to register %s", __func__, name));
+            statistic = &overflow;
+        }
+    }
+    registerLock.Unlock();
+
+    return statistic;
+}
+
+size_t LSFStatisticsRegistry::GetNumStatistics(void) const
+{
+    return static_cast<size_t>(numStatistics);
+}
+
+QStatus LSFStatisticsRegistry::DumpToFile(const std::string& filePath) const
+{
+    QCC_DbgTrace(("%s: filePath=%s", __func__, filePath.c_str()));
+
+    /*
+     * Write to a temporary file and rename it so that a reader polling the
+     * file never sees a partial dump
+     */
+    std::string tmpPath = filePath + ".tmp";
+    std::ofstream stream(tmpPath.c_str(), std::ios_base::out);
+    if (!stream.is_open()) {
+        QCC_LogError(ER_OPEN_FAILED, ("%s: File not found: %s", __func__, tmpPath.c_str()));
+        return ER_OPEN_FAILED;
+    }
+
+    size_t count = GetNumStatistics();
+    for (size_t i = 0; i < count; i++) {
+        const LSFStatistic& statistic = statistics[i];
+        stream << statistic.GetName() << ' ' << LSFStatisticTypeText(statistic.GetType()) << ' ' << statistic.GetValue();
+        if (statistic.GetType() == LSF_STATISTIC_HISTOGRAM) {
+            uint32_t p50, p99, maxValue;
+            statistic.GetPercentiles(p50, p99, maxValue);
+            stream << " p50=" << p50 << " p99=" << p99 << " max=" << maxValue;
+        }
+        stream << std::endl;
+    }
+    stream.close();
+
+    if (rename(tmpPath.c_str(), filePath.c_str())) {
+        QCC_LogError(ER_FAIL, ("%s: Failed to rename %s", __func__, tmpPath.c_str()));
+        return ER_FAIL;
+    }
+
+    return ER_OK;
+}
+
+const char* lsf::LSFStatisticTypeText(LSFStatisticType type)
+{
+    switch (type) {
+        LSF_CASE(LSF_STATISTIC_COUNTER);
+        LSF_CASE(LSF_STATISTIC_GAUGE);
+        LSF_CASE(LSF_STATISTIC_HISTOGRAM);
+
+    default:
+        return "<unknown>";
+    }
+}
@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <LSFStringTable.h>
+#include <Mutex.h>
+#include <qcc/Debug.h>
+
+#include <set>
+
+using namespace lsf;
+
+#define QCC_MODULE "LSF_STRING_TABLE"
+
+/*
+ * The nodes of a std::set never move, so the address of an element is a
+ * stable handle
+ */
+typedef std::set<LSFString> StringSet;
+
+static Mutex& GetTableLock(void)
+{
+    static Mutex tableLock;
+    return tableLock;
+}
+
+static StringSet& GetStrings(void)
+{
+    static StringSet strings;
+    return strings;
+}
+
+static size_t numBytes = 0;
+
+LSFStringHandle LSFStringTable::Intern(const LSFString& str)
+{
+    Mutex& lock = GetTableLock();
+    StringSet& strings = GetStrings();
+
+    QStatus status = lock.Lock();
+    if (ER_OK != status) {
+        QCC_LogError(status, ("%s: tableLock.Lock() failed", __func__));
+    }
+
+    std::pair<StringSet::iterator, bool> ret = strings.insert(str);
+    if (ret.second) {
+        numBytes += str.capacity() + sizeof(LSFString);
+    }
+    LSFStringHandle handle = &(*ret.first);
+
+    if (ER_OK == status) {
+        status = lock.Unlock();
+        if (ER_OK != status) {
+            QCC_LogError(status, ("%s: tableLock.Unlock() failed", __func__));
+        }
+    }
+
+    return handle;
+}
+
+size_t LSFStringTable::GetNumStrings(void)
+{
+    Mutex& lock = GetTableLock();
+    lock.Lock();
+    size_t num = GetStrings().size();
+    lock.Unlock();
+    return num;
+}
+
+size_t LSFStringTable::GetNumBytes(void)
+{
+    Mutex& lock = GetTableLock();
+    lock.Lock();
+    size_t bytes = numBytes;
+    lock.Unlock();
+    return bytes;
+}
@@ -51,20 +51,22 @@ const char* ControllerServiceSceneWithSceneElementsInterfaceName = "org.allseen.
 const char* ControllerServiceSceneElementInterfaceName = "org.allseen.LSF.ControllerService.SceneElement";
 const char* ControllerServiceMasterSceneInterfaceName = "org.allseen.LSF.ControllerService.MasterScene";
 const char* ControllerServiceDataSetInterfaceName = "org.allseen.LSF.ControllerService.DataSet";
+const char* ControllerServiceStatisticsInterfaceName = "org.allseen.LSF.ControllerService.Statistics";
 ajn::SessionPort ControllerServiceSessionPort = 43;
 
 const uint32_t ControllerServiceInterfaceVersion = 1;
-const uint32_t ControllerServiceLampInterfaceVersion = 1;
-const uint32_t ControllerServiceLampGroupInterfaceVersion = 1;
-const uint32_t ControllerServicePresetInterfaceVersion = 1;
+const uint32_t ControllerServiceLampInterfaceVersion = 2;
+const uint32_t ControllerServiceLampGroupInterfaceVersion = 2;
+const uint32_t ControllerServicePresetInterfaceVersion = 2;
 const uint32_t ControllerServiceTransitionEffectInterfaceVersion = 1;
 const uint32_t ControllerServicePulseEffectInterfaceVersion = 1;
-const uint32_t ControllerServiceSceneInterfaceVersion = 1;
-const uint32_t ControllerServiceSceneWithSceneElementsInterfaceVersion = 1;
-const uint32_t ControllerServiceSceneElementInterfaceVersion = 1;
+const uint32_t ControllerServiceSceneInterfaceVersion = 2;
+const uint32_t ControllerServiceSceneWithSceneElementsInterfaceVersion = 2;
+const uint32_t ControllerServiceSceneElementInterfaceVersion = 2;
 const uint32_t ControllerServiceMasterSceneInterfaceVersion = 1;
-const uint32_t ControllerServiceLeaderElectionAndStateSyncInterfaceVersion = 1;
+const uint32_t ControllerServiceLeaderElectionAndStateSyncInterfaceVersion = 2;
 const uint32_t ControllerServiceDataSetInterfaceVersion = 1;
+const uint32_t ControllerServiceStatisticsInterfaceVersion = 1;
 
 const char* LampServiceObjectPath = "/org/allseen/LSF/Lamp";
 const char* LampServiceInterfaceName = "org.allseen.LSF.LampService";
@@ -117,6 +119,19 @@ uint64_t GetTimestampInMs(void)
     return ret;
 }
 
+uint64_t GetTimestampInUs(void)
+{
+    struct timespec ts;
+    uint64_t ret;
+
+    platform_gettime(&ts);
+
+    ret = ((uint64_t)(ts.tv_sec)) * 1000000;
+    ret += (uint64_t)ts.tv_nsec / 1000;
+
+    return ret;
+}
+
 uint32_t GetTimestampInSeconds(void)
 {
     struct timespec ts;
@@ -160,39 +175,45 @@ char* strdupnew(const char* str) {
 }
 
 LampState::LampState() :
-    onOff(false),
     hue(0),
     saturation(0),
     colorTemp(0),
     brightness(0),
+    onOff(false),
     nullState(true)
 {
     //QCC_DbgPrintf(("%s: %s", __func__, this->c_str()));
 }
 
 LampState::LampState(bool onOff, uint32_t hue, uint32_t saturation, uint32_t colorTemp, uint32_t brightness) :
-    onOff(onOff),
     hue(hue),
     saturation(saturation),
     colorTemp(colorTemp),
     brightness(brightness),
+    onOff(onOff),
     nullState(false)
 {
     //QCC_DbgPrintf(("%s: %s", __func__, this->c_str()));
 }
 
-LampState::LampState(const ajn::MsgArg& arg)
+LampState::LampState(const ajn::MsgArg& arg) :
+    hue(0),
+    saturation(0),
+    colorTemp(0),
+    brightness(0),
+    onOff(false),
+    nullState(true)
 {
     Set(arg);
     //QCC_DbgPrintf(("%s: %s", __func__, this->c_str()));
 }
 
 LampState::LampState(const LampState& other) :
-    onOff(other.onOff),
     hue(other.hue),
     saturation(other.saturation),
     colorTemp(other.colorTemp),
     brightness(other.brightness),
+    onOff(other.onOff),
     nullState(other.nullState)
 {
     //QCC_DbgPrintf(("%s: %s", __func__, this->c_str()));
@@ -1925,7 +1946,7 @@ LSFResponseCode SceneWithSceneElements::IsDependentOnSceneElement(LSFString& sce
 }
 
 SceneElement::SceneElement(const LSFStringList& lampList, const LSFStringList& lampGroupList, const LSFString& effectId) :
-    lamps(lampList), lampGroups(lampGroupList), effectID(effectId), invalidArgs(false)
+    lamps(lampList), lampGroups(lampGroupList), effectID(effectId), effectType(GetEffectType(effectId)), invalidArgs(false)
 {
     QCC_DbgPrintf(("%s", __func__));
 }
@@ -1974,6 +1995,7 @@ SceneElement& SceneElement::operator=(const SceneElement& other)
     lamps = other.lamps;
     lampGroups = other.lampGroups;
     effectID = other.effectID;
+    effectType = other.effectType;
 
     invalidArgs = false;
 
@@ -2002,6 +2024,7 @@ void SceneElement::Set(const ajn::MsgArg& lampList, const ajn::MsgArg& lampGroup
     effectId.Get("s", &uniqueId);
 
     effectID = uniqueId;
+    effectType = GetEffectType(effectID);
     invalidArgs = false;
 }
 
@@ -2065,4 +2088,16 @@ LSFResponseCode SceneElement::IsDependentOnEffect(LSFString& effectId)
     return responseCode;
 }
 
+LSFEffectType SceneElement::GetEffectType(const LSFString& effectId)
+{
+    if (effectId.find("TRANSITION_EFFECT") != std::string::npos) {
+        return LSF_EFFECT_TRANSITION;
+    } else if (effectId.find("PULSE_EFFECT") != std::string::npos) {
+        return LSF_EFFECT_PULSE;
+    } else if (effectId.find("PRESET") != std::string::npos) {
+        return LSF_EFFECT_PRESET;
+    }
+    return LSF_EFFECT_UNKNOWN;
+}
+
 }
@@ -0,0 +1,1655 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+/*
+ * End to end benchmark of a Controller Service driving a lamp fleet.
+ *
+ * Start a controller service and a lamp fleet simulator on the local bus,
+ * then run this benchmark. It measures:
+ *  - the time until the controller reports the expected number of lamps,
+ *    counted from the start of the benchmark
+ *  - the method call dispatch throughput of the controller, with <callers>
+ *    GetControllerServiceVersion calls kept in flight. The handler does no
+ *    work, so this is bound by the dispatch path of the controller
+ *  - the GetAllPresetIDs reply latency on its own and while <concurrency>
+ *    SetPresetName calls are kept in flight, which shows whether reads wait
+ *    for the mutations of the same store
+ *  - the ApplyScene and ApplyMasterScene reply latency for each lamp count
+ *  - the lamp states delivered to this client and the CPU time this process
+ *    spends after one ApplyMasterScene for each lamp count. With -S, the
+ *    LampStateChanged and LampsStateChanged signals sent by the controller
+ *    are counted as well
+ *  - the TransitionLampGroupState reply throughput for each lamp count
+ *  - with -C <count>, the time to commission <count> presets and lamp groups
+ *    one call at a time and with a single CreatePresets and CreateLampGroups
+ *    call. The controller service must be built with an
+ *    OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY of at least <count>
+ *  - with -L <lamp_statistics_file>, the calls the controller makes to the
+ *    lamps and the LampStateChanged signals of the lamps while a pulse effect
+ *    plays on up to 100 lamps. The lamp fleet simulator must be started with
+ *    -s <lamp_statistics_file>
+ *  - with -J <command> and -R <statistics_file>, the time a controller service
+ *    joining the site takes to fetch all the stores from the leader. The
+ *    site is filled with -C <count> presets and lamp groups first. <command>
+ *    is run with /bin/sh and must start a controller service with its own
+ *    store directory and with -s <statistics_file>. It is stopped with
+ *    SIGINT once it reports a synchronization
+ *  - with -P <controller_pid>, the CPU time the controller service spends per
+ *    ApplyScene and ApplyMasterScene for each lamp count, and its resident
+ *    memory once the lamps are connected and again after the runs for each
+ *    lamp count, read from /proc. Comparing the CPU time and the apply
+ *    latencies of controller services built with OEM_CS_REQUEST_TRACING set
+ *    to 0 and to 1 gives the overhead of the request tracing. The
+ *    RequestTracer.Records statistic added with -S shows which build ran. Run against a lamp fleet simulator with 1000
+ *    lamps for the figures of a large site. The LampClients.InternedStrings,
+ *    LampClients.InternedStringBytes and LampClients.LampIDCopies statistics
+ *    added with -S show the string footprint and copies of the lamp calls
+ *  - with -K <leader_pid>, the time from killing the leader controller
+ *    service until another controller service serves an ApplyScene. This
+ *    runs last, and needs a second controller service on the bus with the
+ *    same lamps. With OEM_CS_WARM_STANDBY_LAMP_SESSIONS it has the lamp
+ *    sessions open already
+ *
+ * The results are written as JSON. If the controller service was started
+ * with -s <file_path>, pass the same file with -S to add the statistics of
+ * the controller to the results, which include the persistence write latency
+ * and the blob sync latency seen by the leader.
+ *
+ * Usage: lsfbenchmark [-n <num_lamps>] [-s <lamp_counts>] [-i <iterations>]
+ *                     [-c <concurrency>] [-d <duration_seconds>] [-D <callers>]
+ *                     [-C <count>] [-S <statistics_file>] [-L <lamp_statistics_file>]
+ *                     [-J <command> -R <statistics_file>] [-P <controller_pid>]
+ *                     [-K <leader_pid>] [-o <output_file>]
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <alljoyn/BusAttachment.h>
+#include <qcc/Debug.h>
+#include <qcc/atomic.h>
+
+#include <ControllerClient.h>
+#include <ControllerServiceManager.h>
+#include <LampManager.h>
+#include <LampGroupManager.h>
+#include <PresetManager.h>
+#include <TransitionEffectManager.h>
+#include <PulseEffectManager.h>
+#include <SceneElementManager.h>
+#include <SceneManager.h>
+#include <MasterSceneManager.h>
+#include <LSFTypes.h>
+#include <LSFSemaphore.h>
+#include <AJInitializer.h>
+#include <Mutex.h>
+
+using namespace lsf;
+using namespace ajn;
+
+#define QCC_MODULE "CONTROLLER_BENCHMARK"
+
+/*
+ * Time to wait for a reply from the Controller Service
+ */
+#define BENCHMARK_REPLY_TIMEOUT_MS 30000
+
+/*
+ * Interval at which the lamp IDs are polled while waiting for the lamps
+ */
+#define BENCHMARK_LAMP_POLL_INTERVAL_MS 250
+
+/*
+ * Time to wait for the lamps to connect to the Controller Service
+ */
+#define BENCHMARK_LAMP_WAIT_TIMEOUT_MS 300000
+
+/*
+ * Number of lamps the pulse effect is applied to, and its number of pulses
+ */
+#define BENCHMARK_PULSE_EFFECT_LAMPS 100
+#define BENCHMARK_PULSE_EFFECT_PULSES 5
+
+/*
+ * Time to wait before reading the counters of the lamp fleet simulator. The
+ * simulator writes them every second, and the refreshes of the controller
+ * have to complete first
+ */
+#define BENCHMARK_LAMP_STATISTICS_SETTLE_MS 3000
+
+/*
+ * Time to wait before reading the statistics of the controller service,
+ * which writes them every five seconds
+ */
+#define BENCHMARK_CONTROLLER_STATISTICS_SETTLE_MS 11000
+
+/*
+ * Time to wait for another controller service to serve an ApplyScene after
+ * the leader was killed
+ */
+#define BENCHMARK_FAILOVER_TIMEOUT_MS 120000
+
+/*
+ * Time to wait for a joining controller service to report a synchronization
+ */
+#define BENCHMARK_RESYNC_TIMEOUT_MS 300000
+
+struct BenchmarkConfig {
+    BenchmarkConfig() :
+        numLamps(10), iterations(100), concurrency(8), durationInSeconds(10), dispatchCallers(16), commissioningCount(0), controllerPid(0), leaderPid(0) {
+        lampCounts.push_back(10);
+        lampCounts.push_back(100);
+        lampCounts.push_back(1000);
+    }
+
+    uint32_t numLamps;
+    std::vector<uint32_t> lampCounts;
+    uint32_t iterations;
+    uint32_t concurrency;
+    uint32_t durationInSeconds;
+    uint32_t dispatchCallers;
+    uint32_t commissioningCount;
+    pid_t controllerPid;
+    pid_t leaderPid;
+    std::string statisticsFile;
+    std::string lampStatisticsFile;
+    std::string joinCommand;
+    std::string joinStatisticsFile;
+    std::string outputFile;
+};
+
+/*
+ * Receives the replies of all the managers. The benchmark has at most one
+ * call outstanding, except for the group transitions, the version calls of
+ * the dispatch measurement and the preset renames of the mixed load
+ * measurement which are counted separately. \n
+ * The replies carry nothing that ties them to their call, so a reply that
+ * arrives after its call timed out is discarded rather than taken for the
+ * reply of the next call
+ */
+class BenchmarkHandler :
+    public ControllerClientCallback,
+    public ControllerServiceManagerCallback,
+    public LampManagerCallback,
+    public LampGroupManagerCallback,
+    public PresetManagerCallback,
+    public TransitionEffectManagerCallback,
+    public PulseEffectManagerCallback,
+    public SceneElementManagerCallback,
+    public SceneManagerCallback,
+    public MasterSceneManagerCallback {
+  public:
+
+    BenchmarkHandler() : responseCode(LSF_OK), numLateReplies(0), numTransitionReplies(0), numTransitionFailures(0), numVersionReplies(0), numRenameReplies(0), numRenameFailures(0), numLampStates(0) { }
+
+    bool WaitForReply(LSFResponseCode& code, LSFString& id) {
+        if (!replySemaphore.TimedWait(BENCHMARK_REPLY_TIMEOUT_MS)) {
+            replyLock.Lock();
+            // The reply may have been posted after the wait gave up
+            bool replied = replySemaphore.TimedWait(0);
+            if (!replied) {
+                numLateReplies++;
+            }
+            replyLock.Unlock();
+            if (!replied) {
+                QCC_LogError(ER_TIMEOUT, ("%s: Timed out waiting for a reply", __func__));
+                return false;
+            }
+        }
+        replyLock.Lock();
+        code = responseCode;
+        id = replyID;
+        replyLock.Unlock();
+        return true;
+    }
+
+    bool WaitForLampIDs(LSFStringList& ids) {
+        LSFResponseCode code;
+        LSFString id;
+        if (!WaitForReply(code, id) || (code != LSF_OK)) {
+            return false;
+        }
+        replyLock.Lock();
+        ids = lampIDs;
+        replyLock.Unlock();
+        return true;
+    }
+
+    bool WaitForReplyIDs(LSFResponseCode& code, LSFStringList& ids) {
+        LSFString id;
+        if (!WaitForReply(code, id)) {
+            return false;
+        }
+        replyLock.Lock();
+        ids = replyIDs;
+        replyLock.Unlock();
+        return true;
+    }
+
+    bool WaitForConnection(void) { return connectedSemaphore.TimedWait(BENCHMARK_REPLY_TIMEOUT_MS); }
+
+    /*
+     * Forget the connections seen so far, so that WaitForConnection waits
+     * for the next one
+     */
+    void ClearConnections(void) {
+        while (connectedSemaphore.TimedWait(0)) {
+        }
+    }
+
+    bool WaitForTransitionReply(void) { return transitionSemaphore.TimedWait(BENCHMARK_REPLY_TIMEOUT_MS); }
+
+    bool WaitForVersionReply(void) { return versionSemaphore.TimedWait(BENCHMARK_REPLY_TIMEOUT_MS); }
+
+    bool WaitForRenameReply(void) { return renameSemaphore.TimedWait(BENCHMARK_REPLY_TIMEOUT_MS); }
+
+    void ConnectedToControllerServiceCB(const LSFString& controllerServiceDeviceID, const LSFString& controllerServiceName) {
+        printf("Connected to the Controller Service %s\n", controllerServiceName.c_str());
+        connectedSemaphore.Post();
+    }
+
+    void GetAllLampIDsReplyCB(const LSFResponseCode& code, const LSFStringList& ids) {
+        replyLock.Lock();
+        if (!numLateReplies) {
+            lampIDs = ids;
+        }
+        replyLock.Unlock();
+        Reply(code, LSFString());
+    }
+
+    void CreateLampGroupReplyCB(const LSFResponseCode& code, const LSFString& id) { Reply(code, id); }
+    void DeleteLampGroupReplyCB(const LSFResponseCode& code, const LSFString& id) { Reply(code, id); }
+    void CreateLampGroupsReplyCB(const LSFResponseCode& code, const LSFStringList& ids) { Reply(code, ids); }
+    void GetAllPresetIDsReplyCB(const LSFResponseCode& code, const LSFStringList& ids) { Reply(code, LSFString()); }
+    void CreatePresetReplyCB(const LSFResponseCode& code, const LSFString& id) { Reply(code, id); }
+    void DeletePresetReplyCB(const LSFResponseCode& code, const LSFString& id) { Reply(code, id); }
+    void CreatePresetsReplyCB(const LSFResponseCode& code, const LSFStringList& ids) { Reply(code, ids); }
+    void CreateTransitionEffectReplyCB(const LSFResponseCode& code, const LSFString& id, const uint32_t& trackingID) { Reply(code, id); }
+    void DeleteTransitionEffectReplyCB(const LSFResponseCode& code, const LSFString& id) { Reply(code, id); }
+    void CreatePulseEffectReplyCB(const LSFResponseCode& code, const LSFString& id, const uint32_t& trackingID) { Reply(code, id); }
+    void DeletePulseEffectReplyCB(const LSFResponseCode& code, const LSFString& id) { Reply(code, id); }
+    void CreateSceneElementReplyCB(const LSFResponseCode& code, const LSFString& id, const uint32_t& trackingID) { Reply(code, id); }
+    void DeleteSceneElementReplyCB(const LSFResponseCode& code, const LSFString& id) { Reply(code, id); }
+    void CreateSceneWithSceneElementsReplyCB(const LSFResponseCode& code, const LSFString& id, const uint32_t& trackingID) { Reply(code, id); }
+    void DeleteSceneReplyCB(const LSFResponseCode& code, const LSFString& id) { Reply(code, id); }
+    void ApplySceneReplyCB(const LSFResponseCode& code, const LSFString& id) { Reply(code, id); }
+    void CreateMasterSceneReplyCB(const LSFResponseCode& code, const LSFString& id) { Reply(code, id); }
+    void DeleteMasterSceneReplyCB(const LSFResponseCode& code, const LSFString& id) { Reply(code, id); }
+    void ApplyMasterSceneReplyCB(const LSFResponseCode& code, const LSFString& id) { Reply(code, id); }
+
+    void TransitionLampGroupStateReplyCB(const LSFResponseCode& code, const LSFString& id) {
+        qcc::IncrementAndFetch(&numTransitionReplies);
+        if (code != LSF_OK) {
+            qcc::IncrementAndFetch(&numTransitionFailures);
+        }
+        transitionSemaphore.Post();
+    }
+
+    void GetControllerServiceVersionReplyCB(const uint32_t& version) {
+        qcc::IncrementAndFetch(&numVersionReplies);
+        versionSemaphore.Post();
+    }
+
+    void LampStateChangedCB(const LSFString& lampID, const LampState& lampState) {
+        qcc::IncrementAndFetch(&numLampStates);
+    }
+
+    void SetPresetNameReplyCB(const LSFResponseCode& code, const LSFString& id, const LSFString& language) {
+        qcc::IncrementAndFetch(&numRenameReplies);
+        if (code != LSF_OK) {
+            qcc::IncrementAndFetch(&numRenameFailures);
+        }
+        renameSemaphore.Post();
+    }
+
+  private:
+    void Reply(const LSFResponseCode& code, const LSFString& id) {
+        replyLock.Lock();
+        if (numLateReplies) {
+            // The reply of a call that timed out
+            numLateReplies--;
+        } else {
+            responseCode = code;
+            replyID = id;
+            replySemaphore.Post();
+        }
+        replyLock.Unlock();
+    }
+
+    void Reply(const LSFResponseCode& code, const LSFStringList& ids) {
+        replyLock.Lock();
+        if (!numLateReplies) {
+            replyIDs = ids;
+        }
+        replyLock.Unlock();
+        Reply(code, LSFString());
+    }
+
+    Mutex replyLock;
+    LSFResponseCode responseCode;
+    LSFString replyID;
+    LSFStringList replyIDs;
+    LSFStringList lampIDs;
+    uint32_t numLateReplies;
+    LSFSemaphore replySemaphore;
+    LSFSemaphore connectedSemaphore;
+    LSFSemaphore transitionSemaphore;
+    LSFSemaphore versionSemaphore;
+    LSFSemaphore renameSemaphore;
+
+  public:
+    volatile int32_t numTransitionReplies;
+    volatile int32_t numTransitionFailures;
+    volatile int32_t numVersionReplies;
+    volatile int32_t numRenameReplies;
+    volatile int32_t numRenameFailures;
+    volatile int32_t numLampStates;
+};
+
+/*
+ * Latency samples of one measurement, in microseconds
+ */
+struct LatencyResult {
+    LatencyResult() : numLamps(0), failures(0) { }
+
+    void Write(std::ostream& stream) const {
+        std::vector<uint64_t> sorted = samples;
+        std::sort(sorted.begin(), sorted.end());
+
+        uint64_t total = 0;
+        for (size_t i = 0; i < sorted.size(); i++) {
+            total += sorted[i];
+        }
+
+        stream << "{\"lamps\":" << numLamps << ",\"iterations\":" << sorted.size() << ",\"failures\":" << failures;
+        if (!sorted.empty()) {
+            stream << ",\"meanUs\":" << (total / sorted.size())
+                   << ",\"p50Us\":" << sorted[(sorted.size() * 50) / 100]
+                   << ",\"p90Us\":" << sorted[(sorted.size() * 90) / 100]
+                   << ",\"p99Us\":" << sorted[(sorted.size() * 99) / 100]
+                   << ",\"maxUs\":" << sorted.back();
+        }
+        stream << "}";
+    }
+
+    uint32_t numLamps;
+    uint32_t failures;
+    std::vector<uint64_t> samples;
+};
+
+struct ThroughputResult {
+    ThroughputResult() : numLamps(0), concurrency(0), durationInMs(0), replies(0), failures(0) { }
+
+    void Write(std::ostream& stream) const {
+        stream << "{\"lamps\":" << numLamps << ",\"concurrency\":" << concurrency << ",\"durationMs\":" << durationInMs
+               << ",\"replies\":" << replies << ",\"failures\":" << failures
+               << ",\"repliesPerSecond\":" << (durationInMs ? ((replies * 1000) / durationInMs) : 0) << "}";
+    }
+
+    uint32_t numLamps;
+    uint32_t concurrency;
+    uint64_t durationInMs;
+    uint64_t replies;
+    uint64_t failures;
+};
+
+/*
+ * Time to create the same number of entities one call at a time and with a
+ * single batch call
+ */
+struct CommissioningResult {
+    CommissioningResult(const char* entity, uint32_t count) :
+        entity(entity), count(count), individualMs(0), individualFailures(0), batchMs(0), batchOk(false) { }
+
+    void Write(std::ostream& stream) const {
+        stream << "{\"entity\":\"" << entity << "\",\"count\":" << count
+               << ",\"individualMs\":" << individualMs << ",\"individualFailures\":" << individualFailures
+               << ",\"batchMs\":" << batchMs << ",\"batchOk\":" << (batchOk ? "true" : "false") << "}";
+    }
+
+    const char* entity;
+    uint32_t count;
+    uint64_t individualMs;
+    uint32_t individualFailures;
+    uint64_t batchMs;
+    bool batchOk;
+};
+
+/*
+ * Lamp state updates seen after one ApplyMasterScene. The signal counts are
+ * taken from the statistics of the controller service and are -1 without it
+ */
+struct StateSignalResult {
+    StateSignalResult() : numLamps(0), applied(false), lampStates(0), clientCpuUs(0), signals(-1), signalledStates(-1) { }
+
+    void Write(std::ostream& stream) const {
+        stream << "{\"lamps\":" << numLamps << ",\"applied\":" << (applied ? "true" : "false")
+               << ",\"lampStatesReceived\":" << lampStates << ",\"clientCpuUs\":" << clientCpuUs
+               << ",\"stateChangedSignals\":" << signals << ",\"signalledLampStates\":" << signalledStates << "}";
+    }
+
+    uint32_t numLamps;
+    bool applied;
+    uint32_t lampStates;
+    uint64_t clientCpuUs;
+    int64_t signals;
+    int64_t signalledStates;
+};
+
+/*
+ * Calls made to the lamps and signals sent by the lamps while a pulse effect
+ * is applied, as counted by the lamp fleet simulator
+ */
+struct LampTrafficResult {
+    LampTrafficResult() : numLamps(0), numPulses(0), applied(false), methodCalls(0), getAllCalls(0), stateChangedSignals(0) { }
+
+    void Write(std::ostream& stream) const {
+        stream << "{\"lamps\":" << numLamps << ",\"pulses\":" << numPulses << ",\"applied\":" << (applied ? "true" : "false")
+               << ",\"lampMethodCalls\":" << methodCalls << ",\"getAllCalls\":" << getAllCalls
+               << ",\"stateChangedSignals\":" << stateChangedSignals << "}";
+    }
+
+    uint32_t numLamps;
+    uint32_t numPulses;
+    bool applied;
+    int64_t methodCalls;
+    int64_t getAllCalls;
+    int64_t stateChangedSignals;
+};
+
+/*
+ * CPU time the controller service spent on the ApplyScene and
+ * ApplyMasterScene calls made for a lamp count
+ */
+struct ApplyCpuResult {
+    ApplyCpuResult() : numLamps(0), applies(0), controllerCpuUs(0) { }
+
+    void Write(std::ostream& stream) const {
+        stream << "{\"lamps\":" << numLamps << ",\"applies\":" << applies << ",\"controllerCpuUs\":" << controllerCpuUs
+               << ",\"controllerCpuUsPerApply\":" << (applies ? (controllerCpuUs / applies) : 0) << "}";
+    }
+
+    uint32_t numLamps;
+    uint32_t applies;
+    uint64_t controllerCpuUs;
+};
+
+/*
+ * Resident memory of the controller service in kB. peakKB is the high water
+ * mark over the life of the process
+ */
+struct MemoryResult {
+    MemoryResult() : numLamps(0), connectedKB(0), loadedKB(0), peakKB(0) { }
+
+    void Write(std::ostream& stream) const {
+        stream << "{\"lamps\":" << numLamps << ",\"connectedKB\":" << connectedKB
+               << ",\"loadedKB\":" << loadedKB << ",\"peakKB\":" << peakKB << "}";
+    }
+
+    uint32_t numLamps;
+    uint64_t connectedKB;
+    uint64_t loadedKB;
+    uint64_t peakKB;
+};
+
+/*
+ * Synchronization of a controller service joining the site, as recorded by
+ * that controller service
+ */
+struct ResyncResult {
+    ResyncResult() : numPresets(0), numLampGroups(0), started(false), synchronized(false), syncMs(0), syncBlobs(0), reportedAfterMs(0) { }
+
+    void Write(std::ostream& stream) const {
+        stream << "{\"presets\":" << numPresets << ",\"lampGroups\":" << numLampGroups
+               << ",\"started\":" << (started ? "true" : "false") << ",\"synchronized\":" << (synchronized ? "true" : "false")
+               << ",\"syncMs\":" << syncMs << ",\"syncBlobs\":" << syncBlobs << ",\"reportedAfterMs\":" << reportedAfterMs << "}";
+    }
+
+    uint32_t numPresets;
+    uint32_t numLampGroups;
+    bool started;
+    bool synchronized;
+    int64_t syncMs;
+    int64_t syncBlobs;
+    uint64_t reportedAfterMs;
+};
+
+/*
+ * Time until a scene is served again after the leader was killed, counted
+ * from the kill
+ */
+struct FailoverResult {
+    FailoverResult() : numLamps(0), killed(false), connectedMs(0), firstApplySceneMs(0), failedApplyScenes(0), recovered(false) { }
+
+    void Write(std::ostream& stream) const {
+        stream << "{\"lamps\":" << numLamps << ",\"killed\":" << (killed ? "true" : "false")
+               << ",\"connectedMs\":" << connectedMs << ",\"firstApplySceneMs\":" << firstApplySceneMs
+               << ",\"failedApplyScenes\":" << failedApplyScenes << ",\"recovered\":" << (recovered ? "true" : "false") << "}";
+    }
+
+    uint32_t numLamps;
+    bool killed;
+    uint64_t connectedMs;
+    uint64_t firstApplySceneMs;
+    uint32_t failedApplyScenes;
+    bool recovered;
+};
+
+class ControllerBenchmark {
+  public:
+    ControllerBenchmark(BusAttachment& bus, const BenchmarkConfig& config) :
+        config(config),
+        client(bus, handler),
+        controllerServiceManager(client, handler),
+        lampManager(client, handler),
+        lampGroupManager(client, handler),
+        presetManager(client, handler),
+        transitionEffectManager(client, handler),
+        pulseEffectManager(client, handler),
+        sceneElementManager(client, handler),
+        sceneManager(client, handler),
+        masterSceneManager(client, handler),
+        lampConnectTimeInMs(0) { }
+
+    bool Run(void);
+
+    void WriteResults(std::ostream& stream);
+
+  private:
+    bool WaitForLamps(uint64_t startTimestamp);
+
+    bool Call(ControllerClientStatus status, LSFString* id = NULL);
+
+    void RunDispatch(void);
+
+    bool MeasureRead(LatencyResult& result);
+
+    uint32_t SendRenames(const LSFString& presetID, uint32_t& sent, uint32_t numRenames);
+
+    void RunMixedLoad(void);
+
+    bool RunForLampCount(uint32_t numLamps);
+
+    void MeasureStateSignals(const LSFString& masterSceneID, uint32_t numLamps);
+
+    void RunCommissioning(void);
+
+    void RunPulseEffect(void);
+
+    void RunResync(void);
+
+    void RunFailover(void);
+
+    const BenchmarkConfig& config;
+    BenchmarkHandler handler;
+    ControllerClient client;
+    ControllerServiceManager controllerServiceManager;
+    LampManager lampManager;
+    LampGroupManager lampGroupManager;
+    PresetManager presetManager;
+    TransitionEffectManager transitionEffectManager;
+    PulseEffectManager pulseEffectManager;
+    SceneElementManager sceneElementManager;
+    SceneManager sceneManager;
+    MasterSceneManager masterSceneManager;
+
+    LSFStringList lampIDs;
+    uint64_t lampConnectTimeInMs;
+    ThroughputResult dispatchResult;
+    LatencyResult readResult;
+    LatencyResult readUnderWritesResult;
+    ThroughputResult writeResult;
+    std::vector<LatencyResult> applySceneResults;
+    std::vector<LatencyResult> applyMasterSceneResults;
+    std::vector<ThroughputResult> groupTransitionResults;
+    std::vector<StateSignalResult> stateSignalResults;
+    std::vector<ApplyCpuResult> applyCpuResults;
+    std::vector<CommissioningResult> commissioningResults;
+    LampTrafficResult pulseEffectTrafficResult;
+    MemoryResult memoryResult;
+    ResyncResult resyncResult;
+    FailoverResult failoverResult;
+};
+
+/*
+ * Read the file written by the -s option of the controller service or of the
+ * lamp fleet simulator. Each line is "<name> <type> <value> [...]"
+ */
+static bool ReadStatistics(const std::string& filePath, std::map<std::string, int64_t>& values)
+{
+    std::ifstream file(filePath.c_str());
+    if (!file.is_open()) {
+        QCC_LogError(ER_OPEN_FAILED, ("%s: File not found: %s", __func__, filePath.c_str()));
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string name;
+        std::string type;
+        long long value;
+        if (fields >> name >> type >> value) {
+            values[name] = value;
+        }
+    }
+    return true;
+}
+
+/*
+ * Read the resident memory of a process from /proc/<pid>/status
+ */
+static bool ReadProcessMemory(pid_t pid, uint64_t& residentKB, uint64_t& peakKB)
+{
+    std::ostringstream filePath;
+    filePath << "/proc/" << pid << "/status";
+    std::ifstream file(filePath.str().c_str());
+    if (!file.is_open()) {
+        QCC_LogError(ER_OPEN_FAILED, ("%s: File not found: %s", __func__, filePath.str().c_str()));
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string name;
+        unsigned long long value;
+        if (fields >> name >> value) {
+            if (name == "VmRSS:") {
+                residentKB = value;
+            } else if (name == "VmHWM:") {
+                peakKB = value;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * Read the user and system CPU time of a process from /proc/<pid>/stat
+ */
+static bool ReadProcessCpuTime(pid_t pid, uint64_t& timeInUs)
+{
+    std::ostringstream filePath;
+    filePath << "/proc/" << pid << "/stat";
+    std::ifstream file(filePath.str().c_str());
+    std::string line;
+    if (!file.is_open() || !std::getline(file, line)) {
+        QCC_LogError(ER_OPEN_FAILED, ("%s: File not found: %s", __func__, filePath.str().c_str()));
+        return false;
+    }
+
+    // The process name may contain spaces, so the fields are counted from the ')' that ends it
+    size_t nameEnd = line.rfind(')');
+    if (nameEnd == std::string::npos) {
+        return false;
+    }
+
+    // utime and stime are the 14th and 15th fields, the state is the 3rd
+    std::istringstream fields(line.substr(nameEnd + 1));
+    std::string field;
+    for (int i = 3; i < 14; i++) {
+        fields >> field;
+    }
+    unsigned long long userTicks, systemTicks;
+    if (!(fields >> userTicks >> systemTicks)) {
+        return false;
+    }
+
+    timeInUs = ((userTicks + systemTicks) * 1000000ULL) / sysconf(_SC_CLK_TCK);
+    return true;
+}
+
+bool ControllerBenchmark::Call(ControllerClientStatus status, LSFString* id)
+{
+    if (status != CONTROLLER_CLIENT_OK) {
+        QCC_LogError(ER_FAIL, ("%s: Call failed with %s", __func__, ControllerClientStatusText(status)));
+        return false;
+    }
+
+    LSFResponseCode responseCode;
+    LSFString replyID;
+    if (!handler.WaitForReply(responseCode, replyID)) {
+        return false;
+    }
+    if (id) {
+        *id = replyID;
+    }
+    return (responseCode == LSF_OK);
+}
+
+bool ControllerBenchmark::WaitForLamps(uint64_t startTimestamp)
+{
+    uint64_t deadline = startTimestamp + BENCHMARK_LAMP_WAIT_TIMEOUT_MS;
+    while (GetTimestampInMs() < deadline) {
+        if (lampManager.GetAllLampIDs() != CONTROLLER_CLIENT_OK) {
+            return false;
+        }
+        if (!handler.WaitForLampIDs(lampIDs)) {
+            return false;
+        }
+        if (lampIDs.size() >= config.numLamps) {
+            lampConnectTimeInMs = GetTimestampInMs() - startTimestamp;
+            printf("%u lamps connected after %llu ms\n", static_cast<uint32_t>(lampIDs.size()), static_cast<unsigned long long>(lampConnectTimeInMs));
+            return true;
+        }
+        usleep(1000 * BENCHMARK_LAMP_POLL_INTERVAL_MS);
+    }
+
+    printf("Only %u of %u lamps connected after %u ms\n", static_cast<uint32_t>(lampIDs.size()), config.numLamps, BENCHMARK_LAMP_WAIT_TIMEOUT_MS);
+    return false;
+}
+
+void ControllerBenchmark::RunDispatch(void)
+{
+    printf("Measuring dispatch with %u callers\n", config.dispatchCallers);
+    fflush(stdout);
+
+    dispatchResult.numLamps = static_cast<uint32_t>(lampIDs.size());
+    dispatchResult.concurrency = config.dispatchCallers;
+
+    int32_t initialReplies = handler.numVersionReplies;
+    uint32_t inFlight = 0;
+    uint64_t start = GetTimestampInMs();
+    uint64_t end = start + (1000 * config.durationInSeconds);
+
+    for (uint32_t i = 0; i < config.dispatchCallers; i++) {
+        if (controllerServiceManager.GetControllerServiceVersion() == CONTROLLER_CLIENT_OK) {
+            inFlight++;
+        }
+    }
+
+    while (inFlight) {
+        if (!handler.WaitForVersionReply()) {
+            QCC_LogError(ER_TIMEOUT, ("%s: %u version calls did not complete", __func__, inFlight));
+            break;
+        }
+        inFlight--;
+
+        if ((GetTimestampInMs() < end) && (controllerServiceManager.GetControllerServiceVersion() == CONTROLLER_CLIENT_OK)) {
+            inFlight++;
+        }
+    }
+
+    dispatchResult.durationInMs = GetTimestampInMs() - start;
+    dispatchResult.replies = static_cast<uint64_t>(handler.numVersionReplies - initialReplies);
+    dispatchResult.failures = inFlight;
+}
+
+bool ControllerBenchmark::MeasureRead(LatencyResult& result)
+{
+    uint64_t start = GetTimestampInUs();
+    if (Call(presetManager.GetAllPresetIDs())) {
+        result.samples.push_back(GetTimestampInUs() - start);
+    } else {
+        result.failures++;
+    }
+
+    // Stop if nothing comes back at all
+    return !(result.samples.empty() && (result.failures > 10));
+}
+
+uint32_t ControllerBenchmark::SendRenames(const LSFString& presetID, uint32_t& sent, uint32_t numRenames)
+{
+    uint32_t numSent = 0;
+    for (uint32_t i = 0; i < numRenames; i++, sent++) {
+        std::ostringstream name;
+        name << "BenchmarkPreset" << sent;
+        if (presetManager.SetPresetName(presetID, name.str()) == CONTROLLER_CLIENT_OK) {
+            numSent++;
+        }
+    }
+    return numSent;
+}
+
+void ControllerBenchmark::RunMixedLoad(void)
+{
+    printf("Measuring reads with %u writes in flight\n", config.concurrency);
+    fflush(stdout);
+
+    LSFString presetID;
+    if (!Call(presetManager.CreatePreset(LampState(true, 0, 0, 0, 100), "BenchmarkPreset"), &presetID)) {
+        return;
+    }
+
+    readResult.numLamps = static_cast<uint32_t>(lampIDs.size());
+    uint64_t end = GetTimestampInMs() + (1000 * config.durationInSeconds);
+    while ((GetTimestampInMs() < end) && MeasureRead(readResult)) {
+    }
+
+    readUnderWritesResult.numLamps = readResult.numLamps;
+    writeResult.numLamps = readResult.numLamps;
+    writeResult.concurrency = config.concurrency;
+
+    int32_t initialReplies = handler.numRenameReplies;
+    int32_t initialFailures = handler.numRenameFailures;
+    uint32_t sent = 0;
+    uint32_t inFlight = SendRenames(presetID, sent, config.concurrency);
+    uint64_t start = GetTimestampInMs();
+    end = start + (1000 * config.durationInSeconds);
+
+    /*
+     * The reads are issued one at a time from this thread. The replies of the
+     * renames are counted on the callback thread, and the renames that have
+     * completed are replaced after every read
+     */
+    while ((GetTimestampInMs() < end) && MeasureRead(readUnderWritesResult)) {
+        uint32_t completed = static_cast<uint32_t>(handler.numRenameReplies - initialReplies);
+        uint32_t outstanding = inFlight - completed;
+        if (outstanding < config.concurrency) {
+            inFlight += SendRenames(presetID, sent, config.concurrency - outstanding);
+        }
+    }
+
+    while (inFlight > static_cast<uint32_t>(handler.numRenameReplies - initialReplies)) {
+        if (!handler.WaitForRenameReply()) {
+            QCC_LogError(ER_TIMEOUT, ("%s: Preset renames did not complete", __func__));
+            break;
+        }
+    }
+
+    writeResult.durationInMs = GetTimestampInMs() - start;
+    writeResult.replies = static_cast<uint64_t>(handler.numRenameReplies - initialReplies);
+    writeResult.failures = static_cast<uint64_t>(handler.numRenameFailures - initialFailures);
+
+    Call(presetManager.DeletePreset(presetID));
+}
+
+bool ControllerBenchmark::RunForLampCount(uint32_t numLamps)
+{
+    printf("Measuring with %u lamps\n", numLamps);
+    fflush(stdout);
+
+    LSFStringList lamps;
+    LSFStringList::const_iterator lit = lampIDs.begin();
+    for (uint32_t i = 0; i < numLamps; i++, lit++) {
+        lamps.push_back(*lit);
+    }
+
+    LSFStringList noGroups;
+    LSFString lampGroupID;
+    LSFString transitionEffectID;
+    LSFString sceneElementID;
+    LSFString sceneID;
+    LSFString masterSceneID;
+    uint32_t trackingID;
+
+    LampState onState(true, 0, 0, 0, 100);
+    LampState offState(false, 0, 0, 0, 0);
+    uint32_t transitionPeriod = 0;
+    TransitionEffect transitionEffect(onState, transitionPeriod);
+
+    bool ok = Call(lampGroupManager.CreateLampGroup(LampGroup(lamps, noGroups), "BenchmarkGroup"), &lampGroupID);
+    if (ok) {
+        ok = Call(transitionEffectManager.CreateTransitionEffect(trackingID, transitionEffect, "BenchmarkEffect"), &transitionEffectID);
+    }
+    if (ok) {
+        LSFStringList groups;
+        groups.push_back(lampGroupID);
+        LSFStringList noLamps;
+        ok = Call(sceneElementManager.CreateSceneElement(trackingID, SceneElement(noLamps, groups, transitionEffectID), "BenchmarkSceneElement"), &sceneElementID);
+    }
+    if (ok) {
+        LSFStringList sceneElements;
+        sceneElements.push_back(sceneElementID);
+        ok = Call(sceneManager.CreateSceneWithSceneElements(trackingID, SceneWithSceneElements(sceneElements), "BenchmarkScene"), &sceneID);
+    }
+    if (ok) {
+        LSFStringList scenes;
+        scenes.push_back(sceneID);
+        ok = Call(masterSceneManager.CreateMasterScene(MasterScene(scenes), "BenchmarkMasterScene"), &masterSceneID);
+    }
+
+    if (ok) {
+        LatencyResult sceneResult;
+        LatencyResult masterSceneResult;
+        sceneResult.numLamps = numLamps;
+        masterSceneResult.numLamps = numLamps;
+
+        ApplyCpuResult cpuResult;
+        cpuResult.numLamps = numLamps;
+        uint64_t cpuBefore = 0;
+        bool haveCpu = config.controllerPid && ReadProcessCpuTime(config.controllerPid, cpuBefore);
+
+        for (uint32_t i = 0; (i < config.iterations) && ok; i++) {
+            uint64_t start = GetTimestampInUs();
+            if (Call(sceneManager.ApplyScene(sceneID))) {
+                sceneResult.samples.push_back(GetTimestampInUs() - start);
+            } else {
+                sceneResult.failures++;
+            }
+
+            start = GetTimestampInUs();
+            if (Call(masterSceneManager.ApplyMasterScene(masterSceneID))) {
+                masterSceneResult.samples.push_back(GetTimestampInUs() - start);
+            } else {
+                masterSceneResult.failures++;
+            }
+
+            // Stop if nothing comes back at all
+            ok = !(sceneResult.samples.empty() && (sceneResult.failures > 10));
+        }
+
+        uint64_t cpuAfter = 0;
+        if (haveCpu && ReadProcessCpuTime(config.controllerPid, cpuAfter)) {
+            cpuResult.applies = static_cast<uint32_t>(sceneResult.samples.size() + sceneResult.failures + masterSceneResult.samples.size() + masterSceneResult.failures);
+            cpuResult.controllerCpuUs = cpuAfter - cpuBefore;
+            applyCpuResults.push_back(cpuResult);
+        }
+
+        applySceneResults.push_back(sceneResult);
+        applyMasterSceneResults.push_back(masterSceneResult);
+    }
+
+    if (ok) {
+        MeasureStateSignals(masterSceneID, numLamps);
+    }
+
+    if (ok) {
+        ThroughputResult result;
+        result.numLamps = numLamps;
+        result.concurrency = config.concurrency;
+
+        int32_t initialReplies = handler.numTransitionReplies;
+        int32_t initialFailures = handler.numTransitionFailures;
+        uint32_t inFlight = 0;
+        uint64_t start = GetTimestampInMs();
+        uint64_t end = start + (1000 * config.durationInSeconds);
+
+        for (uint32_t i = 0; i < config.concurrency; i++) {
+            if (lampGroupManager.TransitionLampGroupState(lampGroupID, (i & 1) ? offState : onState) == CONTROLLER_CLIENT_OK) {
+                inFlight++;
+            }
+        }
+
+        uint32_t sent = inFlight;
+        while (inFlight) {
+            if (!handler.WaitForTransitionReply()) {
+                QCC_LogError(ER_TIMEOUT, ("%s: %u group transitions did not complete", __func__, inFlight));
+                break;
+            }
+            inFlight--;
+
+            if (GetTimestampInMs() < end) {
+                sent++;
+                if (lampGroupManager.TransitionLampGroupState(lampGroupID, (sent & 1) ? offState : onState) == CONTROLLER_CLIENT_OK) {
+                    inFlight++;
+                }
+            }
+        }
+
+        result.durationInMs = GetTimestampInMs() - start;
+        result.replies = static_cast<uint64_t>(handler.numTransitionReplies - initialReplies);
+        result.failures = static_cast<uint64_t>(handler.numTransitionFailures - initialFailures);
+        groupTransitionResults.push_back(result);
+    }
+
+    if (!masterSceneID.empty()) {
+        Call(masterSceneManager.DeleteMasterScene(masterSceneID));
+    }
+    if (!sceneID.empty()) {
+        Call(sceneManager.DeleteScene(sceneID));
+    }
+    if (!sceneElementID.empty()) {
+        Call(sceneElementManager.DeleteSceneElement(sceneElementID));
+    }
+    if (!transitionEffectID.empty()) {
+        Call(transitionEffectManager.DeleteTransitionEffect(transitionEffectID));
+    }
+    if (!lampGroupID.empty()) {
+        Call(lampGroupManager.DeleteLampGroup(lampGroupID));
+    }
+
+    return ok;
+}
+
+static uint64_t GetCpuTimeInUs(void)
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage)) {
+        return 0;
+    }
+    return (static_cast<uint64_t>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000) + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
+void ControllerBenchmark::MeasureStateSignals(const LSFString& masterSceneID, uint32_t numLamps)
+{
+    StateSignalResult result;
+    result.numLamps = numLamps;
+
+    // The state changes of the scene applies above must be over first
+    uint32_t settleTime = config.statisticsFile.empty() ? BENCHMARK_LAMP_STATISTICS_SETTLE_MS : BENCHMARK_CONTROLLER_STATISTICS_SETTLE_MS;
+    usleep(1000 * settleTime);
+
+    std::map<std::string, int64_t> before;
+    std::map<std::string, int64_t> after;
+    bool haveStatistics = !config.statisticsFile.empty() && ReadStatistics(config.statisticsFile, before);
+
+    int32_t initialLampStates = handler.numLampStates;
+    uint64_t initialCpuTime = GetCpuTimeInUs();
+
+    result.applied = Call(masterSceneManager.ApplyMasterScene(masterSceneID));
+    usleep(1000 * settleTime);
+
+    result.clientCpuUs = GetCpuTimeInUs() - initialCpuTime;
+    result.lampStates = static_cast<uint32_t>(handler.numLampStates - initialLampStates);
+
+    if (haveStatistics && ReadStatistics(config.statisticsFile, after)) {
+        result.signals = after["LampClients.StateChangedSignals"] - before["LampClients.StateChangedSignals"];
+        result.signalledStates = after["LampClients.SignalledLampStates"] - before["LampClients.SignalledLampStates"];
+    }
+
+    stateSignalResults.push_back(result);
+}
+
+void ControllerBenchmark::RunCommissioning(void)
+{
+    uint32_t count = config.commissioningCount;
+    printf("Commissioning %u presets and lamp groups\n", count);
+    fflush(stdout);
+
+    std::list<LampState> states;
+    std::list<LampGroup> groups;
+    LSFStringList names;
+    LSFStringList noGroups;
+    LSFStringList firstLamp;
+    firstLamp.push_back(lampIDs.front());
+    for (uint32_t i = 0; i < count; i++) {
+        std::ostringstream name;
+        name << "Benchmark" << i;
+        names.push_back(name.str());
+        states.push_back(LampState(true, i, 0, 0, 100));
+        groups.push_back(LampGroup(firstLamp, noGroups));
+    }
+
+    CommissioningResult presetResult("preset", count);
+    LSFStringList ids;
+    LSFString id;
+
+    uint64_t start = GetTimestampInMs();
+    LSFStringList::const_iterator nit = names.begin();
+    for (std::list<LampState>::const_iterator it = states.begin(); it != states.end(); ++it, ++nit) {
+        if (Call(presetManager.CreatePreset(*it, *nit), &id)) {
+            ids.push_back(id);
+        } else {
+            presetResult.individualFailures++;
+        }
+    }
+    presetResult.individualMs = GetTimestampInMs() - start;
+    for (LSFStringList::const_iterator it = ids.begin(); it != ids.end(); ++it) {
+        Call(presetManager.DeletePreset(*it));
+    }
+
+    LSFResponseCode code = LSF_ERR_FAILURE;
+    ids.clear();
+    start = GetTimestampInMs();
+    if (presetManager.CreatePresets(states, names) == CONTROLLER_CLIENT_OK) {
+        presetResult.batchOk = handler.WaitForReplyIDs(code, ids) && (code == LSF_OK);
+    }
+    presetResult.batchMs = GetTimestampInMs() - start;
+    for (LSFStringList::const_iterator it = ids.begin(); it != ids.end(); ++it) {
+        Call(presetManager.DeletePreset(*it));
+    }
+    commissioningResults.push_back(presetResult);
+
+    CommissioningResult groupResult("lampGroup", count);
+    ids.clear();
+
+    start = GetTimestampInMs();
+    nit = names.begin();
+    for (std::list<LampGroup>::const_iterator it = groups.begin(); it != groups.end(); ++it, ++nit) {
+        if (Call(lampGroupManager.CreateLampGroup(*it, *nit), &id)) {
+            ids.push_back(id);
+        } else {
+            groupResult.individualFailures++;
+        }
+    }
+    groupResult.individualMs = GetTimestampInMs() - start;
+    for (LSFStringList::const_iterator it = ids.begin(); it != ids.end(); ++it) {
+        Call(lampGroupManager.DeleteLampGroup(*it));
+    }
+
+    code = LSF_ERR_FAILURE;
+    ids.clear();
+    start = GetTimestampInMs();
+    if (lampGroupManager.CreateLampGroups(groups, names) == CONTROLLER_CLIENT_OK) {
+        groupResult.batchOk = handler.WaitForReplyIDs(code, ids) && (code == LSF_OK);
+    }
+    groupResult.batchMs = GetTimestampInMs() - start;
+    for (LSFStringList::const_iterator it = ids.begin(); it != ids.end(); ++it) {
+        Call(lampGroupManager.DeleteLampGroup(*it));
+    }
+    commissioningResults.push_back(groupResult);
+}
+
+void ControllerBenchmark::RunPulseEffect(void)
+{
+    uint32_t numLamps = std::min(static_cast<uint32_t>(lampIDs.size()), static_cast<uint32_t>(BENCHMARK_PULSE_EFFECT_LAMPS));
+    printf("Counting the lamp traffic of a pulse effect on %u lamps\n", numLamps);
+    fflush(stdout);
+
+    LSFStringList lamps;
+    LSFStringList::const_iterator lit = lampIDs.begin();
+    for (uint32_t i = 0; i < numLamps; i++, lit++) {
+        lamps.push_back(*lit);
+    }
+
+    pulseEffectTrafficResult.numLamps = numLamps;
+    pulseEffectTrafficResult.numPulses = BENCHMARK_PULSE_EFFECT_PULSES;
+
+    LSFString pulseEffectID;
+    LSFString sceneElementID;
+    LSFString sceneID;
+    uint32_t trackingID;
+
+    LampState fromState(true, 0, 0, 0, 0);
+    LampState toState(true, 0, 0, 0, 100);
+    uint32_t period = 1000;
+    uint32_t duration = 500;
+    uint32_t numPulses = BENCHMARK_PULSE_EFFECT_PULSES;
+    PulseEffect pulseEffect(toState, period, duration, numPulses, fromState);
+
+    bool ok = Call(pulseEffectManager.CreatePulseEffect(trackingID, pulseEffect, "BenchmarkPulseEffect"), &pulseEffectID);
+    if (ok) {
+        LSFStringList noGroups;
+        ok = Call(sceneElementManager.CreateSceneElement(trackingID, SceneElement(lamps, noGroups, pulseEffectID), "BenchmarkPulseSceneElement"), &sceneElementID);
+    }
+    if (ok) {
+        LSFStringList sceneElements;
+        sceneElements.push_back(sceneElementID);
+        ok = Call(sceneManager.CreateSceneWithSceneElements(trackingID, SceneWithSceneElements(sceneElements), "BenchmarkPulseScene"), &sceneID);
+    }
+
+    // Let the traffic of the earlier measurements die down
+    usleep(1000 * BENCHMARK_LAMP_STATISTICS_SETTLE_MS);
+
+    std::map<std::string, int64_t> before;
+    std::map<std::string, int64_t> after;
+    if (ok) {
+        ok = ReadStatistics(config.lampStatisticsFile, before);
+    }
+    if (ok) {
+        pulseEffectTrafficResult.applied = Call(sceneManager.ApplyScene(sceneID));
+        usleep(1000 * BENCHMARK_LAMP_STATISTICS_SETTLE_MS);
+        ok = ReadStatistics(config.lampStatisticsFile, after);
+    }
+    if (ok) {
+        pulseEffectTrafficResult.methodCalls = after["LampFleet.MethodCalls"] - before["LampFleet.MethodCalls"];
+        pulseEffectTrafficResult.getAllCalls = after["LampFleet.GetAllCalls"] - before["LampFleet.GetAllCalls"];
+        pulseEffectTrafficResult.stateChangedSignals = after["LampFleet.StateChangedSignals"] - before["LampFleet.StateChangedSignals"];
+    }
+
+    if (!sceneID.empty()) {
+        Call(sceneManager.DeleteScene(sceneID));
+    }
+    if (!sceneElementID.empty()) {
+        Call(sceneElementManager.DeleteSceneElement(sceneElementID));
+    }
+    if (!pulseEffectID.empty()) {
+        Call(pulseEffectManager.DeletePulseEffect(pulseEffectID));
+    }
+}
+
+void ControllerBenchmark::RunResync(void)
+{
+    uint32_t count = config.commissioningCount;
+    printf("Measuring the synchronization of a joining controller with %u presets and lamp groups\n", count);
+    fflush(stdout);
+
+    LSFStringList presetIDs;
+    LSFStringList lampGroupIDs;
+    if (count) {
+        std::list<LampState> states;
+        std::list<LampGroup> groups;
+        LSFStringList names;
+        LSFStringList noGroups;
+        for (uint32_t i = 0; i < count; i++) {
+            std::ostringstream name;
+            name << "BenchmarkSite" << i;
+            names.push_back(name.str());
+            states.push_back(LampState(true, i, 0, 0, 100));
+            groups.push_back(LampGroup(lampIDs, noGroups));
+        }
+
+        LSFResponseCode code = LSF_ERR_FAILURE;
+        if (presetManager.CreatePresets(states, names) == CONTROLLER_CLIENT_OK) {
+            handler.WaitForReplyIDs(code, presetIDs);
+        }
+        code = LSF_ERR_FAILURE;
+        if (lampGroupManager.CreateLampGroups(groups, names) == CONTROLLER_CLIENT_OK) {
+            handler.WaitForReplyIDs(code, lampGroupIDs);
+        }
+    }
+    resyncResult.numPresets = static_cast<uint32_t>(presetIDs.size());
+    resyncResult.numLampGroups = static_cast<uint32_t>(lampGroupIDs.size());
+
+    // A file left by an earlier run would be taken for the result of this one
+    unlink(config.joinStatisticsFile.c_str());
+
+    uint64_t start = GetTimestampInMs();
+    pid_t pid = fork();
+    if (pid == 0) {
+        // Own process group, so that SIGINT reaches the controller and not just the shell
+        setpgid(0, 0);
+        execl("/bin/sh", "sh", "-c", config.joinCommand.c_str(), static_cast<char*>(NULL));
+        _exit(127);
+    }
+
+    if (pid > 0) {
+        resyncResult.started = true;
+        uint64_t deadline = start + BENCHMARK_RESYNC_TIMEOUT_MS;
+        while (!resyncResult.synchronized && (GetTimestampInMs() < deadline)) {
+            usleep(1000 * BENCHMARK_LAMP_POLL_INTERVAL_MS);
+            std::map<std::string, int64_t> values;
+            if ((access(config.joinStatisticsFile.c_str(), R_OK) == 0) && ReadStatistics(config.joinStatisticsFile, values) && (values["LeaderElection.LastSyncMs"] > 0)) {
+                resyncResult.synchronized = true;
+                resyncResult.syncMs = values["LeaderElection.LastSyncMs"];
+                resyncResult.syncBlobs = values["LeaderElection.LastSyncBlobs"];
+                resyncResult.reportedAfterMs = GetTimestampInMs() - start;
+            }
+        }
+
+        kill(-pid, SIGINT);
+        waitpid(pid, NULL, 0);
+    } else {
+        QCC_LogError(ER_FAIL, ("%s: fork failed", __func__));
+    }
+
+    if (resyncResult.synchronized) {
+        printf("The joining controller synchronized %lld stores in %lld ms\n", static_cast<long long>(resyncResult.syncBlobs), static_cast<long long>(resyncResult.syncMs));
+    } else {
+        printf("The joining controller did not report a synchronization\n");
+    }
+
+    for (LSFStringList::const_iterator it = presetIDs.begin(); it != presetIDs.end(); ++it) {
+        Call(presetManager.DeletePreset(*it));
+    }
+    for (LSFStringList::const_iterator it = lampGroupIDs.begin(); it != lampGroupIDs.end(); ++it) {
+        Call(lampGroupManager.DeleteLampGroup(*it));
+    }
+}
+
+void ControllerBenchmark::RunFailover(void)
+{
+    printf("Measuring the failover after killing the leader %d\n", static_cast<int>(config.leaderPid));
+    fflush(stdout);
+
+    failoverResult.numLamps = static_cast<uint32_t>(lampIDs.size());
+
+    LSFStringList noGroups;
+    LSFString transitionEffectID;
+    LSFString sceneElementID;
+    LSFString sceneID;
+    uint32_t trackingID;
+
+    LampState onState(true, 0, 0, 0, 100);
+    uint32_t transitionPeriod = 0;
+    TransitionEffect transitionEffect(onState, transitionPeriod);
+
+    bool ok = Call(transitionEffectManager.CreateTransitionEffect(trackingID, transitionEffect, "BenchmarkFailoverEffect"), &transitionEffectID);
+    if (ok) {
+        ok = Call(sceneElementManager.CreateSceneElement(trackingID, SceneElement(lampIDs, noGroups, transitionEffectID), "BenchmarkFailoverSceneElement"), &sceneElementID);
+    }
+    if (ok) {
+        LSFStringList sceneElements;
+        sceneElements.push_back(sceneElementID);
+        ok = Call(sceneManager.CreateSceneWithSceneElements(trackingID, SceneWithSceneElements(sceneElements), "BenchmarkFailoverScene"), &sceneID);
+    }
+    if (ok) {
+        ok = Call(sceneManager.ApplyScene(sceneID));
+    }
+    if (!ok) {
+        QCC_LogError(ER_FAIL, ("%s: Could not set up the scene", __func__));
+        return;
+    }
+
+    // Give the followers time to fetch the new scene from the leader
+    usleep(1000 * BENCHMARK_LAMP_STATISTICS_SETTLE_MS);
+
+    handler.ClearConnections();
+    if (kill(config.leaderPid, SIGKILL)) {
+        QCC_LogError(ER_FAIL, ("%s: Could not kill %d", __func__, static_cast<int>(config.leaderPid)));
+        return;
+    }
+    failoverResult.killed = true;
+
+    uint64_t start = GetTimestampInMs();
+    uint64_t deadline = start + BENCHMARK_FAILOVER_TIMEOUT_MS;
+
+    bool connected = false;
+    while (!connected && (GetTimestampInMs() < deadline)) {
+        connected = handler.WaitForConnection();
+    }
+    if (!connected) {
+        printf("No other Controller Service took over after %u ms\n", BENCHMARK_FAILOVER_TIMEOUT_MS);
+        return;
+    }
+    failoverResult.connectedMs = GetTimestampInMs() - start;
+
+    while (GetTimestampInMs() < deadline) {
+        if (Call(sceneManager.ApplyScene(sceneID))) {
+            failoverResult.firstApplySceneMs = GetTimestampInMs() - start;
+            failoverResult.recovered = true;
+            break;
+        }
+        failoverResult.failedApplyScenes++;
+        usleep(1000 * BENCHMARK_LAMP_POLL_INTERVAL_MS);
+    }
+    printf("First ApplyScene served %llu ms after the leader was killed\n", static_cast<unsigned long long>(failoverResult.firstApplySceneMs));
+
+    Call(sceneManager.DeleteScene(sceneID));
+    Call(sceneElementManager.DeleteSceneElement(sceneElementID));
+    Call(transitionEffectManager.DeleteTransitionEffect(transitionEffectID));
+}
+
+bool ControllerBenchmark::Run(void)
+{
+    uint64_t startTimestamp = GetTimestampInMs();
+
+    ControllerClientStatus status = client.Start();
+    if (status != CONTROLLER_CLIENT_OK) {
+        QCC_LogError(ER_FAIL, ("%s: ControllerClient::Start failed with %s", __func__, ControllerClientStatusText(status)));
+        return false;
+    }
+
+    if (!handler.WaitForConnection()) {
+        QCC_LogError(ER_TIMEOUT, ("%s: No Controller Service found", __func__));
+        return false;
+    }
+
+    if (!WaitForLamps(startTimestamp)) {
+        return false;
+    }
+
+    lampIDs.sort();
+
+    if (config.controllerPid) {
+        memoryResult.numLamps = static_cast<uint32_t>(lampIDs.size());
+        ReadProcessMemory(config.controllerPid, memoryResult.connectedKB, memoryResult.peakKB);
+    }
+
+    if (config.dispatchCallers) {
+        RunDispatch();
+    }
+
+    RunMixedLoad();
+
+    bool ok = true;
+    for (std::vector<uint32_t>::const_iterator it = config.lampCounts.begin(); (it != config.lampCounts.end()) && ok; ++it) {
+        if (*it > lampIDs.size()) {
+            printf("Skipping %u lamps, only %u are connected\n", *it, static_cast<uint32_t>(lampIDs.size()));
+            continue;
+        }
+        ok = RunForLampCount(*it);
+    }
+
+    if (config.controllerPid) {
+        ReadProcessMemory(config.controllerPid, memoryResult.loadedKB, memoryResult.peakKB);
+    }
+
+    if (ok && !config.lampStatisticsFile.empty()) {
+        RunPulseEffect();
+    }
+
+    if (ok && config.commissioningCount) {
+        RunCommissioning();
+    }
+
+    if (ok && !config.joinCommand.empty() && !config.joinStatisticsFile.empty()) {
+        RunResync();
+    }
+
+    // Runs last, as it takes the leader down
+    if (ok && config.leaderPid) {
+        RunFailover();
+    }
+
+    client.Stop();
+    return ok;
+}
+
+/*
+ * Copy the file written by the -s option of the controller service into the
+ * results. Each line is "<name> <type> <value> [p50=<n> p99=<n> max=<n>]"
+ */
+static void WriteControllerStatistics(std::ostream& stream, const std::string& filePath)
+{
+    std::ifstream file(filePath.c_str());
+    if (!file.is_open()) {
+        QCC_LogError(ER_OPEN_FAILED, ("%s: File not found: %s", __func__, filePath.c_str()));
+        stream << "{}";
+        return;
+    }
+
+    stream << "{";
+    bool first = true;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string name;
+        std::string type;
+        long long value;
+        if (!(fields >> name >> type >> value)) {
+            continue;
+        }
+
+        stream << (first ? "" : ",") << "\"" << name << "\":{\"type\":\"" << type << "\",\"value\":" << value;
+        std::string percentile;
+        while (fields >> percentile) {
+            size_t pos = percentile.find('=');
+            if (pos != std::string::npos) {
+                stream << ",\"" << percentile.substr(0, pos) << "\":" << percentile.substr(pos + 1);
+            }
+        }
+        stream << "}";
+        first = false;
+    }
+    stream << "}";
+}
+
+void ControllerBenchmark::WriteResults(std::ostream& stream)
+{
+    stream << "{\"lampsExpected\":" << config.numLamps
+           << ",\"lampsConnected\":" << lampIDs.size()
+           << ",\"lampConnectTimeMs\":" << lampConnectTimeInMs;
+
+    stream << ",\"dispatch\":";
+    dispatchResult.Write(stream);
+    stream << ",\"presetReads\":";
+    readResult.Write(stream);
+    stream << ",\"presetReadsUnderWrites\":";
+    readUnderWritesResult.Write(stream);
+    stream << ",\"presetWrites\":";
+    writeResult.Write(stream);
+
+    stream << ",\"applyScene\":[";
+    for (size_t i = 0; i < applySceneResults.size(); i++) {
+        stream << (i ? "," : "");
+        applySceneResults[i].Write(stream);
+    }
+    stream << "],\"applyMasterScene\":[";
+    for (size_t i = 0; i < applyMasterSceneResults.size(); i++) {
+        stream << (i ? "," : "");
+        applyMasterSceneResults[i].Write(stream);
+    }
+    stream << "],\"masterSceneStateSignals\":[";
+    for (size_t i = 0; i < stateSignalResults.size(); i++) {
+        stream << (i ? "," : "");
+        stateSignalResults[i].Write(stream);
+    }
+    stream << "],\"groupTransition\":[";
+    for (size_t i = 0; i < groupTransitionResults.size(); i++) {
+        stream << (i ? "," : "");
+        groupTransitionResults[i].Write(stream);
+    }
+    stream << "],\"commissioning\":[";
+    for (size_t i = 0; i < commissioningResults.size(); i++) {
+        stream << (i ? "," : "");
+        commissioningResults[i].Write(stream);
+    }
+    stream << "]";
+
+    if (!config.lampStatisticsFile.empty()) {
+        stream << ",\"pulseEffectLampTraffic\":";
+        pulseEffectTrafficResult.Write(stream);
+    }
+
+    if (config.controllerPid) {
+        stream << ",\"applyControllerCpu\":[";
+        for (size_t i = 0; i < applyCpuResults.size(); i++) {
+            stream << (i ? "," : "");
+            applyCpuResults[i].Write(stream);
+        }
+        stream << "],\"controllerMemory\":";
+        memoryResult.Write(stream);
+    }
+
+    if (!config.joinCommand.empty()) {
+        stream << ",\"resync\":";
+        resyncResult.Write(stream);
+    }
+
+    if (config.leaderPid) {
+        stream << ",\"failover\":";
+        failoverResult.Write(stream);
+    }
+
+    if (!config.statisticsFile.empty()) {
+        stream << ",\"controllerStatistics\":";
+        WriteControllerStatistics(stream, config.statisticsFile);
+    }
+    stream << "}" << std::endl;
+}
+
+static void usage(char** argv)
+{
+    printf("Usage: %s [-n <num_lamps>] [-s <lamp_counts>] [-i <iterations>] [-c <concurrency>] [-d <duration_seconds>] [-D <callers>] [-C <count>] [-S <statistics_file>] [-L <lamp_statistics_file>] [-J <command> -R <statistics_file>] [-P <controller_pid>] [-K <leader_pid>] [-o <output_file>]\n\n", argv[0]);
+    printf("Options:\n");
+    printf("   -n <num_lamps>          = Number of lamps to wait for. Default 10\n");
+    printf("   -s <lamp_counts>        = Comma separated lamp counts to measure. Default 10,100,1000\n");
+    printf("   -i <iterations>         = Number of ApplyScene and ApplyMasterScene calls per lamp count. Default 100\n");
+    printf("   -c <concurrency>        = Group transitions and preset renames kept in flight. Default 8\n");
+    printf("   -d <duration_seconds>   = Duration of the group transition, dispatch and preset read measurements. Default 10\n");
+    printf("   -D <callers>            = Version calls kept in flight in the dispatch measurement. Default 16, 0 skips it\n");
+    printf("   -C <count>              = Number of presets and lamp groups to commission. Default 0 (skipped)\n");
+    printf("   -S <statistics_file>    = Statistics file written by the controller service -s option\n");
+    printf("   -L <lamp_statistics_file> = Statistics file written by the lamp fleet simulator -s option\n");
+    printf("   -J <command>            = Shell command starting a controller service that joins the site\n");
+    printf("   -R <statistics_file>    = Statistics file written by the -s option of the joining controller service\n");
+    printf("   -P <controller_pid>     = Process ID of the controller service, to report its CPU time and resident memory\n");
+    printf("   -K <leader_pid>         = Kill the leader Controller Service at the end and time the failover\n");
+    printf("   -o <output_file>        = File to write the JSON results to. Default stdout\n");
+}
+
+int main(int argc, char** argv)
+{
+    BenchmarkConfig config;
+
+    for (int i = 1; i < argc; i++) {
+        if ((i + 1) >= argc) {
+            usage(argv);
+            return 1;
+        }
+
+        if (0 == strcmp("-n", argv[i])) {
+            config.numLamps = strtoul(argv[++i], NULL, 10);
+        } else if (0 == strcmp("-s", argv[i])) {
+            config.lampCounts.clear();
+            std::istringstream counts(argv[++i]);
+            std::string count;
+            while (std::getline(counts, count, ',')) {
+                config.lampCounts.push_back(strtoul(count.c_str(), NULL, 10));
+            }
+        } else if (0 == strcmp("-i", argv[i])) {
+            config.iterations = strtoul(argv[++i], NULL, 10);
+        } else if (0 == strcmp("-c", argv[i])) {
+            config.concurrency = strtoul(argv[++i], NULL, 10);
+        } else if (0 == strcmp("-d", argv[i])) {
+            config.durationInSeconds = strtoul(argv[++i], NULL, 10);
+        } else if (0 == strcmp("-D", argv[i])) {
+            config.dispatchCallers = strtoul(argv[++i], NULL, 10);
+        } else if (0 == strcmp("-C", argv[i])) {
+            config.commissioningCount = strtoul(argv[++i], NULL, 10);
+        } else if (0 == strcmp("-S", argv[i])) {
+            config.statisticsFile = argv[++i];
+        } else if (0 == strcmp("-L", argv[i])) {
+            config.lampStatisticsFile = argv[++i];
+        } else if (0 == strcmp("-J", argv[i])) {
+            config.joinCommand = argv[++i];
+        } else if (0 == strcmp("-R", argv[i])) {
+            config.joinStatisticsFile = argv[++i];
+        } else if (0 == strcmp("-P", argv[i])) {
+            config.controllerPid = static_cast<pid_t>(strtol(argv[++i], NULL, 10));
+        } else if (0 == strcmp("-K", argv[i])) {
+            config.leaderPid = static_cast<pid_t>(strtol(argv[++i], NULL, 10));
+        } else if (0 == strcmp("-o", argv[i])) {
+            config.outputFile = argv[++i];
+        } else {
+            usage(argv);
+            return 1;
+        }
+    }
+
+    AJInitializer ajInitializer;
+    if (ajInitializer.Initialize() != ER_OK) {
+        return -1;
+    }
+
+    BusAttachment bus("ControllerBenchmark", true);
+    QStatus status = bus.Start();
+    if (status == ER_OK) {
+        status = bus.Connect();
+    }
+    if (status != ER_OK) {
+        QCC_LogError(status, ("%s: Failed to start and connect the bus", __func__));
+        return -1;
+    }
+
+    int ret = 0;
+    {
+        ControllerBenchmark benchmark(bus, config);
+        if (!benchmark.Run()) {
+            ret = 1;
+        }
+
+        if (config.outputFile.empty()) {
+            benchmark.WriteResults(std::cout);
+        } else {
+            std::ofstream stream(config.outputFile.c_str());
+            benchmark.WriteResults(stream);
+        }
+    }
+
+    bus.Disconnect();
+    bus.Stop();
+    bus.Join();
+
+    return ret;
+}
@@ -0,0 +1,447 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+/*
+ * Microbenchmark of the conversions between the LSF types and MsgArgs.
+ *
+ * Get is the conversion from the type to a MsgArg, including the release of
+ * the MsgArg. Set is the conversion from a MsgArg to a new instance of the
+ * type, including the release of the instance. Every allocation made through
+ * operator new is counted, so the results show the allocations per operation
+ * along with the time. The footprint and iteration speed of a store of
+ * 10,000 presets are measured as well.
+ *
+ * Usage: lsftypes_benchmark [-i <iterations>] [-o <output_file>]
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <alljoyn/MsgArg.h>
+
+#include <LSFTypes.h>
+#include <AJInitializer.h>
+
+using namespace lsf;
+using namespace ajn;
+
+/*
+ * The exception specifications of the replaced allocation functions must
+ * match the ones in <new>, which differ between C++03 and C++11
+ */
+#if __cplusplus < 201103L
+#define BENCHMARK_NEW_THROWS throw (std::bad_alloc)
+#define BENCHMARK_DELETE_THROWS throw ()
+#else
+#define BENCHMARK_NEW_THROWS
+#define BENCHMARK_DELETE_THROWS noexcept
+#endif
+
+/*
+ * Allocation counters. AllJoyn threads may allocate while a case runs, so
+ * the counters are updated under a lock that needs no construction, as
+ * allocations happen before main
+ */
+static pthread_mutex_t allocationLock = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t numAllocations = 0;
+static uint64_t numAllocatedBytes = 0;
+
+static void GetAllocationCounters(uint64_t& allocations, uint64_t& bytes)
+{
+    pthread_mutex_lock(&allocationLock);
+    allocations = numAllocations;
+    bytes = numAllocatedBytes;
+    pthread_mutex_unlock(&allocationLock);
+}
+
+void* operator new(size_t size) BENCHMARK_NEW_THROWS
+{
+    void* ptr = malloc(size ? size : 1);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    pthread_mutex_lock(&allocationLock);
+    numAllocations++;
+    numAllocatedBytes += size;
+    pthread_mutex_unlock(&allocationLock);
+    return ptr;
+}
+
+void* operator new[](size_t size) BENCHMARK_NEW_THROWS
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) BENCHMARK_DELETE_THROWS
+{
+    free(ptr);
+}
+
+void operator delete[](void* ptr) BENCHMARK_DELETE_THROWS
+{
+    free(ptr);
+}
+
+/*
+ * Sizes of the lists in the benchmarked types
+ */
+static const uint32_t listSizes[] = { 1, 10, 100, 1000 };
+
+static LSFStringList MakeIDs(const char* prefix, uint32_t count)
+{
+    LSFStringList ids;
+    for (uint32_t i = 0; i < count; i++) {
+        char id[64];
+        snprintf(id, sizeof(id), "%s%030u", prefix, i);
+        ids.push_back(id);
+    }
+    return ids;
+}
+
+/*
+ * A conversion to measure
+ */
+class MarshallingCase {
+  public:
+    MarshallingCase(const char* name, uint32_t size) : name(name), size(size) { }
+
+    virtual ~MarshallingCase() { }
+
+    virtual void Get(void) = 0;
+
+    virtual void Set(void) = 0;
+
+    const char* name;
+    uint32_t size;
+};
+
+class LampStateCase : public MarshallingCase {
+  public:
+    LampStateCase() : MarshallingCase("LampState", 1), state(true, 10, 20, 30, 40) {
+        state.Get(&arg, true);
+    }
+
+    void Get(void) {
+        MsgArg out;
+        state.Get(&out, true);
+    }
+
+    void Set(void) {
+        LampState in;
+        in.Set(arg);
+    }
+
+  private:
+    LampState state;
+    MsgArg arg;
+};
+
+class LampGroupCase : public MarshallingCase {
+  public:
+    LampGroupCase(uint32_t size) : MarshallingCase("LampGroup", size), group(MakeIDs("lamp", size), MakeIDs("group", size)) {
+        group.Get(&lampArg, &groupArg);
+    }
+
+    void Get(void) {
+        MsgArg lamps, groups;
+        group.Get(&lamps, &groups);
+    }
+
+    void Set(void) {
+        LampGroup in;
+        in.Set(lampArg, groupArg);
+    }
+
+  private:
+    LampGroup group;
+    MsgArg lampArg;
+    MsgArg groupArg;
+};
+
+class TransitionToStateCase : public MarshallingCase {
+  public:
+    TransitionToStateCase(uint32_t size) : MarshallingCase("TransitionLampsLampGroupsToState", size) {
+        LSFStringList lamps = MakeIDs("lamp", size);
+        LSFStringList groups = MakeIDs("group", size);
+        LampState state(true, 10, 20, 30, 40);
+        uint32_t period = 1000;
+        component = TransitionLampsLampGroupsToState(lamps, groups, state, period);
+        component.Get(&arg);
+    }
+
+    void Get(void) {
+        MsgArg out;
+        component.Get(&out);
+    }
+
+    void Set(void) {
+        TransitionLampsLampGroupsToState in;
+        in.Set(arg);
+    }
+
+  private:
+    TransitionLampsLampGroupsToState component;
+    MsgArg arg;
+};
+
+/*
+ * A scene with ten transition to state components that each hold size lamps
+ */
+class SceneCase : public MarshallingCase {
+  public:
+    SceneCase(uint32_t size) : MarshallingCase("Scene", size) {
+        LSFStringList lamps = MakeIDs("lamp", size);
+        LSFStringList groups;
+        LampState state(true, 10, 20, 30, 40);
+        uint32_t period = 1000;
+
+        TransitionLampsLampGroupsToStateList toStateList;
+        for (uint32_t i = 0; i < 10; i++) {
+            toStateList.push_back(TransitionLampsLampGroupsToState(lamps, groups, state, period));
+        }
+        TransitionLampsLampGroupsToPresetList toPresetList;
+        PulseLampsLampGroupsWithStateList pulseStateList;
+        PulseLampsLampGroupsWithPresetList pulsePresetList;
+        scene = Scene(toStateList, toPresetList, pulseStateList, pulsePresetList);
+        scene.Get(&args[0], &args[1], &args[2], &args[3]);
+    }
+
+    void Get(void) {
+        MsgArg out[4];
+        scene.Get(&out[0], &out[1], &out[2], &out[3]);
+    }
+
+    void Set(void) {
+        Scene in;
+        in.Set(args[0], args[1], args[2], args[3]);
+    }
+
+  private:
+    Scene scene;
+    MsgArg args[4];
+};
+
+class MasterSceneCase : public MarshallingCase {
+  public:
+    MasterSceneCase(uint32_t size) : MarshallingCase("MasterScene", size), masterScene(MakeIDs("scene", size)) {
+        masterScene.Get(&arg);
+    }
+
+    void Get(void) {
+        MsgArg out;
+        masterScene.Get(&out);
+    }
+
+    void Set(void) {
+        MasterScene in;
+        in.Set(arg);
+    }
+
+  private:
+    MasterScene masterScene;
+    MsgArg arg;
+};
+
+struct CaseResult {
+    std::string name;
+    std::string operation;
+    uint32_t size;
+    uint32_t iterations;
+    uint64_t nanosecondsPerOp;
+    uint64_t allocationsPerOp;
+    uint64_t bytesPerOp;
+};
+
+static void Measure(MarshallingCase& marshallingCase, bool get, uint32_t iterations, std::vector<CaseResult>& results)
+{
+    // Fewer iterations for the large lists so that each case takes a similar time
+    uint32_t count = iterations / marshallingCase.size;
+    if (count < 10) {
+        count = 10;
+    }
+
+    uint64_t allocations, bytes;
+    GetAllocationCounters(allocations, bytes);
+    uint64_t start = GetTimestampInUs();
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (get) {
+            marshallingCase.Get();
+        } else {
+            marshallingCase.Set();
+        }
+    }
+
+    uint64_t elapsed = GetTimestampInUs() - start;
+
+    CaseResult result;
+    result.name = marshallingCase.name;
+    result.operation = get ? "Get" : "Set";
+    result.size = marshallingCase.size;
+    result.iterations = count;
+    result.nanosecondsPerOp = (elapsed * 1000) / count;
+    uint64_t endAllocations, endBytes;
+    GetAllocationCounters(endAllocations, endBytes);
+    result.allocationsPerOp = (endAllocations - allocations) / count;
+    result.bytesPerOp = (endBytes - bytes) / count;
+    results.push_back(result);
+
+    fprintf(stderr, "%-34s %s size=%-5u %10llu ns/op %8llu allocs/op %10llu bytes/op\n",
+            result.name.c_str(), result.operation.c_str(), result.size,
+            static_cast<unsigned long long>(result.nanosecondsPerOp),
+            static_cast<unsigned long long>(result.allocationsPerOp),
+            static_cast<unsigned long long>(result.bytesPerOp));
+}
+
+/*
+ * Memory footprint and iteration speed of the preset store at its realistic
+ * upper size. Build reports the allocations made to insert the presets and
+ * Iterate the time to visit every preset, both per preset
+ */
+static void MeasurePresetMap(uint32_t numPresets, std::vector<CaseResult>& results)
+{
+    LSFStringList ids = MakeIDs("preset", numPresets);
+    LSFStringList names = MakeIDs("name", numPresets);
+
+    uint64_t allocations, bytes;
+    GetAllocationCounters(allocations, bytes);
+    uint64_t start = GetTimestampInUs();
+
+    PresetMap presets;
+    LSFStringList::const_iterator nit = names.begin();
+    for (LSFStringList::const_iterator it = ids.begin(); it != ids.end(); ++it, ++nit) {
+        presets[*it] = std::make_pair(*nit, LampState(true, 10, 20, 30, 40));
+    }
+
+    CaseResult result;
+    result.name = "PresetMap";
+    result.size = numPresets;
+    result.iterations = 1;
+
+    result.operation = "Build";
+    result.nanosecondsPerOp = ((GetTimestampInUs() - start) * 1000) / numPresets;
+    uint64_t endAllocations, endBytes;
+    GetAllocationCounters(endAllocations, endBytes);
+    result.allocationsPerOp = (endAllocations - allocations) / numPresets;
+    result.bytesPerOp = (endBytes - bytes) / numPresets;
+    results.push_back(result);
+
+    uint32_t passes = 100;
+    uint64_t total = 0;
+    start = GetTimestampInUs();
+    for (uint32_t i = 0; i < passes; i++) {
+        for (PresetMap::const_iterator it = presets.begin(); it != presets.end(); ++it) {
+            total += it->second.second.brightness;
+        }
+    }
+
+    result.operation = "Iterate";
+    result.iterations = passes;
+    result.nanosecondsPerOp = ((GetTimestampInUs() - start) * 1000) / (static_cast<uint64_t>(passes) * numPresets);
+    result.allocationsPerOp = 0;
+    result.bytesPerOp = 0;
+    results.push_back(result);
+
+    fprintf(stderr, "PresetMap size=%u build %llu ns/preset %llu bytes/preset, iterate %llu ns/preset (%llu)\n",
+            numPresets, static_cast<unsigned long long>(results[results.size() - 2].nanosecondsPerOp),
+            static_cast<unsigned long long>(results[results.size() - 2].bytesPerOp),
+            static_cast<unsigned long long>(result.nanosecondsPerOp), static_cast<unsigned long long>(total));
+}
+
+static void MeasureAndDelete(MarshallingCase* marshallingCase, uint32_t iterations, std::vector<CaseResult>& results)
+{
+    Measure(*marshallingCase, true, iterations, results);
+    Measure(*marshallingCase, false, iterations, results);
+    delete marshallingCase;
+}
+
+static void WriteResults(std::ostream& stream, const std::vector<CaseResult>& results)
+{
+    stream << "{\"benchmarks\":[";
+    for (size_t i = 0; i < results.size(); i++) {
+        const CaseResult& result = results[i];
+        stream << (i ? "," : "") << std::endl
+               << "{\"name\":\"" << result.name << "." << result.operation << "\",\"size\":" << result.size
+               << ",\"iterations\":" << result.iterations << ",\"nsPerOp\":" << result.nanosecondsPerOp
+               << ",\"allocsPerOp\":" << result.allocationsPerOp << ",\"bytesPerOp\":" << result.bytesPerOp << "}";
+    }
+    stream << std::endl << "]}" << std::endl;
+}
+
+static void usage(char** argv)
+{
+    printf("Usage: %s [-i <iterations>] [-o <output_file>]\n\n", argv[0]);
+    printf("Options:\n");
+    printf("   -i <iterations>         = Iterations of each case, divided by the list size. Default 100000\n");
+    printf("   -o <output_file>        = File to write the JSON results to. Default stdout\n");
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t iterations = 100000;
+    std::string outputFile;
+
+    for (int i = 1; i < argc; i++) {
+        if ((i + 1) >= argc) {
+            usage(argv);
+            return 1;
+        }
+
+        if (0 == strcmp("-i", argv[i])) {
+            iterations = strtoul(argv[++i], NULL, 10);
+        } else if (0 == strcmp("-o", argv[i])) {
+            outputFile = argv[++i];
+        } else {
+            usage(argv);
+            return 1;
+        }
+    }
+
+    AJInitializer ajInitializer;
+    if (ajInitializer.Initialize() != ER_OK) {
+        return -1;
+    }
+
+    std::vector<CaseResult> results;
+
+    MeasureAndDelete(new LampStateCase(), iterations, results);
+    for (size_t i = 0; i < (sizeof(listSizes) / sizeof(listSizes[0])); i++) {
+        MeasureAndDelete(new LampGroupCase(listSizes[i]), iterations, results);
+        MeasureAndDelete(new TransitionToStateCase(listSizes[i]), iterations, results);
+        MeasureAndDelete(new SceneCase(listSizes[i]), iterations, results);
+        MeasureAndDelete(new MasterSceneCase(listSizes[i]), iterations, results);
+    }
+
+    MeasurePresetMap(10000, results);
+
+    if (outputFile.empty()) {
+        WriteResults(std::cout, results);
+    } else {
+        std::ofstream stream(outputFile.c_str());
+        WriteResults(stream, results);
+    }
+
+    return 0;
+}
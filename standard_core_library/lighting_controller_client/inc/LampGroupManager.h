@@ -102,6 +102,14 @@ class LampGroupManagerCallback {
      */
     virtual void CreateLampGroupWithTrackingReplyCB(const LSFResponseCode& responseCode, const LSFString& lampGroupID, const uint32_t& trackingID) { }
 
+    /**
+     * Indicates that a reply has been received for the CreateLampGroups method call.
+     *
+     * @param responseCode   The response code
+     * @param lampGroupIDs   The Lamp Group IDs, in the order of the request. Empty unless responseCode is LSF_OK
+     */
+    virtual void CreateLampGroupsReplyCB(const LSFResponseCode& responseCode, const LSFStringList& lampGroupIDs) { }
+
     /**
      *  Indicates that the signal LampGroupsCreated has been received.
      *
@@ -126,6 +134,15 @@ class LampGroupManagerCallback {
      */
     virtual void DeleteLampGroupReplyCB(const LSFResponseCode& responseCode, const LSFString& lampGroupID) { }
 
+    /**
+     * Indicates that a reply has been received for the DeleteLampGroups method call.
+     *
+     * @param responseCode    The response code. LSF_ERR_DEPENDENCY if a Lamp Group is still
+     *                        used by a Scene Element or by a Lamp Group that is not deleted with it
+     * @param lampGroupIDs    The Lamp Group IDs of the request
+     */
+    virtual void DeleteLampGroupsReplyCB(const LSFResponseCode& responseCode, const LSFStringList& lampGroupIDs) { }
+
     /**
      *  Indicates that the signal LampGroupsDeleted has been received.
      *
@@ -359,6 +376,22 @@ class LampGroupManager : public Manager {
      */
     ControllerClientStatus CreateLampGroupWithTracking(uint32_t& trackingID, const LampGroup& lampGroup, const LSFString& lampGroupName, const LSFString& language = LSFString("en"));
 
+    /**
+     * Create several Lamp Groups in one call. \n
+     * The Controller Service creates either all of the Lamp Groups or none of them,
+     * writes its persistent store once and sends a single LampGroupsCreated signal. \n
+     * Response in LampGroupManagerCallback::CreateLampGroupsReplyCB
+     *
+     * @param lampGroups      Lamp Groups
+     * @param lampGroupNames  Names of the Lamp Groups, one per entry of lampGroups
+     * @param language
+     * @return
+     *      - CONTROLLER_CLIENT_OK if successful
+     *      - An error status otherwise
+     *
+     */
+    ControllerClientStatus CreateLampGroups(const std::list<LampGroup>& lampGroups, const LSFStringList& lampGroupNames, const LSFString& language = LSFString("en"));
+
     /**
      * Modify a Lamp Group. \n
      * Response in LampGroupManagerCallback::UpdateLampGroupReplyCB
@@ -396,6 +429,19 @@ class LampGroupManager : public Manager {
      */
     ControllerClientStatus DeleteLampGroup(const LSFString& lampGroupID);
 
+    /**
+     * Delete several Lamp Groups in one call. \n
+     * The Controller Service deletes either all of the Lamp Groups or none of them. \n
+     * Response in LampGroupManagerCallback::DeleteLampGroupsReplyCB
+     *
+     * @param lampGroupIDs    The Lamp Group IDs
+     * @return
+     *      - CONTROLLER_CLIENT_OK if successful
+     *      - An error status otherwise
+     *
+     */
+    ControllerClientStatus DeleteLampGroups(const LSFStringList& lampGroupIDs);
+
     /**
      * Transition a Lamp Group to a new state. \n
      * Response in LampGroupManagerCallback::TransitionLampGroupStateReplyCB
@@ -654,6 +700,11 @@ class LampGroupManager : public Manager {
      */
     void CreateLampGroupWithTrackingReply(LSFResponseCode& responseCode, LSFString& lsfId, uint32_t& trackingID);
 
+    /**
+     * Method Reply Handler for the signal CreateLampGroups
+     */
+    void CreateLampGroupsReply(LSFResponseCode& responseCode, LSFStringList& idList);
+
     /**
      * Method Reply Handler for the signal UpdateLampGroup
      */
@@ -669,6 +720,11 @@ class LampGroupManager : public Manager {
      */
     void DeleteLampGroupReply(LSFResponseCode& responseCode, LSFString& lsfId);
 
+    /**
+     * Method Reply Handler for the signal DeleteLampGroups
+     */
+    void DeleteLampGroupsReply(LSFResponseCode& responseCode, LSFStringList& idList);
+
     /**
      * Method Reply Handler for the signal ResetLampGroupStateField
      */
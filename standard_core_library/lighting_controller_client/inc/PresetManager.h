@@ -113,6 +113,18 @@ class PresetManagerCallback {
      */
     virtual void CreatePresetWithTrackingReplyCB(const LSFResponseCode& responseCode, const LSFString& presetID, const uint32_t& trackingID) { }
 
+    /**
+     * Response to PresetManager::CreatePresets. \n
+     * response code LSF_OK on success. \n
+     *      LSF_ERR_INVALID_ARGS - language not supported, a name is too long or a state is NULL. \n
+     *      LSF_ERR_EMPTY_NAME - a preset name is empty. \n
+     *      LSF_ERR_NO_SLOT - not enough room for all of the presets. \n
+     *      LSF_ERR_RESOURCES - blob is too big. \n
+     * @param responseCode    The return code
+     * @param presetIDs    The ids of the new Presets, in the order of the request
+     */
+    virtual void CreatePresetsReplyCB(const LSFResponseCode& responseCode, const LSFStringList& presetIDs) { }
+
     /**
      * A Preset has been created
      *
@@ -130,6 +142,17 @@ class PresetManagerCallback {
      */
     virtual void UpdatePresetReplyCB(const LSFResponseCode& responseCode, const LSFString& presetID) { }
 
+    /**
+     * Response to PresetManager::UpdatePresets. \n
+     * response code LSF_OK on success. \n
+     *      LSF_ERR_INVALID_ARGS - a state is NULL or a preset is listed twice. \n
+     *      LSF_ERR_NOT_FOUND - a preset does not exist. \n
+     *      LSF_ERR_RESOURCES - blob is too big. \n
+     * @param responseCode    The return code
+     * @param presetIDs    The ids of the updated Presets
+     */
+    virtual void UpdatePresetsReplyCB(const LSFResponseCode& responseCode, const LSFStringList& presetIDs) { }
+
     /**
      * A Preset has been updated
      *
@@ -146,6 +169,16 @@ class PresetManagerCallback {
      */
     virtual void DeletePresetReplyCB(const LSFResponseCode& responseCode, const LSFString& presetID) { }
 
+    /**
+     * Response to PresetManager::DeletePresets. \n
+     * response code LSF_OK on success. \n
+     *      LSF_ERR_NOT_FOUND - a preset is not found. \n
+     *      LSF_ERR_DEPENDENCY - a preset is used by a scene element. \n
+     * @param responseCode    The return code
+     * @param presetIDs    The ids of the Presets
+     */
+    virtual void DeletePresetsReplyCB(const LSFResponseCode& responseCode, const LSFStringList& presetIDs) { }
+
     /**
      * A Preset has been deleted
      *
@@ -254,6 +287,17 @@ class PresetManager : public Manager {
      */
     ControllerClientStatus CreatePresetWithTracking(uint32_t& trackingID, const LampState& preset, const LSFString& presetName, const LSFString& language = LSFString("en"));
 
+    /**
+     * Create several presets in one call. \n
+     * Either all of the presets are created or none of them. \n
+     * Response in PresetManagerCallback::CreatePresetsReplyCB. \n
+     *
+     * @param presets The states of the new presets
+     * @param presetNames One name per entry of presets
+     * @param language
+     */
+    ControllerClientStatus CreatePresets(const std::list<LampState>& presets, const LSFStringList& presetNames, const LSFString& language = LSFString("en"));
+
     /**
      * Update an existing Preset. \n
      * Response in PresetManagerCallback::UpdatePresetReplyCB. \n
@@ -264,6 +308,16 @@ class PresetManager : public Manager {
      */
     ControllerClientStatus UpdatePreset(const LSFString& presetID, const LampState& preset);
 
+    /**
+     * Update several existing presets in one call. \n
+     * Either all of the presets are updated or none of them. \n
+     * Response in PresetManagerCallback::UpdatePresetsReplyCB. \n
+     *
+     * @param presetIDs    The ids of the Presets
+     * @param presets The new state information, one per entry of presetIDs
+     */
+    ControllerClientStatus UpdatePresets(const LSFStringList& presetIDs, const std::list<LampState>& presets);
+
     /**
      * Delete a preset. \n
      * Return asynchronously the preset response code and unique id. \n
@@ -273,6 +327,15 @@ class PresetManager : public Manager {
      */
     ControllerClientStatus DeletePreset(const LSFString& presetID);
 
+    /**
+     * Delete several presets in one call. \n
+     * Either all of the presets are deleted or none of them. \n
+     * Response in PresetManagerCallback::DeletePresetsReplyCB. \n
+     *
+     * @param presetIDs    The ids of the Presets to delete
+     */
+    ControllerClientStatus DeletePresets(const LSFStringList& presetIDs);
+
     /**
      * Get the default Lamp State. \n
      * Return asynchronously the preset response code and lamp state which id is 'DefaultLampState'. \n
@@ -358,10 +421,22 @@ class PresetManager : public Manager {
         callback.UpdatePresetReplyCB(responseCode, lsfId);
     }
 
+    void CreatePresetsReply(LSFResponseCode& responseCode, LSFStringList& idList) {
+        callback.CreatePresetsReplyCB(responseCode, idList);
+    }
+
+    void UpdatePresetsReply(LSFResponseCode& responseCode, LSFStringList& idList) {
+        callback.UpdatePresetsReplyCB(responseCode, idList);
+    }
+
     void DeletePresetReply(LSFResponseCode& responseCode, LSFString& lsfId) {
         callback.DeletePresetReplyCB(responseCode, lsfId);
     }
 
+    void DeletePresetsReply(LSFResponseCode& responseCode, LSFStringList& idList) {
+        callback.DeletePresetsReplyCB(responseCode, idList);
+    }
+
     /**
      * Method Reply Handler for the signal GetDefaultLampState
      */
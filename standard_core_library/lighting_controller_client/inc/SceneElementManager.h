@@ -94,6 +94,19 @@ class SceneElementManagerCallback {
      */
     virtual void CreateSceneElementReplyCB(const LSFResponseCode& responseCode, const LSFString& sceneElementID, const uint32_t& trackingID) { }
 
+    /**
+     * Response to SceneElementManager::CreateSceneElements.
+     *
+     * @param responseCode    The response code: \n
+     *  LSF_OK - operation succeeded \n
+     *  LSF_ERR_INVALID_ARGS - Language not supported, Invalid SceneElement components specified, name length exceeds \n
+     *  LSF_ERR_EMPTY_NAME - a sceneElement name is empty \n
+     *  LSF_ERR_RESOURCES - Could not allocate memory \n
+     *  LSF_ERR_NO_SLOT - No slot for the new SceneElements \n
+     * @param sceneElementIDs    The ids of the new SceneElements, in the order of the request
+     */
+    virtual void CreateSceneElementsReplyCB(const LSFResponseCode& responseCode, const LSFStringList& sceneElementIDs) { }
+
     /**
      *  This signal is fired any time a sceneElement is been created.
      *
@@ -130,6 +143,17 @@ class SceneElementManagerCallback {
      */
     virtual void DeleteSceneElementReplyCB(const LSFResponseCode& responseCode, const LSFString& sceneElementID) { }
 
+    /**
+     * Response to SceneElementManager::DeleteSceneElements.
+     *
+     * @param responseCode    The response code: \n
+     *  LSF_OK - operation succeeded \n
+     *  LSF_ERR_NOT_FOUND - can't find a sceneElement id \n
+     *  LSF_ERR_DEPENDENCY - a sceneElement is used by a scene \n
+     * @param sceneElementIDs    The ids of the sceneElements
+     */
+    virtual void DeleteSceneElementsReplyCB(const LSFResponseCode& responseCode, const LSFStringList& sceneElementIDs) { }
+
     /**
      * This signal is fired any time a sceneElement has been deleted.
      *
@@ -219,6 +243,17 @@ class SceneElementManager : public Manager {
      */
     ControllerClientStatus CreateSceneElement(uint32_t& trackingID, const SceneElement& sceneElement, const LSFString& sceneElementName, const LSFString& language = LSFString("en"));
 
+    /**
+     *  Create several SceneElements in one call. \n
+     *  Either all of the sceneElements are created or none of them. \n
+     *  Response in SceneElementManagerCallback::CreateSceneElementsReplyCB
+     *
+     * @param sceneElements      The sceneElements
+     * @param sceneElementNames  One name per entry of sceneElements
+     * @param language           The sceneElement language
+     */
+    ControllerClientStatus CreateSceneElements(const std::list<SceneElement>& sceneElements, const LSFStringList& sceneElementNames, const LSFString& language = LSFString("en"));
+
     /**
      * Modify an existing sceneElement. \n
      * Response in SceneElementManagerCallback::UpdateElementReplyCB \n
@@ -236,6 +271,15 @@ class SceneElementManager : public Manager {
      */
     ControllerClientStatus DeleteSceneElement(const LSFString& sceneElementID);
 
+    /**
+     * Delete several sceneElements in one call. \n
+     * Either all of the sceneElements are deleted or none of them. \n
+     * Response in SceneElementManagerCallback::DeleteSceneElementsReplyCB
+     *
+     * @param sceneElementIDs    The ids of the sceneElements to delete
+     */
+    ControllerClientStatus DeleteSceneElements(const LSFStringList& sceneElementIDs);
+
     /**
      * Get the information about the specified sceneElement. \n
      * Response in SceneElementManagerCallback::GetSceneElementReplyCB
@@ -300,6 +344,10 @@ class SceneElementManager : public Manager {
         callback.DeleteSceneElementReplyCB(responseCode, lsfId);
     }
 
+    void DeleteSceneElementsReply(LSFResponseCode& responseCode, LSFStringList& idList) {
+        callback.DeleteSceneElementsReplyCB(responseCode, idList);
+    }
+
     void SetSceneElementNameReply(LSFResponseCode& responseCode, LSFString& lsfId, LSFString& language) {
         callback.SetSceneElementNameReplyCB(responseCode, lsfId, language);
     }
@@ -312,6 +360,10 @@ class SceneElementManager : public Manager {
         callback.CreateSceneElementReplyCB(responseCode, lsfId, trackingID);
     }
 
+    void CreateSceneElementsReply(LSFResponseCode& responseCode, LSFStringList& idList) {
+        callback.CreateSceneElementsReplyCB(responseCode, idList);
+    }
+
     void UpdateSceneElementReply(LSFResponseCode& responseCode, LSFString& lsfId) {
         callback.UpdateSceneElementReplyCB(responseCode, lsfId);
     }
@@ -117,6 +117,20 @@ class SceneManagerCallback {
      */
     virtual void CreateSceneWithSceneElementsReplyCB(const LSFResponseCode& responseCode, const LSFString& sceneID, const uint32_t& trackingID) { }
 
+    /**
+     * Response to SceneManager::CreateScenesWithSceneElements.
+     *
+     * @param responseCode    The response code: \n
+     *  LSF_OK - operation succeeded \n
+     *  LSF_ERR_INVALID_ARGS - Language not supported, Invalid Scene components specified, name length exceeds \n
+     *  LSF_ERR_EMPTY_NAME - a scene name is empty \n
+     *  LSF_ERR_NOT_FOUND - a Scene Element does not exist \n
+     *  LSF_ERR_RESOURCES - Could not allocate memory \n
+     *  LSF_ERR_NO_SLOT - No slot for the new Scenes \n
+     * @param sceneIDs        The ids of the new Scenes, in the order of the request
+     */
+    virtual void CreateScenesWithSceneElementsReplyCB(const LSFResponseCode& responseCode, const LSFStringList& sceneIDs) { }
+
     /**
      *  This signal is fired any time a scene is been created.
      *
@@ -157,6 +171,17 @@ class SceneManagerCallback {
      */
     virtual void DeleteSceneReplyCB(const LSFResponseCode& responseCode, const LSFString& sceneID) { }
 
+    /**
+     * Response to SceneManager::DeleteScenes.
+     *
+     * @param responseCode    The response code: \n
+     *  LSF_OK - operation succeeded \n
+     *  LSF_ERR_NOT_FOUND - can't find a scene id \n
+     *  LSF_ERR_DEPENDENCY - a scene is used by a master scene \n
+     * @param sceneIDs    The ids of the scenes
+     */
+    virtual void DeleteScenesReplyCB(const LSFResponseCode& responseCode, const LSFStringList& sceneIDs) { }
+
     /**
      * This signal is fired any time a scene has been deleted.
      *
@@ -283,6 +308,17 @@ class SceneManager : public Manager {
      */
     ControllerClientStatus CreateSceneWithSceneElements(uint32_t& trackingID, const SceneWithSceneElements& scene, const LSFString& sceneName, const LSFString& language = LSFString("en"));
 
+    /**
+     *  Create several Scenes with Scene Elements in one call. \n
+     *  Either all of the scenes are created or none of them. \n
+     *  Response in SceneManagerCallback::CreateScenesWithSceneElementsReplyCB
+     *
+     * @param scenes      Scenes with Scene Elements
+     * @param sceneNames  One name per entry of scenes
+     * @param language    The scene language
+     */
+    ControllerClientStatus CreateScenesWithSceneElements(const std::list<SceneWithSceneElements>& scenes, const LSFStringList& sceneNames, const LSFString& language = LSFString("en"));
+
     /**
      * Modify an existing scene. \n
      * Response in SceneManagerCallback::UpdateSceneReplyCB \n
@@ -309,6 +345,15 @@ class SceneManager : public Manager {
      */
     ControllerClientStatus DeleteScene(const LSFString& sceneID);
 
+    /**
+     * Delete several scenes in one call. \n
+     * Either all of the scenes are deleted or none of them. \n
+     * Response in SceneManagerCallback::DeleteScenesReplyCB
+     *
+     * @param sceneIDs    The ids of the scenes to delete
+     */
+    ControllerClientStatus DeleteScenes(const LSFStringList& sceneIDs);
+
     /**
      * Get the information about the specified scene. \n
      * Response in SceneManagerCallback::GetSceneReplyCB
@@ -392,6 +437,10 @@ class SceneManager : public Manager {
         callback.DeleteSceneReplyCB(responseCode, lsfId);
     }
 
+    void DeleteScenesReply(LSFResponseCode& responseCode, LSFStringList& idList) {
+        callback.DeleteScenesReplyCB(responseCode, idList);
+    }
+
     void SetSceneNameReply(LSFResponseCode& responseCode, LSFString& lsfId, LSFString& language) {
         callback.SetSceneNameReplyCB(responseCode, lsfId, language);
     }
@@ -412,6 +461,10 @@ class SceneManager : public Manager {
         callback.CreateSceneWithSceneElementsReplyCB(responseCode, lsfId, trackingID);
     }
 
+    void CreateScenesWithSceneElementsReply(LSFResponseCode& responseCode, LSFStringList& idList) {
+        callback.CreateScenesWithSceneElementsReplyCB(responseCode, idList);
+    }
+
     void UpdateSceneReply(LSFResponseCode& responseCode, LSFString& lsfId) {
         callback.UpdateSceneReplyCB(responseCode, lsfId);
     }
@@ -0,0 +1,239 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+/*
+ * Connects to the leader Controller Service and prints the counters, gauges
+ * and histograms of its org.allseen.LSF.ControllerService.Statistics
+ * interface at a fixed interval.
+ *
+ * Usage: ControllerServiceStatisticsSample [-i <interval_in_seconds>]
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <alljoyn/BusAttachment.h>
+#include <alljoyn/ProxyBusObject.h>
+#include <alljoyn/AboutListener.h>
+#include <alljoyn/AboutObjectDescription.h>
+#include <alljoyn/AboutData.h>
+#include <qcc/Debug.h>
+
+#include <LSFTypes.h>
+#include <LSFStatistics.h>
+#include <AJInitializer.h>
+#include <Mutex.h>
+
+using namespace lsf;
+using namespace ajn;
+
+#define QCC_MODULE "STATISTICS_SAMPLE"
+
+static volatile sig_atomic_t g_running = true;
+
+static void SigIntHandler(int sig)
+{
+    g_running = false;
+}
+
+class StatisticsHandler : public AboutListener, public SessionListener {
+  public:
+
+    StatisticsHandler(BusAttachment& bus) : bus(bus), controller(NULL), sessionId(0) { }
+
+    ~StatisticsHandler() {
+        objectLock.Lock();
+        if (controller) {
+            delete controller;
+            controller = NULL;
+        }
+        objectLock.Unlock();
+    }
+
+    virtual void Announced(const char* busName, uint16_t version, SessionPort port, const MsgArg& objectDescriptionArg, const MsgArg& aboutDataArg)
+    {
+        QCC_DbgTrace(("%s: busName=%s port=%u", __func__, busName, port));
+        bus.EnableConcurrentCallbacks();
+
+        AboutObjectDescription objectDescs(objectDescriptionArg);
+        if (!objectDescs.HasPath(ControllerServiceObjectPath)) {
+            return;
+        }
+
+        AboutData aboutData(aboutDataArg);
+        bool isLeader = false;
+        MsgArg* leaderArg = NULL;
+        if ((aboutData.GetField("IsLeader", leaderArg) != ER_OK) || !leaderArg || (leaderArg->Get("b", &isLeader) != ER_OK) || !isLeader) {
+            QCC_DbgPrintf(("%s: Ignoring non-leader announcement from %s", __func__, busName));
+            return;
+        }
+
+        objectLock.Lock();
+        if (!controller) {
+            SessionOpts opts(SessionOpts::TRAFFIC_MESSAGES, false, SessionOpts::PROXIMITY_ANY, TRANSPORT_ANY);
+            SessionId newSessionId = 0;
+            QStatus status = bus.JoinSession(busName, port, this, newSessionId, opts);
+            if (status == ER_OK) {
+                ProxyBusObject* newController = new ProxyBusObject(bus, busName, ControllerServiceObjectPath, newSessionId);
+                status = newController->IntrospectRemoteObject();
+                if (status == ER_OK) {
+                    controller = newController;
+                    sessionId = newSessionId;
+                    printf("Connected to the Controller Service on %s\n", busName);
+                } else {
+                    QCC_LogError(status, ("%s: IntrospectRemoteObject failed", __func__));
+                    delete newController;
+                    bus.LeaveSession(newSessionId);
+                }
+            } else {
+                QCC_LogError(status, ("%s: JoinSession with %s failed", __func__, busName));
+            }
+        }
+        objectLock.Unlock();
+    }
+
+    virtual void SessionLost(SessionId lostSessionId, SessionLostReason reason)
+    {
+        QCC_DbgTrace(("%s: sessionId=%u reason=%d", __func__, lostSessionId, reason));
+        objectLock.Lock();
+        if (controller && (lostSessionId == sessionId)) {
+            delete controller;
+            controller = NULL;
+            sessionId = 0;
+            printf("Lost the Controller Service, waiting for the next leader\n");
+        }
+        objectLock.Unlock();
+    }
+
+    void PrintStatistics(void)
+    {
+        objectLock.Lock();
+        if (!controller) {
+            objectLock.Unlock();
+            printf("Waiting for the leader Controller Service\n");
+            return;
+        }
+
+        Message reply(bus);
+        QStatus status = controller->MethodCall(ControllerServiceStatisticsInterfaceName, "GetControllerServiceStatistics", NULL, 0, reply);
+        objectLock.Unlock();
+
+        if (status != ER_OK) {
+            QCC_LogError(status, ("%s: GetControllerServiceStatistics failed", __func__));
+            return;
+        }
+
+        const MsgArg* args;
+        size_t numArgs;
+        reply->GetArgs(numArgs, args);
+        if (numArgs != 2) {
+            QCC_LogError(ER_FAIL, ("%s: Unexpected number of reply args %u", __func__, numArgs));
+            return;
+        }
+
+        uint32_t responseCode;
+        args[0].Get("u", &responseCode);
+        if (responseCode != LSF_OK) {
+            printf("GetControllerServiceStatistics: %s\n", LSFResponseCodeText(static_cast<LSFResponseCode>(responseCode)));
+            return;
+        }
+
+        size_t numEntries;
+        MsgArg* entries;
+        args[1].Get("a(suxuuu)", &numEntries, &entries);
+
+        printf("\n%-48s %-10s %12s %8s %8s %8s\n", "Statistic", "Type", "Value", "p50", "p99", "Max");
+        for (size_t i = 0; i < numEntries; i++) {
+            char* name;
+            uint32_t type;
+            int64_t value;
+            uint32_t p50, p99, maxValue;
+            entries[i].Get("(suxuuu)", &name, &type, &value, &p50, &p99, &maxValue);
+
+            if (type == LSF_STATISTIC_HISTOGRAM) {
+                printf("%-48s %-10s %12lld %8u %8u %8u\n", name, "histogram", static_cast<long long>(value), p50, p99, maxValue);
+            } else {
+                printf("%-48s %-10s %12lld\n", name, (type == LSF_STATISTIC_GAUGE) ? "gauge" : "counter", static_cast<long long>(value));
+            }
+        }
+        fflush(stdout);
+    }
+
+  private:
+    BusAttachment& bus;
+    Mutex objectLock;
+    ProxyBusObject* controller;
+    SessionId sessionId;
+};
+
+int main(int argc, char** argv)
+{
+    uint32_t intervalInSeconds = 1;
+    for (int i = 1; i < argc; i++) {
+        if ((0 == strcmp("-i", argv[i])) && ((i + 1) < argc)) {
+            intervalInSeconds = strtoul(argv[++i], NULL, 10);
+            if (intervalInSeconds == 0) {
+                intervalInSeconds = 1;
+            }
+        } else {
+            printf("Usage: %s [-i <interval_in_seconds>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    AJInitializer ajInitializer;
+    if (ajInitializer.Initialize() != ER_OK) {
+        return -1;
+    }
+
+    signal(SIGINT, SigIntHandler);
+
+    BusAttachment bus("ControllerServiceStatisticsSample", true);
+    QStatus status = bus.Start();
+    if (status == ER_OK) {
+        status = bus.Connect();
+    }
+    if (status != ER_OK) {
+        QCC_LogError(status, ("%s: Failed to start and connect the bus", __func__));
+        return -1;
+    }
+
+    StatisticsHandler handler(bus);
+    bus.RegisterAboutListener(handler);
+
+    const char* interfaces[] = { ControllerServiceStatisticsInterfaceName };
+    status = bus.WhoImplements(interfaces, sizeof(interfaces) / sizeof(interfaces[0]));
+    if (status != ER_OK) {
+        QCC_LogError(status, ("%s: WhoImplements failed", __func__));
+        return -1;
+    }
+
+    while (g_running) {
+        sleep(intervalInSeconds);
+        handler.PrintStatistics();
+    }
+
+    bus.CancelWhoImplements(interfaces, sizeof(interfaces) / sizeof(interfaces[0]));
+    bus.UnregisterAboutListener(handler);
+    bus.Disconnect();
+    bus.Stop();
+    bus.Join();
+
+    return 0;
+}
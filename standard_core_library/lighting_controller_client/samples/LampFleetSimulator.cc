@@ -0,0 +1,1405 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+/*
+ * Hosts a fleet of virtual lamps in one process so that the Controller
+ * Service can be load tested on a single machine.
+ *
+ * The lamps are spread over a small set of bus attachments, the lamp hosts.
+ * Each host registers the LampService, LampState, LampDetails, LampParameters,
+ * Config and About objects once, and every lamp on it gets a session port and
+ * an About announcement of its own. The Controller Service joins a lamp on
+ * the port it announced, so the host tells the lamps apart by session.
+ *
+ * Every bus attachment is a client of the routing node it connects to, also
+ * when that is the bundled router in this process, and counts against the
+ * client limits of that routing node. Hosting many lamps per attachment keeps
+ * a large fleet within those limits.
+ *
+ * Method calls on a lamp can be delayed, dropped or answered with an error.
+ * Like the thin Lamp Service, a lamp answers its method calls one at a time.
+ * Delayed calls are held by a timer, so no dispatcher thread waits on a lamp.
+ * Property reads and About calls are answered at once.
+ *
+ * With -s, the fleet wide counters are written to a file every second in the
+ * format of the Controller Service -s option, so that lsfbenchmark can count
+ * the calls the controller makes to the lamps during a measurement.
+ *
+ * Usage: LampFleetSimulator [-n <num_lamps>] [-b <num_buses>] [-l <latency_ms>]
+ *                           [-j <jitter_ms>] [-d <drop_percent>] [-e <error_percent>]
+ *                           [-f <fault_percent>] [-p <lamp_id_prefix>]
+ *                           [-k <keystore_file>] [-s <statistics_file>]
+ */
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <alljoyn/BusAttachment.h>
+#include <alljoyn/BusObject.h>
+#include <alljoyn/AboutData.h>
+#include <qcc/Debug.h>
+#include <qcc/Util.h>
+
+#include <LSFTypes.h>
+#include <LSFKeyListener.h>
+#include <LSFStatistics.h>
+#include <AJInitializer.h>
+#include <Mutex.h>
+#include <Alarm.h>
+#include <LampResponseCodes.h>
+
+using namespace lsf;
+using namespace ajn;
+
+#define QCC_MODULE "LAMP_FLEET_SIMULATOR"
+
+/*
+ * Path of the About object of a lamp host. The announcement of each lamp is
+ * sent from a path below it
+ */
+#define LAMP_FLEET_ABOUT_OBJECT_PATH "/About"
+
+/*
+ * Version of the About interface
+ */
+#define LAMP_FLEET_ABOUT_VERSION 1
+
+/*
+ * Number of concurrent callbacks of the bus attachment of a lamp host
+ */
+#define LAMP_FLEET_BUS_CONCURRENCY 4
+
+/*
+ * Fault code reported by the lamps that are started with a fault
+ */
+#define LAMP_FLEET_FAULT_CODE 1
+
+/*
+ * Most LampStateChanged signals a lamp sends for one pulse effect
+ */
+#define LAMP_FLEET_MAX_PULSE_SIGNALS 20
+
+static volatile sig_atomic_t g_running = true;
+
+static void SigIntHandler(int sig)
+{
+    g_running = false;
+}
+
+static const char* lampInterfacesXml =
+    "<node>"
+    "  <interface name='org.allseen.LSF.LampService'>"
+    "    <property name='Version' type='u' access='read'/>"
+    "    <property name='LampServiceVersion' type='u' access='read'/>"
+    "    <property name='LampFaults' type='au' access='read'/>"
+    "    <method name='ClearLampFault'>"
+    "      <arg name='LampFaultCode' type='u' direction='in'/>"
+    "      <arg name='LampResponseCode' type='u' direction='out'/>"
+    "      <arg name='LampFaultCode' type='u' direction='out'/>"
+    "    </method>"
+    "  </interface>"
+    "  <interface name='org.allseen.LSF.LampParameters'>"
+    "    <property name='Version' type='u' access='read'/>"
+    "    <property name='Energy_Usage_Milliwatts' type='u' access='read'/>"
+    "    <property name='Brightness_Lumens' type='u' access='read'/>"
+    "  </interface>"
+    "  <interface name='org.allseen.LSF.LampDetails'>"
+    "    <property name='Version' type='u' access='read'/>"
+    "    <property name='Make' type='u' access='read'/>"
+    "    <property name='Model' type='u' access='read'/>"
+    "    <property name='Type' type='u' access='read'/>"
+    "    <property name='LampType' type='u' access='read'/>"
+    "    <property name='LampBaseType' type='u' access='read'/>"
+    "    <property name='LampBeamAngle' type='u' access='read'/>"
+    "    <property name='Dimmable' type='b' access='read'/>"
+    "    <property name='Color' type='b' access='read'/>"
+    "    <property name='VariableColorTemp' type='b' access='read'/>"
+    "    <property name='HasEffects' type='b' access='read'/>"
+    "    <property name='MinVoltage' type='u' access='read'/>"
+    "    <property name='MaxVoltage' type='u' access='read'/>"
+    "    <property name='Wattage' type='u' access='read'/>"
+    "    <property name='IncandescentEquivalent' type='u' access='read'/>"
+    "    <property name='MaxLumens' type='u' access='read'/>"
+    "    <property name='MinTemperature' type='u' access='read'/>"
+    "    <property name='MaxTemperature' type='u' access='read'/>"
+    "    <property name='ColorRenderingIndex' type='u' access='read'/>"
+    "    <property name='LampID' type='s' access='read'/>"
+    "  </interface>"
+    "  <interface name='org.allseen.LSF.LampState'>"
+    "    <property name='Version' type='u' access='read'/>"
+    "    <method name='TransitionLampState'>"
+    "      <arg name='Timestamp' type='t' direction='in'/>"
+    "      <arg name='NewState' type='a{sv}' direction='in'/>"
+    "      <arg name='TransitionPeriod' type='u' direction='in'/>"
+    "      <arg name='LampResponseCode' type='u' direction='out'/>"
+    "    </method>"
+    "    <method name='ApplyPulseEffect'>"
+    "      <arg name='FromState' type='a{sv}' direction='in'/>"
+    "      <arg name='ToState' type='a{sv}' direction='in'/>"
+    "      <arg name='period' type='u' direction='in'/>"
+    "      <arg name='duration' type='u' direction='in'/>"
+    "      <arg name='numPulses' type='u' direction='in'/>"
+    "      <arg name='timestamp' type='t' direction='in'/>"
+    "      <arg name='LampResponseCode' type='u' direction='out'/>"
+    "    </method>"
+    "    <signal name='LampStateChanged'>"
+    "      <arg name='LampID' type='s'/>"
+    "    </signal>"
+    "    <property name='OnOff' type='b' access='readwrite'/>"
+    "    <property name='Hue' type='u' access='readwrite'/>"
+    "    <property name='Saturation' type='u' access='readwrite'/>"
+    "    <property name='ColorTemp' type='u' access='readwrite'/>"
+    "    <property name='Brightness' type='u' access='readwrite'/>"
+    "  </interface>"
+    "  <interface name='org.alljoyn.Config'>"
+    "    <annotation name='org.alljoyn.Bus.Secure' value='true'/>"
+    "    <property name='Version' type='q' access='read'/>"
+    "    <method name='FactoryReset'/>"
+    "    <method name='Restart'/>"
+    "    <method name='SetPasscode'>"
+    "      <arg name='daemonRealm' type='s' direction='in'/>"
+    "      <arg name='newPasscode' type='ay' direction='in'/>"
+    "    </method>"
+    "    <method name='GetConfigurations'>"
+    "      <arg name='languageTag' type='s' direction='in'/>"
+    "      <arg name='languages' type='a{sv}' direction='out'/>"
+    "    </method>"
+    "    <method name='UpdateConfigurations'>"
+    "      <arg name='languageTag' type='s' direction='in'/>"
+    "      <arg name='configMap' type='a{sv}' direction='in'/>"
+    "    </method>"
+    "    <method name='ResetConfigurations'>"
+    "      <arg name='languageTag' type='s' direction='in'/>"
+    "      <arg name='fieldList' type='as' direction='in'/>"
+    "    </method>"
+    "  </interface>"
+    "</node>";
+
+/*
+ * Behaviour shared by all the lamps of the fleet
+ */
+struct FleetConfig {
+    FleetConfig() :
+        numLamps(100), numBuses(4), latency(0), jitter(0), dropPercent(0), errorPercent(0), faultPercent(0),
+        lampIdPrefix("SimLamp"), keyStoreFile("/tmp/lamp_fleet_simulator.ks") { }
+
+    uint32_t numLamps;
+    uint32_t numBuses;
+    uint32_t latency;
+    uint32_t jitter;
+    uint32_t dropPercent;
+    uint32_t errorPercent;
+    uint32_t faultPercent;
+    std::string lampIdPrefix;
+    std::string keyStoreFile;
+    std::string statisticsFile;
+};
+
+/*
+ * Fleet wide counters, printed periodically. They are registered in main
+ * before any lamp is started
+ */
+static LSFStatisticsRegistry statistics;
+static LSFStatistic* methodCallsStatistic = NULL;
+static LSFStatistic* droppedCallsStatistic = NULL;
+static LSFStatistic* errorRepliesStatistic = NULL;
+static LSFStatistic* stateChangesStatistic = NULL;
+static LSFStatistic* getAllCallsStatistic = NULL;
+static LSFStatistic* sessionsStatistic = NULL;
+
+/*
+ * The lamp whose session a Properties call arrived on. The properties
+ * handler of AllJoyn does not pass the message to Get and Set, so the host
+ * makes the lamp current for the duration of the call
+ */
+static pthread_key_t currentLampKey;
+
+/*
+ * A virtual lamp. It has no bus objects of its own, the objects of the lamp
+ * host it lives on answer for it on its sessions
+ */
+class VirtualLamp {
+  public:
+    VirtualLamp(const FleetConfig& config, uint32_t index);
+
+    const LSFString& GetLampID(void) const { return lampID; }
+
+    /*
+     * @return A random number below range
+     */
+    uint32_t Random(uint32_t range);
+
+    uint32_t RandomPercent(void) { return Random(100); }
+
+    /*
+     * @return true if the call should be answered with an error
+     */
+    bool FailCall(void);
+
+    QStatus Get(const char* ifcName, const char* propName, MsgArg& val);
+
+    QStatus Set(const char* ifcName, const char* propName, MsgArg& val);
+
+    void TransitionLampState(const MsgArg& newState);
+
+    LampResponseCode ClearLampFault(uint32_t faultCode);
+
+    void GetConfigurations(MsgArg& arg);
+
+    /*
+     * @return true if the name of the lamp changed
+     */
+    bool UpdateConfigurations(const MsgArg& arg);
+
+    QStatus GetAboutData(MsgArg& arg, const char* language);
+
+    QStatus GetAnnouncedAboutData(MsgArg& arg);
+
+    /*
+     * Session port the lamp is reached on, and the sessions joined on it.
+     * The sessions are protected by the lock of the lamp host
+     */
+    SessionPort port;
+    std::set<SessionId> sessions;
+
+    /*
+     * Time in ms at which the lamp is done with the calls queued on it.
+     * Protected by the lock of the reply scheduler
+     */
+    uint64_t busyUntil;
+
+  private:
+    const FleetConfig& config;
+    LSFString lampID;
+    unsigned int seed;
+
+    Mutex lampLock;
+    LSFString lampName;
+    LampState state;
+    std::vector<uint32_t> faults;
+    AboutData aboutData;
+};
+
+/*
+ * Implemented by the bus objects whose calls are answered after the
+ * simulated latency
+ */
+class LampCallHandler {
+  public:
+    virtual ~LampCallHandler() { }
+
+    /*
+     * Answer a method call on behalf of a lamp
+     */
+    virtual void HandleLampCall(VirtualLamp& lamp, const InterfaceDescription::Member* member, Message& msg) = 0;
+};
+
+/*
+ * Holds the method calls of all the lamps until their simulated latency has
+ * elapsed, so that no AllJoyn dispatcher thread sleeps on a lamp. A lamp
+ * answers its calls one at a time, in the order they arrived
+ */
+class ReplyScheduler : public AlarmListener {
+  public:
+    ReplyScheduler(const FleetConfig& config) : config(config), isRunning(true), replyAlarm(this) { }
+
+    /*
+     * Answer a call now or after the latency of the lamp, or drop it
+     */
+    void Submit(LampCallHandler& handler, VirtualLamp& lamp, const InterfaceDescription::Member* member, Message& msg);
+
+    /*
+     * Stop the scheduler. Calls that are still held are never answered
+     */
+    void Stop(void);
+
+    void AlarmTriggered(void);
+
+  private:
+    struct DeferredCall {
+        DeferredCall(LampCallHandler& handler, VirtualLamp& lamp, const InterfaceDescription::Member* member, Message& msg) :
+            handler(&handler), lamp(&lamp), member(member), msg(msg) { }
+
+        LampCallHandler* handler;
+        VirtualLamp* lamp;
+        const InterfaceDescription::Member* member;
+        Message msg;
+    };
+
+    typedef std::multimap<uint64_t, DeferredCall> DeferredCallMap;
+
+    /*
+     * Load the alarm for the earliest held call. Must be called with
+     * schedulerLock held
+     */
+    void SetAlarm(uint64_t now);
+
+    const FleetConfig& config;
+    volatile sig_atomic_t isRunning;
+    Mutex schedulerLock;
+    DeferredCallMap deferredCalls;
+    Alarm replyAlarm;
+};
+
+class LampHost;
+
+/*
+ * The Config object of a lamp host. The calls are answered by the lamp of
+ * the session they arrive on
+ */
+class HostConfigObject : public BusObject, public LampCallHandler {
+  public:
+    HostConfigObject(LampHost& host) : BusObject(ConfigServiceObjectPath), host(host) { }
+
+    QStatus Init(BusAttachment& bus);
+
+    QStatus Get(const char* ifcName, const char* propName, MsgArg& val);
+
+    void HandleLampCall(VirtualLamp& lamp, const InterfaceDescription::Member* member, Message& msg);
+
+  private:
+    void ConfigCall(const InterfaceDescription::Member* member, Message& msg);
+
+    LampHost& host;
+};
+
+/*
+ * The About object of a lamp host. GetAboutData is answered with the About
+ * data of the lamp of the session the call arrives on
+ */
+class HostAboutObject : public BusObject {
+  public:
+    HostAboutObject(LampHost& host) : BusObject(LAMP_FLEET_ABOUT_OBJECT_PATH), host(host) { }
+
+    QStatus Init(BusAttachment& bus);
+
+    QStatus Get(const char* ifcName, const char* propName, MsgArg& val);
+
+  private:
+    void GetAboutData(const InterfaceDescription::Member* member, Message& msg);
+    void GetObjectDescription(const InterfaceDescription::Member* member, Message& msg);
+
+    LampHost& host;
+};
+
+/*
+ * Sends the About announcement of one lamp. The sessionless signal cache
+ * keeps the last signal per sender, interface, member and object path, so
+ * each lamp announces from a path of its own
+ */
+class LampAnnouncer : public BusObject {
+  public:
+    LampAnnouncer(const char* path) : BusObject(path), announceSignal(NULL) { }
+
+    QStatus Init(BusAttachment& bus);
+
+    QStatus Announce(VirtualLamp& lamp, const MsgArg& objectDescription);
+
+  private:
+    const InterfaceDescription::Member* announceSignal;
+};
+
+/*
+ * A bus attachment that hosts a share of the fleet. It owns the Lamp Service,
+ * Config and About objects of all its lamps, and tells the lamps apart by
+ * the session port each of them is reached on
+ */
+class LampHost : public BusObject, public LampCallHandler, public SessionPortListener, public SessionListener {
+  public:
+    LampHost(const FleetConfig& config, uint32_t index, LSFKeyListener& keyListener, ReplyScheduler& scheduler);
+
+    ~LampHost();
+
+    QStatus Start(void);
+
+    void Stop(void);
+
+    /*
+     * Bind a session port for a lamp and announce it
+     */
+    QStatus AddLamp(VirtualLamp& lamp);
+
+    /*
+     * Announce a lamp again, after its name changed
+     */
+    void Reannounce(VirtualLamp& lamp);
+
+    /*
+     * @return The lamp reached on a session, or NULL
+     */
+    VirtualLamp* GetLamp(SessionId sessionId);
+
+    const MsgArg& GetObjectDescription(void) const { return objectDescription; }
+
+    ReplyScheduler& GetScheduler(void) { return scheduler; }
+
+    QStatus Get(const char* ifcName, const char* propName, MsgArg& val);
+
+    QStatus Set(const char* ifcName, const char* propName, MsgArg& val);
+
+    bool AcceptSessionJoiner(SessionPort sessionPort, const char* joiner, const SessionOpts& opts);
+
+    void SessionJoined(SessionPort sessionPort, SessionId id, const char* joiner);
+
+    void SessionLost(SessionId sessionId, SessionLostReason reason);
+
+    void HandleLampCall(VirtualLamp& lamp, const InterfaceDescription::Member* member, Message& msg);
+
+  protected:
+    void CallMethodHandler(MessageReceiver::MethodHandler handler, const InterfaceDescription::Member* member, Message& message, void* context);
+
+  private:
+    void LampCall(const InterfaceDescription::Member* member, Message& msg);
+
+    void SendLampStateChanged(VirtualLamp& lamp);
+
+    const FleetConfig& config;
+    uint32_t index;
+    LSFKeyListener& keyListener;
+    ReplyScheduler& scheduler;
+    BusAttachment bus;
+    HostConfigObject configObject;
+    HostAboutObject aboutObject;
+    MsgArg objectDescription;
+    const InterfaceDescription::Member* lampStateChanged;
+
+    Mutex hostLock;
+    std::map<SessionPort, VirtualLamp*> lampsByPort;
+    std::map<SessionId, VirtualLamp*> lampsBySession;
+    std::map<VirtualLamp*, LampAnnouncer*> announcers;
+};
+
+VirtualLamp::VirtualLamp(const FleetConfig& config, uint32_t index) :
+    port(SESSION_PORT_ANY),
+    busyUntil(0),
+    config(config),
+    seed(index ^ qcc::Rand32()),
+    state(false, 0, 0, 0, 0),
+    aboutData("en")
+{
+    char suffix[16];
+    snprintf(suffix, sizeof(suffix), "%06u", index);
+    lampID = config.lampIdPrefix + suffix;
+    lampName = lampID;
+
+    if (RandomPercent() < config.faultPercent) {
+        faults.push_back(LAMP_FLEET_FAULT_CODE);
+    }
+
+    uint8_t appId[16];
+    for (size_t i = 0; i < sizeof(appId); i++) {
+        appId[i] = static_cast<uint8_t>(rand_r(&seed));
+    }
+    aboutData.SetAppId(appId, sizeof(appId));
+    aboutData.SetDeviceId(lampID.c_str());
+    aboutData.SetDeviceName(lampName.c_str());
+    aboutData.SetAppName("LampFleetSimulator");
+    aboutData.SetManufacturer("AllSeen Alliance");
+    aboutData.SetModelNumber("VirtualLamp");
+    aboutData.SetDescription("Virtual lamp of the lamp fleet simulator");
+    aboutData.SetSoftwareVersion("1.0");
+}
+
+uint32_t VirtualLamp::Random(uint32_t range)
+{
+    lampLock.Lock();
+    uint32_t value = static_cast<uint32_t>(rand_r(&seed)) % range;
+    lampLock.Unlock();
+    return value;
+}
+
+bool VirtualLamp::FailCall(void)
+{
+    if (RandomPercent() < config.errorPercent) {
+        errorRepliesStatistic->Increment();
+        return true;
+    }
+    return false;
+}
+
+QStatus VirtualLamp::Get(const char* ifcName, const char* propName, MsgArg& val)
+{
+    QStatus status = ER_OK;
+
+    lampLock.Lock();
+    if (0 == strcmp(propName, "Version")) {
+        val.Set("u", 1);
+    } else if (0 == strcmp(ifcName, LampServiceStateInterfaceName)) {
+        if (0 == strcmp(propName, "OnOff")) {
+            val.Set("b", state.onOff);
+        } else if (0 == strcmp(propName, "Hue")) {
+            val.Set("u", state.hue);
+        } else if (0 == strcmp(propName, "Saturation")) {
+            val.Set("u", state.saturation);
+        } else if (0 == strcmp(propName, "ColorTemp")) {
+            val.Set("u", state.colorTemp);
+        } else if (0 == strcmp(propName, "Brightness")) {
+            val.Set("u", state.brightness);
+        } else {
+            status = ER_BUS_NO_SUCH_PROPERTY;
+        }
+    } else if (0 == strcmp(ifcName, LampServiceInterfaceName)) {
+        if (0 == strcmp(propName, "LampServiceVersion")) {
+            val.Set("u", 1);
+        } else if (0 == strcmp(propName, "LampFaults")) {
+            val.Set("au", faults.size(), faults.empty() ? NULL : &faults[0]);
+            val.Stabilize();
+        } else {
+            status = ER_BUS_NO_SUCH_PROPERTY;
+        }
+    } else if (0 == strcmp(ifcName, LampServiceParametersInterfaceName)) {
+        if (0 == strcmp(propName, "Energy_Usage_Milliwatts")) {
+            val.Set("u", state.onOff ? 9000 : 0);
+        } else if (0 == strcmp(propName, "Brightness_Lumens")) {
+            val.Set("u", state.onOff ? 800 : 0);
+        } else {
+            status = ER_BUS_NO_SUCH_PROPERTY;
+        }
+    } else if (0 == strcmp(ifcName, LampServiceDetailsInterfaceName)) {
+        if (0 == strcmp(propName, "LampID")) {
+            val.Set("s", lampID.c_str());
+            val.Stabilize();
+        } else if ((0 == strcmp(propName, "Dimmable")) || (0 == strcmp(propName, "Color")) ||
+                   (0 == strcmp(propName, "VariableColorTemp")) || (0 == strcmp(propName, "HasEffects"))) {
+            val.Set("b", true);
+        } else if (0 == strcmp(propName, "MinTemperature")) {
+            val.Set("u", 2700);
+        } else if (0 == strcmp(propName, "MaxTemperature")) {
+            val.Set("u", 9000);
+        } else if (0 == strcmp(propName, "MaxLumens")) {
+            val.Set("u", 800);
+        } else {
+            val.Set("u", 0);
+        }
+    } else {
+        status = ER_BUS_NO_SUCH_PROPERTY;
+    }
+    lampLock.Unlock();
+
+    return status;
+}
+
+QStatus VirtualLamp::Set(const char* ifcName, const char* propName, MsgArg& val)
+{
+    if (0 != strcmp(ifcName, LampServiceStateInterfaceName)) {
+        return ER_BUS_PROPERTY_ACCESS_DENIED;
+    }
+
+    QStatus status = ER_OK;
+    lampLock.Lock();
+    if (0 == strcmp(propName, "OnOff")) {
+        status = val.Get("b", &state.onOff);
+    } else if (0 == strcmp(propName, "Hue")) {
+        status = val.Get("u", &state.hue);
+    } else if (0 == strcmp(propName, "Saturation")) {
+        status = val.Get("u", &state.saturation);
+    } else if (0 == strcmp(propName, "ColorTemp")) {
+        status = val.Get("u", &state.colorTemp);
+    } else if (0 == strcmp(propName, "Brightness")) {
+        status = val.Get("u", &state.brightness);
+    } else {
+        status = ER_BUS_NO_SUCH_PROPERTY;
+    }
+    lampLock.Unlock();
+
+    return status;
+}
+
+void VirtualLamp::TransitionLampState(const MsgArg& newState)
+{
+    size_t numEntries = 0;
+    MsgArg* entries = NULL;
+    newState.Get("a{sv}", &numEntries, &entries);
+    if (numEntries) {
+        lampLock.Lock();
+        state.Set(newState);
+        lampLock.Unlock();
+    }
+}
+
+LampResponseCode VirtualLamp::ClearLampFault(uint32_t faultCode)
+{
+    LampResponseCode responseCode = LAMP_ERR_INVALID;
+    lampLock.Lock();
+    for (std::vector<uint32_t>::iterator it = faults.begin(); it != faults.end(); ++it) {
+        if (*it == faultCode) {
+            faults.erase(it);
+            responseCode = LAMP_OK;
+            break;
+        }
+    }
+    lampLock.Unlock();
+    return responseCode;
+}
+
+void VirtualLamp::GetConfigurations(MsgArg& arg)
+{
+    const char* languages[] = { "en" };
+
+    lampLock.Lock();
+    MsgArg values[4];
+    values[0].Set("s", lampName.c_str());
+    values[1].Set("s", "en");
+    values[2].Set("as", 1, languages);
+    values[3].Set("s", "AllSeen Alliance");
+
+    MsgArg entries[4];
+    entries[0].Set("{sv}", "DeviceName", &values[0]);
+    entries[1].Set("{sv}", "DefaultLanguage", &values[1]);
+    entries[2].Set("{sv}", "SupportedLanguages", &values[2]);
+    entries[3].Set("{sv}", "Manufacturer", &values[3]);
+
+    arg.Set("a{sv}", 4, entries);
+    arg.Stabilize();
+    lampLock.Unlock();
+}
+
+bool VirtualLamp::UpdateConfigurations(const MsgArg& arg)
+{
+    size_t numEntries = 0;
+    MsgArg* entries = NULL;
+    arg.Get("a{sv}", &numEntries, &entries);
+
+    bool nameChanged = false;
+    for (size_t i = 0; i < numEntries; i++) {
+        char* key;
+        MsgArg* value;
+        entries[i].Get("{sv}", &key, &value);
+        if (0 == strcmp(key, "DeviceName")) {
+            char* name;
+            if (value->Get("s", &name) == ER_OK) {
+                lampLock.Lock();
+                lampName = name;
+                aboutData.SetDeviceName(name);
+                lampLock.Unlock();
+                nameChanged = true;
+            }
+        }
+    }
+    return nameChanged;
+}
+
+QStatus VirtualLamp::GetAboutData(MsgArg& arg, const char* language)
+{
+    lampLock.Lock();
+    QStatus status = aboutData.GetAboutData(&arg, language);
+    if (status == ER_OK) {
+        arg.Stabilize();
+    }
+    lampLock.Unlock();
+    return status;
+}
+
+QStatus VirtualLamp::GetAnnouncedAboutData(MsgArg& arg)
+{
+    lampLock.Lock();
+    QStatus status = aboutData.GetAnnouncedAboutData(&arg);
+    if (status == ER_OK) {
+        arg.Stabilize();
+    }
+    lampLock.Unlock();
+    return status;
+}
+
+void ReplyScheduler::Submit(LampCallHandler& handler, VirtualLamp& lamp, const InterfaceDescription::Member* member, Message& msg)
+{
+    methodCallsStatistic->Increment();
+
+    if (lamp.RandomPercent() < config.dropPercent) {
+        droppedCallsStatistic->Increment();
+        return;
+    }
+
+    uint32_t delay = config.latency;
+    if (config.jitter) {
+        delay += lamp.Random(config.jitter + 1);
+    }
+
+    uint64_t now = GetTimestampInMs();
+    bool answerNow = false;
+
+    schedulerLock.Lock();
+    if (!isRunning) {
+        schedulerLock.Unlock();
+        return;
+    }
+    uint64_t start = (lamp.busyUntil > now) ? lamp.busyUntil : now;
+    lamp.busyUntil = start + delay;
+    if (lamp.busyUntil == now) {
+        answerNow = true;
+    } else {
+        deferredCalls.insert(std::make_pair(lamp.busyUntil, DeferredCall(handler, lamp, member, msg)));
+        SetAlarm(now);
+    }
+    schedulerLock.Unlock();
+
+    if (answerNow) {
+        handler.HandleLampCall(lamp, member, msg);
+    }
+}
+
+void ReplyScheduler::Stop(void)
+{
+    schedulerLock.Lock();
+    isRunning = false;
+    deferredCalls.clear();
+    schedulerLock.Unlock();
+
+    replyAlarm.Stop();
+    replyAlarm.Join();
+}
+
+void ReplyScheduler::SetAlarm(uint64_t now)
+{
+    if (!deferredCalls.empty()) {
+        uint64_t due = deferredCalls.begin()->first;
+        replyAlarm.SetAlarmInMs((due > now) ? static_cast<uint32_t>(due - now) : 1);
+    }
+}
+
+void ReplyScheduler::AlarmTriggered(void)
+{
+    std::list<DeferredCall> dueCalls;
+
+    schedulerLock.Lock();
+    uint64_t now = GetTimestampInMs();
+    DeferredCallMap::iterator end = deferredCalls.upper_bound(now);
+    for (DeferredCallMap::iterator it = deferredCalls.begin(); it != end; ++it) {
+        dueCalls.push_back(it->second);
+    }
+    deferredCalls.erase(deferredCalls.begin(), end);
+    SetAlarm(now);
+    schedulerLock.Unlock();
+
+    for (std::list<DeferredCall>::iterator it = dueCalls.begin(); it != dueCalls.end(); ++it) {
+        it->handler->HandleLampCall(*it->lamp, it->member, it->msg);
+    }
+}
+
+QStatus HostConfigObject::Init(BusAttachment& bus)
+{
+    const InterfaceDescription* intf = bus.GetInterface(ConfigServiceInterfaceName);
+    if (!intf) {
+        return ER_BUS_NO_SUCH_INTERFACE;
+    }
+
+    QStatus status = AddInterface(*intf);
+    if (status == ER_OK) {
+        const MethodEntry methodEntries[] = {
+            { intf->GetMember("GetConfigurations"), static_cast<MessageReceiver::MethodHandler>(&HostConfigObject::ConfigCall) },
+            { intf->GetMember("UpdateConfigurations"), static_cast<MessageReceiver::MethodHandler>(&HostConfigObject::ConfigCall) },
+            { intf->GetMember("ResetConfigurations"), static_cast<MessageReceiver::MethodHandler>(&HostConfigObject::ConfigCall) },
+            { intf->GetMember("FactoryReset"), static_cast<MessageReceiver::MethodHandler>(&HostConfigObject::ConfigCall) },
+            { intf->GetMember("Restart"), static_cast<MessageReceiver::MethodHandler>(&HostConfigObject::ConfigCall) },
+            { intf->GetMember("SetPasscode"), static_cast<MessageReceiver::MethodHandler>(&HostConfigObject::ConfigCall) }
+        };
+        status = AddMethodHandlers(methodEntries, sizeof(methodEntries) / sizeof(MethodEntry));
+    }
+
+    return status;
+}
+
+QStatus HostConfigObject::Get(const char* ifcName, const char* propName, MsgArg& val)
+{
+    if (0 == strcmp(propName, "Version")) {
+        return val.Set("q", 1);
+    }
+    return ER_BUS_NO_SUCH_PROPERTY;
+}
+
+void HostConfigObject::ConfigCall(const InterfaceDescription::Member* member, Message& msg)
+{
+    VirtualLamp* lamp = host.GetLamp(msg->GetSessionId());
+    if (!lamp) {
+        MethodReply(msg, ER_BUS_NO_SESSION);
+        return;
+    }
+    host.GetScheduler().Submit(*this, *lamp, member, msg);
+}
+
+void HostConfigObject::HandleLampCall(VirtualLamp& lamp, const InterfaceDescription::Member* member, Message& msg)
+{
+    bool getConfigurations = (0 == strcmp(member->name.c_str(), "GetConfigurations"));
+    bool updateConfigurations = (0 == strcmp(member->name.c_str(), "UpdateConfigurations"));
+
+    if ((getConfigurations || updateConfigurations) && lamp.FailCall()) {
+        MethodReply(msg, ER_FAIL);
+        return;
+    }
+
+    if (getConfigurations) {
+        MsgArg reply;
+        lamp.GetConfigurations(reply);
+        MethodReply(msg, &reply, 1);
+    } else if (updateConfigurations) {
+        bool nameChanged = lamp.UpdateConfigurations(*msg->GetArg(1));
+        MethodReply(msg);
+        if (nameChanged) {
+            host.Reannounce(lamp);
+        }
+    } else {
+        MethodReply(msg);
+    }
+}
+
+QStatus HostAboutObject::Init(BusAttachment& bus)
+{
+    const InterfaceDescription* intf = bus.GetInterface(AboutInterfaceName);
+    if (!intf) {
+        return ER_BUS_NO_SUCH_INTERFACE;
+    }
+
+    QStatus status = AddInterface(*intf);
+    if (status == ER_OK) {
+        const MethodEntry methodEntries[] = {
+            { intf->GetMember("GetAboutData"), static_cast<MessageReceiver::MethodHandler>(&HostAboutObject::GetAboutData) },
+            { intf->GetMember("GetObjectDescription"), static_cast<MessageReceiver::MethodHandler>(&HostAboutObject::GetObjectDescription) }
+        };
+        status = AddMethodHandlers(methodEntries, sizeof(methodEntries) / sizeof(MethodEntry));
+    }
+
+    return status;
+}
+
+QStatus HostAboutObject::Get(const char* ifcName, const char* propName, MsgArg& val)
+{
+    if (0 == strcmp(propName, "Version")) {
+        return val.Set("q", LAMP_FLEET_ABOUT_VERSION);
+    }
+    return ER_BUS_NO_SUCH_PROPERTY;
+}
+
+void HostAboutObject::GetAboutData(const InterfaceDescription::Member* member, Message& msg)
+{
+    VirtualLamp* lamp = host.GetLamp(msg->GetSessionId());
+    if (!lamp) {
+        MethodReply(msg, ER_BUS_NO_SESSION);
+        return;
+    }
+
+    const char* language = NULL;
+    msg->GetArg(0)->Get("s", &language);
+
+    MsgArg reply;
+    QStatus status = lamp->GetAboutData(reply, language);
+    if (status == ER_OK) {
+        MethodReply(msg, &reply, 1);
+    } else {
+        MethodReply(msg, status);
+    }
+}
+
+void HostAboutObject::GetObjectDescription(const InterfaceDescription::Member* member, Message& msg)
+{
+    MethodReply(msg, &host.GetObjectDescription(), 1);
+}
+
+QStatus LampAnnouncer::Init(BusAttachment& bus)
+{
+    const InterfaceDescription* intf = bus.GetInterface(AboutInterfaceName);
+    if (!intf) {
+        return ER_BUS_NO_SUCH_INTERFACE;
+    }
+
+    announceSignal = intf->GetMember("Announce");
+    return AddInterface(*intf);
+}
+
+QStatus LampAnnouncer::Announce(VirtualLamp& lamp, const MsgArg& objectDescription)
+{
+    MsgArg args[4];
+    args[0].Set("q", LAMP_FLEET_ABOUT_VERSION);
+    args[1].Set("q", lamp.port);
+    args[2] = objectDescription;
+
+    QStatus status = lamp.GetAnnouncedAboutData(args[3]);
+    if (status == ER_OK) {
+        status = Signal(NULL, 0, *announceSignal, args, 4, 0, ALLJOYN_FLAG_SESSIONLESS);
+    }
+    return status;
+}
+
+LampHost::LampHost(const FleetConfig& config, uint32_t index, LSFKeyListener& keyListener, ReplyScheduler& scheduler) :
+    BusObject(LampServiceObjectPath),
+    config(config),
+    index(index),
+    keyListener(keyListener),
+    scheduler(scheduler),
+    bus("LampFleetSimulator", true, LAMP_FLEET_BUS_CONCURRENCY),
+    configObject(*this),
+    aboutObject(*this),
+    lampStateChanged(NULL)
+{
+    const char* lampInterfaces[] = {
+        LampServiceInterfaceName,
+        LampServiceParametersInterfaceName,
+        LampServiceDetailsInterfaceName,
+        LampServiceStateInterfaceName
+    };
+    const char* configInterfaces[] = {
+        ConfigServiceInterfaceName
+    };
+
+    MsgArg entries[2];
+    entries[0].Set("(oas)", LampServiceObjectPath, sizeof(lampInterfaces) / sizeof(lampInterfaces[0]), lampInterfaces);
+    entries[1].Set("(oas)", ConfigServiceObjectPath, sizeof(configInterfaces) / sizeof(configInterfaces[0]), configInterfaces);
+    objectDescription.Set("a(oas)", 2, entries);
+    objectDescription.Stabilize();
+}
+
+LampHost::~LampHost()
+{
+    Stop();
+
+    for (std::map<VirtualLamp*, LampAnnouncer*>::iterator it = announcers.begin(); it != announcers.end(); ++it) {
+        delete it->second;
+    }
+    announcers.clear();
+}
+
+QStatus LampHost::Start(void)
+{
+    QCC_DbgTrace(("%s: index=%u", __func__, index));
+
+    QStatus status = bus.Start();
+    if (status == ER_OK) {
+        status = bus.Connect();
+    }
+    if (status == ER_OK) {
+        status = bus.EnablePeerSecurity("ALLJOYN_ECDHE_PSK", &keyListener, config.keyStoreFile.c_str(), true);
+    }
+    if (status == ER_OK) {
+        status = bus.CreateInterfacesFromXml(lampInterfacesXml);
+    }
+    if (status != ER_OK) {
+        QCC_LogError(status, ("%s: Failed to set up the bus of host %u", __func__, index));
+        return status;
+    }
+
+    const char* lampInterfaces[] = {
+        LampServiceInterfaceName,
+        LampServiceParametersInterfaceName,
+        LampServiceDetailsInterfaceName,
+        LampServiceStateInterfaceName
+    };
+    for (size_t i = 0; (i < (sizeof(lampInterfaces) / sizeof(lampInterfaces[0]))) && (status == ER_OK); i++) {
+        const InterfaceDescription* intf = bus.GetInterface(lampInterfaces[i]);
+        status = intf ? AddInterface(*intf) : ER_BUS_NO_SUCH_INTERFACE;
+    }
+
+    if (status == ER_OK) {
+        const InterfaceDescription* serviceIntf = bus.GetInterface(LampServiceInterfaceName);
+        const InterfaceDescription* stateIntf = bus.GetInterface(LampServiceStateInterfaceName);
+        lampStateChanged = stateIntf->GetMember("LampStateChanged");
+
+        const MethodEntry methodEntries[] = {
+            { stateIntf->GetMember("TransitionLampState"), static_cast<MessageReceiver::MethodHandler>(&LampHost::LampCall) },
+            { stateIntf->GetMember("ApplyPulseEffect"), static_cast<MessageReceiver::MethodHandler>(&LampHost::LampCall) },
+            { serviceIntf->GetMember("ClearLampFault"), static_cast<MessageReceiver::MethodHandler>(&LampHost::LampCall) }
+        };
+        status = AddMethodHandlers(methodEntries, sizeof(methodEntries) / sizeof(MethodEntry));
+    }
+
+    if (status == ER_OK) {
+        status = configObject.Init(bus);
+    }
+    if (status == ER_OK) {
+        status = aboutObject.Init(bus);
+    }
+    if (status == ER_OK) {
+        status = bus.RegisterBusObject(*this);
+    }
+    if (status == ER_OK) {
+        status = bus.RegisterBusObject(configObject);
+    }
+    if (status == ER_OK) {
+        status = bus.RegisterBusObject(aboutObject);
+    }
+
+    if (status != ER_OK) {
+        QCC_LogError(status, ("%s: Failed to start host %u", __func__, index));
+    }
+
+    return status;
+}
+
+void LampHost::Stop(void)
+{
+    QCC_DbgTrace(("%s: index=%u", __func__, index));
+    for (std::map<VirtualLamp*, LampAnnouncer*>::iterator it = announcers.begin(); it != announcers.end(); ++it) {
+        bus.UnregisterBusObject(*it->second);
+    }
+    bus.UnregisterBusObject(aboutObject);
+    bus.UnregisterBusObject(configObject);
+    bus.UnregisterBusObject(*this);
+    bus.Disconnect();
+    bus.Stop();
+    bus.Join();
+}
+
+QStatus LampHost::AddLamp(VirtualLamp& lamp)
+{
+    QCC_DbgTrace(("%s: index=%u lampID=%s", __func__, index, lamp.GetLampID().c_str()));
+
+    SessionOpts opts(SessionOpts::TRAFFIC_MESSAGES, true, SessionOpts::PROXIMITY_ANY, TRANSPORT_ANY);
+    SessionPort port = SESSION_PORT_ANY;
+    QStatus status = bus.BindSessionPort(port, opts, *this);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("%s: Failed to bind a session port for lamp %s", __func__, lamp.GetLampID().c_str()));
+        return status;
+    }
+    lamp.port = port;
+
+    std::string path = std::string(LAMP_FLEET_ABOUT_OBJECT_PATH) + "/" + lamp.GetLampID().c_str();
+    LampAnnouncer* announcer = new LampAnnouncer(path.c_str());
+    status = announcer->Init(bus);
+    if (status == ER_OK) {
+        status = bus.RegisterBusObject(*announcer);
+    }
+    if (status != ER_OK) {
+        QCC_LogError(status, ("%s: Failed to register the announcer of lamp %s", __func__, lamp.GetLampID().c_str()));
+        bus.UnbindSessionPort(port);
+        delete announcer;
+        return status;
+    }
+
+    hostLock.Lock();
+    lampsByPort[port] = &lamp;
+    announcers[&lamp] = announcer;
+    hostLock.Unlock();
+
+    status = announcer->Announce(lamp, objectDescription);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("%s: Failed to announce lamp %s", __func__, lamp.GetLampID().c_str()));
+    }
+    return status;
+}
+
+void LampHost::Reannounce(VirtualLamp& lamp)
+{
+    hostLock.Lock();
+    std::map<VirtualLamp*, LampAnnouncer*>::iterator it = announcers.find(&lamp);
+    LampAnnouncer* announcer = (it != announcers.end()) ? it->second : NULL;
+    hostLock.Unlock();
+
+    if (announcer) {
+        announcer->Announce(lamp, objectDescription);
+    }
+}
+
+VirtualLamp* LampHost::GetLamp(SessionId sessionId)
+{
+    hostLock.Lock();
+    std::map<SessionId, VirtualLamp*>::iterator it = lampsBySession.find(sessionId);
+    VirtualLamp* lamp = (it != lampsBySession.end()) ? it->second : NULL;
+    hostLock.Unlock();
+    return lamp;
+}
+
+void LampHost::CallMethodHandler(MessageReceiver::MethodHandler handler, const InterfaceDescription::Member* member, Message& message, void* context)
+{
+    // The controller reads the state of a lamp with a single GetAll
+    if (0 == strcmp(member->name.c_str(), "GetAll")) {
+        getAllCallsStatistic->Increment();
+    }
+    pthread_setspecific(currentLampKey, GetLamp(message->GetSessionId()));
+    BusObject::CallMethodHandler(handler, member, message, context);
+    pthread_setspecific(currentLampKey, NULL);
+}
+
+QStatus LampHost::Get(const char* ifcName, const char* propName, MsgArg& val)
+{
+    VirtualLamp* lamp = static_cast<VirtualLamp*>(pthread_getspecific(currentLampKey));
+    return lamp ? lamp->Get(ifcName, propName, val) : ER_BUS_NO_SESSION;
+}
+
+QStatus LampHost::Set(const char* ifcName, const char* propName, MsgArg& val)
+{
+    VirtualLamp* lamp = static_cast<VirtualLamp*>(pthread_getspecific(currentLampKey));
+    if (!lamp) {
+        return ER_BUS_NO_SESSION;
+    }
+
+    QStatus status = lamp->Set(ifcName, propName, val);
+    if (status == ER_OK) {
+        SendLampStateChanged(*lamp);
+    }
+    return status;
+}
+
+bool LampHost::AcceptSessionJoiner(SessionPort sessionPort, const char* joiner, const SessionOpts& opts)
+{
+    QCC_DbgTrace(("%s: index=%u port=%u joiner=%s", __func__, index, sessionPort, joiner));
+    hostLock.Lock();
+    bool accept = (lampsByPort.find(sessionPort) != lampsByPort.end());
+    hostLock.Unlock();
+    return accept;
+}
+
+void LampHost::SessionJoined(SessionPort sessionPort, SessionId id, const char* joiner)
+{
+    QCC_DbgTrace(("%s: index=%u port=%u sessionId=%u", __func__, index, sessionPort, id));
+    bus.SetSessionListener(id, this);
+
+    hostLock.Lock();
+    std::map<SessionPort, VirtualLamp*>::iterator it = lampsByPort.find(sessionPort);
+    if (it != lampsByPort.end()) {
+        lampsBySession[id] = it->second;
+        it->second->sessions.insert(id);
+    }
+    hostLock.Unlock();
+    sessionsStatistic->Increment();
+}
+
+void LampHost::SessionLost(SessionId sessionId, SessionLostReason reason)
+{
+    QCC_DbgTrace(("%s: index=%u sessionId=%u", __func__, index, sessionId));
+    hostLock.Lock();
+    std::map<SessionId, VirtualLamp*>::iterator it = lampsBySession.find(sessionId);
+    bool erased = (it != lampsBySession.end());
+    if (erased) {
+        it->second->sessions.erase(sessionId);
+        lampsBySession.erase(it);
+    }
+    hostLock.Unlock();
+    if (erased) {
+        sessionsStatistic->Decrement();
+    }
+}
+
+void LampHost::LampCall(const InterfaceDescription::Member* member, Message& msg)
+{
+    VirtualLamp* lamp = GetLamp(msg->GetSessionId());
+    if (!lamp) {
+        MethodReply(msg, ER_BUS_NO_SESSION);
+        return;
+    }
+    scheduler.Submit(*this, *lamp, member, msg);
+}
+
+void LampHost::HandleLampCall(VirtualLamp& lamp, const InterfaceDescription::Member* member, Message& msg)
+{
+    if (0 == strcmp(member->name.c_str(), "TransitionLampState")) {
+        uint32_t responseCode = LAMP_ERR_BUSY;
+        if (!lamp.FailCall()) {
+            lamp.TransitionLampState(*msg->GetArg(1));
+            responseCode = LAMP_OK;
+        }
+
+        MsgArg reply("u", responseCode);
+        MethodReply(msg, &reply, 1);
+
+        if (responseCode == LAMP_OK) {
+            SendLampStateChanged(lamp);
+        }
+    } else if (0 == strcmp(member->name.c_str(), "ApplyPulseEffect")) {
+        uint32_t responseCode = lamp.FailCall() ? LAMP_ERR_BUSY : LAMP_OK;
+        MsgArg reply("u", responseCode);
+        MethodReply(msg, &reply, 1);
+
+        /*
+         * The pulses are not played and the lamp is left in its current state,
+         * but it signals a state change for every pulse like a lamp playing
+         * them would. The signals are sent at once rather than one period apart
+         */
+        if (responseCode == LAMP_OK) {
+            uint32_t numPulses = 0;
+            msg->GetArg(4)->Get("u", &numPulses);
+            if (numPulses > LAMP_FLEET_MAX_PULSE_SIGNALS) {
+                numPulses = LAMP_FLEET_MAX_PULSE_SIGNALS;
+            }
+            for (uint32_t i = 0; i < numPulses; i++) {
+                SendLampStateChanged(lamp);
+            }
+        }
+    } else if (0 == strcmp(member->name.c_str(), "ClearLampFault")) {
+        uint32_t faultCode = 0;
+        msg->GetArg(0)->Get("u", &faultCode);
+
+        uint32_t responseCode = lamp.FailCall() ? LAMP_ERR_BUSY : lamp.ClearLampFault(faultCode);
+
+        MsgArg reply[2];
+        reply[0].Set("u", responseCode);
+        reply[1].Set("u", faultCode);
+        MethodReply(msg, reply, 2);
+    }
+}
+
+void LampHost::SendLampStateChanged(VirtualLamp& lamp)
+{
+    stateChangesStatistic->Increment();
+
+    hostLock.Lock();
+    std::set<SessionId> tempSessions = lamp.sessions;
+    hostLock.Unlock();
+
+    MsgArg arg("s", lamp.GetLampID().c_str());
+    for (std::set<SessionId>::const_iterator it = tempSessions.begin(); it != tempSessions.end(); ++it) {
+        QStatus status = Signal(NULL, *it, *lampStateChanged, &arg, 1);
+        if (status != ER_OK) {
+            QCC_LogError(status, ("%s: Failed to signal on session %u", __func__, *it));
+        }
+    }
+}
+
+static bool ParseUInt(int argc, char** argv, int& i, uint32_t& value)
+{
+    if ((i + 1) >= argc) {
+        printf("option %s requires a parameter\n", argv[i]);
+        return false;
+    }
+    value = strtoul(argv[++i], NULL, 10);
+    return true;
+}
+
+static void usage(char** argv)
+{
+    printf("Usage: %s [-n <num_lamps>] [-b <num_buses>] [-l <latency_ms>] [-j <jitter_ms>] [-d <drop_percent>] [-e <error_percent>] [-f <fault_percent>] [-p <lamp_id_prefix>] [-k <keystore_file>] [-s <statistics_file>]\n\n", argv[0]);
+    printf("Options:\n");
+    printf("   -n <num_lamps>        = Number of virtual lamps. Default 100\n");
+    printf("   -b <num_buses>        = Number of bus attachments the lamps are spread over. Default 4\n");
+    printf("   -l <latency_ms>       = Time taken by a lamp to answer a method call\n");
+    printf("   -j <jitter_ms>        = Random extra time, up to this value, added to the latency\n");
+    printf("   -d <drop_percent>     = Percentage of method calls that are never answered\n");
+    printf("   -e <error_percent>    = Percentage of method calls answered with an error\n");
+    printf("   -f <fault_percent>    = Percentage of lamps that report a lamp fault\n");
+    printf("   -p <lamp_id_prefix>   = Prefix of the lamp IDs. Default SimLamp\n");
+    printf("   -k <keystore_file>    = Key store shared by the lamps\n");
+    printf("   -s <statistics_file>  = Write the fleet wide counters to a file every second\n");
+}
+
+int main(int argc, char** argv)
+{
+    FleetConfig config;
+
+    for (int i = 1; i < argc; i++) {
+        bool ok = true;
+        if (0 == strcmp("-n", argv[i])) {
+            ok = ParseUInt(argc, argv, i, config.numLamps);
+        } else if (0 == strcmp("-b", argv[i])) {
+            ok = ParseUInt(argc, argv, i, config.numBuses);
+            ok = ok && (config.numBuses > 0);
+        } else if (0 == strcmp("-l", argv[i])) {
+            ok = ParseUInt(argc, argv, i, config.latency);
+        } else if (0 == strcmp("-j", argv[i])) {
+            ok = ParseUInt(argc, argv, i, config.jitter);
+        } else if (0 == strcmp("-d", argv[i])) {
+            ok = ParseUInt(argc, argv, i, config.dropPercent);
+        } else if (0 == strcmp("-e", argv[i])) {
+            ok = ParseUInt(argc, argv, i, config.errorPercent);
+        } else if (0 == strcmp("-f", argv[i])) {
+            ok = ParseUInt(argc, argv, i, config.faultPercent);
+        } else if ((0 == strcmp("-p", argv[i])) && ((i + 1) < argc)) {
+            config.lampIdPrefix = argv[++i];
+        } else if ((0 == strcmp("-k", argv[i])) && ((i + 1) < argc)) {
+            config.keyStoreFile = argv[++i];
+        } else if ((0 == strcmp("-s", argv[i])) && ((i + 1) < argc)) {
+            config.statisticsFile = argv[++i];
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            usage(argv);
+            return 1;
+        }
+    }
+
+    AJInitializer ajInitializer;
+    if (ajInitializer.Initialize() != ER_OK) {
+        return -1;
+    }
+
+    signal(SIGINT, SigIntHandler);
+
+    pthread_key_create(&currentLampKey, NULL);
+
+    methodCallsStatistic = statistics.Register("LampFleet.MethodCalls", LSF_STATISTIC_COUNTER);
+    droppedCallsStatistic = statistics.Register("LampFleet.DroppedCalls", LSF_STATISTIC_COUNTER);
+    errorRepliesStatistic = statistics.Register("LampFleet.ErrorReplies", LSF_STATISTIC_COUNTER);
+    stateChangesStatistic = statistics.Register("LampFleet.StateChangedSignals", LSF_STATISTIC_COUNTER);
+    getAllCallsStatistic = statistics.Register("LampFleet.GetAllCalls", LSF_STATISTIC_COUNTER);
+    sessionsStatistic = statistics.Register("LampFleet.Sessions", LSF_STATISTIC_GAUGE);
+
+    LSFKeyListener keyListener;
+    ReplyScheduler scheduler(config);
+
+    std::vector<LampHost*> hosts;
+    for (uint32_t i = 0; (i < config.numBuses) && g_running; i++) {
+        LampHost* host = new LampHost(config, i, keyListener, scheduler);
+        if (host->Start() != ER_OK) {
+            delete host;
+            break;
+        }
+        hosts.push_back(host);
+    }
+
+    std::vector<VirtualLamp*> lamps;
+    lamps.reserve(config.numLamps);
+    for (uint32_t i = 0; (i < config.numLamps) && !hosts.empty() && g_running; i++) {
+        VirtualLamp* lamp = new VirtualLamp(config, i);
+        if (hosts[i % hosts.size()]->AddLamp(*lamp) != ER_OK) {
+            delete lamp;
+            break;
+        }
+        lamps.push_back(lamp);
+        if (((i + 1) % 100) == 0) {
+            printf("Started %u lamps\n", i + 1);
+            fflush(stdout);
+        }
+    }
+    printf("Running %u lamps on %u bus attachments\n", static_cast<uint32_t>(lamps.size()), static_cast<uint32_t>(hosts.size()));
+
+    for (uint32_t tick = 1; g_running; tick++) {
+        sleep(1);
+        if (!config.statisticsFile.empty()) {
+            statistics.DumpToFile(config.statisticsFile);
+        }
+        if ((tick % 5) == 0) {
+            printf("sessions=%lld methodCalls=%lld dropped=%lld errors=%lld stateChanges=%lld getAll=%lld\n",
+                   static_cast<long long>(sessionsStatistic->GetValue()), static_cast<long long>(methodCallsStatistic->GetValue()),
+                   static_cast<long long>(droppedCallsStatistic->GetValue()), static_cast<long long>(errorRepliesStatistic->GetValue()),
+                   static_cast<long long>(stateChangesStatistic->GetValue()), static_cast<long long>(getAllCallsStatistic->GetValue()));
+            fflush(stdout);
+        }
+    }
+
+    scheduler.Stop();
+
+    for (std::vector<LampHost*>::iterator it = hosts.begin(); it != hosts.end(); ++it) {
+        delete *it;
+    }
+    hosts.clear();
+
+    for (std::vector<VirtualLamp*>::iterator it = lamps.begin(); it != lamps.end(); ++it) {
+        delete *it;
+    }
+    lamps.clear();
+
+    pthread_key_delete(currentLampKey);
+
+    return 0;
+}
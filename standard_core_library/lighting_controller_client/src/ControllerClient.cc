@@ -15,6 +15,7 @@
  ******************************************************************************/
 
 #include <algorithm>
+#include <string.h>
 #include <alljoyn/Status.h>
 #include <qcc/Debug.h>
 
@@ -515,6 +516,52 @@ void ControllerClient::StateChangedSignalDispatcher(const ajn::InterfaceDescript
         return;
     }
 
+    if (0 == strcmp(message->GetMemberName(), "LampsStateChanged")) {
+        /*
+         * The batched form of LampStateChanged. Each element is delivered to the
+         * LampStateChanged handler so applications see no difference
+         */
+        StateChangedSignalDispatcherMap::iterator it = stateChangedSignalHandlers.find("LampStateChanged");
+        if (it != stateChangedSignalHandlers.end()) {
+            StateChangedSignalHandlerBase* handler = it->second;
+
+            size_t numInputArgs;
+            const MsgArg* inputArgs;
+            message->GetArgs(numInputArgs, inputArgs);
+
+            if (CheckNumArgsInMessage(numInputArgs, 1) != LSF_OK) {
+                return;
+            }
+
+            MsgArg* elems = NULL;
+            size_t numElems = 0;
+            QStatus status = inputArgs[0].Get("a(sa{sv})", &numElems, &elems);
+            if (status != ER_OK) {
+                QCC_LogError(status, ("%s: Invalid LampsStateChanged signal", __func__));
+                return;
+            }
+
+            for (size_t i = 0; i < numElems; ++i) {
+                char* id = NULL;
+                MsgArg* stateArgs = NULL;
+                size_t stateArgsSize = 0;
+                if (elems[i].Get("(sa{sv})", &id, &stateArgsSize, &stateArgs) != ER_OK) {
+                    QCC_LogError(ER_FAIL, ("%s: Skipping invalid LampsStateChanged element", __func__));
+                    continue;
+                }
+
+                MsgArg stateArg;
+                stateArg.Set("a{sv}", stateArgsSize, stateArgs);
+                LampState state(stateArg);
+
+                LSFString lampId = LSFString(id);
+
+                handler->Handle(lampId, state);
+            }
+        }
+        return;
+    }
+
     StateChangedSignalDispatcherMap::iterator it = stateChangedSignalHandlers.find(message->GetMemberName());
     if (it != stateChangedSignalHandlers.end()) {
         StateChangedSignalHandlerBase* handler = it->second;
@@ -1306,8 +1353,10 @@ void ControllerClient::AddMethodHandlers()
         AddMethodReplyWithResponseCodeAndIDHandler("TransitionLampGroupStateToPreset", lampGroupManagerPtr, &LampGroupManager::TransitionLampGroupStateToPresetReply);
         AddMethodReplyWithResponseCodeAndIDHandler("CreateLampGroup", lampGroupManagerPtr, &LampGroupManager::CreateLampGroupReply);
         AddMethodReplyWithResponseCodeIDAndTrackingIDHandler("CreateLampGroup", lampGroupManagerPtr, &LampGroupManager::CreateLampGroupWithTrackingReply);
+        AddMethodReplyWithResponseCodeAndListOfIDsHandler("CreateLampGroups", lampGroupManagerPtr, &LampGroupManager::CreateLampGroupsReply);
         AddMethodReplyWithResponseCodeAndIDHandler("UpdateLampGroup", lampGroupManagerPtr, &LampGroupManager::UpdateLampGroupReply);
         AddMethodReplyWithResponseCodeAndIDHandler("DeleteLampGroup", lampGroupManagerPtr, &LampGroupManager::DeleteLampGroupReply);
+        AddMethodReplyWithResponseCodeAndListOfIDsHandler("DeleteLampGroups", lampGroupManagerPtr, &LampGroupManager::DeleteLampGroupsReply);
 
         AddMethodReplyWithResponseCodeAndIDHandler("PulseLampGroupWithState", lampGroupManagerPtr, &LampGroupManager::PulseLampGroupWithStateReply);
         AddMethodReplyWithResponseCodeAndIDHandler("PulseLampGroupWithPreset", lampGroupManagerPtr, &LampGroupManager::PulseLampGroupWithPresetReply);
@@ -1328,7 +1377,10 @@ void ControllerClient::AddMethodHandlers()
         AddMethodReplyWithResponseCodeAndIDHandler("CreatePreset", presetManagerPtr, &PresetManager::CreatePresetReply);
         AddMethodReplyWithResponseCodeIDAndTrackingIDHandler("CreatePreset", presetManagerPtr, &PresetManager::CreatePresetWithTrackingReply);
         AddMethodReplyWithResponseCodeAndIDHandler("UpdatePreset", presetManagerPtr, &PresetManager::UpdatePresetReply);
+        AddMethodReplyWithResponseCodeAndListOfIDsHandler("CreatePresets", presetManagerPtr, &PresetManager::CreatePresetsReply);
+        AddMethodReplyWithResponseCodeAndListOfIDsHandler("UpdatePresets", presetManagerPtr, &PresetManager::UpdatePresetsReply);
         AddMethodReplyWithResponseCodeAndIDHandler("DeletePreset", presetManagerPtr, &PresetManager::DeletePresetReply);
+        AddMethodReplyWithResponseCodeAndListOfIDsHandler("DeletePresets", presetManagerPtr, &PresetManager::DeletePresetsReply);
 
         AddMethodReplyWithUint32ValueHandler("SetDefaultLampState", presetManagerPtr, &PresetManager::SetDefaultLampStateReply);
     }
@@ -1380,9 +1432,11 @@ void ControllerClient::AddMethodHandlers()
         AddMethodReplyWithResponseCodeAndIDHandler("CreateScene", sceneManagerPtr, &SceneManager::CreateSceneReply);
         AddMethodReplyWithResponseCodeIDAndTrackingIDHandler("CreateScene", sceneManagerPtr, &SceneManager::CreateSceneWithTrackingReply);
         AddMethodReplyWithResponseCodeIDAndTrackingIDHandler("CreateSceneWithSceneElements", sceneManagerPtr, &SceneManager::CreateSceneWithSceneElementsReply);
+        AddMethodReplyWithResponseCodeAndListOfIDsHandler("CreateScenesWithSceneElements", sceneManagerPtr, &SceneManager::CreateScenesWithSceneElementsReply);
         AddMethodReplyWithResponseCodeAndIDHandler("UpdateScene", sceneManagerPtr, &SceneManager::UpdateSceneReply);
         AddMethodReplyWithResponseCodeAndIDHandler("UpdateSceneWithSceneElements", sceneManagerPtr, &SceneManager::UpdateSceneWithSceneElementsReply);
         AddMethodReplyWithResponseCodeAndIDHandler("DeleteScene", sceneManagerPtr, &SceneManager::DeleteSceneReply);
+        AddMethodReplyWithResponseCodeAndListOfIDsHandler("DeleteScenes", sceneManagerPtr, &SceneManager::DeleteScenesReply);
         AddMethodReplyWithResponseCodeAndIDHandler("ApplyScene", sceneManagerPtr, &SceneManager::ApplySceneReply);
     }
 
@@ -1399,8 +1453,10 @@ void ControllerClient::AddMethodHandlers()
 
         AddMethodReplyWithResponseCodeIDAndNameHandler("SetSceneElementName", sceneElementManagerPtr, &SceneElementManager::SetSceneElementNameReply);
         AddMethodReplyWithResponseCodeIDAndTrackingIDHandler("CreateSceneElement", sceneElementManagerPtr, &SceneElementManager::CreateSceneElementReply);
+        AddMethodReplyWithResponseCodeAndListOfIDsHandler("CreateSceneElements", sceneElementManagerPtr, &SceneElementManager::CreateSceneElementsReply);
         AddMethodReplyWithResponseCodeAndIDHandler("UpdateSceneElement", sceneElementManagerPtr, &SceneElementManager::UpdateSceneElementReply);
         AddMethodReplyWithResponseCodeAndIDHandler("DeleteSceneElement", sceneElementManagerPtr, &SceneElementManager::DeleteSceneElementReply);
+        AddMethodReplyWithResponseCodeAndListOfIDsHandler("DeleteSceneElements", sceneElementManagerPtr, &SceneElementManager::DeleteSceneElementsReply);
         AddMethodReplyWithResponseCodeAndIDHandler("ApplySceneElement", sceneElementManagerPtr, &SceneElementManager::ApplySceneElementReply);
     }
 
@@ -1474,6 +1530,18 @@ void ControllerClient::AddSignalHandlers()
             ControllerServiceObjectPath);
     }
 
+    /*
+     * Only present in version 2 or later of the Lamp interface
+     */
+    const InterfaceDescription::Member* lampsStateChangedSignal = controllerServiceLampInterface->GetMember("LampsStateChanged");
+    if (lampsStateChangedSignal) {
+        bus.RegisterSignalHandler(
+            this,
+            static_cast<MessageReceiver::SignalHandler>(&ControllerClient::StateChangedSignalDispatcher),
+            lampsStateChangedSignal,
+            ControllerServiceObjectPath);
+    }
+
     if (controllerServiceTransitionEffectInterface && controllerServicePulseEffectInterface && controllerServiceSceneElementInterface) {
         const SignalEntry additionalSignalEntries[] = {
             { controllerServiceTransitionEffectInterface->GetMember("TransitionEffectsNameChanged"), static_cast<MessageReceiver::SignalHandler>(&ControllerClient::SignalWithArgDispatcher) },
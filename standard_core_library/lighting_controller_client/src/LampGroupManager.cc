@@ -101,6 +101,58 @@ ControllerClientStatus LampGroupManager::CreateLampGroupWithTracking(uint32_t& t
                4);
 }
 
+ControllerClientStatus LampGroupManager::CreateLampGroups(const std::list<LampGroup>& lampGroups, const LSFStringList& lampGroupNames, const LSFString& language)
+{
+    QCC_DbgPrintf(("%s: numLampGroups=%u", __func__, lampGroups.size()));
+
+    size_t numLampGroups = lampGroups.size();
+    if ((numLampGroups == 0) || (numLampGroups != lampGroupNames.size())) {
+        QCC_LogError(ER_BAD_ARG_1, ("%s: Need one name per Lamp Group", __func__));
+        return CONTROLLER_CLIENT_ERR_FAILURE;
+    }
+
+    MsgArg* groupArray = new MsgArg[numLampGroups];
+    size_t i = 0;
+    LSFStringList::const_iterator nameIt = lampGroupNames.begin();
+    for (std::list<LampGroup>::const_iterator it = lampGroups.begin(); it != lampGroups.end(); it++, nameIt++, i++) {
+        size_t numLamps = it->lamps.size();
+        const char** lampList = NULL;
+        if (numLamps) {
+            lampList = new const char*[numLamps];
+            size_t j = 0;
+            for (LSFStringList::const_iterator nit = it->lamps.begin(); nit != it->lamps.end(); nit++) {
+                lampList[j++] = nit->c_str();
+            }
+        }
+
+        size_t numGroups = it->lampGroups.size();
+        const char** lampGroupList = NULL;
+        if (numGroups) {
+            lampGroupList = new const char*[numGroups];
+            size_t j = 0;
+            for (LSFStringList::const_iterator nit = it->lampGroups.begin(); nit != it->lampGroups.end(); nit++) {
+                lampGroupList[j++] = nit->c_str();
+            }
+        }
+
+        groupArray[i].Set("(asass)", numLamps, lampList, numGroups, lampGroupList, nameIt->c_str());
+        delete [] lampList;
+        delete [] lampGroupList;
+        groupArray[i].SetOwnershipFlags(MsgArg::OwnsArgs, true);
+    }
+
+    MsgArg args[2];
+    args[0].Set("a(asass)", numLampGroups, groupArray);
+    args[0].SetOwnershipFlags(MsgArg::OwnsArgs, true);
+    args[1].Set("s", language.c_str());
+
+    return controllerClient.MethodCallAsyncForReplyWithResponseCodeAndListOfIDs(
+               ControllerServiceLampGroupInterfaceName,
+               "CreateLampGroups",
+               args,
+               2);
+}
+
 ControllerClientStatus LampGroupManager::UpdateLampGroup(const LSFString& lampGroupID, const LampGroup& lampGroup)
 {
     QCC_DbgPrintf(("%s: lampGroupID=%s", __func__, lampGroupID.c_str()));
@@ -161,6 +213,34 @@ ControllerClientStatus LampGroupManager::DeleteLampGroup(const LSFString& lampGr
                1);
 }
 
+ControllerClientStatus LampGroupManager::DeleteLampGroups(const LSFStringList& lampGroupIDs)
+{
+    QCC_DbgPrintf(("%s: numLampGroups=%u", __func__, lampGroupIDs.size()));
+
+    size_t idsVecSize = lampGroupIDs.size();
+    if (idsVecSize == 0) {
+        QCC_LogError(ER_BAD_ARG_1, ("%s: Size of lampGroupIDs list is 0", __func__));
+        return CONTROLLER_CLIENT_ERR_FAILURE;
+    }
+
+    const char** idsVec = new const char*[idsVecSize];
+    size_t i = 0;
+    for (LSFStringList::const_iterator it = lampGroupIDs.begin(); it != lampGroupIDs.end(); it++) {
+        idsVec[i++] = it->c_str();
+    }
+
+    MsgArg arg;
+    arg.Set("as", idsVecSize, idsVec);
+    delete [] idsVec;
+    arg.SetOwnershipFlags(MsgArg::OwnsArgs);
+
+    return controllerClient.MethodCallAsyncForReplyWithResponseCodeAndListOfIDs(
+               ControllerServiceLampGroupInterfaceName,
+               "DeleteLampGroups",
+               &arg,
+               1);
+}
+
 ControllerClientStatus LampGroupManager::ResetLampGroupState(const LSFString& lampGroupID)
 {
     QCC_DbgPrintf(("%s: lampGroupID=%s", __func__, lampGroupID.c_str()));
@@ -402,6 +482,11 @@ void LampGroupManager::CreateLampGroupWithTrackingReply(LSFResponseCode& respons
     callback.CreateLampGroupWithTrackingReplyCB(responseCode, lsfId, trackingID);
 }
 
+void LampGroupManager::CreateLampGroupsReply(LSFResponseCode& responseCode, LSFStringList& idList) {
+    QCC_DbgTrace(("%s", __func__));
+    callback.CreateLampGroupsReplyCB(responseCode, idList);
+}
+
 void LampGroupManager::UpdateLampGroupReply(LSFResponseCode& responseCode, LSFString& lsfId) {
     QCC_DbgTrace(("%s", __func__));
     callback.UpdateLampGroupReplyCB(responseCode, lsfId);
@@ -412,6 +497,11 @@ void LampGroupManager::DeleteLampGroupReply(LSFResponseCode& responseCode, LSFSt
     callback.DeleteLampGroupReplyCB(responseCode, lsfId);
 }
 
+void LampGroupManager::DeleteLampGroupsReply(LSFResponseCode& responseCode, LSFStringList& idList) {
+    QCC_DbgTrace(("%s", __func__));
+    callback.DeleteLampGroupsReplyCB(responseCode, idList);
+}
+
 void LampGroupManager::ResetLampGroupStateReply(LSFResponseCode& responseCode, LSFString& lsfId) {
     QCC_DbgTrace(("%s", __func__));
     callback.ResetLampGroupStateReplyCB(responseCode, lsfId);
@@ -134,6 +134,43 @@ ControllerClientStatus PresetManager::CreatePresetWithTracking(uint32_t& trackin
                3);
 }
 
+ControllerClientStatus PresetManager::CreatePresets(const std::list<LampState>& presets, const LSFStringList& presetNames, const LSFString& language)
+{
+    QCC_DbgPrintf(("%s: numPresets=%u", __func__, presets.size()));
+
+    size_t numPresets = presets.size();
+    if ((numPresets == 0) || (numPresets != presetNames.size())) {
+        QCC_LogError(ER_BAD_ARG_1, ("%s: Need one name per preset", __func__));
+        return CONTROLLER_CLIENT_ERR_FAILURE;
+    }
+
+    MsgArg* presetArray = new MsgArg[numPresets];
+    size_t i = 0;
+    LSFStringList::const_iterator nameIt = presetNames.begin();
+    for (std::list<LampState>::const_iterator it = presets.begin(); it != presets.end(); it++, nameIt++, i++) {
+        size_t stateArgsSize;
+        MsgArg* stateArgs;
+        MsgArg stateArg;
+
+        it->Get(&stateArg);
+        stateArg.Get("a{sv}", &stateArgsSize, &stateArgs);
+
+        presetArray[i].Set("(a{sv}s)", stateArgsSize, stateArgs, nameIt->c_str());
+        presetArray[i].SetOwnershipFlags(MsgArg::OwnsArgs, true);
+    }
+
+    MsgArg args[2];
+    args[0].Set("a(a{sv}s)", numPresets, presetArray);
+    args[0].SetOwnershipFlags(MsgArg::OwnsArgs, true);
+    args[1].Set("s", language.c_str());
+
+    return controllerClient.MethodCallAsyncForReplyWithResponseCodeAndListOfIDs(
+               ControllerServicePresetInterfaceName,
+               "CreatePresets",
+               args,
+               2);
+}
+
 ControllerClientStatus PresetManager::UpdatePreset(const LSFString& presetID, const LampState& preset)
 {
     //QCC_DbgPrintf(("%s: presetID=%s preset=%s", __func__, presetID.c_str(), preset.c_str()));
@@ -148,6 +185,42 @@ ControllerClientStatus PresetManager::UpdatePreset(const LSFString& presetID, co
                2);
 }
 
+ControllerClientStatus PresetManager::UpdatePresets(const LSFStringList& presetIDs, const std::list<LampState>& presets)
+{
+    QCC_DbgPrintf(("%s: numPresets=%u", __func__, presets.size()));
+
+    size_t numPresets = presets.size();
+    if ((numPresets == 0) || (numPresets != presetIDs.size())) {
+        QCC_LogError(ER_BAD_ARG_1, ("%s: Need one state per preset", __func__));
+        return CONTROLLER_CLIENT_ERR_FAILURE;
+    }
+
+    MsgArg* presetArray = new MsgArg[numPresets];
+    size_t i = 0;
+    LSFStringList::const_iterator idIt = presetIDs.begin();
+    for (std::list<LampState>::const_iterator it = presets.begin(); it != presets.end(); it++, idIt++, i++) {
+        size_t stateArgsSize;
+        MsgArg* stateArgs;
+        MsgArg stateArg;
+
+        it->Get(&stateArg);
+        stateArg.Get("a{sv}", &stateArgsSize, &stateArgs);
+
+        presetArray[i].Set("(sa{sv})", idIt->c_str(), stateArgsSize, stateArgs);
+        presetArray[i].SetOwnershipFlags(MsgArg::OwnsArgs, true);
+    }
+
+    MsgArg arg;
+    arg.Set("a(sa{sv})", numPresets, presetArray);
+    arg.SetOwnershipFlags(MsgArg::OwnsArgs, true);
+
+    return controllerClient.MethodCallAsyncForReplyWithResponseCodeAndListOfIDs(
+               ControllerServicePresetInterfaceName,
+               "UpdatePresets",
+               &arg,
+               1);
+}
+
 ControllerClientStatus PresetManager::DeletePreset(const LSFString& presetID)
 {
     QCC_DbgPrintf(("%s: presetID=%s", __func__, presetID.c_str()));
@@ -161,6 +234,34 @@ ControllerClientStatus PresetManager::DeletePreset(const LSFString& presetID)
                1);
 }
 
+ControllerClientStatus PresetManager::DeletePresets(const LSFStringList& presetIDs)
+{
+    QCC_DbgPrintf(("%s: numPresets=%u", __func__, presetIDs.size()));
+
+    size_t idsVecSize = presetIDs.size();
+    if (idsVecSize == 0) {
+        QCC_LogError(ER_BAD_ARG_1, ("%s: Size of presetIDs list is 0", __func__));
+        return CONTROLLER_CLIENT_ERR_FAILURE;
+    }
+
+    const char** idsVec = new const char*[idsVecSize];
+    size_t i = 0;
+    for (LSFStringList::const_iterator it = presetIDs.begin(); it != presetIDs.end(); it++) {
+        idsVec[i++] = it->c_str();
+    }
+
+    MsgArg arg;
+    arg.Set("as", idsVecSize, idsVec);
+    delete [] idsVec;
+    arg.SetOwnershipFlags(MsgArg::OwnsArgs);
+
+    return controllerClient.MethodCallAsyncForReplyWithResponseCodeAndListOfIDs(
+               ControllerServicePresetInterfaceName,
+               "DeletePresets",
+               &arg,
+               1);
+}
+
 ControllerClientStatus PresetManager::GetDefaultLampState(void)
 {
     QCC_DbgPrintf(("%s", __func__));
@@ -86,6 +86,58 @@ ControllerClientStatus SceneElementManager::CreateSceneElement(uint32_t& trackin
                5);
 }
 
+ControllerClientStatus SceneElementManager::CreateSceneElements(const std::list<SceneElement>& sceneElements, const LSFStringList& sceneElementNames, const LSFString& language)
+{
+    QCC_DbgPrintf(("%s: numSceneElements=%u", __func__, sceneElements.size()));
+
+    size_t numSceneElements = sceneElements.size();
+    if ((numSceneElements == 0) || (numSceneElements != sceneElementNames.size())) {
+        QCC_LogError(ER_BAD_ARG_1, ("%s: Need one name per SceneElement", __func__));
+        return CONTROLLER_CLIENT_ERR_FAILURE;
+    }
+
+    MsgArg* elementArray = new MsgArg[numSceneElements];
+    size_t i = 0;
+    LSFStringList::const_iterator nameIt = sceneElementNames.begin();
+    for (std::list<SceneElement>::const_iterator it = sceneElements.begin(); it != sceneElements.end(); it++, nameIt++, i++) {
+        size_t numLamps = it->lamps.size();
+        const char** lampList = NULL;
+        if (numLamps) {
+            lampList = new const char*[numLamps];
+            size_t j = 0;
+            for (LSFStringList::const_iterator nit = it->lamps.begin(); nit != it->lamps.end(); nit++) {
+                lampList[j++] = nit->c_str();
+            }
+        }
+
+        size_t numGroups = it->lampGroups.size();
+        const char** lampGroupList = NULL;
+        if (numGroups) {
+            lampGroupList = new const char*[numGroups];
+            size_t j = 0;
+            for (LSFStringList::const_iterator nit = it->lampGroups.begin(); nit != it->lampGroups.end(); nit++) {
+                lampGroupList[j++] = nit->c_str();
+            }
+        }
+
+        elementArray[i].Set("(asasss)", numLamps, lampList, numGroups, lampGroupList, it->effectID.c_str(), nameIt->c_str());
+        delete [] lampList;
+        delete [] lampGroupList;
+        elementArray[i].SetOwnershipFlags(MsgArg::OwnsArgs, true);
+    }
+
+    MsgArg args[2];
+    args[0].Set("a(asasss)", numSceneElements, elementArray);
+    args[0].SetOwnershipFlags(MsgArg::OwnsArgs, true);
+    args[1].Set("s", language.c_str());
+
+    return controllerClient.MethodCallAsyncForReplyWithResponseCodeAndListOfIDs(
+               ControllerServiceSceneElementInterfaceName,
+               "CreateSceneElements",
+               args,
+               2);
+}
+
 ControllerClientStatus SceneElementManager::UpdateSceneElement(const LSFString& sceneElementID, const SceneElement& sceneElement)
 {
     QCC_DbgPrintf(("%s: sceneElementID=%s", __func__, sceneElementID.c_str()));
@@ -159,6 +211,34 @@ ControllerClientStatus SceneElementManager::DeleteSceneElement(const LSFString&
                1);
 }
 
+ControllerClientStatus SceneElementManager::DeleteSceneElements(const LSFStringList& sceneElementIDs)
+{
+    QCC_DbgPrintf(("%s: numSceneElements=%u", __func__, sceneElementIDs.size()));
+
+    size_t idsVecSize = sceneElementIDs.size();
+    if (idsVecSize == 0) {
+        QCC_LogError(ER_BAD_ARG_1, ("%s: Size of sceneElementIDs list is 0", __func__));
+        return CONTROLLER_CLIENT_ERR_FAILURE;
+    }
+
+    const char** idsVec = new const char*[idsVecSize];
+    size_t i = 0;
+    for (LSFStringList::const_iterator it = sceneElementIDs.begin(); it != sceneElementIDs.end(); it++) {
+        idsVec[i++] = it->c_str();
+    }
+
+    MsgArg arg;
+    arg.Set("as", idsVecSize, idsVec);
+    delete [] idsVec;
+    arg.SetOwnershipFlags(MsgArg::OwnsArgs);
+
+    return controllerClient.MethodCallAsyncForReplyWithResponseCodeAndListOfIDs(
+               ControllerServiceSceneElementInterfaceName,
+               "DeleteSceneElements",
+               &arg,
+               1);
+}
+
 ControllerClientStatus SceneElementManager::GetSceneElementDataSet(const LSFString& sceneElementID, const LSFString& language)
 {
     ControllerClientStatus status = CONTROLLER_CLIENT_OK;
@@ -118,6 +118,47 @@ ControllerClientStatus SceneManager::CreateSceneWithSceneElements(uint32_t& trac
                3);
 }
 
+ControllerClientStatus SceneManager::CreateScenesWithSceneElements(const std::list<SceneWithSceneElements>& scenes, const LSFStringList& sceneNames, const LSFString& language)
+{
+    QCC_DbgPrintf(("%s: numScenes=%u", __func__, scenes.size()));
+
+    size_t numScenes = scenes.size();
+    if ((numScenes == 0) || (numScenes != sceneNames.size())) {
+        QCC_LogError(ER_BAD_ARG_1, ("%s: Need one name per Scene", __func__));
+        return CONTROLLER_CLIENT_ERR_FAILURE;
+    }
+
+    MsgArg* sceneArray = new MsgArg[numScenes];
+    size_t i = 0;
+    LSFStringList::const_iterator nameIt = sceneNames.begin();
+    for (std::list<SceneWithSceneElements>::const_iterator it = scenes.begin(); it != scenes.end(); it++, nameIt++, i++) {
+        size_t numSceneElements = it->sceneElements.size();
+        const char** sceneElementList = NULL;
+        if (numSceneElements) {
+            sceneElementList = new const char*[numSceneElements];
+            size_t j = 0;
+            for (LSFStringList::const_iterator nit = it->sceneElements.begin(); nit != it->sceneElements.end(); nit++) {
+                sceneElementList[j++] = nit->c_str();
+            }
+        }
+
+        sceneArray[i].Set("(ass)", numSceneElements, sceneElementList, nameIt->c_str());
+        delete [] sceneElementList;
+        sceneArray[i].SetOwnershipFlags(MsgArg::OwnsArgs, true);
+    }
+
+    MsgArg args[2];
+    args[0].Set("a(ass)", numScenes, sceneArray);
+    args[0].SetOwnershipFlags(MsgArg::OwnsArgs, true);
+    args[1].Set("s", language.c_str());
+
+    return controllerClient.MethodCallAsyncForReplyWithResponseCodeAndListOfIDs(
+               ControllerServiceSceneWithSceneElementsInterfaceName,
+               "CreateScenesWithSceneElements",
+               args,
+               2);
+}
+
 ControllerClientStatus SceneManager::UpdateScene(const LSFString& sceneID, const Scene& scene)
 {
     QCC_DbgPrintf(("%s: sceneID=%s", __func__, sceneID.c_str()));
@@ -238,6 +279,34 @@ ControllerClientStatus SceneManager::DeleteScene(const LSFString& sceneID)
                1);
 }
 
+ControllerClientStatus SceneManager::DeleteScenes(const LSFStringList& sceneIDs)
+{
+    QCC_DbgPrintf(("%s: numScenes=%u", __func__, sceneIDs.size()));
+
+    size_t idsVecSize = sceneIDs.size();
+    if (idsVecSize == 0) {
+        QCC_LogError(ER_BAD_ARG_1, ("%s: Size of sceneIDs list is 0", __func__));
+        return CONTROLLER_CLIENT_ERR_FAILURE;
+    }
+
+    const char** idsVec = new const char*[idsVecSize];
+    size_t i = 0;
+    for (LSFStringList::const_iterator it = sceneIDs.begin(); it != sceneIDs.end(); it++) {
+        idsVec[i++] = it->c_str();
+    }
+
+    MsgArg arg;
+    arg.Set("as", idsVecSize, idsVec);
+    delete [] idsVec;
+    arg.SetOwnershipFlags(MsgArg::OwnsArgs);
+
+    return controllerClient.MethodCallAsyncForReplyWithResponseCodeAndListOfIDs(
+               ControllerServiceSceneInterfaceName,
+               "DeleteScenes",
+               &arg,
+               1);
+}
+
 ControllerClientStatus SceneManager::GetSceneDataSet(const LSFString& sceneID, const LSFString& language)
 {
     ControllerClientStatus status = CONTROLLER_CLIENT_OK;
@@ -0,0 +1,116 @@
+/******************************************************************************
+ *
+ *
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <BlobCompression.h>
+
+#include <stdlib.h>
+#include <string>
+
+/* Header files included for Google Test Framework */
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace lsf;
+#ifdef LSF_BINDINGS
+using namespace controllerservice;
+#endif
+
+static string RandomBytes(size_t len, int alphabet)
+{
+    string bytes;
+    for (size_t i = 0; i < len; i++) {
+        bytes.push_back((char) (rand() % alphabet));
+    }
+    return bytes;
+}
+
+/*
+ * Compress the blob, decompress the result and expect the original back
+ */
+static void ExpectRoundTrip(const string& blob)
+{
+    string compressed;
+    CompressBlob(blob, compressed);
+
+    string decompressed;
+    EXPECT_TRUE(DecompressBlob((const uint8_t*) compressed.data(), compressed.size(), blob.size(), decompressed));
+    EXPECT_TRUE(decompressed == blob) << "round trip of " << blob.size() << " bytes failed";
+}
+
+/*
+ * A blob shaped like the persistent store files
+ */
+static string StoreBlob(size_t numEntries)
+{
+    string blob;
+    char line[128];
+    for (size_t i = 0; i < numEntries; i++) {
+        snprintf(line, sizeof(line), "Preset PRESET_%u \"Preset %u\" 0 1 %u 100 2700 %u\n", (unsigned) i, (unsigned) i, (unsigned) (i * 37), (unsigned) (i * 7));
+        blob.append(line);
+    }
+    return blob;
+}
+
+TEST(BlobCompressionTest, RoundTripEmpty) {
+    ExpectRoundTrip(string());
+}
+
+TEST(BlobCompressionTest, RoundTripShort) {
+    for (size_t len = 1; len <= 64; len++) {
+        ExpectRoundTrip(RandomBytes(len, 4));
+    }
+}
+
+TEST(BlobCompressionTest, RoundTripRepetitive) {
+    ExpectRoundTrip(string(1, 'a'));
+    ExpectRoundTrip(string(4, 'a'));
+    ExpectRoundTrip(string(100000, 'a'));
+
+    string pattern;
+    for (size_t i = 0; i < 10000; i++) {
+        pattern.append("LampGroup ");
+    }
+    ExpectRoundTrip(pattern);
+}
+
+TEST(BlobCompressionTest, RoundTripRandom) {
+    srand(12345);
+    ExpectRoundTrip(RandomBytes(1000, 256));
+    ExpectRoundTrip(RandomBytes(70000, 256));
+    ExpectRoundTrip(RandomBytes(70000, 3));
+}
+
+TEST(BlobCompressionTest, RoundTripStoreBlob) {
+    string blob = StoreBlob(5000);
+    string compressed;
+    CompressBlob(blob, compressed);
+    EXPECT_LT(compressed.size(), blob.size());
+
+    ExpectRoundTrip(blob);
+}
+
+TEST(BlobCompressionTest, RejectMalformed) {
+    string blob = StoreBlob(100);
+    string compressed;
+    CompressBlob(blob, compressed);
+
+    string decompressed;
+    EXPECT_FALSE(DecompressBlob((const uint8_t*) compressed.data(), compressed.size() / 2, blob.size(), decompressed));
+    EXPECT_FALSE(DecompressBlob((const uint8_t*) compressed.data(), compressed.size(), blob.size() - 1, decompressed));
+    EXPECT_FALSE(DecompressBlob((const uint8_t*) compressed.data(), compressed.size(), blob.size() + 1, decompressed));
+}
@@ -0,0 +1,211 @@
+/******************************************************************************
+ *
+ *
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include "TestControllerService.h"
+
+#include <Manager.h>
+#include <LampGroupManager.h>
+#include <FileParser.h>
+#include <OEM_CS_Config.h>
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <new>
+#include <sstream>
+#include <string>
+
+#include <alljoyn/MsgArg.h>
+
+/* Header files included for Google Test Framework */
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace lsf;
+using namespace ajn;
+#ifdef LSF_BINDINGS
+using namespace controllerservice;
+#endif
+
+/*
+ * The exception specifications of the replaced allocation functions must
+ * match the ones in <new>, which differ between C++03 and C++11
+ */
+#if __cplusplus < 201103L
+#define BLOB_COPY_TEST_NEW_THROWS throw (std::bad_alloc)
+#define BLOB_COPY_TEST_DELETE_THROWS throw ()
+#else
+#define BLOB_COPY_TEST_NEW_THROWS
+#define BLOB_COPY_TEST_DELETE_THROWS noexcept
+#endif
+
+/*
+ * Copies of a blob are counted as the allocations made by the test thread
+ * that are at least half the size of the blob. The tokens and entities
+ * parsed from a blob are far smaller than that. Other threads of the
+ * Controller Service may allocate at any time, so the counters are only
+ * updated for the thread that started counting, under a lock that needs
+ * no construction as allocations happen before main
+ */
+static pthread_mutex_t allocationLock = PTHREAD_MUTEX_INITIALIZER;
+static bool counting = false;
+static pthread_t countingThread;
+static size_t copyThreshold = 0;
+static uint32_t numCopies = 0;
+
+static void StartCountingCopies(const string& blob)
+{
+    pthread_mutex_lock(&allocationLock);
+    counting = true;
+    countingThread = pthread_self();
+    copyThreshold = blob.size() / 2;
+    numCopies = 0;
+    pthread_mutex_unlock(&allocationLock);
+}
+
+static uint32_t StopCountingCopies(void)
+{
+    pthread_mutex_lock(&allocationLock);
+    counting = false;
+    uint32_t copies = numCopies;
+    pthread_mutex_unlock(&allocationLock);
+    return copies;
+}
+
+void* operator new(size_t size) BLOB_COPY_TEST_NEW_THROWS
+{
+    void* ptr = malloc(size ? size : 1);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    pthread_mutex_lock(&allocationLock);
+    if (counting && (size >= copyThreshold) && pthread_equal(countingThread, pthread_self())) {
+        numCopies++;
+    }
+    pthread_mutex_unlock(&allocationLock);
+    return ptr;
+}
+
+void* operator new[](size_t size) BLOB_COPY_TEST_NEW_THROWS
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) BLOB_COPY_TEST_DELETE_THROWS
+{
+    free(ptr);
+}
+
+void operator delete[](void* ptr) BLOB_COPY_TEST_DELETE_THROWS
+{
+    free(ptr);
+}
+
+/*
+ * A lamp groups blob as the leader serialises it
+ */
+static string LampGroupsBlob(uint32_t numLampGroups)
+{
+    string blob;
+    for (uint32_t i = 0; i < numLampGroups; i++) {
+        ostringstream id;
+        id << "LAMP_GROUP_" << i;
+        ostringstream lamp;
+        lamp << "LAMP_" << i;
+        LampGroup group;
+        group.lamps.push_back(lamp.str());
+        blob.append(LampGroupManager::GetString("Group", id.str(), group));
+    }
+    return blob;
+}
+
+/*
+ * Read every token of a stream the way ReplaceMap does
+ */
+static size_t ReadTokens(istream& stream)
+{
+    size_t numTokens = 0;
+    while (!ParseString(stream).empty()) {
+        numTokens++;
+    }
+    return numTokens;
+}
+
+/*
+ * The leader copies the serialised blob into a snapshot once. Reading the
+ * snapshot and marshalling it into a signal or reply argument share it
+ */
+TEST(BlobCopyTest, SendSharesTheSnapshot) {
+    const string blob = LampGroupsBlob(1000);
+
+    StartCountingCopies(blob);
+    Manager::BlobSnapshot* snapshot = new Manager::BlobSnapshot(blob, Manager::GetChecksum(blob), 0, 1);
+    EXPECT_EQ(1U, StopCountingCopies());
+
+    StartCountingCopies(blob);
+    snapshot->AddRef();
+    {
+        Manager::BlobSnapshotStream stream;
+        stream.Attach(snapshot);
+        EXPECT_EQ(6000U, ReadTokens(stream));
+    }
+
+    MsgArg arg;
+    arg.Set("s", snapshot->blob.c_str());
+    EXPECT_EQ(snapshot->blob.c_str(), arg.v_string.str);
+    EXPECT_EQ(0U, StopCountingCopies());
+
+    snapshot->Release();
+}
+
+/*
+ * A follower parses the blob in place from the received message buffer
+ */
+TEST(BlobCopyTest, ReceiveParsesInPlace) {
+    const string blob = LampGroupsBlob(1000);
+
+    StartCountingCopies(blob);
+    BlobInputStream stream(blob.data(), blob.size());
+    EXPECT_EQ(6000U, ReadTokens(stream));
+    EXPECT_EQ(0U, StopCountingCopies());
+}
+
+/*
+ * Replacing a store with a received blob does not copy the blob
+ */
+TEST(BlobCopyTest, ReplaceMapParsesInPlace) {
+    ControllerService* controllerService = GetTestControllerService();
+    ASSERT_TRUE(controllerService != NULL);
+
+    const string blob = LampGroupsBlob(OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY);
+    uint32_t checksum = Manager::GetChecksum(blob);
+
+    // A blob is only taken if it is newer than the store
+    usleep(10 * 1000);
+
+    StartCountingCopies(blob);
+    controllerService->GetLampGroupManager().HandleReceivedBlob(blob.data(), blob.size(), checksum, 0);
+    EXPECT_EQ(0U, StopCountingCopies());
+
+    ostringstream exported;
+    EXPECT_EQ(LSF_OK, controllerService->ExportConfigurationAPI(exported));
+    ostringstream lastID;
+    lastID << "LampGroup LAMP_GROUP_" << (OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY - 1) << ' ';
+    EXPECT_NE(string::npos, exported.str().find(lastID.str()));
+}
@@ -0,0 +1,90 @@
+/******************************************************************************
+ *
+ *
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <Manager.h>
+
+#include <stdlib.h>
+#include <string>
+
+/* Header files included for Google Test Framework */
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace lsf;
+#ifdef LSF_BINDINGS
+using namespace controllerservice;
+#endif
+
+/*
+ * Byte at a time Adler-32 as defined in RFC 1950
+ */
+static uint32_t ReferenceAdler32(const string& str)
+{
+    uint32_t a = 1;
+    uint32_t b = 0;
+    for (size_t i = 0; i < str.length(); i++) {
+        a = (a + (uint8_t) str[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+}
+
+static string RandomBytes(size_t len)
+{
+    string bytes;
+    for (size_t i = 0; i < len; i++) {
+        bytes.push_back((char) (rand() % 256));
+    }
+    return bytes;
+}
+
+TEST(ChecksumTest, KnownValues) {
+    EXPECT_EQ(0x00000001U, Manager::GetChecksum(""));
+    EXPECT_EQ(0x11E60398U, Manager::GetChecksum("Wikipedia"));
+}
+
+TEST(ChecksumTest, ShortLengthsAndOffsets) {
+    srand(1950);
+    string buffer = RandomBytes(256);
+    for (size_t len = 0; len <= 200; len++) {
+        for (size_t offset = 0; offset < 32; offset += 7) {
+            string str = buffer.substr(offset, len);
+            EXPECT_EQ(ReferenceAdler32(str), Manager::GetChecksum(str)) << "len " << len << " offset " << offset;
+        }
+    }
+}
+
+TEST(ChecksumTest, LargeRandomLengths) {
+    srand(5552);
+    for (int i = 0; i < 20; i++) {
+        string str = RandomBytes(rand() % 200000);
+        EXPECT_EQ(ReferenceAdler32(str), Manager::GetChecksum(str)) << "len " << str.length();
+    }
+}
+
+/*
+ * All 0xFF bytes maximise the sums, so these lengths around and beyond
+ * the 5552 byte modulo interval catch any overflow of the block sums
+ */
+TEST(ChecksumTest, MaximalBytes) {
+    const size_t lengths[] = { 0, 1, 31, 32, 33, 5551, 5552, 5553, 5552 * 2 + 32, 100000, 1000000 };
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        string str(lengths[i], (char) 0xFF);
+        EXPECT_EQ(ReferenceAdler32(str), Manager::GetChecksum(str)) << "len " << lengths[i];
+    }
+}
@@ -0,0 +1,151 @@
+/******************************************************************************
+ *
+ *
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include "TestControllerService.h"
+
+#include <LSFTypes.h>
+
+#include <unistd.h>
+
+#include <sstream>
+#include <string>
+
+/* Header files included for Google Test Framework */
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace lsf;
+#ifdef LSF_BINDINGS
+using namespace controllerservice;
+#endif
+
+/*
+ * Time to wait for the Controller Service to allow updates
+ */
+#define IMPORT_TEST_START_TIMEOUT_MS 60000
+
+/*
+ * A snapshot with one entity of each kind and every reference resolving.
+ * The suffix is appended to the names, so that snapshots with different
+ * suffixes produce different exports
+ */
+static string Snapshot(const string& suffix)
+{
+    ostringstream stream;
+    stream << "LSFConfiguration 1\n"
+           << "Section LampGroups\n"
+           << "LampGroup LAMP_GROUP_A \"Group A" << suffix << "\" Lamp LAMP_1 EndLampGroup\n"
+           << "LampGroup LAMP_GROUP_B \"Group B" << suffix << "\" Lamp LAMP_2 LampGroup LAMP_GROUP_A EndLampGroup\n"
+           << "EndSection\n"
+           << "Section Presets\n"
+           << "Preset PRESET_A \"Preset A" << suffix << "\" 0 1 10 100 2700 70\n"
+           << "EndSection\n"
+           << "Section TransitionEffects\n"
+           << "TransitionEffect TRANSITION_EFFECT_A \"Transition A" << suffix << "\" 1 0 1 10 100 2700 50 1000\n"
+           << "EndSection\n"
+           << "Section PulseEffects\n"
+           << "PulseEffect PULSE_EFFECT_A \"Pulse A" << suffix << "\" 0 PRESET_A PRESET_A 1000 500 3\n"
+           << "EndSection\n"
+           << "Section SceneElements\n"
+           << "SceneElement SCENE_ELEMENT_A \"Element A" << suffix << "\" Lamp LAMP_1 LampGroup LAMP_GROUP_B Effect TRANSITION_EFFECT_A EndSceneElement\n"
+           << "EndSection\n"
+           << "Section Scenes\n"
+           << "Scene SCENE_A \"Scene A" << suffix << "\"\n\tSceneElements\n\t\t SCENE_ELEMENT_A\n\tEndSceneElements\nEndScene\n"
+           << "EndSection\n"
+           << "Section MasterScenes\n"
+           << "MasterScene MASTER_SCENE_A \"Master Scene A" << suffix << "\" Scene SCENE_A EndMasterScene\n"
+           << "EndSection\n"
+           << "EndLSFConfiguration\n";
+    return stream.str();
+}
+
+/*
+ * Replace the single occurrence of from with to
+ */
+static string Replace(const string& str, const string& from, const string& to)
+{
+    string replaced = str;
+    size_t pos = replaced.find(from);
+    EXPECT_NE(string::npos, pos) << from;
+    if (string::npos != pos) {
+        replaced.replace(pos, from.length(), to);
+    }
+    return replaced;
+}
+
+static LSFResponseCode Import(ControllerService* controllerService, const string& snapshot)
+{
+    istringstream stream(snapshot);
+    return controllerService->ImportConfigurationAPI(stream);
+}
+
+static string Export(ControllerService* controllerService)
+{
+    ostringstream stream;
+    EXPECT_EQ(LSF_OK, controllerService->ExportConfigurationAPI(stream));
+    return stream.str();
+}
+
+/*
+ * Imports a valid snapshot into the shared test Controller Service and
+ * then snapshots that each break one kind of reference. Every broken
+ * import must fail with LSF_ERR_DEPENDENCY and leave all the stores as
+ * they were, even though the rest of the broken snapshot differs from
+ * what is stored
+ */
+TEST(ConfigurationImportTest, DependencyFailureLeavesStoresUntouched) {
+    ControllerService* controllerService = GetTestControllerService();
+    ASSERT_TRUE(controllerService != NULL);
+
+    /*
+     * Updates are refused until the leader election has settled
+     */
+    const string snapshot = Snapshot("");
+    LSFResponseCode responseCode;
+    uint64_t startTimestamp = GetTimestampInMs();
+    do {
+        responseCode = Import(controllerService, snapshot);
+        if (LSF_ERR_BUSY == responseCode) {
+            usleep(100 * 1000);
+        }
+    } while ((LSF_ERR_BUSY == responseCode) && ((GetTimestampInMs() - startTimestamp) < IMPORT_TEST_START_TIMEOUT_MS));
+    EXPECT_EQ(LSF_OK, responseCode);
+
+    const string exported = Export(controllerService);
+
+    const string changed = Snapshot(" changed");
+    const string brokenSnapshots[] = {
+        Replace(changed, "LampGroup LAMP_GROUP_A EndLampGroup", "LampGroup LAMP_GROUP_MISSING EndLampGroup"),
+        Replace(changed, "LampGroup LAMP_GROUP_B Effect", "LampGroup LAMP_GROUP_MISSING Effect"),
+        Replace(changed, "Effect TRANSITION_EFFECT_A", "Effect TRANSITION_EFFECT_MISSING"),
+        Replace(changed, "\t\t SCENE_ELEMENT_A\n", "\t\t SCENE_ELEMENT_MISSING\n"),
+        Replace(changed, "Scene SCENE_A EndMasterScene", "Scene SCENE_MISSING EndMasterScene")
+    };
+
+    for (size_t i = 0; i < sizeof(brokenSnapshots) / sizeof(brokenSnapshots[0]); i++) {
+        EXPECT_EQ(LSF_ERR_DEPENDENCY, Import(controllerService, brokenSnapshots[i])) << "broken snapshot " << i;
+        EXPECT_EQ(exported, Export(controllerService)) << "broken snapshot " << i;
+    }
+
+    /*
+     * The unbroken snapshot imports, so the failures above were down to
+     * the broken references alone
+     */
+    EXPECT_EQ(LSF_OK, Import(controllerService, changed));
+    EXPECT_NE(exported, Export(controllerService));
+}
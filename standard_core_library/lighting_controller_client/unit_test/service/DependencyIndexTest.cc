@@ -0,0 +1,162 @@
+/******************************************************************************
+ *
+ *
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <DependencyIndex.h>
+
+#include <stdlib.h>
+#include <map>
+#include <set>
+#include <sstream>
+
+/* Header files included for Google Test Framework */
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace lsf;
+#ifdef LSF_BINDINGS
+using namespace controllerservice;
+#endif
+
+static LSFStringList List(const char* id1, const char* id2 = NULL, const char* id3 = NULL)
+{
+    LSFStringList list;
+    const char* ids[] = { id1, id2, id3 };
+    for (size_t i = 0; i < 3; i++) {
+        if (ids[i]) {
+            list.push_back(ids[i]);
+        }
+    }
+    return list;
+}
+
+static set<LSFString> Users(const DependencyIndex& index, const LSFString& usedID)
+{
+    LSFStringList userIDs;
+    index.GetUsers(usedID, userIDs);
+    set<LSFString> users(userIDs.begin(), userIDs.end());
+    EXPECT_EQ(users.size(), userIDs.size()) << "a user of " << usedID << " is listed more than once";
+    return users;
+}
+
+TEST(DependencyIndexTest, AddAndRemove) {
+    DependencyIndex index;
+    EXPECT_FALSE(index.IsUsed("LAMP_GROUP_A"));
+
+    index.Add("SCENE_ELEMENT_1", List("LAMP_GROUP_A", "LAMP_GROUP_B"));
+    index.Add("SCENE_ELEMENT_2", "LAMP_GROUP_A");
+    EXPECT_TRUE(index.IsUsed("LAMP_GROUP_A"));
+    EXPECT_TRUE(index.IsUsed("LAMP_GROUP_B"));
+    EXPECT_FALSE(index.IsUsed("LAMP_GROUP_C"));
+    EXPECT_EQ(2U, Users(index, "LAMP_GROUP_A").size());
+    EXPECT_EQ(1U, Users(index, "LAMP_GROUP_B").count("SCENE_ELEMENT_1"));
+
+    index.Remove("SCENE_ELEMENT_1", List("LAMP_GROUP_A", "LAMP_GROUP_B"));
+    EXPECT_TRUE(index.IsUsed("LAMP_GROUP_A"));
+    EXPECT_FALSE(index.IsUsed("LAMP_GROUP_B"));
+    EXPECT_EQ(1U, Users(index, "LAMP_GROUP_A").count("SCENE_ELEMENT_2"));
+
+    index.Remove("SCENE_ELEMENT_2", "LAMP_GROUP_A");
+    EXPECT_FALSE(index.IsUsed("LAMP_GROUP_A"));
+    EXPECT_TRUE(Users(index, "LAMP_GROUP_A").empty());
+}
+
+TEST(DependencyIndexTest, DuplicateReferencesAreCounted) {
+    DependencyIndex index;
+    index.Add("MASTER_SCENE_1", List("SCENE_A", "SCENE_A", "SCENE_B"));
+    EXPECT_EQ(1U, Users(index, "SCENE_A").size());
+
+    index.Remove("MASTER_SCENE_1", "SCENE_A");
+    EXPECT_TRUE(index.IsUsed("SCENE_A"));
+
+    index.Remove("MASTER_SCENE_1", "SCENE_A");
+    EXPECT_FALSE(index.IsUsed("SCENE_A"));
+    EXPECT_TRUE(index.IsUsed("SCENE_B"));
+}
+
+TEST(DependencyIndexTest, RemoveUnknownIsIgnored) {
+    DependencyIndex index;
+    index.Remove("SCENE_ELEMENT_1", "LAMP_GROUP_A");
+    index.Add("SCENE_ELEMENT_1", "LAMP_GROUP_A");
+    index.Remove("SCENE_ELEMENT_2", "LAMP_GROUP_A");
+    index.Remove("SCENE_ELEMENT_1", "LAMP_GROUP_B");
+    EXPECT_TRUE(index.IsUsed("LAMP_GROUP_A"));
+    EXPECT_EQ(1U, Users(index, "LAMP_GROUP_A").count("SCENE_ELEMENT_1"));
+}
+
+TEST(DependencyIndexTest, Clear) {
+    DependencyIndex index;
+    index.Add("SCENE_1", List("SCENE_ELEMENT_A", "SCENE_ELEMENT_B"));
+    index.Clear();
+    EXPECT_FALSE(index.IsUsed("SCENE_ELEMENT_A"));
+    EXPECT_FALSE(index.IsUsed("SCENE_ELEMENT_B"));
+    EXPECT_TRUE(Users(index, "SCENE_ELEMENT_A").empty());
+}
+
+/*
+ * Create, update and delete entities at random the way a manager does,
+ * removing the old references before adding the new ones, and check the
+ * index against a scan of every entity after each step
+ */
+TEST(DependencyIndexTest, MatchesScanAcrossUpdates) {
+    const int NUM_USERS = 20;
+    const int NUM_USED = 10;
+
+    srand(49);
+    DependencyIndex index;
+    map<LSFString, LSFStringList> entities;
+
+    for (int step = 0; step < 2000; step++) {
+        ostringstream userID;
+        userID << "USER_" << (rand() % NUM_USERS);
+
+        map<LSFString, LSFStringList>::iterator it = entities.find(userID.str());
+        if (it != entities.end()) {
+            index.Remove(it->first, it->second);
+            entities.erase(it);
+        }
+
+        if (rand() % 4) {
+            LSFStringList usedIDs;
+            int numUsed = rand() % 4;
+            for (int i = 0; i < numUsed; i++) {
+                ostringstream usedID;
+                usedID << "USED_" << (rand() % NUM_USED);
+                usedIDs.push_back(usedID.str());
+            }
+            index.Add(userID.str(), usedIDs);
+            entities[userID.str()] = usedIDs;
+        }
+
+        for (int used = 0; used < NUM_USED; used++) {
+            ostringstream usedID;
+            usedID << "USED_" << used;
+
+            set<LSFString> expected;
+            for (it = entities.begin(); it != entities.end(); ++it) {
+                for (LSFStringList::const_iterator lit = it->second.begin(); lit != it->second.end(); ++lit) {
+                    if (*lit == usedID.str()) {
+                        expected.insert(it->first);
+                    }
+                }
+            }
+
+            ASSERT_EQ(!expected.empty(), index.IsUsed(usedID.str())) << "step " << step << " " << usedID.str();
+            ASSERT_TRUE(expected == Users(index, usedID.str())) << "step " << step << " " << usedID.str();
+        }
+    }
+}
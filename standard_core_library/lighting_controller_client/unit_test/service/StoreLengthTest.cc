@@ -0,0 +1,233 @@
+/******************************************************************************
+ *
+ *
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <LampGroupManager.h>
+#include <PresetManager.h>
+#include <TransitionEffectManager.h>
+#include <PulseEffectManager.h>
+#include <SceneElementManager.h>
+#include <SceneManager.h>
+#include <MasterSceneManager.h>
+
+#include <stdlib.h>
+#include <sstream>
+#include <string>
+
+/* Header files included for Google Test Framework */
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace lsf;
+#ifdef LSF_BINDINGS
+using namespace controllerservice;
+#endif
+
+/*
+ * Every entity kind is checked with this many random instances
+ */
+#define STORE_LENGTH_TEST_ITERATIONS 500
+
+/*
+ * Values of every decimal width from 1 to 10 digits
+ */
+static uint32_t RandomValue(void)
+{
+    static const uint32_t limits[] = { 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+    int width = rand() % 10;
+    if (width == 9) {
+        return (rand() % 2) ? 0xFFFFFFFF : 1000000000 + rand();
+    }
+    return rand() % limits[width];
+}
+
+static LSFString RandomString(const char* prefix)
+{
+    ostringstream str;
+    str << prefix;
+    int len = rand() % 12;
+    for (int i = 0; i < len; i++) {
+        str << (char) ('a' + rand() % 26);
+    }
+    return str.str();
+}
+
+static LSFStringList RandomIDList(const char* prefix)
+{
+    LSFStringList list;
+    int len = rand() % 4;
+    for (int i = 0; i < len; i++) {
+        list.push_back(RandomString(prefix));
+    }
+    return list;
+}
+
+static LampState RandomState(void)
+{
+    LampState state;
+    state.nullState = (rand() % 4 == 0);
+    state.onOff = (rand() % 2 == 0);
+    state.hue = RandomValue();
+    state.saturation = RandomValue();
+    state.colorTemp = RandomValue();
+    state.brightness = RandomValue();
+    return state;
+}
+
+TEST(StoreLengthTest, LampGroup) {
+    srand(1);
+    for (int i = 0; i < STORE_LENGTH_TEST_ITERATIONS; i++) {
+        LSFString name = RandomString("");
+        LSFString id = RandomString("LAMP_GROUP_");
+        LampGroup group;
+        group.lamps = RandomIDList("LAMP_");
+        group.lampGroups = RandomIDList("LAMP_GROUP_");
+        ASSERT_EQ(LampGroupManager::GetString(name, id, group).length(), LampGroupManager::GetStringLength(name, id, group));
+    }
+}
+
+TEST(StoreLengthTest, Preset) {
+    srand(2);
+    for (int i = 0; i < STORE_LENGTH_TEST_ITERATIONS; i++) {
+        LSFString name = RandomString("");
+        LSFString id = RandomString("PRESET_");
+        LampState preset = RandomState();
+        ASSERT_EQ(PresetManager::GetString(name, id, preset).length(), PresetManager::GetStringLength(name, id, preset));
+    }
+}
+
+TEST(StoreLengthTest, TransitionEffect) {
+    srand(3);
+    for (int i = 0; i < STORE_LENGTH_TEST_ITERATIONS; i++) {
+        LSFString name = RandomString("");
+        LSFString id = RandomString("TRANSITION_EFFECT_");
+        TransitionEffect transitionEffect;
+        transitionEffect.state = RandomState();
+        transitionEffect.transitionPeriod = RandomValue();
+        transitionEffect.presetID = RandomString("PRESET_");
+        ASSERT_EQ(TransitionEffectManager::GetString(name, id, transitionEffect).length(), TransitionEffectManager::GetStringLength(name, id, transitionEffect));
+    }
+}
+
+TEST(StoreLengthTest, PulseEffect) {
+    srand(4);
+    for (int i = 0; i < STORE_LENGTH_TEST_ITERATIONS; i++) {
+        LSFString name = RandomString("");
+        LSFString id = RandomString("PULSE_EFFECT_");
+        PulseEffect pulseEffect;
+        pulseEffect.fromState = RandomState();
+        pulseEffect.toState = RandomState();
+        pulseEffect.pulsePeriod = RandomValue();
+        pulseEffect.pulseDuration = RandomValue();
+        pulseEffect.numPulses = RandomValue();
+        pulseEffect.fromPreset = RandomString("PRESET_");
+        pulseEffect.toPreset = RandomString("PRESET_");
+        ASSERT_EQ(PulseEffectManager::GetString(name, id, pulseEffect).length(), PulseEffectManager::GetStringLength(name, id, pulseEffect));
+    }
+}
+
+TEST(StoreLengthTest, SceneElement) {
+    srand(5);
+    for (int i = 0; i < STORE_LENGTH_TEST_ITERATIONS; i++) {
+        LSFString name = RandomString("");
+        LSFString id = RandomString("SCENE_ELEMENT_");
+        SceneElement sceneElement;
+        sceneElement.lamps = RandomIDList("LAMP_");
+        sceneElement.lampGroups = RandomIDList("LAMP_GROUP_");
+        sceneElement.effectID = RandomString("PRESET_");
+        ASSERT_EQ(SceneElementManager::GetString(name, id, sceneElement).length(), SceneElementManager::GetStringLength(name, id, sceneElement));
+    }
+}
+
+TEST(StoreLengthTest, Scene) {
+    srand(6);
+    for (int i = 0; i < STORE_LENGTH_TEST_ITERATIONS; i++) {
+        LSFString name = RandomString("");
+        LSFString id = RandomString("SCENE_");
+        Scene scene;
+
+        int count = rand() % 3;
+        for (int j = 0; j < count; j++) {
+            TransitionLampsLampGroupsToState component;
+            component.lamps = RandomIDList("LAMP_");
+            component.lampGroups = RandomIDList("LAMP_GROUP_");
+            component.state = RandomState();
+            component.transitionPeriod = RandomValue();
+            scene.transitionToStateComponent.push_back(component);
+        }
+
+        count = rand() % 3;
+        for (int j = 0; j < count; j++) {
+            TransitionLampsLampGroupsToPreset component;
+            component.lamps = RandomIDList("LAMP_");
+            component.lampGroups = RandomIDList("LAMP_GROUP_");
+            component.presetID = RandomString("PRESET_");
+            component.transitionPeriod = RandomValue();
+            scene.transitionToPresetComponent.push_back(component);
+        }
+
+        count = rand() % 3;
+        for (int j = 0; j < count; j++) {
+            PulseLampsLampGroupsWithState component;
+            component.lamps = RandomIDList("LAMP_");
+            component.lampGroups = RandomIDList("LAMP_GROUP_");
+            component.fromState = RandomState();
+            component.toState = RandomState();
+            component.pulsePeriod = RandomValue();
+            component.pulseDuration = RandomValue();
+            component.numPulses = RandomValue();
+            scene.pulseWithStateComponent.push_back(component);
+        }
+
+        count = rand() % 3;
+        for (int j = 0; j < count; j++) {
+            PulseLampsLampGroupsWithPreset component;
+            component.lamps = RandomIDList("LAMP_");
+            component.lampGroups = RandomIDList("LAMP_GROUP_");
+            component.fromPreset = RandomString("PRESET_");
+            component.toPreset = RandomString("PRESET_");
+            component.pulsePeriod = RandomValue();
+            component.pulseDuration = RandomValue();
+            component.numPulses = RandomValue();
+            scene.pulseWithPresetComponent.push_back(component);
+        }
+
+        ASSERT_EQ(SceneManager::GetString(name, id, scene).length(), SceneManager::GetStringLength(name, id, scene));
+    }
+}
+
+TEST(StoreLengthTest, SceneWithSceneElements) {
+    srand(7);
+    for (int i = 0; i < STORE_LENGTH_TEST_ITERATIONS; i++) {
+        LSFString name = RandomString("");
+        LSFString id = RandomString("SCENE_");
+        SceneWithSceneElements sceneWithSceneElements;
+        sceneWithSceneElements.sceneElements = RandomIDList("SCENE_ELEMENT_");
+        ASSERT_EQ(SceneManager::GetString(name, id, sceneWithSceneElements).length(), SceneManager::GetStringLength(name, id, sceneWithSceneElements));
+    }
+}
+
+TEST(StoreLengthTest, MasterScene) {
+    srand(8);
+    for (int i = 0; i < STORE_LENGTH_TEST_ITERATIONS; i++) {
+        LSFString name = RandomString("");
+        LSFString id = RandomString("MASTER_SCENE_");
+        MasterScene masterScene;
+        masterScene.scenes = RandomIDList("SCENE_");
+        ASSERT_EQ(MasterSceneManager::GetString(name, id, masterScene).length(), MasterSceneManager::GetStringLength(name, id, masterScene));
+    }
+}
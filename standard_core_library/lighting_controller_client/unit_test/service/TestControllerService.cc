@@ -0,0 +1,101 @@
+/******************************************************************************
+ *
+ *
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include "TestControllerService.h"
+
+#include <ControllerServiceManagerInit.h>
+#include <AJInitializer.h>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+/* Header files included for Google Test Framework */
+#include <gtest/gtest.h>
+
+using namespace lsf;
+#ifdef LSF_BINDINGS
+using namespace controllerservice;
+#endif
+
+static AJInitializer* ajInitializer = NULL;
+static ControllerServiceManager* controllerSvcManagerPtr = NULL;
+
+/*
+ * Stops the shared Controller Service, if a test started it, before the
+ * process exits
+ */
+class TestControllerServiceEnvironment : public testing::Environment {
+  public:
+    virtual void TearDown() {
+        if (controllerSvcManagerPtr) {
+            controllerSvcManagerPtr->Stop();
+            controllerSvcManagerPtr->Join();
+            delete controllerSvcManagerPtr;
+            controllerSvcManagerPtr = NULL;
+        }
+        delete ajInitializer;
+        ajInitializer = NULL;
+    }
+};
+
+static testing::Environment* const testControllerServiceEnvironment = testing::AddGlobalTestEnvironment(new TestControllerServiceEnvironment());
+
+namespace lsf {
+
+OPTIONAL_NAMESPACE_CONTROLLER_SERVICE
+
+ControllerService* GetTestControllerService(void)
+{
+    if (controllerSvcManagerPtr) {
+        return controllerSvcManagerPtr->GetControllerServicePtr();
+    }
+
+    if (ajInitializer) {
+        // A previous attempt failed
+        return NULL;
+    }
+
+    char storeLocation[] = "/tmp/lsfservicetestXXXXXX";
+    if (!mkdtemp(storeLocation) || chdir(storeLocation)) {
+        return NULL;
+    }
+
+    ajInitializer = new AJInitializer();
+    if (ajInitializer->Initialize() != ER_OK) {
+        return NULL;
+    }
+
+    ControllerServiceManager* manager =
+        InitializeControllerServiceManager("OEMConfig.ini", "Config.ini", "LampGroups.lsf", "Presets.lsf", "TransitionEffect.lsf", "PulseEffect.lsf",
+                                           "SceneElement.lsf", "Scenes.lsf", "SceneWithSceneElement.lsf", "MasterScenes.lsf");
+    if (!manager) {
+        return NULL;
+    }
+
+    if (manager->Start(NULL) != ER_OK) {
+        delete manager;
+        return NULL;
+    }
+
+    controllerSvcManagerPtr = manager;
+    return controllerSvcManagerPtr->GetControllerServicePtr();
+}
+
+OPTIONAL_NAMESPACE_CLOSE
+
+} //lsf
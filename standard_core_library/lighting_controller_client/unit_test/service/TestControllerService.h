@@ -0,0 +1,39 @@
+#ifndef TEST_CONTROLLER_SERVICE_H
+#define TEST_CONTROLLER_SERVICE_H
+/******************************************************************************
+ *
+ *
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+#include <ControllerService.h>
+
+namespace lsf {
+
+OPTIONAL_NAMESPACE_CONTROLLER_SERVICE
+
+/**
+ * Get the Controller Service shared by the tests that need one. \n
+ * It is started in process in a scratch directory on first use and
+ * stopped after the last test, so every test that uses it sees the
+ * stores as the previous one left them
+ * @return NULL if the Controller Service could not be started
+ */
+ControllerService* GetTestControllerService(void);
+
+OPTIONAL_NAMESPACE_CLOSE
+
+} //lsf
+
+#endif
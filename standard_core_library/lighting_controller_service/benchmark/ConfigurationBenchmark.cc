@@ -0,0 +1,298 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+/*
+ * Benchmark of the configuration snapshot import and export of a Controller
+ * Service.
+ *
+ * Starts a Controller Service in process, generates a snapshot of
+ * <num_entities> entities split evenly across the lamp groups, presets,
+ * transition effects, pulse effects, scene elements, scenes and master
+ * scenes, with every reference resolving, and measures:
+ *  - the time to import the snapshot with ImportConfigurationAPI
+ *  - the time to export it again with ExportConfigurationAPI
+ *
+ * Each store is limited to OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY entities and
+ * to the size of its persistent store file, so the controller service must
+ * be built with a limit of at least <num_entities> / 7 for the import to
+ * succeed. Otherwise the import reports LSF_ERR_NO_SLOT.
+ *
+ * The results are written as JSON.
+ *
+ * Usage: lsfconfigbenchmark [-n <num_entities>] [-i <iterations>]
+ *                           [-k <directory>] [-o <output_file>]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <qcc/Debug.h>
+
+#include <ControllerService.h>
+#include <ControllerServiceManagerInit.h>
+#include <OEM_CS_Config.h>
+#include <LSFTypes.h>
+#include <AJInitializer.h>
+
+#ifdef LSF_BINDINGS
+using namespace lsf::controllerservice;
+#else
+using namespace lsf;
+#endif
+
+#define QCC_MODULE "CONFIGURATION_BENCHMARK"
+
+/*
+ * Time to wait for the Controller Service to allow updates
+ */
+#define BENCHMARK_START_TIMEOUT_MS 60000
+
+#define BENCHMARK_NUM_STORES 7
+
+struct BenchmarkConfig {
+    BenchmarkConfig() : numEntities(5000), iterations(10) { }
+
+    uint32_t numEntities;
+    uint32_t iterations;
+    std::string storeLocation;
+    std::string outputFile;
+};
+
+struct TimingResult {
+    TimingResult() : responseCode(LSF_OK), iterations(0), totalMs(0), minMs(0), maxMs(0) { }
+
+    void Add(uint64_t elapsedMs) {
+        if ((0 == iterations) || (elapsedMs < minMs)) {
+            minMs = elapsedMs;
+        }
+        if (elapsedMs > maxMs) {
+            maxMs = elapsedMs;
+        }
+        totalMs += elapsedMs;
+        iterations++;
+    }
+
+    void Write(std::ostream& stream) const {
+        stream << "{\"responseCode\":\"" << LSFResponseCodeText(responseCode) << "\""
+               << ",\"iterations\":" << iterations
+               << ",\"meanMs\":" << (iterations ? (totalMs / iterations) : 0)
+               << ",\"minMs\":" << minMs
+               << ",\"maxMs\":" << maxMs << "}";
+    }
+
+    LSFResponseCode responseCode;
+    uint32_t iterations;
+    uint64_t totalMs;
+    uint64_t minMs;
+    uint64_t maxMs;
+};
+
+static std::string EntityID(const char* prefix, uint32_t index)
+{
+    std::ostringstream id;
+    id << prefix << "_" << index;
+    return id.str();
+}
+
+/*
+ * Write a snapshot in the format of ExportConfigurationAPI. Lamp group i
+ * nests lamp group i / 2, and scene element, scene and master scene i each
+ * refer to the entities with the same index, with the scene elements
+ * cycling through presets, transition effects and pulse effects
+ */
+static void GenerateSnapshot(std::ostream& stream, uint32_t numEntities)
+{
+    uint32_t perStore = numEntities / BENCHMARK_NUM_STORES;
+
+    stream << "LSFConfiguration 1\n";
+
+    stream << "Section LampGroups\n";
+    for (uint32_t i = 0; i < perStore; i++) {
+        stream << "LampGroup " << EntityID("LAMP_GROUP", i) << " \"Group " << i << "\" Lamp " << EntityID("LAMP", i);
+        if (i) {
+            stream << " LampGroup " << EntityID("LAMP_GROUP", i / 2);
+        }
+        stream << " EndLampGroup\n";
+    }
+    stream << "EndSection\n";
+
+    stream << "Section Presets\n";
+    for (uint32_t i = 0; i < perStore; i++) {
+        stream << "Preset " << EntityID("PRESET", i) << " \"Preset " << i << "\" 0 1 " << i << " 100 2700 " << (i * 7) << '\n';
+    }
+    stream << "EndSection\n";
+
+    stream << "Section TransitionEffects\n";
+    for (uint32_t i = 0; i < perStore; i++) {
+        stream << "TransitionEffect " << EntityID("TRANSITION_EFFECT", i) << " \"Transition " << i << "\" 1 0 1 " << i << " 100 2700 50 1000\n";
+    }
+    stream << "EndSection\n";
+
+    stream << "Section PulseEffects\n";
+    for (uint32_t i = 0; i < perStore; i++) {
+        stream << "PulseEffect " << EntityID("PULSE_EFFECT", i) << " \"Pulse " << i << "\" 0 " << EntityID("PRESET", i) << ' ' << EntityID("PRESET", (i + 1) % perStore) << " 1000 500 3\n";
+    }
+    stream << "EndSection\n";
+
+    static const char* effectPrefixes[] = { "PRESET", "TRANSITION_EFFECT", "PULSE_EFFECT" };
+    stream << "Section SceneElements\n";
+    for (uint32_t i = 0; i < perStore; i++) {
+        stream << "SceneElement " << EntityID("SCENE_ELEMENT", i) << " \"Element " << i << "\" Lamp " << EntityID("LAMP", i)
+               << " LampGroup " << EntityID("LAMP_GROUP", i) << " Effect " << EntityID(effectPrefixes[i % 3], i) << " EndSceneElement\n";
+    }
+    stream << "EndSection\n";
+
+    stream << "Section Scenes\n";
+    for (uint32_t i = 0; i < perStore; i++) {
+        stream << "Scene " << EntityID("SCENE", i) << " \"Scene " << i << "\"\n\tSceneElements\n\t\t " << EntityID("SCENE_ELEMENT", i) << "\n\tEndSceneElements\nEndScene\n";
+    }
+    stream << "EndSection\n";
+
+    stream << "Section MasterScenes\n";
+    for (uint32_t i = 0; i < perStore; i++) {
+        stream << "MasterScene " << EntityID("MASTER_SCENE", i) << " \"Master Scene " << i << "\" Scene " << EntityID("SCENE", i) << " EndMasterScene\n";
+    }
+    stream << "EndSection\n";
+
+    stream << "EndLSFConfiguration\n";
+}
+
+static void usage(char** argv)
+{
+    printf("Usage: %s [-n <num_entities>] [-i <iterations>] [-k <directory>] [-o <output_file>]\n\n", argv[0]);
+    printf("Options:\n");
+    printf("   -n <num_entities>       = Number of entities in the snapshot. Default 5000\n");
+    printf("   -i <iterations>         = Number of imports and exports to time. Default 10\n");
+    printf("   -k <directory>          = Directory for the persistent store of the controller service. Default current directory\n");
+    printf("   -o <output_file>        = File to write the JSON results to. Default stdout\n");
+}
+
+int main(int argc, char** argv)
+{
+    BenchmarkConfig config;
+
+    for (int i = 1; i < argc; i++) {
+        if ((i + 1) >= argc) {
+            usage(argv);
+            return 1;
+        }
+
+        if (0 == strcmp("-n", argv[i])) {
+            config.numEntities = strtoul(argv[++i], NULL, 10);
+        } else if (0 == strcmp("-i", argv[i])) {
+            config.iterations = strtoul(argv[++i], NULL, 10);
+        } else if (0 == strcmp("-k", argv[i])) {
+            config.storeLocation = argv[++i];
+        } else if (0 == strcmp("-o", argv[i])) {
+            config.outputFile = argv[++i];
+        } else {
+            usage(argv);
+            return 1;
+        }
+    }
+
+    if (!config.storeLocation.empty() && chdir(config.storeLocation.c_str())) {
+        QCC_LogError(ER_FAIL, ("%s: chdir() failed", __func__));
+        return 1;
+    }
+
+    AJInitializer ajInitializer;
+    if (ajInitializer.Initialize() != ER_OK) {
+        return -1;
+    }
+
+    std::ostringstream generated;
+    GenerateSnapshot(generated, config.numEntities);
+    const std::string snapshot = generated.str();
+
+    ControllerServiceManager* controllerSvcManagerPtr =
+        InitializeControllerServiceManager("OEMConfig.ini", "Config.ini", "LampGroups.lsf", "Presets.lsf", "TransitionEffect.lsf", "PulseEffect.lsf",
+                                           "SceneElement.lsf", "Scenes.lsf", "SceneWithSceneElement.lsf", "MasterScenes.lsf");
+    if (controllerSvcManagerPtr == NULL) {
+        QCC_LogError(ER_OUT_OF_MEMORY, ("%s: Failed to start the Controller Service Manager", __func__));
+        return -1;
+    }
+
+    if (controllerSvcManagerPtr->Start(NULL) != ER_OK) {
+        QCC_LogError(ER_FAIL, ("%s: Failed to start the Controller Service", __func__));
+        delete controllerSvcManagerPtr;
+        return -1;
+    }
+
+    ControllerService* controllerService = controllerSvcManagerPtr->GetControllerServicePtr();
+    TimingResult importResult;
+    TimingResult exportResult;
+    size_t exportedBytes = 0;
+
+    /*
+     * Updates are refused until the leader election has settled, the first
+     * successful import is not timed
+     */
+    uint64_t startTimestamp = GetTimestampInMs();
+    do {
+        std::istringstream stream(snapshot);
+        importResult.responseCode = controllerService->ImportConfigurationAPI(stream);
+        if (LSF_ERR_BUSY == importResult.responseCode) {
+            usleep(100 * 1000);
+        }
+    } while ((LSF_ERR_BUSY == importResult.responseCode) && ((GetTimestampInMs() - startTimestamp) < BENCHMARK_START_TIMEOUT_MS));
+
+    for (uint32_t i = 0; (i < config.iterations) && (LSF_OK == importResult.responseCode); i++) {
+        std::istringstream stream(snapshot);
+        uint64_t timestamp = GetTimestampInMs();
+        importResult.responseCode = controllerService->ImportConfigurationAPI(stream);
+        importResult.Add(GetTimestampInMs() - timestamp);
+    }
+
+    for (uint32_t i = 0; (i < config.iterations) && (LSF_OK == exportResult.responseCode); i++) {
+        std::ostringstream stream;
+        uint64_t timestamp = GetTimestampInMs();
+        exportResult.responseCode = controllerService->ExportConfigurationAPI(stream);
+        exportResult.Add(GetTimestampInMs() - timestamp);
+        exportedBytes = stream.str().size();
+    }
+
+    controllerSvcManagerPtr->Stop();
+    controllerSvcManagerPtr->Join();
+    delete controllerSvcManagerPtr;
+
+    std::ostringstream results;
+    results << "{\"entities\":" << config.numEntities
+            << ",\"maxEntitiesPerStore\":" << OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY
+            << ",\"snapshotBytes\":" << snapshot.size()
+            << ",\"exportedBytes\":" << exportedBytes
+            << ",\"import\":";
+    importResult.Write(results);
+    results << ",\"export\":";
+    exportResult.Write(results);
+    results << "}" << std::endl;
+
+    if (config.outputFile.empty()) {
+        std::cout << results.str();
+    } else {
+        std::ofstream stream(config.outputFile.c_str());
+        stream << results.str();
+    }
+
+    return (LSF_OK == importResult.responseCode) ? 0 : 1;
+}
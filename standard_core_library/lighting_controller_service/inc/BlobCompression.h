@@ -0,0 +1,70 @@
+#ifndef LSF_BLOB_COMPRESSION_H
+#define LSF_BLOB_COMPRESSION_H
+/**
+ * \ingroup ControllerService
+ */
+/**
+ * @file
+ * This file provides definitions for the blob compression codec used
+ * during leader election state sync
+ */
+
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <string>
+#include <stdint.h>
+#include <stddef.h>
+#include "LSFNamespaceSpecifier.h"
+
+namespace lsf {
+
+OPTIONAL_NAMESPACE_CONTROLLER_SERVICE
+
+/**
+ * First version of the LeaderElectionAndStateSync interface that supports
+ * the GetCompressedBlob method and the CompressedBlobChanged signal
+ */
+#define LSF_BLOB_COMPRESSION_MIN_INTERFACE_VERSION 2
+
+/**
+ * Compress a blob using the in-tree LZ77 codec. \n
+ * The output is a sequence of (literals, match) tokens in the style of LZ4
+ * with 16-bit back references, which is sufficient for blobs bounded by
+ * the persistent store size limit.
+ *
+ * @param blob        The uncompressed blob
+ * @param compressed  Container to pass back the compressed bytes
+ * @return None
+ */
+void CompressBlob(const std::string& blob, std::string& compressed);
+
+/**
+ * Decompress a blob produced by CompressBlob
+ *
+ * @param data              The compressed bytes
+ * @param len               Number of compressed bytes
+ * @param uncompressedLen   Expected length of the uncompressed blob
+ * @param blob              Container to pass back the uncompressed blob
+ * @return true if the input was well formed and decoded to exactly uncompressedLen bytes
+ */
+bool DecompressBlob(const uint8_t* data, size_t len, size_t uncompressedLen, std::string& blob);
+
+OPTIONAL_NAMESPACE_CLOSE
+
+} //lsf
+
+#endif
@@ -24,8 +24,11 @@
  *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
+#include <list>
 #include <map>
 #include <string>
+#include <vector>
+#include <functional>
 
 #include <alljoyn/BusAttachment.h>
 #include <alljoyn/ProxyBusObject.h>
@@ -33,10 +36,12 @@
 #include <alljoyn/config/ConfigService.h>
 
 #include <LSFTypes.h>
+#include <LSFStatistics.h>
 #include <Mutex.h>
 
 #ifdef LSF_BINDINGS
 #include <lsf/controllerservice/PersistenceThread.h>
+#include <lsf/controllerservice/MethodCallExecutor.h>
 #include <lsf/controllerservice/LampManager.h>
 #include <lsf/controllerservice/LampGroupManager.h>
 #include <lsf/controllerservice/PresetManager.h>
@@ -51,6 +56,7 @@
 #include <lsf/controllerservice/LSFAboutDataStore.h>
 #else
 #include <PersistenceThread.h>
+#include <MethodCallExecutor.h>
 #include <LampManager.h>
 #include <LampGroupManager.h>
 #include <PresetManager.h>
@@ -311,6 +317,21 @@ class ControllerService : public ajn::BusObject, public ajn::services::ConfigSer
      * @param name to send
      */
     void SendMethodReplyWithResponseCodeIDLanguageAndName(const ajn::Message& msg, LSFResponseCode responseCode, const LSFString& lsfId, const LSFString& language, const LSFString& name);
+    /**
+     * Send Method Reply With Response Code Only \n
+     * Reply for a method call that was not executed. The first reply argument is set to
+     * the response code and the remaining arguments are set to empty values matching
+     * the reply signature of the method \n
+     * @param member   The interface member of the method call
+     * @param msg      The method call message
+     * @param responseCode type LSFResponseCode
+     */
+    void SendMethodReplyWithResponseCodeOnly(const ajn::InterfaceDescription::Member* member, const ajn::Message& msg, LSFResponseCode responseCode);
+    /**
+     * Reply LSF_ERR_BUSY to a method call that was accepted but will not be executed
+     * @param msg      The method call message
+     */
+    void SendBusyReply(const ajn::Message& msg);
     /**
      * Send Signal with list of IDs
      * @param ifaceName - interface that the signal is located
@@ -340,6 +361,13 @@ class ControllerService : public ajn::BusObject, public ajn::services::ConfigSer
      */
     QStatus SendStateChangedSignal(const char* ifaceName, const char* signalName, const LSFString& lampID, const LampState& lampState);
 
+    /**
+     * Send the LampsStateChanged signal
+     * @param lampStates - The state of each lamp that changed
+     * @return QStatus
+     */
+    QStatus SendLampsStateChangedSignal(const LampStateMap& lampStates);
+
     /**
      * Send Signal Without Arg - just an empty signal
      * @param ifaceName - interface that the signal is located
@@ -357,11 +385,13 @@ class ControllerService : public ajn::BusObject, public ajn::services::ConfigSer
     }
     /**
      * Schedule File Read Write \n
-     * a trigger to synchronize all lighting service meta data with persistent storage.\n
+     * a trigger to synchronize the meta data of a manager with persistent storage.\n
      * Meta data includes lamp groups, scenes, master scenes, presets, transition effects and pulse effects.
-     * @param manager - parameter not in use
+     * @param manager - the manager whose persistent store should be read or written
+     * @param write - true if the request is for writing out a change. Writes are coalesced
+     *                over OEM_CS_PERSISTENCE_WRITE_COALESCE_MS
      */
-    void ScheduleFileReadWrite(Manager* manager);
+    void ScheduleFileReadWrite(Manager* manager, bool write = false);
     /**
      * Send Blob Update \n
      * Updating the leader controller service about the current controller service meta data \n
@@ -370,7 +400,7 @@ class ControllerService : public ajn::BusObject, public ajn::services::ConfigSer
      * @param checksum
      * @param timestamp
      */
-    QStatus SendBlobUpdate(LSFBlobType type, std::string blob, uint32_t checksum, uint64_t timestamp);
+    QStatus SendBlobUpdate(LSFBlobType type, const std::string& blob, uint32_t checksum, uint64_t timestamp);
     /**
      * Send Get Blob Reply \n
      * Replay to Get blob request \n
@@ -380,7 +410,7 @@ class ControllerService : public ajn::BusObject, public ajn::services::ConfigSer
      * @param checksum
      * @param timestamp
      */
-    void SendGetBlobReply(ajn::Message& message, LSFBlobType type, std::string blob, uint32_t checksum, uint64_t timestamp);
+    void SendGetBlobReply(ajn::Message& message, LSFBlobType type, const std::string& blob, uint32_t checksum, uint64_t timestamp);
     /**
      * Is Running
      */
@@ -434,6 +464,18 @@ class ControllerService : public ajn::BusObject, public ajn::services::ConfigSer
      */
     LSFAboutDataStore& GetAboutDataStore(void) { return aboutDataStore; };
 
+    /**
+     * Return the statistics registry of the Controller Service
+     */
+    LSFStatisticsRegistry& GetStatistics(void) { return statistics; };
+
+    /**
+     * Write the current statistics to a local file
+     * @param filePath - the file to write
+     * @return ER_OK if successful, error otherwise
+     */
+    QStatus DumpStatistics(const std::string& filePath);
+
     /**
      * Developer API to Lighting Reset the Controller Service.
      * This function will reset all the persistent store
@@ -485,10 +527,80 @@ class ControllerService : public ajn::BusObject, public ajn::services::ConfigSer
      *         LSF_ERR_FAILURE - If reset failed
      */
     LSFResponseCode FactoryResetAPI(void);
+
+    /**
+     * Developer API to export all the lighting data of the
+     * Controller Service as a single versioned snapshot.
+     * The lamp groups, presets, effects, scene elements, scenes
+     * and master scenes are read under their locks at the same
+     * time, so the snapshot is consistent across the stores.
+     *
+     * Please note that the whole snapshot is built in memory
+     * before it is written, so that the stores are not held
+     * while the stream is written. It takes about as much memory
+     * again as the persistent store files together
+     *
+     * @param  stream - the stream to write the snapshot to
+     * @return LSFResponseCode indicating the status of the operation
+     *         LSF_OK - If the export was successful
+     *         LSF_ERR_FAILURE - If the snapshot could not be written
+     */
+    LSFResponseCode ExportConfigurationAPI(std::ostream& stream);
+
+    /**
+     * Developer API to replace all the lighting data of the
+     * Controller Service with a snapshot written by
+     * ExportConfigurationAPI. The references between the entities
+     * of the snapshot are validated before anything is applied,
+     * and either every store is replaced or none is.
+     *
+     * Please note that this is a blocking function call and
+     * all the stores are locked while the snapshot is applied.
+     * The snapshot is not parsed as it is read: each section is
+     * read into memory in full and staged in a copy of its store,
+     * so an import takes memory for the text of the snapshot and
+     * for a second copy of every store. The size of a store is only
+     * checked once its section has been read
+     *
+     * @param  stream - the stream to read the snapshot from
+     * @return LSFResponseCode indicating the status of the operation
+     *         LSF_OK - If the import was successful
+     *         LSF_ERR_BUSY - If updates are not allowed at the moment
+     *         LSF_ERR_INVALID_ARGS - If the snapshot is malformed or of an unknown version
+     *         LSF_ERR_DEPENDENCY - If an entity refers to one missing from the snapshot
+     *         LSF_ERR_NO_SLOT - If a store would have more than the supported number of entities
+     *         LSF_ERR_RESOURCES - If a store would not fit in its persistent store file
+     */
+    LSFResponseCode ImportConfigurationAPI(std::istream& stream);
+
+    /**
+     * Export the lighting data to a local file
+     * @param filePath - the file to write
+     * @return as ExportConfigurationAPI
+     */
+    LSFResponseCode ExportConfiguration(const std::string& filePath);
+
+    /**
+     * Import the lighting data from a local file
+     * @param filePath - the file to read
+     * @return as ImportConfigurationAPI, LSF_ERR_NOT_FOUND if the file cannot be opened
+     */
+    LSFResponseCode ImportConfiguration(const std::string& filePath);
   private:
 
     void Initialize();
 
+    /**
+     * Lock all the stores for a configuration export or import, in the
+     * order in which the scene operations lock them
+     */
+    void LockConfigurationStores(void);
+
+    /**
+     * Unlock the stores locked by LockConfigurationStores
+     */
+    void UnlockConfigurationStores(void);
+
     uint32_t GetControllerServiceInterfaceVersion(void);
 
     /**
@@ -511,6 +623,26 @@ class ControllerService : public ajn::BusObject, public ajn::services::ConfigSer
 
     QStatus CreateAndAddInterfaces(const InterfaceEntry* entries, size_t numEntries);
 
+    /*
+     * Declared first so that it is constructed before the managers that
+     * register their statistics with it
+     */
+    LSFStatisticsRegistry statistics;
+
+    LSFStatistic* methodCallsStatistic;
+    LSFStatistic* executedCallsStatistic;
+    LSFStatistic* rejectedCallsStatistic;
+    LSFStatistic* executorP50LatencyStatistic;
+    LSFStatistic* executorP99LatencyStatistic;
+    LSFStatistic* executorMaxLatencyStatistic;
+    LSFStatistic* lastFailoverStatistic;
+    LSFStatistic* blobRepliesStatistic;
+    LSFStatistic* averageBlobReplyLatencyStatistic;
+    LSFStatistic* maxBlobReplyLatencyStatistic;
+    LSFStatistic* lastSyncStatistic;
+    LSFStatistic* lastSyncBlobsStatistic;
+    LSFStatistic* traceRecordsStatistic;
+
     Mutex updatesAllowedLock;
     bool updatesAllowed;
     ajn::BusAttachment bus;
@@ -568,14 +700,27 @@ class ControllerService : public ajn::BusObject, public ajn::services::ConfigSer
 
     void GetControllerServiceVersion(ajn::Message& msg);
 
+    void GetControllerServiceStatistics(ajn::Message& msg);
+
+    /*
+     * Register the statistics that are kept elsewhere and copied into the
+     * registry by UpdatePolledStatistics
+     */
+    void RegisterPolledStatistics(void);
+
+    /*
+     * Copy the statistics that are kept elsewhere into the registry
+     */
+    void UpdatePolledStatistics(void);
+
     /*
      * This function is not thread safe. it should not be called without locking messageHandlersLock
      */
     template <typename OBJ>
-    void AddMethodHandler(const std::string& methodName, OBJ* obj, void (OBJ::* methodCall)(ajn::Message &))
+    void AddMethodHandler(const char* interfaceName, const char* methodName, OBJ* obj, void (OBJ::* methodCall)(ajn::Message &), bool mutatesStore = false)
     {
-        MethodHandlerBase* handler = new MethodHandler<OBJ>(obj, methodCall);
-        std::pair<DispatcherMap::iterator, bool> ins = messageHandlers.insert(std::make_pair(methodName, handler));
+        MethodHandlerBase* handler = new MethodHandler<OBJ>(obj, methodCall, mutatesStore);
+        std::pair<DispatcherMap::iterator, bool> ins = messageHandlers.insert(std::make_pair(DispatcherKey(interfaceName, methodName), handler));
         if (ins.second == false) {
             // if this was already there, overwrite and delete the old handler
             delete ins.first->second;
@@ -583,10 +728,22 @@ class ControllerService : public ajn::BusObject, public ajn::services::ConfigSer
         }
     }
 
-    class MethodHandlerBase {
+    /*
+     * Add the handler of a method call that modifies the persistent store of
+     * obj. These calls are executed one at a time for obj
+     */
+    template <typename OBJ>
+    void AddStoreMethodHandler(const char* interfaceName, const char* methodName, OBJ* obj, void (OBJ::* methodCall)(ajn::Message &))
+    {
+        AddMethodHandler(interfaceName, methodName, obj, methodCall, true);
+    }
+
+    class MethodHandlerBase : public MethodCallHandler {
       public:
         virtual ~MethodHandlerBase() { }
         virtual void Handle(ajn::Message& msg) = 0;
+        virtual const void* GetObject(void) const = 0;
+        virtual bool MutatesStore(void) const = 0;
     };
 
     template <typename OBJ>
@@ -594,8 +751,8 @@ class ControllerService : public ajn::BusObject, public ajn::services::ConfigSer
         typedef void (OBJ::* HandlerFunction)(ajn::Message&);
 
       public:
-        MethodHandler(OBJ* obj, HandlerFunction handleFunc) :
-            object(obj), handler(handleFunc) { }
+        MethodHandler(OBJ* obj, HandlerFunction handleFunc, bool mutatesStore) :
+            object(obj), handler(handleFunc), mutatesStore(mutatesStore) { }
 
         virtual ~MethodHandler() { }
 
@@ -603,17 +760,76 @@ class ControllerService : public ajn::BusObject, public ajn::services::ConfigSer
             (object->*(handler))(msg);
         }
 
+        virtual const void* GetObject(void) const {
+            return object;
+        }
+
+        virtual bool MutatesStore(void) const {
+            return mutatesStore;
+        }
+
         OBJ* object;
         HandlerFunction handler;
+        bool mutatesStore;
     };
 
-    typedef std::map<std::string, MethodHandlerBase*> DispatcherMap;
+    /*
+     * Method handlers are keyed by interface and member name, the same member
+     * name may be used by more than one interface
+     */
+    typedef std::pair<std::string, std::string> DispatcherKey;
+    typedef std::map<DispatcherKey, MethodHandlerBase*> DispatcherMap;
     DispatcherMap messageHandlers;
     Mutex messageHandlersLock;
 
+    /*
+     * Build the dispatch table used by MethodCallDispatcher from messageHandlers.
+     * Must be called after all the method handlers have been added and before
+     * the Controller Service BusObject is registered
+     */
+    void FreezeMethodHandlers(void);
+
+    /*
+     * Where a method call is dispatched to. Calls with a serialKey modify the
+     * state of that object and are executed one at a time for the object
+     */
+    struct DispatchTarget {
+        MethodHandlerBase* handler;
+        const void* serialKey;
+
+        DispatchTarget(MethodHandlerBase* handler, const void* serialKey) : handler(handler), serialKey(serialKey) { }
+    };
+
+    typedef std::pair<const ajn::InterfaceDescription::Member*, DispatchTarget> DispatchTableEntry;
+
+    /*
+     * Orders dispatch table entries by interface member
+     */
+    struct DispatchTableEntryLess {
+        bool operator()(const DispatchTableEntry& lhs, const ajn::InterfaceDescription::Member* rhs) const {
+            return std::less<const ajn::InterfaceDescription::Member*>()(lhs.first, rhs);
+        }
+        bool operator()(const DispatchTableEntry& lhs, const DispatchTableEntry& rhs) const {
+            return std::less<const ajn::InterfaceDescription::Member*>()(lhs.first, rhs.first);
+        }
+    };
+
+    /*
+     * Immutable once frozen, so it is read without taking any lock
+     */
+    typedef std::vector<DispatchTableEntry> DispatchTable;
+    DispatchTable dispatchTable;
+    volatile bool dispatchTableFrozen;
+
+    volatile int32_t methodCallCount;
+
+    const ajn::InterfaceDescription::Member* lampsStateChangedSignal;
+
 
     PersistenceThread fileWriterThread;
 
+    MethodCallExecutor methodCallExecutor;
+
     ControllerServiceRank rank;
 
     bool deprecatedConstructorUsed;
@@ -747,6 +963,24 @@ class ControllerServiceManager {
      * Get a pointer to Controller Service
      */
     ControllerService* GetControllerServicePtr(void) { return &controllerService; };
+    /**
+     * Write the current statistics to a local file
+     */
+    QStatus DumpStatistics(const std::string& filePath) {
+        return controllerService.DumpStatistics(filePath);
+    }
+    /**
+     * Export the lighting data to a local file
+     */
+    LSFResponseCode ExportConfiguration(const std::string& filePath) {
+        return controllerService.ExportConfiguration(filePath);
+    }
+    /**
+     * Replace the lighting data with the contents of a local file
+     */
+    LSFResponseCode ImportConfiguration(const std::string& filePath) {
+        return controllerService.ImportConfiguration(filePath);
+    }
 
   private:
     ControllerService controllerService;
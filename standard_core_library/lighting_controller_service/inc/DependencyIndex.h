@@ -0,0 +1,106 @@
+#ifndef DEPENDENCY_INDEX_H
+#define DEPENDENCY_INDEX_H
+/**
+ * \ingroup ControllerService
+ */
+/**
+ * @file
+ * This file provides definitions for the dependency index
+ */
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <map>
+
+#include <LSFTypes.h>
+
+#include "LSFNamespaceSpecifier.h"
+
+namespace lsf {
+
+OPTIONAL_NAMESPACE_CONTROLLER_SERVICE
+
+/**
+ * Reverse index of the references between entities, e.g. from a Lamp Group
+ * to the Scene Elements that use it. \n
+ * Kept by the manager of the referring entities and updated under its lock
+ * whenever an entity is created, updated or deleted, so that a delete can be
+ * checked without scanning every entity.
+ */
+class DependencyIndex {
+  public:
+    /**
+     * Record the references of an entity
+     * @param userID   The referring entity
+     * @param usedIDs  The entities it refers to
+     */
+    void Add(const LSFString& userID, const LSFStringList& usedIDs);
+    /**
+     * Record a reference of an entity
+     * @param userID  The referring entity
+     * @param usedID  The entity it refers to
+     */
+    void Add(const LSFString& userID, const LSFString& usedID);
+    /**
+     * Forget the references of an entity
+     * @param userID   The referring entity
+     * @param usedIDs  The entities it referred to
+     */
+    void Remove(const LSFString& userID, const LSFStringList& usedIDs);
+    /**
+     * Forget a reference of an entity
+     * @param userID  The referring entity
+     * @param usedID  The entity it referred to
+     */
+    void Remove(const LSFString& userID, const LSFString& usedID);
+    /**
+     * Forget all references
+     */
+    void Clear(void) {
+        users.clear();
+    }
+    /**
+     * Check whether any entity refers to an entity
+     * @param usedID  The entity
+     * @return true if the entity is in use
+     */
+    bool IsUsed(const LSFString& usedID) const {
+        return (users.find(usedID) != users.end());
+    }
+    /**
+     * Get the entities that refer to an entity
+     * @param usedID   The entity
+     * @param userIDs  The referring entities, each listed once
+     */
+    void GetUsers(const LSFString& usedID, LSFStringList& userIDs) const;
+
+  private:
+    /*
+     * An entity may list the same reference more than once, so the
+     * references of each user are counted
+     */
+    typedef std::map<LSFString, uint32_t> UserCountMap;
+    typedef std::map<LSFString, UserCountMap> UsersMap;
+
+    UsersMap users;
+};
+
+OPTIONAL_NAMESPACE_CLOSE
+
+} //lsf
+
+
+#endif
@@ -56,10 +56,66 @@ T ParseValue(std::istream& stream)
     return t;
 }
 
+/**
+ * Input stream that parses a blob in place. \n
+ * Unlike std::istringstream it does not take a copy of the blob, which
+ * must outlive the stream.
+ */
+class BlobInputStream : private std::streambuf, public std::istream {
+  public:
+    /**
+     * Constructor
+     *
+     * @param blob  The blob to read from
+     */
+    BlobInputStream(const std::string& blob) : std::istream(this) {
+        char* begin = const_cast<char*>(blob.data());
+        setg(begin, begin, begin + blob.size());
+    }
+
+    /**
+     * Constructor
+     *
+     * @param blob    The buffer to read from, it must outlive the stream
+     * @param length  The number of characters in the buffer
+     */
+    BlobInputStream(const char* blob, size_t length) : std::istream(this) {
+        char* begin = const_cast<char*>(blob);
+        setg(begin, begin, begin + length);
+    }
+};
+
 std::ostream& WriteValue(std::ostream& stream, const std::string& name);
 
 std::ostream& WriteString(std::ostream& stream, const std::string& name);
 
+/**
+ * Get the number of characters a value takes when written to a stream
+ *
+ * @param value     The value
+ * @return          The number of decimal digits of the value
+ */
+size_t GetValueLength(uint32_t value);
+
+/**
+ * Get the number of characters a Lamp State takes when written to a stream
+ * as "nullState onOff hue saturation colorTemp brightness"
+ *
+ * @param state     The Lamp State
+ * @return          The length of the written Lamp State
+ */
+size_t GetLampStateLength(const LampState& state);
+
+/**
+ * Get the number of characters a list of IDs takes when written to a stream
+ * along with a fixed number of characters for each ID, e.g. " Lamp "
+ *
+ * @param list           The IDs
+ * @param markupLength   The number of characters written along with each ID
+ * @return               The length of the written list
+ */
+size_t GetIDListLength(const LSFStringList& list, size_t markupLength);
+
 OPTIONAL_NAMESPACE_CLOSE
 
 } //lsf
@@ -31,13 +31,16 @@
 
 #ifdef LSF_BINDINGS
 #include <lsf/controllerservice/Manager.h>
+#include <lsf/controllerservice/RequestTracer.h>
 #else
 #include <Manager.h>
+#include <RequestTracer.h>
 #endif
 
 #include <Thread.h>
 #include <LSFSemaphore.h>
 #include <Alarm.h>
+#include <LSFStringTable.h>
 #include <alljoyn/AboutProxy.h>
 
 #include <string>
@@ -387,15 +390,15 @@ class LampClients : public Manager, public ajn::BusAttachment::JoinSessionAsyncC
     };
 
     struct QueuedMethodCallElement {
-        QueuedMethodCallElement() {
+        QueuedMethodCallElement() : method(NULL) {
             lamps.clear();
             args.clear();
         }
 
-        QueuedMethodCallElement(LSFStringList lampList, std::string intf, std::string methodName) :
+        QueuedMethodCallElement(LSFStringList lampList, std::string intf, LSFStringHandle methodName) :
             lamps(lampList), interface(intf), method(methodName) { }
 
-        QueuedMethodCallElement(LSFString lamp, std::string intf, std::string methodName) :
+        QueuedMethodCallElement(LSFString lamp, std::string intf, LSFStringHandle methodName) :
             interface(intf), method(methodName) {
             lamps.clear();
             lamps.push_back(lamp);
@@ -403,7 +406,7 @@ class LampClients : public Manager, public ajn::BusAttachment::JoinSessionAsyncC
 
         LSFStringList lamps;
         std::string interface;
-        std::string method;
+        LSFStringHandle method;
         std::vector<ajn::MsgArg> args;
     };
 
@@ -411,7 +414,8 @@ class LampClients : public Manager, public ajn::BusAttachment::JoinSessionAsyncC
 
     struct QueuedMethodCall {
         QueuedMethodCall(const ajn::Message& msg, ajn::MessageReceiver::ReplyHandler replyHandler, bool allLampsOp = false) :
-            inMsg(msg), replyFunc(replyHandler), responseID(qcc::RandHexString(8).c_str()), responseCounter(), methodCallCount(0), allLampsOperation(allLampsOp) {
+            inMsg(msg), replyFunc(replyHandler), responseID(qcc::RandHexString(8).c_str()), responseCounter(), methodCallCount(0), allLampsOperation(allLampsOp),
+            traceId(LSF_TRACE_ID(msg)), traceTimestamp(0) {
         }
 
         void AddMethodCallElement(QueuedMethodCallElement& element) {
@@ -426,19 +430,26 @@ class LampClients : public Manager, public ajn::BusAttachment::JoinSessionAsyncC
         QueuedMethodCallElementList methodCallElements;
         uint32_t methodCallCount;
         bool allLampsOperation;
+        uint64_t traceId;
+        uint64_t traceTimestamp;
     };
 
+    /*
+     * One is allocated for every lamp of every method call, so the lamp ID and
+     * the method name are interned rather than copied
+     */
     struct QueuedMethodCallContext {
-        QueuedMethodCallContext(LSFString lampId, QueuedMethodCall* qCallPtr, LSFString met) :
-            lampID(lampId), queuedCallPtr(qCallPtr), method(met), timeSent(0) { }
+        QueuedMethodCallContext(LSFStringHandle lampId, QueuedMethodCall* qCallPtr, LSFStringHandle met) :
+            lampID(lampId), queuedCallPtr(qCallPtr), method(met), timeSent(0), traceTimestamp(0) { }
 
-        QueuedMethodCallContext(LSFString lampId, LSFString met) :
-            lampID(lampId), queuedCallPtr(NULL), method(met), timeSent(0) { }
+        QueuedMethodCallContext(const LSFString& lampId, LSFStringHandle met) :
+            lampID(LSFStringTable::Intern(lampId)), queuedCallPtr(NULL), method(met), timeSent(0), traceTimestamp(0) { }
 
-        LSFString lampID;
+        LSFStringHandle lampID;
         QueuedMethodCall* queuedCallPtr;
-        LSFString method;
+        LSFStringHandle method;
         uint64_t timeSent;
+        uint64_t traceTimestamp;
     };
 
     void SendMethodReply(LSFResponseCode responseCode, ajn::Message msg, std::list<ajn::MsgArg>& stdArgs, std::list<ajn::MsgArg>& custArgs);
@@ -447,11 +458,33 @@ class LampClients : public Manager, public ajn::BusAttachment::JoinSessionAsyncC
 
     LSFResponseCode DoGetLampState(QueuedMethodCallContext* ctx);
 
+    /*
+     * Queue a refresh of the state of a lamp unless one is already pending
+     */
+    void RefreshLampState(const LSFString& lampID);
+
+    /*
+     * Called when a refresh of the state of a lamp has completed, successfully or not.
+     * Refreshes again if the lamp changed state meanwhile
+     */
+    void LampStateRefreshCompleted(const LSFString& lampID);
+
     void QueueLampMethod(QueuedMethodCall* queuedCall);
 
     void HandleReplyWithLampResponseCode(ajn::Message& msg, void* context);
     void HandleGetReply(ajn::Message& msg, void* context);
     void HandleGetLampStateReply(ajn::Message& msg, void* context);
+
+    /*
+     * Collect a lamp state change to be signalled once the coalescing window closes
+     */
+    void QueueLampStateChanged(const LSFString& lampID, const LampState& state);
+
+    /*
+     * Signal the collected lamp state changes if the coalescing window has closed.
+     * Returns the number of ms until it closes or 0 if there is nothing left to signal
+     */
+    uint64_t SendLampStateChanges(void);
     void HandleReplyWithVariant(ajn::Message& msg, void* context);
     void HandleReplyWithKeyValuePairs(ajn::Message& msg, void* context);
     void HandleDataSetReply(ajn::Message& msg, void* context);
@@ -474,11 +507,13 @@ class LampClients : public Manager, public ajn::BusAttachment::JoinSessionAsyncC
             port = 0;
             replaced = false;
             aboutObject = NULL;
+            lampIdHandle = NULL;
             ClearSessionAndObjects();
         }
 
         void Set(LSFString& lampid, LSFString& busname, LSFString& lampName, uint16_t& sessionPort) {
             lampId = lampid;
+            lampIdHandle = LSFStringTable::Intern(lampid);
             busName = busname;
             name = lampName;
             port = sessionPort;
@@ -526,6 +561,7 @@ class LampClients : public Manager, public ajn::BusAttachment::JoinSessionAsyncC
         }
 
         LSFString lampId;
+        LSFStringHandle lampIdHandle;
         ajn::ProxyBusObject object;
         ajn::ProxyBusObject configObject;
         AboutProxy* aboutObject;
@@ -548,6 +584,18 @@ class LampClients : public Manager, public ajn::BusAttachment::JoinSessionAsyncC
     Mutex getLampStateListLock;
     GetLampStateList getLampStateList;
 
+    /*
+     * Lamps with a state refresh queued or in flight. The value is set when
+     * another LampStateChanged signal arrived in the meantime, in which case
+     * the state is refreshed once more when the current refresh completes.
+     * Protected by getLampStateListLock
+     */
+    typedef std::map<LSFString, bool> LampStateRefreshMap;
+    LampStateRefreshMap lampStateRefreshes;
+
+    Mutex lampStateChangesLock;
+    LampStateMap lampStateChanges;
+    uint64_t lampStateChangesDueTimestamp;
 
     typedef std::map<LSFString, QStatus> JoinSessionReplyMap;
 
@@ -579,11 +627,49 @@ class LampClients : public Manager, public ajn::BusAttachment::JoinSessionAsyncC
 
     volatile sig_atomic_t connectToLamps;
 
+    /**
+     * Returns true if the sessions with the lamps should be kept open. This is
+     * the case while we are the leader, and while we are a follower if
+     * OEM_CS_WARM_STANDBY_LAMP_SESSIONS is enabled
+     */
+    bool KeepLampSessions(void) {
+        return (connectToLamps || (OEM_CS_WARM_STANDBY_LAMP_SESSIONS && isRunning));
+    }
+
     uint32_t disconnectFromLampsTimestamp;
 
     volatile sig_atomic_t alarmTriggered;
 
     Alarm retryAlarm;
+
+    /**
+     * Count the connected and blacklisted lamps. Only called from the Run thread
+     */
+    void UpdateLampStatistics(void);
+
+    LSFStatistic* lampMethodCallsStatistic;
+    LSFStatistic* methodQueueDepthStatistic;
+    LSFStatistic* pendingResponsesStatistic;
+    LSFStatistic* connectedLampsStatistic;
+    LSFStatistic* blacklistedLampsStatistic;
+    LSFStatistic* internedStringsStatistic;
+    LSFStatistic* internedStringBytesStatistic;
+    LSFStatistic* lampIDCopiesStatistic;
+    LSFStatistic* stateSignalsStatistic;
+    LSFStatistic* signalledStatesStatistic;
+
+    /*
+     * The names of the lamp methods, interned once so that queuing a call
+     * does not take the lock of the string table
+     */
+    LSFStringHandle getMethod;
+    LSFStringHandle getAllMethod;
+    LSFStringHandle transitionLampStateMethod;
+    LSFStringHandle applyPulseEffectMethod;
+    LSFStringHandle clearLampFaultMethod;
+    LSFStringHandle getAboutDataMethod;
+    LSFStringHandle getConfigurationsMethod;
+    LSFStringHandle updateConfigurationsMethod;
 };
 
 OPTIONAL_NAMESPACE_CLOSE
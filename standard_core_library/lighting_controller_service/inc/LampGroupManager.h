@@ -27,9 +27,11 @@
 #ifdef LSF_BINDINGS
 #include <lsf/controllerservice/Manager.h>
 #include <lsf/controllerservice/LampManager.h>
+#include <lsf/controllerservice/DependencyIndex.h>
 #else
 #include <Manager.h>
 #include <LampManager.h>
+#include <DependencyIndex.h>
 #endif
 
 #include <LSFTypes.h>
@@ -161,6 +163,15 @@ class LampGroupManager : public Manager {
      *   LSF_OK - on success
      */
     void CreateLampGroup(ajn::Message& message);
+    /**
+     * Create several Lamp Groups at once. \n
+     * Either all the lamp groups are created or none is. They are stored with a
+     * single file write and announced with a single "LampGroupsCreated" signal. \n
+     * @param message contains MsgArg with an array of lamp group details and group names, relevant language. \n
+     * Return asynchronously response code and the lamp group ids in the order of the request. \n
+     *   LSF_OK - on success
+     */
+    void CreateLampGroups(ajn::Message& message);
     /**
      * Update Lamp Group - fill the group with other details. \n
      * Send signal to the controller client "org.allseen.LSF.ControllerService.LampGroup" "LampGroupsUpdated". \n
@@ -179,6 +190,15 @@ class LampGroupManager : public Manager {
      *   LSF_OK - on success
      */
     void DeleteLampGroup(ajn::Message& message);
+    /**
+     * Delete several Lamp Groups at once. \n
+     * Either all the lamp groups are deleted or none is. A lamp group that is
+     * nested only by other lamp groups of the same request can be deleted. \n
+     * @param message contains MsgArg with the lamp group ids. \n
+     * Return asynchronously response code and the lamp group ids. \n
+     *   LSF_OK - on success
+     */
+    void DeleteLampGroups(ajn::Message& message);
     /**
      * Get Lamp Group details. \n
      * @param message contains MsgArg with lamp group id. \n
@@ -225,22 +245,61 @@ class LampGroupManager : public Manager {
     /**
      * Handle Received Blob
      */
-    void HandleReceivedBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp);
+    void HandleReceivedBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp);
 
     /**
      * Handle Received Update Blob
      */
-    void HandleReceivedUpdateBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp);
+    void HandleReceivedUpdateBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp);
+    /**
+     * Lock the lamp groups for a configuration export or import
+     */
+    QStatus LockStore(void) {
+        return lampGroupsLock.Lock();
+    }
+    /**
+     * Unlock the lamp groups after a configuration export or import
+     */
+    QStatus UnlockStore(void) {
+        return lampGroupsLock.Unlock();
+    }
+    /**
+     * Write the lamp groups to a configuration snapshot. \n
+     * Should only be called with the store locked
+     * @param stream  The snapshot
+     */
+    void ExportConfiguration(std::ostream& stream);
+    /**
+     * Parse the lamp groups section of a configuration snapshot without applying it. \n
+     * Should only be called with the store locked
+     * @param stream            The section
+     * @param staged            The parsed lamp groups
+     * @param stagedBlobLength  Length of the persistent store holding the parsed lamp groups
+     * @return LSF_OK, LSF_ERR_NO_SLOT if there are too many lamp groups or LSF_ERR_RESOURCES if they do not fit in the persistent store
+     */
+    LSFResponseCode StageConfiguration(std::istream& stream, LampGroupMap& staged, size_t& stagedBlobLength);
+    /**
+     * Replace the lamp groups with the ones staged from a configuration snapshot. \n
+     * Should only be called with the store locked
+     * @param staged            The staged lamp groups. Holds the replaced lamp groups on return
+     * @param stagedBlobLength  Length of the persistent store holding the staged lamp groups
+     * @param changes           The IDs replaced by the import
+     */
+    void CommitConfiguration(LampGroupMap& staged, size_t stagedBlobLength, ConfigurationChanges& changes);
 
   protected:
     /**
      * Replace Map
      */
-    void ReplaceMap(std::istringstream& stream);
+    void ReplaceMap(std::istream& stream);
     /**
      * Replace Updates List
      */
-    void ReplaceUpdatesList(std::istringstream& stream);
+    void ReplaceUpdatesList(std::istream& stream);
+    /**
+     * Rebuild subGroupUsers after the lamp groups were replaced as a whole
+     */
+    void RebuildDependencyIndex(void);
     /**
      * Get String
      */
@@ -276,6 +335,7 @@ class LampGroupManager : public Manager {
 
     LampGroupMap lampGroups;                     /**< lamp groups */
     std::set<LSFString> lampGroupUpdates;        /**< List of LampGroupIDs that were updated */
+    DependencyIndex subGroupUsers;               /**< lamp groups that nest each lamp group */
     Mutex lampGroupsLock;                        /**< lamp groups lock */
     LampManager& lampManager;                    /**< lamp manager */
     SceneElementManager* sceneElementManagerPtr; /**< scene element manager pointer */
@@ -288,10 +348,20 @@ class LampGroupManager : public Manager {
      * get updates string
      */
     std::string GetUpdatesString(const std::set<LSFString>& updates);
+
+  public:
     /**
-     * get lamp group string
+     * get the persistent store line of a lamp group
+     */
+    static std::string GetString(const std::string& name, const std::string& id, const LampGroup& group);
+    /**
+     * get the length of the lamp group line without building it
+     */
+    static size_t GetStringLength(const std::string& name, const std::string& id, const LampGroup& group);
+    /**
+     * get the length of the persistent store holding the given lamp groups
      */
-    std::string GetString(const std::string& name, const std::string& id, const LampGroup& group);
+    static size_t GetBlobLength(const LampGroupMap& items);
 };
 
 OPTIONAL_NAMESPACE_CLOSE
@@ -79,17 +79,17 @@ class LeaderElectionObject : public ajn::BusObject, public Thread, public AlarmL
      * get blob reply. \n
      * Get data and metadata about lamps
      */
-    void SendGetBlobReply(ajn::Message& message, LSFBlobType type, std::string blob, uint32_t checksum, uint64_t timestamp);
+    void SendGetBlobReply(ajn::Message& message, LSFBlobType type, const std::string& blob, uint32_t checksum, uint64_t timestamp);
     /**
      * Send blob update. \n
      * Get data and metadata about lamps
      */
-    QStatus SendBlobUpdate(ajn::SessionId session, LSFBlobType type, std::string blob, uint32_t checksum, uint64_t timestamp);
+    QStatus SendBlobUpdate(ajn::SessionId session, LSFBlobType type, const std::string& blob, uint32_t checksum, uint64_t timestamp);
     /**
      * send blob update. \n
      * Send data and metadata about lamps
      */
-    QStatus SendBlobUpdate(LSFBlobType type, std::string blob, uint32_t checksum, uint64_t timestamp);
+    QStatus SendBlobUpdate(LSFBlobType type, const std::string& blob, uint32_t checksum, uint64_t timestamp);
     /**
      * On session member removed
      */
@@ -115,6 +115,44 @@ class LeaderElectionObject : public ajn::BusObject, public Thread, public AlarmL
 
     uint32_t GetLeaderElectionAndStateSyncInterfaceVersion(void);
 
+    /**
+     * Get the time it took this Controller Service to find a new leader, or
+     * to take over as the leader, after it lost its session with the previous leader
+     * @return Time in ms. 0 if no failover has taken place
+     */
+    uint32_t GetLastFailoverTimeInMs(void) {
+        return lastFailoverTimeInMs;
+    }
+
+    /**
+     * Get the duration of the last synchronization with the leader, from
+     * asking for the checksums of its stores until the last store fetched was applied
+     * @param timeInMs  Time in ms. 0 if this Controller Service has not synchronized yet
+     * @param numBlobs  Number of stores fetched
+     */
+    void GetLastSyncInfo(uint32_t& timeInMs, uint32_t& numBlobs) {
+        timeInMs = lastSyncTimeInMs;
+        numBlobs = lastSyncNumBlobs;
+    }
+
+    /**
+     * Get the latency statistics of the GetBlob replies sent to the followers. \n
+     * The latency of a reply is the time from receiving the request until the reply was sent
+     * @param numReplies      Number of replies sent
+     * @param averageLatency  Average latency in ms
+     * @param maxLatency      Highest latency in ms
+     */
+    void GetBlobReplyLatencyInfo(uint32_t& numReplies, uint64_t& averageLatency, uint64_t& maxLatency);
+
+    /**
+     * Handles the GetProperty request for the LeaderElectionAndStateSync interface
+     * @param  ifcName  Interface name
+     * @param  propName Name of the property
+     * @param  val      MsgArg to populate with the property value
+     * @return ER_OK if successful.
+     */
+    QStatus Get(const char* ifcName, const char* propName, ajn::MsgArg& val);
+
   private:
 
     /**
@@ -124,8 +162,14 @@ class LeaderElectionObject : public ajn::BusObject, public Thread, public AlarmL
 
     struct Synchronization {
         volatile int32_t numWaiting;
+        uint32_t numBlobs;
     };
 
+    /*
+     * Record the end of a synchronization started at syncStartTimestamp
+     */
+    void SyncCompleted(uint32_t numBlobs);
+
     void GetChecksumAndModificationTimestamp(const ajn::InterfaceDescription::Member* member, ajn::Message& msg);
     void OnGetChecksumAndModificationTimestampReply(ajn::Message& message, void* context);
 
@@ -136,6 +180,30 @@ class LeaderElectionObject : public ajn::BusObject, public Thread, public AlarmL
     void OnGetBlobReply(ajn::Message& message, void* context);
 
     void OnBlobChanged(const ajn::InterfaceDescription::Member* member, const char* sourcePath, ajn::Message& msg);
+    void OnCompressedBlobChanged(const ajn::InterfaceDescription::Member* member, const char* sourcePath, ajn::Message& msg);
+
+    /**
+     * Hand a received blob over to the manager that owns the blob type
+     */
+    void DispatchReceivedBlob(LSFBlobType type, const char* blob, size_t blobLength, uint32_t checksum, uint64_t timestamp);
+
+    /**
+     * Query the Version property of the current leader to find out
+     * if it understands compressed blobs
+     */
+    bool CheckLeaderSupportsBlobCompression(void);
+
+    /**
+     * Query the Version property of a new leader without waiting for the reply
+     */
+    void QueryLeaderVersion(ajn::ProxyBusObject& proxyObj);
+    void OnLeaderVersionReply(QStatus status, const ajn::MsgArg& value, SessionId sessionId);
+
+    /**
+     * Record the reply to a Version query of the leader on the given session
+     * @return true if the leader understands compressed blobs
+     */
+    bool SetLeaderVersion(SessionId sessionId, QStatus status, const ajn::MsgArg& value);
 
     ControllerService& controller;
     BusAttachment& bus;
@@ -166,6 +234,12 @@ class LeaderElectionObject : public ajn::BusObject, public Thread, public AlarmL
     void OnSessionLost(SessionId sessionId);
     void OnSessionJoined(QStatus status, SessionId sessionId, void* context);
 
+    /**
+     * Check that the current leader still responds on the leader session
+     */
+    void SendLeaderHeartbeat(void);
+    void OnLeaderHeartbeatReply(QStatus status, SessionId sessionId);
+
     typedef std::list<ajn::Message> OverThrowList;
     typedef std::map<Rank, ControllerEntry> ControllersMap;
     typedef std::map<Rank, std::pair<ControllerEntry, uint32_t> > SuccessfulJoinSessionReplies;
@@ -175,10 +249,14 @@ class LeaderElectionObject : public ajn::BusObject, public Thread, public AlarmL
     typedef struct _CurrentLeader {
         ControllerEntry controllerDetails;
         ajn::ProxyBusObject proxyObj;
+        bool versionChecked;
+        bool supportsBlobCompression;
 
         void Clear(void) {
             controllerDetails.Clear();
             proxyObj = ProxyBusObject();
+            versionChecked = false;
+            supportsBlobCompression = false;
         }
     } CurrentLeader;
 
@@ -212,6 +290,7 @@ class LeaderElectionObject : public ajn::BusObject, public Thread, public AlarmL
     volatile sig_atomic_t isRunning;
 
     const ajn::InterfaceDescription::Member* blobChangedSignal;
+    const ajn::InterfaceDescription::Member* compressedBlobChangedSignal;
 
     LSFSemaphore wakeSem;
 
@@ -223,6 +302,21 @@ class LeaderElectionObject : public ajn::BusObject, public Thread, public AlarmL
     volatile sig_atomic_t startElection;
     volatile sig_atomic_t okToSetAlarm;
     volatile sig_atomic_t gotOverthrowReply;
+
+    typedef std::map<std::pair<qcc::String, uint32_t>, uint64_t> PendingBlobRequestMap;
+    Mutex blobRequestsMutex;
+    PendingBlobRequestMap pendingBlobRequests;
+    uint32_t numBlobReplies;
+    uint64_t totalBlobReplyLatency;
+    uint64_t maxBlobReplyLatency;
+
+    volatile sig_atomic_t missedHeartbeats;
+    uint64_t nextHeartbeatTimestamp;
+    uint64_t leaderLostTimestamp;
+    volatile uint32_t lastFailoverTimeInMs;
+    uint64_t syncStartTimestamp;
+    volatile uint32_t lastSyncTimeInMs;
+    volatile uint32_t lastSyncNumBlobs;
     Mutex outGoingLeaderMutex;
     ControllerEntry outGoingLeader;
     Mutex upComingLeaderMutex;
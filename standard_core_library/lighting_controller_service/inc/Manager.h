@@ -26,9 +26,11 @@
 #include <alljoyn/Message.h>
 #include <alljoyn/InterfaceDescription.h>
 #include <alljoyn/MessageReceiver.h>
+#include <qcc/atomic.h>
 
 #include <LSFResponseCodes.h>
 #include <LSFTypes.h>
+#include <LSFStatistics.h>
 
 #include <iostream>
 #include <sstream>
@@ -44,6 +46,15 @@ OPTIONAL_NAMESPACE_CONTROLLER_SERVICE
 
 class ControllerService;
 
+/**
+ * IDs of the entities of a store that were replaced by a configuration import
+ */
+struct ConfigurationChanges {
+    LSFStringList created; /**< IDs only present in the imported configuration */
+    LSFStringList updated; /**< IDs present before and after the import */
+    LSFStringList deleted; /**< IDs not present in the imported configuration */
+};
+
 /**
  * a base class to derive by manager types of classes
  */
@@ -59,6 +70,10 @@ class Manager : public ajn::MessageReceiver {
      * Manager constructor
      */
     Manager(ControllerService& controllerSvc, const std::string& filePath = "");
+    /**
+     * Manager destructor
+     */
+    ~Manager();
     /**
      * Schedule File Read
      */
@@ -71,10 +86,76 @@ class Manager : public ajn::MessageReceiver {
      * Trigger update for persistent data
      */
     void TriggerUpdate(void);
+    /**
+     * Schedule another cycle for the GetBlob requests that were left
+     * queued because ReadWriteFile wrote the store in this cycle
+     */
+    void ScheduleDeferredReads(void);
     /**
      * Schedule File Write
      */
     void ScheduleFileWrite(bool blobUpdate = false, bool initState = false);
+    /**
+     * Read and write the persistent store. \n
+     * Invoked from a persistence worker after the manager has been
+     * scheduled for a read or write. Workers service different managers
+     * concurrently, so an implementation may only take the locks of its
+     * own manager and must not read the store of any other manager.
+     * Cross store work such as SceneManager::SyncSceneData runs on the
+     * thread that changed the stores, never on a persistence worker. \n
+     * Managers without a persistent store are never scheduled and keep
+     * this empty default
+     */
+    virtual void ReadWriteFile(void) { }
+    /**
+     * Record that a coalesced write cycle has completed
+     * @param writeRequestedTimestamp  Time of the first ScheduleFileWrite folded into the cycle
+     * @param numWriteRequests         Number of ScheduleFileWrite calls folded into the cycle
+     */
+    void WriteCompleted(uint64_t writeRequestedTimestamp, uint32_t numWriteRequests);
+    /**
+     * Get the durability latency statistics of the persistent store \n
+     * Answer returns synchronously by the reference parameters
+     * @param lastPersisted  Time at which the last write hit the disk
+     * @param lastLatency    Time in ms between the first change of the last write and it hitting the disk
+     * @param maxLatency     Largest value of lastLatency seen so far
+     * @param numWrites      Number of write cycles
+     * @param numRequests    Number of ScheduleFileWrite calls, numRequests - numWrites were coalesced
+     */
+    void GetWriteLatencyInfo(uint64_t& lastPersisted, uint64_t& lastLatency, uint64_t& maxLatency, uint32_t& numWrites, uint32_t& numRequests);
+    /**
+     * Send the Created, Updated and Deleted signals for a configuration import
+     * @param ifaceName  The interface of the store
+     * @param entities   Prefix of the signal names, e.g. "LampGroups"
+     * @param changes    The IDs replaced by the import
+     */
+    void SendConfigurationSignals(const char* ifaceName, const char* entities, const ConfigurationChanges& changes);
+
+    /**
+     * Compare the IDs of a store before and after a configuration import. \n
+     * Both maps are keyed by ID, so a single ordered pass finds the changes
+     * @param previous  The store before the import
+     * @param current   The store after the import
+     * @param changes   The IDs replaced by the import
+     */
+    template <typename PreviousMap, typename CurrentMap>
+    static void GetConfigurationChanges(const PreviousMap& previous, const CurrentMap& current, ConfigurationChanges& changes) {
+        typename PreviousMap::const_iterator pit = previous.begin();
+        typename CurrentMap::const_iterator cit = current.begin();
+        while ((pit != previous.end()) || (cit != current.end())) {
+            if ((cit == current.end()) || ((pit != previous.end()) && (pit->first < cit->first))) {
+                changes.deleted.push_back(pit->first);
+                ++pit;
+            } else if ((pit == previous.end()) || (cit->first < pit->first)) {
+                changes.created.push_back(cit->first);
+                ++cit;
+            } else {
+                changes.updated.push_back(cit->first);
+                ++pit;
+                ++cit;
+            }
+        }
+    }
 
     //protected:
     /**
@@ -92,26 +173,28 @@ class Manager : public ajn::MessageReceiver {
     const std::string filePath; /**< the file location */
 
     std::string updateFilePath; /**< the update file location */
+
+    class BlobSnapshotStream;
     /**
      * Reading from file
      */
-    bool ValidateFileAndRead(std::istringstream& filestream);
+    bool ValidateFileAndRead(BlobSnapshotStream& filestream);
     /**
      * Reading from file
      */
-    bool ValidateUpdateFileAndRead(std::istringstream& filestream);
+    bool ValidateUpdateFileAndRead(BlobSnapshotStream& filestream);
     /**
      * Reading from file
      */
-    bool ValidateFileAndReadInternal(uint32_t& checksum, uint64_t& timestamp, std::istringstream& filestream);
+    bool ValidateFileAndReadInternal(uint32_t& checksum, uint64_t& timestamp, BlobSnapshotStream& filestream);
     /**
      * Reading from update file
      */
-    bool ValidateUpdateFileAndReadInternal(uint32_t& checksum, uint64_t& timestamp, std::istringstream& filestream);
+    bool ValidateUpdateFileAndReadInternal(uint32_t& checksum, uint64_t& timestamp, BlobSnapshotStream& filestream);
     /**
-     * Get checksum of file
+     * Get the Adler-32 checksum of a file blob
      */
-    uint32_t GetChecksum(const std::string& str);
+    static uint32_t GetChecksum(const std::string& str);
     /**
      * Get file information \n
      * Answer returns synchronously by the reference parameters
@@ -132,6 +215,95 @@ class Manager : public ajn::MessageReceiver {
     void WriteFileWithChecksumAndTimestamp(const std::string& str, uint32_t checksum, uint64_t timestamp);
     void WriteUpdatesFileWithChecksumAndTimestamp(const std::string& str, uint32_t checksum, uint64_t timestamp);
 
+    /**
+     * Immutable copy of a persistent store as it was last written to or read from disk. \n
+     * Readers hold a reference to a snapshot instead of copying the blob. A change
+     * to the store replaces the snapshot rather than modifying it
+     */
+    class BlobSnapshot {
+      public:
+        BlobSnapshot(const std::string& blob, uint32_t checksum, uint64_t timestamp, uint32_t version) :
+            blob(blob), checksum(checksum), timestamp(timestamp), version(version), refCount(1) { }
+
+        void AddRef(void) {
+            qcc::IncrementAndFetch(&refCount);
+        }
+
+        void Release(void) {
+            if (0 == qcc::DecrementAndFetch(&refCount)) {
+                delete this;
+            }
+        }
+
+        const std::string blob;
+        const uint32_t checksum;
+        const uint64_t timestamp;
+        const uint32_t version; /**< incremented every time the store is written */
+
+      private:
+        ~BlobSnapshot() { }
+        volatile int32_t refCount;
+    };
+    /**
+     * Input stream that reads a snapshot in place. It holds a reference to the
+     * snapshot for as long as it reads from it
+     */
+    class BlobSnapshotStream : private std::streambuf, public std::istream {
+      public:
+        BlobSnapshotStream() : std::istream(this), snapshot(NULL) { }
+
+        ~BlobSnapshotStream() {
+            Attach(NULL);
+        }
+        /**
+         * Read from another snapshot
+         * @param newSnapshot  A snapshot reference that the stream takes over, or NULL
+         */
+        void Attach(BlobSnapshot* newSnapshot) {
+            if (snapshot) {
+                snapshot->Release();
+            }
+            snapshot = newSnapshot;
+            char* begin = snapshot ? const_cast<char*>(snapshot->blob.data()) : NULL;
+            setg(begin, begin, snapshot ? (begin + snapshot->blob.size()) : NULL);
+            clear();
+        }
+        /**
+         * The blob that is read
+         */
+        const std::string& str(void) const {
+            return snapshot ? snapshot->blob : empty;
+        }
+
+      private:
+        BlobSnapshotStream(const BlobSnapshotStream&);
+        BlobSnapshotStream& operator=(const BlobSnapshotStream&);
+
+        BlobSnapshot* snapshot;
+        const std::string empty;
+    };
+    /**
+     * Replace a snapshot after its persistent store was written or read
+     * @param mainStore  true if snapshot is the snapshot of the main persistent store
+     *                   of the manager, whose size is reported in the statistics
+     */
+    void SetBlobSnapshot(BlobSnapshot*& snapshot, const std::string& blob, uint32_t checksum, uint64_t timestamp, bool mainStore);
+    /**
+     * Get a reference to a snapshot. The caller must Release() the returned snapshot
+     * @return NULL if there is no snapshot of the store yet
+     */
+    BlobSnapshot* GetBlobSnapshot(BlobSnapshot* const& snapshot);
+    /**
+     * Reply to a GetBlob request from a snapshot
+     * @return false if the snapshot cannot be used and the request has to be served from disk
+     */
+    bool SendBlobSnapshot(ajn::Message& message, BlobSnapshot* const& snapshot);
+    /**
+     * Read a persistent store from its snapshot instead of from disk
+     * @return false if there is no snapshot of the store yet
+     */
+    bool ReadBlobSnapshot(BlobSnapshot* const& snapshot, uint32_t& checksum, uint64_t& timestamp, BlobSnapshotStream& filestream);
+
     uint32_t checkSum; /**< checkSum of the file */
     uint32_t updatesCheckSum; /**< checkSum of the updates file */
     uint64_t timeStamp; /**< timestamp of the file */
@@ -142,7 +314,22 @@ class Manager : public ajn::MessageReceiver {
     std::list<ajn::Message> readBlobMessages; /**< Read blob messages */
     std::list<ajn::Message> readUpdateBlobMessages; /**< Read update blob messages */
 
+    Mutex blobSnapshotMutex; /**< blob snapshot mutex */
+    BlobSnapshot* blobSnapshot; /**< snapshot of the file */
+    BlobSnapshot* updateBlobSnapshot; /**< snapshot of the updates file */
+    uint32_t blobSnapshotVersion; /**< version of the latest snapshot */
+
     volatile sig_atomic_t sendUpdate;         /**< send update */
+
+    Mutex writeStatsMutex;         /**< write latency statistics mutex */
+    uint64_t lastPersistedTimestamp; /**< time at which the last write hit the disk */
+    uint64_t lastWriteLatency; /**< durability latency of the last write in ms */
+    uint64_t maxWriteLatency; /**< largest durability latency in ms */
+    uint32_t numWriteCycles; /**< number of write cycles */
+    uint32_t numWriteRequests; /**< number of ScheduleFileWrite calls */
+
+    LSFStatistic* writeLatencyStatistic; /**< durability latency histogram in ms */
+    LSFStatistic* blobBytesStatistic; /**< size of the persistent store in bytes */
 };
 
 OPTIONAL_NAMESPACE_CLOSE
@@ -26,9 +26,11 @@
 #ifdef LSF_BINDINGS
 #include <lsf/controllerservice/Manager.h>
 #include <lsf/controllerservice/SceneManager.h>
+#include <lsf/controllerservice/DependencyIndex.h>
 #else
 #include <Manager.h>
 #include <SceneManager.h>
+#include <DependencyIndex.h>
 #endif
 
 #include <Mutex.h>
@@ -184,27 +186,81 @@ class MasterSceneManager : public Manager {
      * @param checksum
      * @param timestamp
      */
-    void HandleReceivedBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp);
+    void HandleReceivedBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp);
     /**
      * Handle Received Update Blob
      */
-    void HandleReceivedUpdateBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp);
+    void HandleReceivedUpdateBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp);
+    /**
+     * Lock the master scenes for a configuration export or import
+     */
+    QStatus LockStore(void) {
+        return masterScenesLock.Lock();
+    }
+    /**
+     * Unlock the master scenes after a configuration export or import
+     */
+    QStatus UnlockStore(void) {
+        return masterScenesLock.Unlock();
+    }
+    /**
+     * Write the master scenes to a configuration snapshot. \n
+     * Should only be called with the store locked
+     * @param stream  The snapshot
+     */
+    void ExportConfiguration(std::ostream& stream);
+    /**
+     * Parse the master scenes section of a configuration snapshot without applying it. \n
+     * Should only be called with the store locked
+     * @param stream            The section
+     * @param staged            The parsed master scenes
+     * @param stagedBlobLength  Length of the persistent store holding the parsed master scenes
+     * @return LSF_OK, LSF_ERR_NO_SLOT if there are too many master scenes or LSF_ERR_RESOURCES if they do not fit in the persistent store
+     */
+    LSFResponseCode StageConfiguration(std::istream& stream, MasterSceneMap& staged, size_t& stagedBlobLength);
+    /**
+     * Replace the master scenes with the ones staged from a configuration snapshot. \n
+     * Should only be called with the store locked
+     * @param staged            The staged master scenes. Holds the replaced master scenes on return
+     * @param stagedBlobLength  Length of the persistent store holding the staged master scenes
+     * @param changes           The IDs replaced by the import
+     */
+    void CommitConfiguration(MasterSceneMap& staged, size_t stagedBlobLength, ConfigurationChanges& changes);
 
   private:
 
-    void ReplaceMap(std::istringstream& stream);
+    void ReplaceMap(std::istream& stream);
 
-    void ReplaceUpdatesList(std::istringstream& stream);
+    void ReplaceUpdatesList(std::istream& stream);
+
+    /**
+     * Rebuild sceneUsers after the master scenes were replaced as a whole
+     */
+    void RebuildDependencyIndex(void);
 
     MasterSceneMap masterScenes;
     std::set<LSFString> masterSceneUpdates;    /**< List of MasterSceneIDs that were updated */
     Mutex masterScenesLock;
     SceneManager& sceneManager;
     size_t blobLength;
+    DependencyIndex sceneUsers;    /**< master scenes that apply each scene */
 
     std::string GetString(const MasterSceneMap& items);
     std::string GetUpdatesString(const std::set<LSFString>& updates);
-    std::string GetString(const std::string& name, const std::string& id, const MasterScene& msc);
+
+  public:
+    /**
+     * get the persistent store line of a master scene
+     */
+    static std::string GetString(const std::string& name, const std::string& id, const MasterScene& msc);
+    /**
+     * get the length of the master scene line without building it
+     */
+    static size_t GetStringLength(const std::string& name, const std::string& id, const MasterScene& msc);
+    /**
+     * get the length of the persistent store holding the given master scenes
+     */
+    static size_t GetBlobLength(const MasterSceneMap& items);
 };
 
 OPTIONAL_NAMESPACE_CLOSE
@@ -0,0 +1,191 @@
+#ifndef METHOD_CALL_EXECUTOR_H
+#define METHOD_CALL_EXECUTOR_H
+/**
+ * \ingroup ControllerService
+ */
+/**
+ * @file
+ * This file provides definitions for the method call executor
+ */
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <list>
+#include <set>
+
+#include <alljoyn/Message.h>
+
+#include <Thread.h>
+#include <LSFSemaphore.h>
+#include <Mutex.h>
+
+#ifdef LSF_BINDINGS
+#include <lsf/controllerservice/OEM_CS_Config.h>
+#include <lsf/controllerservice/RequestTracer.h>
+#else
+#include <OEM_CS_Config.h>
+#include <RequestTracer.h>
+#endif
+
+#include "LSFNamespaceSpecifier.h"
+
+namespace lsf {
+
+OPTIONAL_NAMESPACE_CONTROLLER_SERVICE
+
+/**
+ * Number of latency buckets. Bucket i counts calls that took less than 2^i ms
+ */
+#define METHOD_CALL_LATENCY_BUCKETS 16
+
+/**
+ * Interface of the objects that handle a Controller Service method call
+ */
+class MethodCallHandler {
+  public:
+    /**
+     * class destructor
+     */
+    virtual ~MethodCallHandler() { }
+    /**
+     * Handle the method call
+     * @param msg  The method call message
+     */
+    virtual void Handle(ajn::Message& msg) = 0;
+};
+
+/**
+ * Executes Controller Service method calls on a bounded pool of worker
+ * threads instead of the AllJoyn dispatcher threads. \n
+ * Calls queued with a serial key are executed one at a time and in the order
+ * they were received for that key. Calls queued without a serial key run
+ * concurrently with everything else.
+ */
+class MethodCallExecutor {
+  public:
+    /**
+     * class constructor
+     */
+    MethodCallExecutor();
+    /**
+     * class destructor
+     */
+    ~MethodCallExecutor();
+    /**
+     * Start the worker threads
+     * @return ER_OK if at least one worker was started
+     */
+    QStatus Start(void);
+    /**
+     * Stop the worker threads. Method calls that are still queued are not
+     * executed, they are handed back so that the caller can reply to them
+     * @param droppedCalls  The method calls that were still queued
+     */
+    void Stop(std::list<ajn::Message>& droppedCalls);
+    /**
+     * Join the worker threads after stopped
+     */
+    void Join(void);
+    /**
+     * Queue a method call for execution
+     * @param handler    The handler of the method call
+     * @param msg        The method call message
+     * @param serialKey  Calls with the same non-NULL key are executed one at a time
+     * @return false if the queue is full or the executor is not running, in which
+     *         case the caller is responsible for replying to the method call
+     */
+    bool Submit(MethodCallHandler* handler, const ajn::Message& msg, const void* serialKey);
+    /**
+     * Get the latency statistics of the executed method calls. \n
+     * The latency of a call is the time from Submit until its handler returned.
+     * Percentiles are reported as the upper bound of a power of two bucket in ms
+     * @param numCalls          Number of executed method calls
+     * @param numRejectedCalls  Number of method calls rejected because the queue was full
+     * @param p50               50th percentile latency in ms
+     * @param p99               99th percentile latency in ms
+     * @param maxLatencyMs      Highest latency in ms
+     */
+    void GetLatencyInfo(uint64_t& numCalls, uint64_t& numRejectedCalls, uint32_t& p50, uint32_t& p99, uint32_t& maxLatencyMs);
+
+  private:
+
+    class Worker : public Thread {
+      public:
+        Worker(MethodCallExecutor& owner) : owner(owner) { }
+        virtual void Run() {
+            owner.ExecuteMethodCalls();
+        }
+        /**
+         * The workers share the queue of the executor, so stopping one
+         * worker stops all of them
+         */
+        virtual void Stop() {
+            owner.StopWorkers();
+        }
+      private:
+        MethodCallExecutor& owner;
+    };
+
+    /**
+     * Clear the running flag and wake every worker so that they exit
+     */
+    void StopWorkers(void);
+
+    /**
+     * Worker loop
+     */
+    void ExecuteMethodCalls(void);
+
+    void RecordLatency(uint64_t latency);
+
+    /**
+     * A method call waiting for a worker
+     */
+    struct QueuedMethodCall {
+        MethodCallHandler* handler;
+        ajn::Message msg;
+        const void* serialKey;
+        uint64_t submittedTimestamp;
+        uint64_t traceTimestamp;
+
+        QueuedMethodCall(MethodCallHandler* handler, const ajn::Message& msg, const void* serialKey, uint64_t submittedTimestamp) :
+            handler(handler), msg(msg), serialKey(serialKey), submittedTimestamp(submittedTimestamp), traceTimestamp(LSF_TRACE_TIMESTAMP()) { }
+    };
+
+    volatile bool running;
+    LSFSemaphore semaphore;
+
+    Mutex queueLock;
+    std::list<QueuedMethodCall> queue;
+    std::set<const void*> busyKeys;
+    size_t numSerialWorkers;
+    size_t maxSerialWorkers;
+
+    Worker* workers[OEM_CS_NUM_METHOD_CALL_WORKERS];
+
+    Mutex statsLock;
+    uint64_t latencyBuckets[METHOD_CALL_LATENCY_BUCKETS];
+    uint64_t numExecuted;
+    uint64_t numRejected;
+    uint32_t maxLatency;
+};
+
+OPTIONAL_NAMESPACE_CLOSE
+
+} //lsf
+
+
+#endif
@@ -58,6 +58,123 @@ OPTIONAL_NAMESPACE_CONTROLLER_SERVICE
  */
 #define OEM_CS_TIMEOUT_MS_CONNECTED_TO_ROUTING_NODE 5000
 
+/**
+ * Number of worker threads used to read and write the persistent stores.
+ * Each worker services one dirty manager at a time, so independent stores
+ * are serialised and written concurrently. Must be at least 1
+ */
+#define OEM_CS_NUM_PERSISTENCE_WORKERS 2
+
+/**
+ * Time in milliseconds that a persistent store write is held back so that
+ * a burst of changes is written to disk and synced to the other Controller
+ * Services once. Reads of the persistent store are never held back.
+ * Every write, including a lone one, is delayed by up to this time, so the
+ * window is off (0) by default and every change is written immediately.
+ * Changes that arrive while a store is being written are still folded into
+ * one follow up write
+ */
+#define OEM_CS_PERSISTENCE_WRITE_COALESCE_MS 0
+
+/**
+ * Number of worker threads that execute Controller Service method calls.
+ * Calls that modify a manager are executed one at a time per manager and may
+ * occupy at most all but one of the workers, so read requests are never
+ * stalled behind them. Must be at least 1
+ */
+#define OEM_CS_NUM_METHOD_CALL_WORKERS 4
+
+/**
+ * Maximum number of Controller Service method calls waiting for a worker.
+ * Calls received while the queue is full are answered with LSF_ERR_BUSY
+ */
+#define OEM_CS_MAX_METHOD_CALL_QUEUE_SIZE 200
+
+/**
+ * Time in milliseconds that lamp state changes are collected before they are
+ * signalled to the Controller Clients. A lamp that changes state several times
+ * within the window is signalled once with its latest state, at the cost of
+ * delaying every LampStateChanged signal by up to the window.
+ * Off (0) by default, so that every change is signalled immediately
+ */
+#define OEM_CS_LAMP_STATE_CHANGED_COALESCE_MS 0
+
+/**
+ * Set to 1 to signal the lamp state changes collected in a window with a single
+ * LampsStateChanged signal instead of one LampStateChanged signal per lamp.
+ * Only enable this if every Controller Client on the network implements
+ * version 2 or later of the ControllerService.Lamp interface
+ */
+#define OEM_CS_SEND_BATCHED_LAMP_STATE_UPDATES 0
+
+/**
+ * Set to 1 to have the leader broadcast blob updates to the followers using
+ * the CompressedBlobChanged signal instead of BlobChanged. Only enable this
+ * if every Controller Service on the network implements version 2 or later
+ * of the LeaderElectionAndStateSync interface. Blobs fetched by followers
+ * are compressed whenever the leader supports it, regardless of this setting
+ */
+#define OEM_CS_SEND_COMPRESSED_BLOB_UPDATES 0
+
+/**
+ * Set to 1 to have followers keep their sessions with the lamps open while
+ * they are not the leader. A follower that takes over as the leader can then
+ * serve lamp requests straight away instead of joining a session with every
+ * lamp first. Each Controller Service on the network then holds a session with
+ * every lamp, so only enable this if the lamps can accept that many sessions
+ */
+#define OEM_CS_WARM_STANDBY_LAMP_SESSIONS 0
+
+/**
+ * Time in milliseconds that a Controller Service waits for a leader
+ * announcement after it starts an election
+ */
+#define OEM_CS_ELECTION_INTERVAL_MS 1000
+
+/**
+ * Time in milliseconds that a Controller Service waits for the announcement
+ * of a higher ranking Controller Service before it takes over as the leader.
+ * This should comfortably exceed the time About announcements take to reach
+ * the other Controller Services on the network
+ */
+#define OEM_CS_LEADER_ANNOUNCEMENT_WAIT_MS 2000
+
+/**
+ * Time in milliseconds allowed for an overthrow of the current leader
+ * to complete
+ */
+#define OEM_CS_OVERTHROW_TIMEOUT_MS 5000
+
+/**
+ * Interval in milliseconds at which a follower checks that the leader is
+ * still responding on the leader session. The leader is treated as lost after
+ * OEM_CS_LEADER_HEARTBEAT_MISSES consecutive checks time out, without waiting
+ * for the link timeout of the session. Set to 0 to disable the heartbeat.
+ * For sub-second failover, enable the heartbeat and reduce the election
+ * intervals above
+ */
+#define OEM_CS_LEADER_HEARTBEAT_INTERVAL_MS 0
+
+/**
+ * Number of consecutive heartbeats the leader may miss before a follower
+ * leaves the leader session and starts looking for a new leader
+ */
+#define OEM_CS_LEADER_HEARTBEAT_MISSES 3
+
+/**
+ * Set to 1 to record when each Controller Service method call enters and
+ * leaves the stages of the request pipeline, from the dispatcher down to the
+ * lamp replies. The records are kept in a ring buffer that can be written out
+ * in the Chrome trace event format. When set to 0 the tracing is compiled out
+ */
+#define OEM_CS_REQUEST_TRACING 0
+
+/**
+ * Number of stage records kept in the request trace ring buffer. The oldest
+ * records are overwritten first. Must be a power of two
+ */
+#define OEM_CS_REQUEST_TRACE_BUFFER_SIZE 8192
+
 /**
  * Returns the factory set value of the default lamp state. The
  * PresetManager will use this value to initialize the default
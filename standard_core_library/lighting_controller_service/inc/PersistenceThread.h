@@ -23,8 +23,19 @@
  *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
+#include <list>
+#include <set>
+
 #include <Thread.h>
 #include <LSFSemaphore.h>
+#include <Mutex.h>
+
+#ifdef LSF_BINDINGS
+#include <lsf/controllerservice/OEM_CS_Config.h>
+#else
+#include <OEM_CS_Config.h>
+#endif
+
 #include "LSFNamespaceSpecifier.h"
 
 namespace lsf {
@@ -32,8 +43,15 @@ namespace lsf {
 OPTIONAL_NAMESPACE_CONTROLLER_SERVICE
 
 class ControllerService;
+class Manager;
 /**
- * Thread dedicated for persisted data
+ * Thread dedicated for persisted data. \n
+ * Only managers that have been marked dirty through SignalReadWrite are
+ * serviced. Up to OEM_CS_NUM_PERSISTENCE_WORKERS managers are serviced
+ * concurrently but a given manager is never serviced by two workers at once. \n
+ * This is safe because Manager::ReadWriteFile only takes the locks of the
+ * manager being serviced, so two workers never contend on a store lock and
+ * never see another store half way through an update.
  */
 class PersistenceThread : public Thread {
   public:
@@ -46,9 +64,13 @@ class PersistenceThread : public Thread {
      */
     virtual ~PersistenceThread();
     /**
-     * Signal to the thread to be active
+     * Mark a manager as needing a read/write cycle and wake a worker
+     * @param manager  The manager to service
+     * @param write    true if the cycle was requested to write out a change. Writes
+     *                 are held back for OEM_CS_PERSISTENCE_WRITE_COALESCE_MS so that
+     *                 bursts are written once
      */
-    void SignalReadWrite();
+    void SignalReadWrite(Manager* manager, bool write = false);
     /**
      * Thread run method
      */
@@ -63,9 +85,51 @@ class PersistenceThread : public Thread {
     virtual void Join();
 
   private:
+
+    /**
+     * Additional worker servicing the dirty manager queue
+     */
+    class Worker : public Thread {
+      public:
+        Worker(PersistenceThread& owner) : owner(owner) { }
+        virtual void Run() {
+            owner.ServiceDirtyManagers();
+        }
+        /**
+         * The workers share the queue of the persistence thread, so
+         * stopping one worker stops all of them
+         */
+        virtual void Stop() {
+            owner.Stop();
+        }
+      private:
+        PersistenceThread& owner;
+    };
+
+    /**
+     * Worker loop shared by the persistence thread and the additional workers
+     */
+    void ServiceDirtyManagers(void);
+
     ControllerService& service;
-    bool running;
+    volatile bool running;
     LSFSemaphore semaphore;
+
+    /**
+     * A manager waiting to be serviced
+     */
+    struct DirtyManager {
+        Manager* manager;
+        uint64_t dueTimestamp;              /**< do not service before this time */
+        uint64_t writeRequestedTimestamp;   /**< time of the first write request, 0 if none */
+        uint32_t numWriteRequests;          /**< number of write requests folded into this cycle */
+    };
+
+    Mutex dirtyManagersLock;
+    std::list<DirtyManager> dirtyManagers;
+    std::set<Manager*> busyManagers;
+
+    Worker* workers[OEM_CS_NUM_PERSISTENCE_WORKERS];
 };
 
 OPTIONAL_NAMESPACE_CLOSE
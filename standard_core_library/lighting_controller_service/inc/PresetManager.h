@@ -108,6 +108,19 @@ class PresetManager : public Manager {
      *
      */
     void CreatePreset(ajn::Message& msg);
+    /**
+     * Create several presets at once. \n
+     * Either all the presets are created or none is. They are stored with a
+     * single file write and announced with a single 'PresetsCreated' signal. \n
+     * @param msg  contains an array of lamp states and preset names, relevant language. \n
+     * Return asynchronously the response code and the unique ids in the order of the request. \n
+     * response code LSF_OK on success. \n
+     *      LSF_ERR_INVALID_ARGS - language not supported, name is too long, empty state. \n
+     *      LSF_ERR_EMPTY_NAME - preset name is empty. \n
+     *      LSF_ERR_NO_SLOT - too many presets. \n
+     *      LSF_ERR_RESOURCES - blob is too big. \n
+     */
+    void CreatePresets(ajn::Message& msg);
     /**
      * Update existing preset. \n
      * @param msg type Message with MsgArgs: preset id. \n
@@ -118,6 +131,18 @@ class PresetManager : public Manager {
      *      LSF_ERR_RESOURCES - blob is too big. \n
      */
     void UpdatePreset(ajn::Message& msg);
+    /**
+     * Update several presets at once. \n
+     * Either all the presets are updated or none is. They are stored with a
+     * single file write and announced with a single 'PresetsUpdated' signal. \n
+     * @param msg  contains an array of preset ids and lamp states. \n
+     * Return asynchronously the response code and the unique ids of the updated presets. \n
+     * response code LSF_OK on success. \n
+     *      LSF_ERR_INVALID_ARGS - empty state. \n
+     *      LSF_ERR_NOT_FOUND - a preset does not exist. \n
+     *      LSF_ERR_RESOURCES - blob is too big. \n
+     */
+    void UpdatePresets(ajn::Message& msg);
     /**
      * Delete existing preset. \n
      * @param msg type Message with MsgArgs: preset id. \n
@@ -127,6 +152,17 @@ class PresetManager : public Manager {
      *      LSF_ERR_NOT_FOUND - preset with requested id is not found. \n
      */
     void DeletePreset(ajn::Message& msg);
+    /**
+     * Delete several presets at once. \n
+     * Either all the presets are deleted or none is. \n
+     * @param msg type Message with MsgArgs: preset ids. \n
+     * Return asynchronously the response code and the unique ids. \n
+     * Send signal to the controller clients 'org.allseen.LSF.ControllerService.Preset' 'PresetsDeleted'. \n
+     * response code LSF_OK on success. \n
+     *      LSF_ERR_NOT_FOUND - a preset is not found. \n
+     *      LSF_ERR_DEPENDENCY - a preset is used by a scene element. \n
+     */
+    void DeletePresets(ajn::Message& msg);
     /**
      * Get existing preset. \n
      * @param msg type Message with MsgArgs: preset id. \n
@@ -186,11 +222,46 @@ class PresetManager : public Manager {
      * Handle received blob. \n
      * Getting the blob string and wrting it to the file. \n
      */
-    void HandleReceivedBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp);
+    void HandleReceivedBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp);
     /**
      * Handle Received Update Blob
      */
-    void HandleReceivedUpdateBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp);
+    void HandleReceivedUpdateBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp);
+    /**
+     * Lock the presets for a configuration export or import
+     */
+    QStatus LockStore(void) {
+        return presetsLock.Lock();
+    }
+    /**
+     * Unlock the presets after a configuration export or import
+     */
+    QStatus UnlockStore(void) {
+        return presetsLock.Unlock();
+    }
+    /**
+     * Write the presets to a configuration snapshot. \n
+     * Should only be called with the store locked
+     * @param stream  The snapshot
+     */
+    void ExportConfiguration(std::ostream& stream);
+    /**
+     * Parse the presets section of a configuration snapshot without applying it. \n
+     * Should only be called with the store locked
+     * @param stream            The section
+     * @param staged            The parsed presets
+     * @param stagedBlobLength  Length of the persistent store holding the parsed presets
+     * @return LSF_OK, LSF_ERR_NO_SLOT if there are too many presets or LSF_ERR_RESOURCES if they do not fit in the persistent store
+     */
+    LSFResponseCode StageConfiguration(std::istream& stream, PresetMap& staged, size_t& stagedBlobLength);
+    /**
+     * Replace the presets with the ones staged from a configuration snapshot. \n
+     * Should only be called with the store locked
+     * @param staged            The staged presets. Holds the replaced presets on return
+     * @param stagedBlobLength  Length of the persistent store holding the staged presets
+     * @param changes           The IDs replaced by the import
+     */
+    void CommitConfiguration(PresetMap& staged, size_t stagedBlobLength, ConfigurationChanges& changes);
     /**
      * Get Controller Service Preset Interface Version. \n
      * @return 32 unsigned integer version. \n
@@ -220,9 +291,9 @@ class PresetManager : public Manager {
 
   private:
 
-    void ReplaceMap(std::istringstream& stream);
+    void ReplaceMap(std::istream& stream);
 
-    void ReplaceUpdatesList(std::istringstream& stream);
+    void ReplaceUpdatesList(std::istream& stream);
 
     LSFResponseCode CreatePresetInternal(LampState& preset, LSFString& name, LSFString& language, LSFString& presetID);
 
@@ -236,7 +307,20 @@ class PresetManager : public Manager {
 
     std::string GetString(const PresetMap& items);
     std::string GetUpdatesString(const std::set<LSFString>& updates);
-    std::string GetString(const std::string& name, const std::string& id, const LampState& preset);
+
+  public:
+    /**
+     * get the persistent store line of a preset, which is shorter for a null state
+     */
+    static std::string GetString(const std::string& name, const std::string& id, const LampState& preset);
+    /**
+     * get the length of the preset line without building it
+     */
+    static size_t GetStringLength(const std::string& name, const std::string& id, const LampState& preset);
+    /**
+     * get the length of the persistent store holding the given presets
+     */
+    static size_t GetBlobLength(const PresetMap& items);
 };
 
 OPTIONAL_NAMESPACE_CLOSE
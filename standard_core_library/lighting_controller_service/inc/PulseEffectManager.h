@@ -171,11 +171,46 @@ class PulseEffectManager : public Manager {
      * Handle received blob. \n
      * Getting the blob string and wrting it to the file. \n
      */
-    void HandleReceivedBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp);
+    void HandleReceivedBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp);
     /**
      * Handle Received Update Blob
      */
-    void HandleReceivedUpdateBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp);
+    void HandleReceivedUpdateBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp);
+    /**
+     * Lock the pulse effects for a configuration export or import
+     */
+    QStatus LockStore(void) {
+        return pulseEffectsLock.Lock();
+    }
+    /**
+     * Unlock the pulse effects after a configuration export or import
+     */
+    QStatus UnlockStore(void) {
+        return pulseEffectsLock.Unlock();
+    }
+    /**
+     * Write the pulse effects to a configuration snapshot. \n
+     * Should only be called with the store locked
+     * @param stream  The snapshot
+     */
+    void ExportConfiguration(std::ostream& stream);
+    /**
+     * Parse the pulse effects section of a configuration snapshot without applying it. \n
+     * Should only be called with the store locked
+     * @param stream            The section
+     * @param staged            The parsed pulse effects
+     * @param stagedBlobLength  Length of the persistent store holding the parsed pulse effects
+     * @return LSF_OK, LSF_ERR_NO_SLOT if there are too many pulse effects or LSF_ERR_RESOURCES if they do not fit in the persistent store
+     */
+    LSFResponseCode StageConfiguration(std::istream& stream, PulseEffectMap& staged, size_t& stagedBlobLength);
+    /**
+     * Replace the pulse effects with the ones staged from a configuration snapshot. \n
+     * Should only be called with the store locked
+     * @param staged            The staged pulse effects. Holds the replaced pulse effects on return
+     * @param stagedBlobLength  Length of the persistent store holding the staged pulse effects
+     * @param changes           The IDs replaced by the import
+     */
+    void CommitConfiguration(PulseEffectMap& staged, size_t stagedBlobLength, ConfigurationChanges& changes);
     /**
      * Get Controller Service PulseEffect Interface Version. \n
      * @return 32 unsigned integer version. \n
@@ -205,9 +240,9 @@ class PulseEffectManager : public Manager {
 
   private:
 
-    void ReplaceMap(std::istringstream& stream);
+    void ReplaceMap(std::istream& stream);
 
-    void ReplaceUpdatesList(std::istringstream& stream);
+    void ReplaceUpdatesList(std::istream& stream);
 
     LSFResponseCode CreatePulseEffectInternal(PulseEffect& pulseEffect, LSFString& name, LSFString& language, LSFString& pulseEffectID);
 
@@ -224,7 +259,21 @@ class PulseEffectManager : public Manager {
 
     std::string GetString(const PulseEffectMap& items);
     std::string GetUpdatesString(const std::set<LSFString>& updates);
-    std::string GetString(const std::string& name, const std::string& id, const PulseEffect& pulseEffect);
+
+  public:
+    /**
+     * get the persistent store line of a pulse effect, which names the
+     * presets instead of the states when the to state is null
+     */
+    static std::string GetString(const std::string& name, const std::string& id, const PulseEffect& pulseEffect);
+    /**
+     * get the length of the pulse effect line without building it
+     */
+    static size_t GetStringLength(const std::string& name, const std::string& id, const PulseEffect& pulseEffect);
+    /**
+     * get the length of the persistent store holding the given pulse effects
+     */
+    static size_t GetBlobLength(const PulseEffectMap& items);
 };
 
 OPTIONAL_NAMESPACE_CLOSE
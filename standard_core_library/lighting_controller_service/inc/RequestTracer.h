@@ -0,0 +1,135 @@
+#ifndef REQUEST_TRACER_H
+#define REQUEST_TRACER_H
+/**
+ * \ingroup ControllerService
+ */
+/**
+ * @file
+ * This file provides definitions for the request tracer
+ */
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <stdint.h>
+#include <string>
+
+#include <alljoyn/Status.h>
+#include <alljoyn/Message.h>
+
+#ifdef LSF_BINDINGS
+#include <lsf/controllerservice/OEM_CS_Config.h>
+#else
+#include <OEM_CS_Config.h>
+#endif
+
+#include <LSFTypes.h>
+
+#include "LSFNamespaceSpecifier.h"
+
+namespace lsf {
+
+OPTIONAL_NAMESPACE_CONTROLLER_SERVICE
+
+/**
+ * Records the time spent by Controller Service method calls in each stage of
+ * the request pipeline. \n
+ * A request is identified by the sender and the call serial of the incoming
+ * method call, so the stages of a request need nothing but the message to be
+ * attributed. The records are kept in a fixed size ring buffer that is written
+ * without locks
+ */
+class RequestTracer {
+  public:
+    /**
+     * Get the trace ID of a method call. \n
+     * Call serials are only unique per sender, so the serial is kept in the
+     * low 32 bits and a 21 bit hash of the sender's unique name in the bits
+     * above it. The ID stays below 2^53 so that it is exact in a JSON viewer
+     * @param msg  The incoming method call
+     * @return The trace ID
+     */
+    static uint64_t GetTraceId(const ajn::Message& msg);
+
+    /**
+     * Record a stage of a request
+     * @param traceId         The trace ID of the incoming method call
+     * @param stage           Name of the stage. Must be a string literal
+     * @param startTimestamp  Time in microseconds at which the stage started
+     * @param endTimestamp    Time in microseconds at which the stage ended
+     */
+    static void Record(uint64_t traceId, const char* stage, uint64_t startTimestamp, uint64_t endTimestamp);
+
+    /**
+     * Get the number of stages recorded since start-up, including those
+     * overwritten in the ring buffer. Always 0 when tracing is compiled out
+     */
+    static uint32_t GetNumRecords(void);
+
+    /**
+     * Write the recorded stages to a file in the Chrome trace event format,
+     * with one row per request. \n
+     * Records written while the file is being written may be missing or torn
+     * @param filePath  The file to write. It is replaced if it exists
+     * @return ER_OK on success
+     */
+    static QStatus DumpChromeTrace(const std::string& filePath);
+};
+
+/**
+ * Records a stage that lasts until the end of the enclosing scope
+ */
+class RequestTraceScope {
+  public:
+    /**
+     * Start the stage
+     */
+    RequestTraceScope(uint64_t traceId, const char* stage) :
+        traceId(traceId), stage(stage), startTimestamp(GetTimestampInUs()) { }
+
+    /**
+     * End the stage
+     */
+    ~RequestTraceScope() {
+        RequestTracer::Record(traceId, stage, startTimestamp, GetTimestampInUs());
+    }
+
+  private:
+    uint64_t traceId;
+    const char* stage;
+    uint64_t startTimestamp;
+};
+
+#if OEM_CS_REQUEST_TRACING
+
+#define LSF_TRACE_ID(_msg) RequestTracer::GetTraceId(_msg)
+#define LSF_TRACE_TIMESTAMP() GetTimestampInUs()
+#define LSF_TRACE_STAGE(_traceId, _stage, _startTimestamp) RequestTracer::Record((_traceId), (_stage), (_startTimestamp), GetTimestampInUs())
+#define LSF_TRACE_SCOPE(_traceId, _stage) RequestTraceScope requestTraceScope((_traceId), (_stage))
+
+#else
+
+#define LSF_TRACE_ID(_msg) 0
+#define LSF_TRACE_TIMESTAMP() 0
+#define LSF_TRACE_STAGE(_traceId, _stage, _startTimestamp) do { } while (0)
+#define LSF_TRACE_SCOPE(_traceId, _stage) do { } while (0)
+
+#endif
+
+OPTIONAL_NAMESPACE_CLOSE
+
+} //lsf
+
+#endif
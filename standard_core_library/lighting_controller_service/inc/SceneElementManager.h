@@ -25,8 +25,10 @@
 
 #ifdef LSF_BINDINGS
 #include <lsf/controllerservice/Manager.h>
+#include <lsf/controllerservice/DependencyIndex.h>
 #else
 #include <Manager.h>
+#include <DependencyIndex.h>
 #endif
 
 #include <Mutex.h>
@@ -113,6 +115,16 @@ class SceneElementManager : public Manager {
      *  LSF_ERR_NOT_FOUND - can't find sceneElement id
      */
     void DeleteSceneElement(ajn::Message& message);
+    /**
+     * Delete several SceneElements at once \n
+     * Either all the scene elements are deleted or none is. \n
+     * @param message type Message. Contains one MsgArg with the sceneElement ids. \n
+     * Return asynchronous reply with response code and the sceneElement ids: \n
+     *  LSF_OK - operation succeeded \n
+     *  LSF_ERR_NOT_FOUND - can't find a sceneElement id \n
+     *  LSF_ERR_DEPENDENCY - a sceneElement is used by a scene
+     */
+    void DeleteSceneElements(ajn::Message& message);
     /**
      * Create SceneElement and sending signal 'SceneElementsCreated' \n
      * @param message (type Message) with 4 message arguments as parameters (type ajn::MsgArg). \n
@@ -129,6 +141,19 @@ class SceneElementManager : public Manager {
      *  LSF_ERR_NO_SLOT - No slot for new SceneElement
      */
     void CreateSceneElement(ajn::Message& message);
+    /**
+     * Create several SceneElements at once \n
+     * Either all the scene elements are created or none is. They are stored
+     * with a single file write and announced with a single signal. \n
+     * @param message type Message. Contains an array of sceneElements with their names, and the language. \n
+     * Return asynchronous reply with response code and the sceneElement ids in the order of the request: \n
+     *  LSF_OK - operation succeeded \n
+     *  LSF_ERR_INVALID_ARGS - Language not supported, Invalid SceneElement components specified, name length exceeds \n
+     *  LSF_ERR_EMPTY_NAME - a sceneElement name is empty \n
+     *  LSF_ERR_RESOURCES - blob length is longer than MAX_FILE_LEN \n
+     *  LSF_ERR_NO_SLOT - No slot for the new SceneElements
+     */
+    void CreateSceneElements(ajn::Message& message);
     /**
      * Modify an existing sceneElement and then sending signal 'SceneElementsUpdated' \n
      * @param message (type Message) with 4 message arguments as parameters (type ajn::MsgArg). \n
@@ -191,7 +216,42 @@ class SceneElementManager : public Manager {
     /**
      * Handle Received Blob
      */
-    void HandleReceivedBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp);
+    void HandleReceivedBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp);
+    /**
+     * Lock the scene elements for a configuration export or import
+     */
+    QStatus LockStore(void) {
+        return sceneElementsLock.Lock();
+    }
+    /**
+     * Unlock the scene elements after a configuration export or import
+     */
+    QStatus UnlockStore(void) {
+        return sceneElementsLock.Unlock();
+    }
+    /**
+     * Write the scene elements to a configuration snapshot. \n
+     * Should only be called with the store locked
+     * @param stream  The snapshot
+     */
+    void ExportConfiguration(std::ostream& stream);
+    /**
+     * Parse the scene elements section of a configuration snapshot without applying it. \n
+     * Should only be called with the store locked
+     * @param stream            The section
+     * @param staged            The parsed scene elements
+     * @param stagedBlobLength  Length of the persistent store holding the parsed scene elements
+     * @return LSF_OK, LSF_ERR_NO_SLOT if there are too many scene elements or LSF_ERR_RESOURCES if they do not fit in the persistent store
+     */
+    LSFResponseCode StageConfiguration(std::istream& stream, SceneElementMap& staged, size_t& stagedBlobLength);
+    /**
+     * Replace the scene elements with the ones staged from a configuration snapshot. \n
+     * Should only be called with the store locked
+     * @param staged            The staged scene elements. Holds the replaced scene elements on return
+     * @param stagedBlobLength  Length of the persistent store holding the staged scene elements
+     * @param changes           The IDs replaced by the import
+     */
+    void CommitConfiguration(SceneElementMap& staged, size_t stagedBlobLength, ConfigurationChanges& changes);
     /**
      * Get the version of the sceneElement interface. \n
      * Return asynchronously. \n
@@ -213,6 +273,8 @@ class SceneElementManager : public Manager {
     PulseEffectManager* pulseEffectManagerPtr;
     SceneManager* sceneManagerPtr;
     size_t blobLength;
+    DependencyIndex lampGroupUsers;   /**< scene elements that apply each lamp group */
+    DependencyIndex effectUsers;      /**< scene elements that apply each preset or effect */
 
     LSFResponseCode CreateSceneElementInternal(SceneElement& sceneElement, LSFString& name, LSFString& language, LSFString& sceneElementID);
 
@@ -225,7 +287,22 @@ class SceneElementManager : public Manager {
     /**
      * Replace Map
      */
-    void ReplaceMap(std::istringstream& stream);
+    void ReplaceMap(std::istream& stream);
+
+    /**
+     * Add the references of a scene element to the dependency indexes
+     */
+    void AddDependencies(const LSFString& sceneElementID, const SceneElement& sceneElement);
+
+    /**
+     * Remove the references of a scene element from the dependency indexes
+     */
+    void RemoveDependencies(const LSFString& sceneElementID, const SceneElement& sceneElement);
+
+    /**
+     * Rebuild the dependency indexes after the scene elements were replaced as a whole
+     */
+    void RebuildDependencyIndex(void);
 
     /**
      * Get String
@@ -237,10 +314,19 @@ class SceneElementManager : public Manager {
      */
     std::string GetString(const SceneElementMap& items);
 
+  public:
     /**
-     * get scene element string
+     * get the persistent store line of a scene element
+     */
+    static std::string GetString(const std::string& name, const std::string& id, const SceneElement& sceneElement);
+    /**
+     * get the length of the scene element line without building it
+     */
+    static size_t GetStringLength(const std::string& name, const std::string& id, const SceneElement& sceneElement);
+    /**
+     * get the length of the persistent store holding the given scene elements
      */
-    std::string GetString(const std::string& name, const std::string& id, const SceneElement& sceneElement);
+    static size_t GetBlobLength(const SceneElementMap& items);
 };
 
 OPTIONAL_NAMESPACE_CLOSE
@@ -27,10 +27,12 @@
 #include <lsf/controllerservice/Manager.h>
 #include <lsf/controllerservice/LampGroupManager.h>
 #include <lsf/controllerservice/SceneElementManager.h>
+#include <lsf/controllerservice/DependencyIndex.h>
 #else
 #include <Manager.h>
 #include <LampGroupManager.h>
 #include <SceneElementManager.h>
+#include <DependencyIndex.h>
 #endif
 
 #include <Mutex.h>
@@ -57,6 +59,11 @@ class SceneFileManager : public Manager {
      */
     SceneFileManager(ControllerService& controllerSvc, const std::string& filePathToManager = "", const std::string& scene2filePath = "");
 
+    /**
+     * SceneFileManager destructor
+     */
+    ~SceneFileManager();
+
     /**
      * Schedule the New Scene File Read
      */
@@ -65,12 +72,12 @@ class SceneFileManager : public Manager {
     /**
      * Read from the New Scene File
      */
-    bool ValidateScene2FileAndRead(std::istringstream& filestream);
+    bool ValidateScene2FileAndRead(BlobSnapshotStream& filestream);
 
     /**
      * Read from the New Scene File
      */
-    bool ValidateScene2FileAndReadInternal(uint32_t& checksum, uint64_t& timestamp, std::istringstream& filestream);
+    bool ValidateScene2FileAndReadInternal(uint32_t& checksum, uint64_t& timestamp, BlobSnapshotStream& filestream);
 
     /**
      * Get New Scene File information \n
@@ -89,6 +96,7 @@ class SceneFileManager : public Manager {
     uint32_t scene2CheckSum;                        /**< checkSum of the new SceneWithSceneElements file */
     uint64_t scene2TimeStamp;                       /**< timestamp of the new SceneWithSceneElements file */
     std::list<ajn::Message> readScene2BlobMessages; /**< Read new Scene blob messages */
+    BlobSnapshot* scene2BlobSnapshot;               /**< snapshot of the new SceneWithSceneElements file */
 };
 /**
  * scene management class
@@ -155,6 +163,16 @@ class SceneManager : public SceneFileManager {
      *  LSF_ERR_NOT_FOUND - can't find scene id
      */
     void DeleteScene(ajn::Message& message);
+    /**
+     * Delete several Scenes at once \n
+     * Either all the scenes are deleted or none is. \n
+     * @param message type Message. Contains one MsgArg with the scene ids. \n
+     * Return asynchronous reply with response code and the scene ids: \n
+     *  LSF_OK - operation succeeded \n
+     *  LSF_ERR_NOT_FOUND - can't find a scene id \n
+     *  LSF_ERR_DEPENDENCY - a scene is used by a master scene
+     */
+    void DeleteScenes(ajn::Message& message);
     /**
      * Create Scene and sending signal 'ScenesCreated' \n
      * @param message (type Message) with 4 message arguments as parameters (type ajn::MsgArg). \n
@@ -186,6 +204,22 @@ class SceneManager : public SceneFileManager {
      *  LSF_ERR_NO_SLOT - No slot for new Scene
      */
     void CreateSceneWithSceneElements(ajn::Message& message);
+    /**
+     * Create several Scenes with SceneElements at once \n
+     * Either all the scenes are created or none is. They are stored with a
+     * single file write and announced with a single signal. \n
+     * @param message (type Message) with an array of SceneElement ID lists and Scene names,
+     * and the language code for the names. \n
+     *
+     * Return asynchronous reply with response code and the scene ids in the order of the request: \n
+     *  LSF_OK - operation succeeded \n
+     *  LSF_ERR_INVALID_ARGS - Language not supported, Invalid Scene components specified, name length exceeds \n
+     *  LSF_ERR_EMPTY_NAME - a scene name is empty \n
+     *  LSF_ERR_NOT_FOUND - a SceneElement does not exist \n
+     *  LSF_ERR_RESOURCES - blob length is longer than MAX_FILE_LEN \n
+     *  LSF_ERR_NO_SLOT - No slot for the new Scenes
+     */
+    void CreateScenesWithSceneElements(ajn::Message& message);
     /**
      * Modify an existing scene and then sending signal 'ScenesUpdated' \n
      * @param message (type Message) with 4 message arguments as parameters (type ajn::MsgArg). \n
@@ -313,15 +347,49 @@ class SceneManager : public SceneFileManager {
      * @param checksum
      * @param timestamp
      */
-    void HandleReceivedBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp);
+    void HandleReceivedBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp);
     /**
      * Handle Received Update Blob
      */
-    void HandleReceivedUpdateBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp);
+    void HandleReceivedUpdateBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp);
     /**
      * Handle Received Scene2 Blob
      */
-    void HandleReceivedScene2Blob(const std::string& blob, uint32_t checksum, uint64_t timestamp);
+    void HandleReceivedScene2Blob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp);
+    /**
+     * Lock the scenes for a configuration export or import
+     */
+    QStatus LockStore(void) {
+        return scenesLock.Lock();
+    }
+    /**
+     * Unlock the scenes after a configuration export or import
+     */
+    QStatus UnlockStore(void) {
+        return scenesLock.Unlock();
+    }
+    /**
+     * Write the scenes to a configuration snapshot, in terms of their scene elements. \n
+     * Should only be called with the store locked
+     * @param stream  The snapshot
+     */
+    void ExportConfiguration(std::ostream& stream);
+    /**
+     * Parse the scenes section of a configuration snapshot without applying it. \n
+     * Should only be called with the store locked
+     * @param stream  The section
+     * @param staged  The parsed scenes
+     * @return LSF_OK, LSF_ERR_NO_SLOT if there are too many scenes or LSF_ERR_RESOURCES if they do not fit in the persistent store
+     */
+    LSFResponseCode StageConfiguration(std::istream& stream, SceneWithSceneElementsMap& staged);
+    /**
+     * Replace the scenes with the ones staged from a configuration snapshot. \n
+     * Should only be called with the store locked and after the scene
+     * elements and effects of the snapshot have been committed
+     * @param staged   The staged scenes. Empty on return
+     * @param changes  The IDs replaced by the import
+     */
+    void CommitConfiguration(SceneWithSceneElementsMap& staged, ConfigurationChanges& changes);
     /*
      * Done with blob sync
      */
@@ -334,11 +402,17 @@ class SceneManager : public SceneFileManager {
 
   private:
 
-    void ReplaceMap(std::istringstream& stream);
+    void ReplaceMap(std::istream& stream);
 
-    void ReplaceUpdatesList(std::istringstream& stream);
+    void ReplaceUpdatesList(std::istream& stream);
 
-    void ReplaceScene2List(std::istringstream& stream);
+    void ReplaceScene2List(std::istream& stream);
+
+    /**
+     * Parse a scene2 file into a map
+     * @return true if the file has a reset entry
+     */
+    bool ParseScene2List(std::istream& stream, SceneWithSceneElementsMap& sceneMap);
 
     LSFResponseCode ApplySceneNestedInternal(ajn::Message message, LSFStringList& sceneList, LSFString sceneOrMasterSceneId);
 
@@ -362,6 +436,13 @@ class SceneManager : public SceneFileManager {
     SceneElementManager* sceneElementManager;
     MasterSceneManager* masterSceneManager;
     size_t blobLength;
+    DependencyIndex sceneElementUsers;    /**< scenes that apply each scene element */
+
+    /**
+     * Rebuild sceneElementUsers after the scenes were replaced as a whole. \n
+     * Should only be called with scenesLock locked
+     */
+    void RebuildDependencyIndex(void);
 
     /**
      * The function should only be called with scenesLock locked and is
@@ -371,8 +452,25 @@ class SceneManager : public SceneFileManager {
 
     void GetString(std::string& scenes, std::string& scene2, const SceneObjectMap& items);
     std::string GetUpdatesString(const std::list<LSFString>& updates);
-    std::string GetString(const std::string& name, const std::string& id, const Scene& scene);
-    std::string GetString(const std::string& name, const std::string& id, const SceneWithSceneElements& sceneWithSceneElements);
+
+  public:
+    /**
+     * get the persistent store entry of a scene made of components,
+     * as kept in the scene2 file
+     */
+    static std::string GetString(const std::string& name, const std::string& id, const Scene& scene);
+    /**
+     * get the persistent store entry of a scene made of scene elements
+     */
+    static std::string GetString(const std::string& name, const std::string& id, const SceneWithSceneElements& sceneWithSceneElements);
+    /**
+     * get the length of the component scene entry without building it
+     */
+    static size_t GetStringLength(const std::string& name, const std::string& id, const Scene& scene);
+    /**
+     * get the length of the scene element scene entry without building it
+     */
+    static size_t GetStringLength(const std::string& name, const std::string& id, const SceneWithSceneElements& sceneWithSceneElements);
 };
 
 /**
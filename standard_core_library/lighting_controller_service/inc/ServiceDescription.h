@@ -42,6 +42,7 @@ extern const std::string ControllerServiceSceneElementDescription;
 extern const std::string ControllerServiceMasterSceneDescription;
 extern const std::string LeaderElectionAndStateSyncDescription;
 extern const std::string ControllerServiceDataSetDescription;
+extern const std::string ControllerServiceStatisticsDescription;
 
 OPTIONAL_NAMESPACE_CLOSE
 
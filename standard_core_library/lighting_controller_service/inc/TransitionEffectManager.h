@@ -171,11 +171,46 @@ class TransitionEffectManager : public Manager {
      * Handle received blob. \n
      * Getting the blob string and wrting it to the file. \n
      */
-    void HandleReceivedBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp);
+    void HandleReceivedBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp);
     /**
      * Handle Received Update Blob
      */
-    void HandleReceivedUpdateBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp);
+    void HandleReceivedUpdateBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp);
+    /**
+     * Lock the transition effects for a configuration export or import
+     */
+    QStatus LockStore(void) {
+        return transitionEffectsLock.Lock();
+    }
+    /**
+     * Unlock the transition effects after a configuration export or import
+     */
+    QStatus UnlockStore(void) {
+        return transitionEffectsLock.Unlock();
+    }
+    /**
+     * Write the transition effects to a configuration snapshot. \n
+     * Should only be called with the store locked
+     * @param stream  The snapshot
+     */
+    void ExportConfiguration(std::ostream& stream);
+    /**
+     * Parse the transition effects section of a configuration snapshot without applying it. \n
+     * Should only be called with the store locked
+     * @param stream            The section
+     * @param staged            The parsed transition effects
+     * @param stagedBlobLength  Length of the persistent store holding the parsed transition effects
+     * @return LSF_OK, LSF_ERR_NO_SLOT if there are too many transition effects or LSF_ERR_RESOURCES if they do not fit in the persistent store
+     */
+    LSFResponseCode StageConfiguration(std::istream& stream, TransitionEffectMap& staged, size_t& stagedBlobLength);
+    /**
+     * Replace the transition effects with the ones staged from a configuration snapshot. \n
+     * Should only be called with the store locked
+     * @param staged            The staged transition effects. Holds the replaced transition effects on return
+     * @param stagedBlobLength  Length of the persistent store holding the staged transition effects
+     * @param changes           The IDs replaced by the import
+     */
+    void CommitConfiguration(TransitionEffectMap& staged, size_t stagedBlobLength, ConfigurationChanges& changes);
     /**
      * Get Controller Service TransitionEffect Interface Version. \n
      * @return 32 unsigned integer version. \n
@@ -205,9 +240,9 @@ class TransitionEffectManager : public Manager {
 
   private:
 
-    void ReplaceMap(std::istringstream& stream);
+    void ReplaceMap(std::istream& stream);
 
-    void ReplaceUpdatesList(std::istringstream& stream);
+    void ReplaceUpdatesList(std::istream& stream);
 
     LSFResponseCode CreateTransitionEffectInternal(TransitionEffect& transitionEffect, LSFString& name, LSFString& language, LSFString& transitionEffectID);
 
@@ -224,7 +259,21 @@ class TransitionEffectManager : public Manager {
 
     std::string GetString(const TransitionEffectMap& items);
     std::string GetUpdatesString(const std::set<LSFString>& updates);
-    std::string GetString(const std::string& name, const std::string& id, const TransitionEffect& transitionEffect);
+
+  public:
+    /**
+     * get the persistent store line of a transition effect, which names
+     * the preset instead of the state when the state is null
+     */
+    static std::string GetString(const std::string& name, const std::string& id, const TransitionEffect& transitionEffect);
+    /**
+     * get the length of the transition effect line without building it
+     */
+    static size_t GetStringLength(const std::string& name, const std::string& id, const TransitionEffect& transitionEffect);
+    /**
+     * get the length of the persistent store holding the given transition effects
+     */
+    static size_t GetBlobLength(const TransitionEffectMap& items);
 };
 
 OPTIONAL_NAMESPACE_CLOSE
@@ -0,0 +1,197 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifdef LSF_BINDINGS
+#include <lsf/controllerservice/BlobCompression.h>
+#else
+#include <BlobCompression.h>
+#endif
+
+#include <string.h>
+
+namespace lsf {
+
+OPTIONAL_NAMESPACE_CONTROLLER_SERVICE
+
+/*
+ * Token layout:
+ *   [token][literal length ext...][literals...][offset lo][offset hi][match length ext...]
+ * The high nibble of the token holds the literal length and the low nibble
+ * holds (match length - MIN_MATCH). A nibble value of 15 is followed by
+ * extension bytes that are summed until a byte other than 255 is seen.
+ * The final token of a stream carries literals only.
+ */
+#define MIN_MATCH 4
+#define MAX_OFFSET 0xFFFF
+#define HASH_LOG 12
+#define HASH_SIZE (1 << HASH_LOG)
+
+static inline uint32_t Read32(const uint8_t* p)
+{
+    uint32_t val;
+    memcpy(&val, p, sizeof(val));
+    return val;
+}
+
+static inline uint32_t Hash(uint32_t seq)
+{
+    return (seq * 2654435761U) >> (32 - HASH_LOG);
+}
+
+static inline void WriteLength(std::string& out, size_t len)
+{
+    while (len >= 255) {
+        out.push_back(static_cast<char>(255));
+        len -= 255;
+    }
+    out.push_back(static_cast<char>(len));
+}
+
+static void EmitSequence(std::string& out, const uint8_t* literals, size_t literalLen, size_t offset, size_t matchLen)
+{
+    uint8_t token = (literalLen >= 15) ? 0xF0 : static_cast<uint8_t>(literalLen << 4);
+    size_t matchCode = (matchLen) ? matchLen - MIN_MATCH : 0;
+    token |= (matchCode >= 15) ? 0x0F : static_cast<uint8_t>(matchCode);
+    out.push_back(static_cast<char>(token));
+
+    if (literalLen >= 15) {
+        WriteLength(out, literalLen - 15);
+    }
+    out.append(reinterpret_cast<const char*>(literals), literalLen);
+
+    if (matchLen) {
+        out.push_back(static_cast<char>(offset & 0xFF));
+        out.push_back(static_cast<char>((offset >> 8) & 0xFF));
+        if (matchCode >= 15) {
+            WriteLength(out, matchCode - 15);
+        }
+    }
+}
+
+void CompressBlob(const std::string& blob, std::string& compressed)
+{
+    compressed.clear();
+    compressed.reserve(blob.size() / 2 + 16);
+
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(blob.data());
+    const size_t len = blob.size();
+    const uint8_t* anchor = base;
+
+    if (len > MIN_MATCH) {
+        uint32_t table[HASH_SIZE];
+        memset(table, 0xFF, sizeof(table));
+
+        const uint8_t* ip = base;
+        const uint8_t* const limit = base + len - MIN_MATCH;
+        const uint8_t* const end = base + len;
+
+        while (ip <= limit) {
+            uint32_t seq = Read32(ip);
+            uint32_t h = Hash(seq);
+            uint32_t candidatePos = table[h];
+            table[h] = static_cast<uint32_t>(ip - base);
+
+            if (candidatePos != 0xFFFFFFFF) {
+                const uint8_t* candidate = base + candidatePos;
+                size_t offset = ip - candidate;
+                if (offset <= MAX_OFFSET && Read32(candidate) == seq) {
+                    const uint8_t* mp = ip + MIN_MATCH;
+                    const uint8_t* cp = candidate + MIN_MATCH;
+                    while (mp < end && *mp == *cp) {
+                        ++mp;
+                        ++cp;
+                    }
+                    size_t matchLen = mp - ip;
+                    EmitSequence(compressed, anchor, ip - anchor, offset, matchLen);
+                    ip = mp;
+                    anchor = ip;
+                    continue;
+                }
+            }
+            ++ip;
+        }
+    }
+
+    EmitSequence(compressed, anchor, (base + len) - anchor, 0, 0);
+}
+
+static inline bool ReadLength(const uint8_t*& ip, const uint8_t* end, size_t& len)
+{
+    uint8_t byte;
+    do {
+        if (ip >= end) {
+            return false;
+        }
+        byte = *ip++;
+        len += byte;
+    } while (byte == 255);
+    return true;
+}
+
+bool DecompressBlob(const uint8_t* data, size_t len, size_t uncompressedLen, std::string& blob)
+{
+    blob.clear();
+    blob.reserve(uncompressedLen);
+
+    const uint8_t* ip = data;
+    const uint8_t* const end = data + len;
+
+    while (ip < end) {
+        uint8_t token = *ip++;
+
+        size_t literalLen = token >> 4;
+        if (literalLen == 15 && !ReadLength(ip, end, literalLen)) {
+            return false;
+        }
+        if (literalLen > static_cast<size_t>(end - ip) || blob.size() + literalLen > uncompressedLen) {
+            return false;
+        }
+        blob.append(reinterpret_cast<const char*>(ip), literalLen);
+        ip += literalLen;
+
+        if (ip == end) {
+            break;
+        }
+
+        if (end - ip < 2) {
+            return false;
+        }
+        size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+
+        size_t matchLen = token & 0x0F;
+        if (matchLen == 15 && !ReadLength(ip, end, matchLen)) {
+            return false;
+        }
+        matchLen += MIN_MATCH;
+
+        if (offset == 0 || offset > blob.size() || blob.size() + matchLen > uncompressedLen) {
+            return false;
+        }
+
+        // Byte-wise copy because the match may overlap the bytes it produces
+        size_t from = blob.size() - offset;
+        for (size_t i = 0; i < matchLen; i++) {
+            blob.push_back(blob[from + i]);
+        }
+    }
+
+    return (blob.size() == uncompressedLen);
+}
+
+OPTIONAL_NAMESPACE_CLOSE
+
+} //lsf
@@ -24,16 +24,22 @@
 #include <lsf/controllerservice/ControllerService.h>
 #include <lsf/controllerservice/ServiceDescription.h>
 #include <lsf/controllerservice/DeviceIcon.h>
+#include <lsf/controllerservice/FileParser.h>
 #else
 #include <OEM_CS_Config.h>
 #include <ControllerService.h>
 #include <ServiceDescription.h>
 #include <DeviceIcon.h>
+#include <FileParser.h>
 #endif
 
 #include <alljoyn/AllJoynStd.h>
 #include <alljoyn/notification/NotificationService.h>
+#include <qcc/atomic.h>
 #include <string>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
 
 using namespace lsf;
 using namespace ajn;
@@ -233,11 +239,15 @@ ControllerService::ControllerService(
     obsObject(NULL),
     isObsObjectReady(false),
     isRunning(true),
+    dispatchTableFrozen(false),
+    methodCallCount(0),
+    lampsStateChangedSignal(NULL),
     fileWriterThread(*this),
     rank(),
     deprecatedConstructorUsed(true)
 {
     QCC_LogError(ER_FAIL, ("%s: DEPRECATED CONSTRUCTOR. Please use the constructor with AboutDataStore", __func__));
+    RegisterPolledStatistics();
 }
 
 ControllerService::ControllerService(
@@ -276,11 +286,14 @@ ControllerService::ControllerService(
     obsObject(NULL),
     isObsObjectReady(false),
     isRunning(true),
+    dispatchTableFrozen(false),
+    methodCallCount(0),
+    lampsStateChangedSignal(NULL),
     fileWriterThread(*this),
     rank(),
     deprecatedConstructorUsed(false)
 {
-
+    RegisterPolledStatistics();
 }
 
 ControllerService::ControllerService(
@@ -314,11 +327,15 @@ ControllerService::ControllerService(
     obsObject(NULL),
     isObsObjectReady(false),
     isRunning(true),
+    dispatchTableFrozen(false),
+    methodCallCount(0),
+    lampsStateChangedSignal(NULL),
     fileWriterThread(*this),
     rank(),
     deprecatedConstructorUsed(true)
 {
     QCC_DbgTrace(("%s:factoryConfigFile=%s, configFile=%s, lampGroupFile=%s, presetFile=%s, sceneFile=%s, masterSceneFile=%s", __func__, factoryConfigFile.c_str(), configFile.c_str(), lampGroupFile.c_str(), presetFile.c_str(), sceneFile.c_str(), masterSceneFile.c_str()));
+    RegisterPolledStatistics();
 }
 
 ControllerService::ControllerService(
@@ -356,6 +373,9 @@ ControllerService::ControllerService(
     obsObject(NULL),
     isObsObjectReady(false),
     isRunning(true),
+    dispatchTableFrozen(false),
+    methodCallCount(0),
+    lampsStateChangedSignal(NULL),
     fileWriterThread(*this),
     rank(),
     deprecatedConstructorUsed(false)
@@ -363,6 +383,7 @@ ControllerService::ControllerService(
     QCC_DbgTrace(("%s:factoryConfigFile=%s, configFile=%s, lampGroupFile=%s, presetFile=%s, sceneFile=%s, masterSceneFile=%s transitionEffectFile=%s pulseEffectFile=%s", __func__,
                   factoryConfigFile.c_str(), configFile.c_str(), lampGroupFile.c_str(), presetFile.c_str(), sceneFile.c_str(), masterSceneFile.c_str(),
                   transitionEffectFile.c_str(), pulseEffectFile.c_str()));
+    RegisterPolledStatistics();
 }
 
 void ControllerService::FoundLocalOnboardingService(const char* busName, SessionPort port)
@@ -400,97 +421,107 @@ void ControllerService::Initialize()
     sceneManager.ReadSavedData();
 
     messageHandlersLock.Lock();
-    AddMethodHandler("LightingResetControllerService", this, &ControllerService::LightingResetControllerService);
-    AddMethodHandler("GetControllerServiceVersion", this, &ControllerService::GetControllerServiceVersion);
-    AddMethodHandler("GetAllLampIDs", &lampManager, &LampManager::GetAllLampIDs);
-    AddMethodHandler("GetLampSupportedLanguages", &lampManager, &LampManager::GetLampSupportedLanguages);
-    AddMethodHandler("GetLampManufacturer", &lampManager, &LampManager::GetLampManufacturer);
-    AddMethodHandler("GetLampName", &lampManager, &LampManager::GetLampName);
-    AddMethodHandler("SetLampName", &lampManager, &LampManager::SetLampName);
-    AddMethodHandler("GetLampDetails", &lampManager, &LampManager::GetLampDetails);
-    AddMethodHandler("GetLampParameters", &lampManager, &LampManager::GetLampParameters);
-    AddMethodHandler("GetLampParametersField", &lampManager, &LampManager::GetLampParametersField);
-    AddMethodHandler("GetLampState", &lampManager, &LampManager::GetLampState);
-    AddMethodHandler("GetLampStateField", &lampManager, &LampManager::GetLampStateField);
-    AddMethodHandler("TransitionLampState", &lampManager, &LampManager::TransitionLampState);
-    AddMethodHandler("PulseLampWithState", &lampManager, &LampManager::PulseLampWithState);
-    AddMethodHandler("PulseLampWithPreset", &lampManager, &LampManager::PulseLampWithPreset);
-    AddMethodHandler("TransitionLampStateToPreset", &lampManager, &LampManager::TransitionLampStateToPreset);
-    AddMethodHandler("TransitionLampGroupState", &lampGroupManager, &LampGroupManager::TransitionLampGroupState);
-    AddMethodHandler("PulseLampGroupWithState", &lampGroupManager, &LampGroupManager::PulseLampGroupWithState);
-    AddMethodHandler("PulseLampGroupWithPreset", &lampGroupManager, &LampGroupManager::PulseLampGroupWithPreset);
-    AddMethodHandler("TransitionLampGroupStateToPreset", &lampGroupManager, &LampGroupManager::TransitionLampGroupStateToPreset);
-    AddMethodHandler("TransitionLampStateField", &lampManager, &LampManager::TransitionLampStateField);
-    AddMethodHandler("TransitionLampGroupStateField", &lampGroupManager, &LampGroupManager::TransitionLampGroupStateField);
-    AddMethodHandler("ResetLampState", &lampManager, &LampManager::ResetLampState);
-    AddMethodHandler("ResetLampGroupState", &lampGroupManager, &LampGroupManager::ResetLampGroupState);
-    AddMethodHandler("ResetLampStateField", &lampManager, &LampManager::ResetLampStateField);
-    AddMethodHandler("ResetLampGroupStateField", &lampGroupManager, &LampGroupManager::ResetLampGroupStateField);
-    AddMethodHandler("GetLampFaults", &lampManager, &LampManager::GetLampFaults);
-    AddMethodHandler("ClearLampFault", &lampManager, &LampManager::ClearLampFault);
-    AddMethodHandler("GetLampServiceVersion", &lampManager, &LampManager::GetLampServiceVersion);
-    AddMethodHandler("GetAllLampGroupIDs", &lampGroupManager, &LampGroupManager::GetAllLampGroupIDs);
-    AddMethodHandler("GetLampGroupName", &lampGroupManager, &LampGroupManager::GetLampGroupName);
-    AddMethodHandler("SetLampGroupName", &lampGroupManager, &LampGroupManager::SetLampGroupName);
-    AddMethodHandler("CreateLampGroup", &lampGroupManager, &LampGroupManager::CreateLampGroup);
-    AddMethodHandler("UpdateLampGroup", &lampGroupManager, &LampGroupManager::UpdateLampGroup);
-    AddMethodHandler("DeleteLampGroup", &lampGroupManager, &LampGroupManager::DeleteLampGroup);
-    AddMethodHandler("GetLampGroup", &lampGroupManager, &LampGroupManager::GetLampGroup);
-    AddMethodHandler("GetDefaultLampState", &presetManager, &PresetManager::GetDefaultLampState);
-    AddMethodHandler("SetDefaultLampState", &presetManager, &PresetManager::SetDefaultLampState);
-    AddMethodHandler("GetAllPresetIDs", &presetManager, &PresetManager::GetAllPresetIDs);
-    AddMethodHandler("GetPresetName", &presetManager, &PresetManager::GetPresetName);
-    AddMethodHandler("SetPresetName", &presetManager, &PresetManager::SetPresetName);
-    AddMethodHandler("CreatePreset", &presetManager, &PresetManager::CreatePreset);
-    AddMethodHandler("UpdatePreset", &presetManager, &PresetManager::UpdatePreset);
-    AddMethodHandler("DeletePreset", &presetManager, &PresetManager::DeletePreset);
-    AddMethodHandler("GetPreset", &presetManager, &PresetManager::GetPreset);
-    AddMethodHandler("GetAllTransitionEffectIDs", &transitionEffectManager, &TransitionEffectManager::GetAllTransitionEffectIDs);
-    AddMethodHandler("GetTransitionEffectName", &transitionEffectManager, &TransitionEffectManager::GetTransitionEffectName);
-    AddMethodHandler("SetTransitionEffectName", &transitionEffectManager, &TransitionEffectManager::SetTransitionEffectName);
-    AddMethodHandler("CreateTransitionEffect", &transitionEffectManager, &TransitionEffectManager::CreateTransitionEffect);
-    AddMethodHandler("UpdateTransitionEffect", &transitionEffectManager, &TransitionEffectManager::UpdateTransitionEffect);
-    AddMethodHandler("DeleteTransitionEffect", &transitionEffectManager, &TransitionEffectManager::DeleteTransitionEffect);
-    AddMethodHandler("GetTransitionEffect", &transitionEffectManager, &TransitionEffectManager::GetTransitionEffect);
-    AddMethodHandler("ApplyTransitionEffectOnLamps", &transitionEffectManager, &TransitionEffectManager::ApplyTransitionEffectOnLamps);
-    AddMethodHandler("ApplyTransitionEffectOnLampGroups", &transitionEffectManager, &TransitionEffectManager::ApplyTransitionEffectOnLampGroups);
-    AddMethodHandler("GetAllPulseEffectIDs", &pulseEffectManager, &PulseEffectManager::GetAllPulseEffectIDs);
-    AddMethodHandler("GetPulseEffectName", &pulseEffectManager, &PulseEffectManager::GetPulseEffectName);
-    AddMethodHandler("SetPulseEffectName", &pulseEffectManager, &PulseEffectManager::SetPulseEffectName);
-    AddMethodHandler("CreatePulseEffect", &pulseEffectManager, &PulseEffectManager::CreatePulseEffect);
-    AddMethodHandler("UpdatePulseEffect", &pulseEffectManager, &PulseEffectManager::UpdatePulseEffect);
-    AddMethodHandler("DeletePulseEffect", &pulseEffectManager, &PulseEffectManager::DeletePulseEffect);
-    AddMethodHandler("GetPulseEffect", &pulseEffectManager, &PulseEffectManager::GetPulseEffect);
-    AddMethodHandler("ApplyPulseEffectOnLamps", &pulseEffectManager, &PulseEffectManager::ApplyPulseEffectOnLamps);
-    AddMethodHandler("ApplyPulseEffectOnLampGroups", &pulseEffectManager, &PulseEffectManager::ApplyPulseEffectOnLampGroups);
-    AddMethodHandler("GetAllSceneIDs", &sceneManager, &SceneManager::GetAllSceneIDs);
-    AddMethodHandler("GetSceneName", &sceneManager, &SceneManager::GetSceneName);
-    AddMethodHandler("SetSceneName", &sceneManager, &SceneManager::SetSceneName);
-    AddMethodHandler("CreateScene", &sceneManager, &SceneManager::CreateScene);
-    AddMethodHandler("UpdateScene", &sceneManager, &SceneManager::UpdateScene);
-    AddMethodHandler("DeleteScene", &sceneManager, &SceneManager::DeleteScene);
-    AddMethodHandler("GetScene", &sceneManager, &SceneManager::GetScene);
-    AddMethodHandler("ApplyScene", &sceneManager, &SceneManager::ApplyScene);
-    AddMethodHandler("CreateSceneWithSceneElements", &sceneManager, &SceneManager::CreateSceneWithSceneElements);
-    AddMethodHandler("UpdateSceneWithSceneElements", &sceneManager, &SceneManager::UpdateSceneWithSceneElements);
-    AddMethodHandler("GetSceneWithSceneElements", &sceneManager, &SceneManager::GetSceneWithSceneElements);
-    AddMethodHandler("GetAllSceneElementIDs", &sceneElementManager, &SceneElementManager::GetAllSceneElementIDs);
-    AddMethodHandler("GetSceneElementName", &sceneElementManager, &SceneElementManager::GetSceneElementName);
-    AddMethodHandler("SetSceneElementName", &sceneElementManager, &SceneElementManager::SetSceneElementName);
-    AddMethodHandler("CreateSceneElement", &sceneElementManager, &SceneElementManager::CreateSceneElement);
-    AddMethodHandler("UpdateSceneElement", &sceneElementManager, &SceneElementManager::UpdateSceneElement);
-    AddMethodHandler("DeleteSceneElement", &sceneElementManager, &SceneElementManager::DeleteSceneElement);
-    AddMethodHandler("GetSceneElement", &sceneElementManager, &SceneElementManager::GetSceneElement);
-    AddMethodHandler("ApplySceneElement", &sceneElementManager, &SceneElementManager::ApplySceneElement);
-    AddMethodHandler("GetAllMasterSceneIDs", &masterSceneManager, &MasterSceneManager::GetAllMasterSceneIDs);
-    AddMethodHandler("GetMasterSceneName", &masterSceneManager, &MasterSceneManager::GetMasterSceneName);
-    AddMethodHandler("SetMasterSceneName", &masterSceneManager, &MasterSceneManager::SetMasterSceneName);
-    AddMethodHandler("CreateMasterScene", &masterSceneManager, &MasterSceneManager::CreateMasterScene);
-    AddMethodHandler("UpdateMasterScene", &masterSceneManager, &MasterSceneManager::UpdateMasterScene);
-    AddMethodHandler("DeleteMasterScene", &masterSceneManager, &MasterSceneManager::DeleteMasterScene);
-    AddMethodHandler("GetMasterScene", &masterSceneManager, &MasterSceneManager::GetMasterScene);
-    AddMethodHandler("ApplyMasterScene", &masterSceneManager, &MasterSceneManager::ApplyMasterScene);
-    AddMethodHandler("GetLampDataSet", &lampManager, &LampManager::GetLampDataSet);
+    AddStoreMethodHandler(ControllerServiceInterfaceName, "LightingResetControllerService", this, &ControllerService::LightingResetControllerService);
+    AddMethodHandler(ControllerServiceInterfaceName, "GetControllerServiceVersion", this, &ControllerService::GetControllerServiceVersion);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "GetAllLampIDs", &lampManager, &LampManager::GetAllLampIDs);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "GetLampSupportedLanguages", &lampManager, &LampManager::GetLampSupportedLanguages);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "GetLampManufacturer", &lampManager, &LampManager::GetLampManufacturer);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "GetLampName", &lampManager, &LampManager::GetLampName);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "SetLampName", &lampManager, &LampManager::SetLampName);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "GetLampDetails", &lampManager, &LampManager::GetLampDetails);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "GetLampParameters", &lampManager, &LampManager::GetLampParameters);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "GetLampParametersField", &lampManager, &LampManager::GetLampParametersField);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "GetLampState", &lampManager, &LampManager::GetLampState);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "GetLampStateField", &lampManager, &LampManager::GetLampStateField);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "TransitionLampState", &lampManager, &LampManager::TransitionLampState);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "PulseLampWithState", &lampManager, &LampManager::PulseLampWithState);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "PulseLampWithPreset", &lampManager, &LampManager::PulseLampWithPreset);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "TransitionLampStateToPreset", &lampManager, &LampManager::TransitionLampStateToPreset);
+    AddMethodHandler(ControllerServiceLampGroupInterfaceName, "TransitionLampGroupState", &lampGroupManager, &LampGroupManager::TransitionLampGroupState);
+    AddMethodHandler(ControllerServiceLampGroupInterfaceName, "PulseLampGroupWithState", &lampGroupManager, &LampGroupManager::PulseLampGroupWithState);
+    AddMethodHandler(ControllerServiceLampGroupInterfaceName, "PulseLampGroupWithPreset", &lampGroupManager, &LampGroupManager::PulseLampGroupWithPreset);
+    AddMethodHandler(ControllerServiceLampGroupInterfaceName, "TransitionLampGroupStateToPreset", &lampGroupManager, &LampGroupManager::TransitionLampGroupStateToPreset);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "TransitionLampStateField", &lampManager, &LampManager::TransitionLampStateField);
+    AddMethodHandler(ControllerServiceLampGroupInterfaceName, "TransitionLampGroupStateField", &lampGroupManager, &LampGroupManager::TransitionLampGroupStateField);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "ResetLampState", &lampManager, &LampManager::ResetLampState);
+    AddMethodHandler(ControllerServiceLampGroupInterfaceName, "ResetLampGroupState", &lampGroupManager, &LampGroupManager::ResetLampGroupState);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "ResetLampStateField", &lampManager, &LampManager::ResetLampStateField);
+    AddMethodHandler(ControllerServiceLampGroupInterfaceName, "ResetLampGroupStateField", &lampGroupManager, &LampGroupManager::ResetLampGroupStateField);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "GetLampFaults", &lampManager, &LampManager::GetLampFaults);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "ClearLampFault", &lampManager, &LampManager::ClearLampFault);
+    AddMethodHandler(ControllerServiceLampInterfaceName, "GetLampServiceVersion", &lampManager, &LampManager::GetLampServiceVersion);
+    AddMethodHandler(ControllerServiceLampGroupInterfaceName, "GetAllLampGroupIDs", &lampGroupManager, &LampGroupManager::GetAllLampGroupIDs);
+    AddMethodHandler(ControllerServiceLampGroupInterfaceName, "GetLampGroupName", &lampGroupManager, &LampGroupManager::GetLampGroupName);
+    AddStoreMethodHandler(ControllerServiceLampGroupInterfaceName, "SetLampGroupName", &lampGroupManager, &LampGroupManager::SetLampGroupName);
+    AddStoreMethodHandler(ControllerServiceLampGroupInterfaceName, "CreateLampGroup", &lampGroupManager, &LampGroupManager::CreateLampGroup);
+    AddStoreMethodHandler(ControllerServiceLampGroupInterfaceName, "CreateLampGroups", &lampGroupManager, &LampGroupManager::CreateLampGroups);
+    AddStoreMethodHandler(ControllerServiceLampGroupInterfaceName, "UpdateLampGroup", &lampGroupManager, &LampGroupManager::UpdateLampGroup);
+    AddStoreMethodHandler(ControllerServiceLampGroupInterfaceName, "DeleteLampGroup", &lampGroupManager, &LampGroupManager::DeleteLampGroup);
+    AddStoreMethodHandler(ControllerServiceLampGroupInterfaceName, "DeleteLampGroups", &lampGroupManager, &LampGroupManager::DeleteLampGroups);
+    AddMethodHandler(ControllerServiceLampGroupInterfaceName, "GetLampGroup", &lampGroupManager, &LampGroupManager::GetLampGroup);
+    AddMethodHandler(ControllerServicePresetInterfaceName, "GetDefaultLampState", &presetManager, &PresetManager::GetDefaultLampState);
+    AddStoreMethodHandler(ControllerServicePresetInterfaceName, "SetDefaultLampState", &presetManager, &PresetManager::SetDefaultLampState);
+    AddMethodHandler(ControllerServicePresetInterfaceName, "GetAllPresetIDs", &presetManager, &PresetManager::GetAllPresetIDs);
+    AddMethodHandler(ControllerServicePresetInterfaceName, "GetPresetName", &presetManager, &PresetManager::GetPresetName);
+    AddStoreMethodHandler(ControllerServicePresetInterfaceName, "SetPresetName", &presetManager, &PresetManager::SetPresetName);
+    AddStoreMethodHandler(ControllerServicePresetInterfaceName, "CreatePreset", &presetManager, &PresetManager::CreatePreset);
+    AddStoreMethodHandler(ControllerServicePresetInterfaceName, "CreatePresets", &presetManager, &PresetManager::CreatePresets);
+    AddStoreMethodHandler(ControllerServicePresetInterfaceName, "UpdatePreset", &presetManager, &PresetManager::UpdatePreset);
+    AddStoreMethodHandler(ControllerServicePresetInterfaceName, "UpdatePresets", &presetManager, &PresetManager::UpdatePresets);
+    AddStoreMethodHandler(ControllerServicePresetInterfaceName, "DeletePreset", &presetManager, &PresetManager::DeletePreset);
+    AddStoreMethodHandler(ControllerServicePresetInterfaceName, "DeletePresets", &presetManager, &PresetManager::DeletePresets);
+    AddMethodHandler(ControllerServicePresetInterfaceName, "GetPreset", &presetManager, &PresetManager::GetPreset);
+    AddMethodHandler(ControllerServiceTransitionEffectInterfaceName, "GetAllTransitionEffectIDs", &transitionEffectManager, &TransitionEffectManager::GetAllTransitionEffectIDs);
+    AddMethodHandler(ControllerServiceTransitionEffectInterfaceName, "GetTransitionEffectName", &transitionEffectManager, &TransitionEffectManager::GetTransitionEffectName);
+    AddStoreMethodHandler(ControllerServiceTransitionEffectInterfaceName, "SetTransitionEffectName", &transitionEffectManager, &TransitionEffectManager::SetTransitionEffectName);
+    AddStoreMethodHandler(ControllerServiceTransitionEffectInterfaceName, "CreateTransitionEffect", &transitionEffectManager, &TransitionEffectManager::CreateTransitionEffect);
+    AddStoreMethodHandler(ControllerServiceTransitionEffectInterfaceName, "UpdateTransitionEffect", &transitionEffectManager, &TransitionEffectManager::UpdateTransitionEffect);
+    AddStoreMethodHandler(ControllerServiceTransitionEffectInterfaceName, "DeleteTransitionEffect", &transitionEffectManager, &TransitionEffectManager::DeleteTransitionEffect);
+    AddMethodHandler(ControllerServiceTransitionEffectInterfaceName, "GetTransitionEffect", &transitionEffectManager, &TransitionEffectManager::GetTransitionEffect);
+    AddMethodHandler(ControllerServiceTransitionEffectInterfaceName, "ApplyTransitionEffectOnLamps", &transitionEffectManager, &TransitionEffectManager::ApplyTransitionEffectOnLamps);
+    AddMethodHandler(ControllerServiceTransitionEffectInterfaceName, "ApplyTransitionEffectOnLampGroups", &transitionEffectManager, &TransitionEffectManager::ApplyTransitionEffectOnLampGroups);
+    AddMethodHandler(ControllerServicePulseEffectInterfaceName, "GetAllPulseEffectIDs", &pulseEffectManager, &PulseEffectManager::GetAllPulseEffectIDs);
+    AddMethodHandler(ControllerServicePulseEffectInterfaceName, "GetPulseEffectName", &pulseEffectManager, &PulseEffectManager::GetPulseEffectName);
+    AddStoreMethodHandler(ControllerServicePulseEffectInterfaceName, "SetPulseEffectName", &pulseEffectManager, &PulseEffectManager::SetPulseEffectName);
+    AddStoreMethodHandler(ControllerServicePulseEffectInterfaceName, "CreatePulseEffect", &pulseEffectManager, &PulseEffectManager::CreatePulseEffect);
+    AddStoreMethodHandler(ControllerServicePulseEffectInterfaceName, "UpdatePulseEffect", &pulseEffectManager, &PulseEffectManager::UpdatePulseEffect);
+    AddStoreMethodHandler(ControllerServicePulseEffectInterfaceName, "DeletePulseEffect", &pulseEffectManager, &PulseEffectManager::DeletePulseEffect);
+    AddMethodHandler(ControllerServicePulseEffectInterfaceName, "GetPulseEffect", &pulseEffectManager, &PulseEffectManager::GetPulseEffect);
+    AddMethodHandler(ControllerServicePulseEffectInterfaceName, "ApplyPulseEffectOnLamps", &pulseEffectManager, &PulseEffectManager::ApplyPulseEffectOnLamps);
+    AddMethodHandler(ControllerServicePulseEffectInterfaceName, "ApplyPulseEffectOnLampGroups", &pulseEffectManager, &PulseEffectManager::ApplyPulseEffectOnLampGroups);
+    AddMethodHandler(ControllerServiceSceneInterfaceName, "GetAllSceneIDs", &sceneManager, &SceneManager::GetAllSceneIDs);
+    AddMethodHandler(ControllerServiceSceneInterfaceName, "GetSceneName", &sceneManager, &SceneManager::GetSceneName);
+    AddStoreMethodHandler(ControllerServiceSceneInterfaceName, "SetSceneName", &sceneManager, &SceneManager::SetSceneName);
+    AddStoreMethodHandler(ControllerServiceSceneInterfaceName, "CreateScene", &sceneManager, &SceneManager::CreateScene);
+    AddStoreMethodHandler(ControllerServiceSceneInterfaceName, "UpdateScene", &sceneManager, &SceneManager::UpdateScene);
+    AddStoreMethodHandler(ControllerServiceSceneInterfaceName, "DeleteScene", &sceneManager, &SceneManager::DeleteScene);
+    AddStoreMethodHandler(ControllerServiceSceneInterfaceName, "DeleteScenes", &sceneManager, &SceneManager::DeleteScenes);
+    AddMethodHandler(ControllerServiceSceneInterfaceName, "GetScene", &sceneManager, &SceneManager::GetScene);
+    AddMethodHandler(ControllerServiceSceneInterfaceName, "ApplyScene", &sceneManager, &SceneManager::ApplyScene);
+    AddStoreMethodHandler(ControllerServiceSceneWithSceneElementsInterfaceName, "CreateSceneWithSceneElements", &sceneManager, &SceneManager::CreateSceneWithSceneElements);
+    AddStoreMethodHandler(ControllerServiceSceneWithSceneElementsInterfaceName, "CreateScenesWithSceneElements", &sceneManager, &SceneManager::CreateScenesWithSceneElements);
+    AddStoreMethodHandler(ControllerServiceSceneWithSceneElementsInterfaceName, "UpdateSceneWithSceneElements", &sceneManager, &SceneManager::UpdateSceneWithSceneElements);
+    AddMethodHandler(ControllerServiceSceneWithSceneElementsInterfaceName, "GetSceneWithSceneElements", &sceneManager, &SceneManager::GetSceneWithSceneElements);
+    AddMethodHandler(ControllerServiceSceneElementInterfaceName, "GetAllSceneElementIDs", &sceneElementManager, &SceneElementManager::GetAllSceneElementIDs);
+    AddMethodHandler(ControllerServiceSceneElementInterfaceName, "GetSceneElementName", &sceneElementManager, &SceneElementManager::GetSceneElementName);
+    AddStoreMethodHandler(ControllerServiceSceneElementInterfaceName, "SetSceneElementName", &sceneElementManager, &SceneElementManager::SetSceneElementName);
+    AddStoreMethodHandler(ControllerServiceSceneElementInterfaceName, "CreateSceneElement", &sceneElementManager, &SceneElementManager::CreateSceneElement);
+    AddStoreMethodHandler(ControllerServiceSceneElementInterfaceName, "CreateSceneElements", &sceneElementManager, &SceneElementManager::CreateSceneElements);
+    AddStoreMethodHandler(ControllerServiceSceneElementInterfaceName, "UpdateSceneElement", &sceneElementManager, &SceneElementManager::UpdateSceneElement);
+    AddStoreMethodHandler(ControllerServiceSceneElementInterfaceName, "DeleteSceneElement", &sceneElementManager, &SceneElementManager::DeleteSceneElement);
+    AddStoreMethodHandler(ControllerServiceSceneElementInterfaceName, "DeleteSceneElements", &sceneElementManager, &SceneElementManager::DeleteSceneElements);
+    AddMethodHandler(ControllerServiceSceneElementInterfaceName, "GetSceneElement", &sceneElementManager, &SceneElementManager::GetSceneElement);
+    AddMethodHandler(ControllerServiceSceneElementInterfaceName, "ApplySceneElement", &sceneElementManager, &SceneElementManager::ApplySceneElement);
+    AddMethodHandler(ControllerServiceMasterSceneInterfaceName, "GetAllMasterSceneIDs", &masterSceneManager, &MasterSceneManager::GetAllMasterSceneIDs);
+    AddMethodHandler(ControllerServiceMasterSceneInterfaceName, "GetMasterSceneName", &masterSceneManager, &MasterSceneManager::GetMasterSceneName);
+    AddStoreMethodHandler(ControllerServiceMasterSceneInterfaceName, "SetMasterSceneName", &masterSceneManager, &MasterSceneManager::SetMasterSceneName);
+    AddStoreMethodHandler(ControllerServiceMasterSceneInterfaceName, "CreateMasterScene", &masterSceneManager, &MasterSceneManager::CreateMasterScene);
+    AddStoreMethodHandler(ControllerServiceMasterSceneInterfaceName, "UpdateMasterScene", &masterSceneManager, &MasterSceneManager::UpdateMasterScene);
+    AddStoreMethodHandler(ControllerServiceMasterSceneInterfaceName, "DeleteMasterScene", &masterSceneManager, &MasterSceneManager::DeleteMasterScene);
+    AddMethodHandler(ControllerServiceMasterSceneInterfaceName, "GetMasterScene", &masterSceneManager, &MasterSceneManager::GetMasterScene);
+    AddMethodHandler(ControllerServiceMasterSceneInterfaceName, "ApplyMasterScene", &masterSceneManager, &MasterSceneManager::ApplyMasterScene);
+    AddMethodHandler(ControllerServiceDataSetInterfaceName, "GetLampDataSet", &lampManager, &LampManager::GetLampDataSet);
+    AddMethodHandler(ControllerServiceStatisticsInterfaceName, "GetControllerServiceStatistics", this, &ControllerService::GetControllerServiceStatistics);
     messageHandlersLock.Unlock();
 }
 
@@ -580,6 +611,7 @@ QStatus ControllerService::RegisterMethodHandlers(void)
     const InterfaceDescription* controllerServiceSceneElementInterface = bus.GetInterface(ControllerServiceSceneElementInterfaceName);
     const InterfaceDescription* controllerServiceMasterSceneInterface = bus.GetInterface(ControllerServiceMasterSceneInterfaceName);
     const InterfaceDescription* controllerServiceDataSetInterface = bus.GetInterface(ControllerServiceDataSetInterfaceName);
+    const InterfaceDescription* controllerServiceStatisticsInterface = bus.GetInterface(ControllerServiceStatisticsInterfaceName);
 
     /*
      * Add method handlers for the various Controller Service interface methods
@@ -611,8 +643,10 @@ QStatus ControllerService::RegisterMethodHandlers(void)
         { controllerServiceLampGroupInterface->GetMember("GetLampGroupName"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceLampGroupInterface->GetMember("SetLampGroupName"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceLampGroupInterface->GetMember("CreateLampGroup"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
+        { controllerServiceLampGroupInterface->GetMember("CreateLampGroups"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceLampGroupInterface->GetMember("UpdateLampGroup"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceLampGroupInterface->GetMember("DeleteLampGroup"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
+        { controllerServiceLampGroupInterface->GetMember("DeleteLampGroups"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceLampGroupInterface->GetMember("GetLampGroup"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceLampGroupInterface->GetMember("TransitionLampGroupState"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceLampGroupInterface->GetMember("PulseLampGroupWithState"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
@@ -627,8 +661,11 @@ QStatus ControllerService::RegisterMethodHandlers(void)
         { controllerServicePresetInterface->GetMember("GetPresetName"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServicePresetInterface->GetMember("SetPresetName"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServicePresetInterface->GetMember("CreatePreset"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
+        { controllerServicePresetInterface->GetMember("CreatePresets"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServicePresetInterface->GetMember("UpdatePreset"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
+        { controllerServicePresetInterface->GetMember("UpdatePresets"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServicePresetInterface->GetMember("DeletePreset"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
+        { controllerServicePresetInterface->GetMember("DeletePresets"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServicePresetInterface->GetMember("GetPreset"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceTransitionEffectInterface->GetMember("GetAllTransitionEffectIDs"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceTransitionEffectInterface->GetMember("GetTransitionEffectName"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
@@ -654,17 +691,21 @@ QStatus ControllerService::RegisterMethodHandlers(void)
         { controllerServiceSceneInterface->GetMember("CreateScene"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceSceneInterface->GetMember("UpdateScene"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceSceneInterface->GetMember("DeleteScene"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
+        { controllerServiceSceneInterface->GetMember("DeleteScenes"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceSceneInterface->GetMember("GetScene"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceSceneInterface->GetMember("ApplyScene"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceSceneWithSceneElementsInterface->GetMember("CreateSceneWithSceneElements"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
+        { controllerServiceSceneWithSceneElementsInterface->GetMember("CreateScenesWithSceneElements"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceSceneWithSceneElementsInterface->GetMember("UpdateSceneWithSceneElements"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceSceneWithSceneElementsInterface->GetMember("GetSceneWithSceneElements"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceSceneElementInterface->GetMember("GetAllSceneElementIDs"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceSceneElementInterface->GetMember("GetSceneElementName"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceSceneElementInterface->GetMember("SetSceneElementName"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceSceneElementInterface->GetMember("CreateSceneElement"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
+        { controllerServiceSceneElementInterface->GetMember("CreateSceneElements"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceSceneElementInterface->GetMember("UpdateSceneElement"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceSceneElementInterface->GetMember("DeleteSceneElement"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
+        { controllerServiceSceneElementInterface->GetMember("DeleteSceneElements"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceSceneElementInterface->GetMember("GetSceneElement"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceSceneElementInterface->GetMember("ApplySceneElement"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceMasterSceneInterface->GetMember("GetAllMasterSceneIDs"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
@@ -675,7 +716,8 @@ QStatus ControllerService::RegisterMethodHandlers(void)
         { controllerServiceMasterSceneInterface->GetMember("DeleteMasterScene"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceMasterSceneInterface->GetMember("GetMasterScene"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
         { controllerServiceMasterSceneInterface->GetMember("ApplyMasterScene"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
-        { controllerServiceDataSetInterface->GetMember("GetLampDataSet"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) }
+        { controllerServiceDataSetInterface->GetMember("GetLampDataSet"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) },
+        { controllerServiceStatisticsInterface->GetMember("GetControllerServiceStatistics"), static_cast<MessageReceiver::MethodHandler>(&ControllerService::MethodCallDispatcher) }
     };
 
     status = AddMethodHandlers(methodEntries, sizeof(methodEntries) / sizeof(MethodEntry));
@@ -749,7 +791,8 @@ QStatus ControllerService::Start(const char* keyStoreFileLocation)
         { ControllerServiceMasterSceneDescription, ControllerServiceMasterSceneInterfaceName },
         { ControllerServiceTransitionEffectDescription, ControllerServiceTransitionEffectInterfaceName },
         { ControllerServicePulseEffectDescription, ControllerServicePulseEffectInterfaceName },
-        { ControllerServiceDataSetDescription, ControllerServiceDataSetInterfaceName }
+        { ControllerServiceDataSetDescription, ControllerServiceDataSetInterfaceName },
+        { ControllerServiceStatisticsDescription, ControllerServiceStatisticsInterfaceName }
     };
 
     status = CreateAndAddInterfaces(interfaceEntries, sizeof(interfaceEntries) / sizeof(InterfaceEntry));
@@ -764,12 +807,23 @@ QStatus ControllerService::Start(const char* keyStoreFileLocation)
         return status;
     }
 
+    const InterfaceDescription* lampInterface = bus.GetInterface(ControllerServiceLampInterfaceName);
+    if (lampInterface) {
+        lampsStateChangedSignal = lampInterface->GetMember("LampsStateChanged");
+    }
+
     status = fileWriterThread.Start();
     if (status != ER_OK) {
         QCC_LogError(status, ("%s: Failed to start file writer thread", __func__));
         return status;
     }
 
+    status = methodCallExecutor.Start();
+    if (status != ER_OK) {
+        QCC_LogError(status, ("%s: Failed to start method call executor", __func__));
+        return status;
+    }
+
     status = aboutIcon.SetContent(DeviceIconMimeType.c_str(), DeviceIcon, DeviceIconSize);
     if (ER_OK != status) {
         status = ER_FAIL;
@@ -786,6 +840,8 @@ QStatus ControllerService::Start(const char* keyStoreFileLocation)
 
     Initialize();
 
+    FreezeMethodHandlers();
+
     /*
      * Register the Config Service on the AllJoyn bus
      */
@@ -870,6 +926,16 @@ QStatus ControllerService::Stop(void)
 
     fileWriterThread.Stop();
 
+    /*
+     * Reply to the method calls that will not be executed any more while the
+     * bus is still connected
+     */
+    std::list<Message> droppedCalls;
+    methodCallExecutor.Stop(droppedCalls);
+    for (std::list<Message>::iterator it = droppedCalls.begin(); it != droppedCalls.end(); ++it) {
+        SendBusyReply(*it);
+    }
+
     bus.UnregisterAllAboutListeners();
 
     sceneManager.UnregisterSceneEventActionObjects();
@@ -912,6 +978,8 @@ QStatus ControllerService::Join(void)
 
     fileWriterThread.Join();
 
+    methodCallExecutor.Join();
+
     bus.UnregisterBusListener(*listener);
 
     bus.UnbindSessionPort(ControllerServiceSessionPort);
@@ -1037,6 +1105,44 @@ QStatus ControllerService::SendStateChangedSignal(const char* ifaceName, const c
     return status;
 }
 
+QStatus ControllerService::SendLampsStateChangedSignal(const LampStateMap& lampStates)
+{
+    QCC_DbgTrace(("%s: numLamps=%d", __func__, lampStates.size()));
+    QStatus status = ER_BUS_NO_SESSION;
+
+    size_t numLamps = lampStates.size();
+    MsgArg* stateArgs = new MsgArg[numLamps];
+    MsgArg* entries = new MsgArg[numLamps];
+
+    size_t i = 0;
+    for (LampStateMap::const_iterator it = lampStates.begin(); it != lampStates.end(); ++it, ++i) {
+        size_t stateArgsSize;
+        MsgArg* stateDict;
+        it->second.Get(&stateArgs[i], true);
+        stateArgs[i].Get("a{sv}", &stateArgsSize, &stateDict);
+        entries[i].Set("(sa{sv})", it->first.c_str(), stateArgsSize, stateDict);
+    }
+
+    MsgArg arg;
+    arg.Set("a(sa{sv})", numLamps, entries);
+
+    serviceSessionMutex.Lock();
+    if ((serviceSession != 0) && lampsStateChangedSignal) {
+        QCC_DbgPrintf(("%s: Session ID = %u", __func__, serviceSession));
+        status = Signal(NULL, serviceSession, *lampsStateChangedSignal, &arg, 1, 0);
+    }
+    serviceSessionMutex.Unlock();
+
+    delete [] entries;
+    delete [] stateArgs;
+
+    if (ER_OK != status) {
+        QCC_LogError(status, ("%s: Failed to send signal", __func__));
+    }
+
+    return status;
+}
+
 QStatus ControllerService::SendSignalWithoutArg(const char* ifaceName, const char* signalName)
 {
     QCC_DbgTrace(("%s:ifaceName=%s signalName=%s", __func__, ifaceName, signalName));
@@ -1269,6 +1375,359 @@ LSFResponseCode ControllerService::LightingResetAPI(void)
     return responseCode;
 }
 
+/*
+ * Version of the configuration snapshot format. A snapshot looks like
+ *
+ * LSFConfiguration <version>
+ * Section <name>
+ * <the records of the store, in the format of its persistent store file>
+ * EndSection
+ * ...
+ * EndLSFConfiguration
+ *
+ * A store without a section is empty in the snapshot
+ */
+#define LSF_CONFIGURATION_VERSION 1
+
+enum ConfigurationSection {
+    CONFIGURATION_LAMP_GROUPS,
+    CONFIGURATION_PRESETS,
+    CONFIGURATION_TRANSITION_EFFECTS,
+    CONFIGURATION_PULSE_EFFECTS,
+    CONFIGURATION_SCENE_ELEMENTS,
+    CONFIGURATION_SCENES,
+    CONFIGURATION_MASTER_SCENES,
+    CONFIGURATION_NUM_SECTIONS
+};
+
+static const char* ConfigurationSectionNames[CONFIGURATION_NUM_SECTIONS] = {
+    "LampGroups",
+    "Presets",
+    "TransitionEffects",
+    "PulseEffects",
+    "SceneElements",
+    "Scenes",
+    "MasterScenes"
+};
+
+/*
+ * Split a snapshot into its sections. The snapshot is read a line at a time,
+ * so only the sections are held in memory and never the raw stream
+ */
+static LSFResponseCode ReadConfigurationSections(std::istream& stream, std::string* sections)
+{
+    std::string line;
+    if (!std::getline(stream, line)) {
+        QCC_LogError(ER_FAIL, ("%s: Empty configuration", __func__));
+        return LSF_ERR_INVALID_ARGS;
+    }
+
+    std::istringstream header(line);
+    std::string magic;
+    uint32_t version = 0;
+    header >> magic >> version;
+    if ((magic != "LSFConfiguration") || (version != LSF_CONFIGURATION_VERSION)) {
+        QCC_LogError(ER_FAIL, ("%s: Unsupported configuration header %s", __func__, line.c_str()));
+        return LSF_ERR_INVALID_ARGS;
+    }
+
+    bool seen[CONFIGURATION_NUM_SECTIONS] = { false };
+    while (std::getline(stream, line)) {
+        if (line == "EndLSFConfiguration") {
+            return LSF_OK;
+        }
+        if (line.empty()) {
+            continue;
+        }
+
+        int section = CONFIGURATION_NUM_SECTIONS;
+        if (0 == line.compare(0, 8, "Section ")) {
+            for (section = 0; section < CONFIGURATION_NUM_SECTIONS; section++) {
+                if (0 == line.compare(8, std::string::npos, ConfigurationSectionNames[section])) {
+                    break;
+                }
+            }
+        }
+        if ((section == CONFIGURATION_NUM_SECTIONS) || seen[section]) {
+            QCC_LogError(ER_FAIL, ("%s: Unexpected line %s", __func__, line.c_str()));
+            return LSF_ERR_INVALID_ARGS;
+        }
+        seen[section] = true;
+
+        bool ended = false;
+        while (!ended && std::getline(stream, line)) {
+            if (line == "EndSection") {
+                ended = true;
+            } else {
+                sections[section] += line;
+                sections[section] += '\n';
+            }
+        }
+        if (!ended) {
+            break;
+        }
+    }
+
+    QCC_LogError(ER_FAIL, ("%s: Truncated configuration", __func__));
+    return LSF_ERR_INVALID_ARGS;
+}
+
+/*
+ * Check that every reference between the staged entities resolves within the
+ * snapshot. These are the references that the delete handlers refuse to break
+ */
+static LSFResponseCode ValidateConfiguration(const LampGroupMap& lampGroups, const PresetMap& presets,
+                                             const TransitionEffectMap& transitionEffects, const PulseEffectMap& pulseEffects,
+                                             const SceneElementMap& sceneElements, const SceneWithSceneElementsMap& scenes,
+                                             const MasterSceneMap& masterScenes)
+{
+    for (LampGroupMap::const_iterator it = lampGroups.begin(); it != lampGroups.end(); ++it) {
+        const LSFStringList& subGroups = it->second.second.lampGroups;
+        for (LSFStringList::const_iterator lit = subGroups.begin(); lit != subGroups.end(); ++lit) {
+            if (lampGroups.find(*lit) == lampGroups.end()) {
+                QCC_LogError(ER_FAIL, ("%s: Lamp Group %s refers to missing Lamp Group %s", __func__, it->first.c_str(), lit->c_str()));
+                return LSF_ERR_DEPENDENCY;
+            }
+        }
+    }
+
+    for (SceneElementMap::const_iterator it = sceneElements.begin(); it != sceneElements.end(); ++it) {
+        const SceneElement& sceneElement = it->second.second;
+        for (LSFStringList::const_iterator lit = sceneElement.lampGroups.begin(); lit != sceneElement.lampGroups.end(); ++lit) {
+            if (lampGroups.find(*lit) == lampGroups.end()) {
+                QCC_LogError(ER_FAIL, ("%s: Scene Element %s refers to missing Lamp Group %s", __func__, it->first.c_str(), lit->c_str()));
+                return LSF_ERR_DEPENDENCY;
+            }
+        }
+
+        bool found = false;
+        switch (sceneElement.effectType) {
+        case LSF_EFFECT_TRANSITION:
+            found = (transitionEffects.find(sceneElement.effectID) != transitionEffects.end());
+            break;
+
+        case LSF_EFFECT_PULSE:
+            found = (pulseEffects.find(sceneElement.effectID) != pulseEffects.end());
+            break;
+
+        case LSF_EFFECT_PRESET:
+            found = (presets.find(sceneElement.effectID) != presets.end());
+            break;
+
+        default:
+            break;
+        }
+        if (!found) {
+            QCC_LogError(ER_FAIL, ("%s: Scene Element %s refers to missing effect %s", __func__, it->first.c_str(), sceneElement.effectID.c_str()));
+            return LSF_ERR_DEPENDENCY;
+        }
+    }
+
+    for (SceneWithSceneElementsMap::const_iterator it = scenes.begin(); it != scenes.end(); ++it) {
+        const LSFStringList& elements = it->second.second.sceneElements;
+        for (LSFStringList::const_iterator lit = elements.begin(); lit != elements.end(); ++lit) {
+            if (sceneElements.find(*lit) == sceneElements.end()) {
+                QCC_LogError(ER_FAIL, ("%s: Scene %s refers to missing Scene Element %s", __func__, it->first.c_str(), lit->c_str()));
+                return LSF_ERR_DEPENDENCY;
+            }
+        }
+    }
+
+    for (MasterSceneMap::const_iterator it = masterScenes.begin(); it != masterScenes.end(); ++it) {
+        const LSFStringList& subScenes = it->second.second.scenes;
+        for (LSFStringList::const_iterator lit = subScenes.begin(); lit != subScenes.end(); ++lit) {
+            if (scenes.find(*lit) == scenes.end()) {
+                QCC_LogError(ER_FAIL, ("%s: Master Scene %s refers to missing Scene %s", __func__, it->first.c_str(), lit->c_str()));
+                return LSF_ERR_DEPENDENCY;
+            }
+        }
+    }
+
+    return LSF_OK;
+}
+
+void ControllerService::LockConfigurationStores(void)
+{
+    masterSceneManager.LockStore();
+    sceneManager.LockStore();
+    sceneElementManager.LockStore();
+    transitionEffectManager.LockStore();
+    pulseEffectManager.LockStore();
+    presetManager.LockStore();
+    lampGroupManager.LockStore();
+}
+
+void ControllerService::UnlockConfigurationStores(void)
+{
+    lampGroupManager.UnlockStore();
+    presetManager.UnlockStore();
+    pulseEffectManager.UnlockStore();
+    transitionEffectManager.UnlockStore();
+    sceneElementManager.UnlockStore();
+    sceneManager.UnlockStore();
+    masterSceneManager.UnlockStore();
+}
+
+LSFResponseCode ControllerService::ExportConfigurationAPI(std::ostream& stream)
+{
+    QCC_DbgPrintf(("%s", __func__));
+
+    /*
+     * Build the snapshot in memory so that the stores are not held
+     * while it is written out
+     */
+    std::ostringstream sections[CONFIGURATION_NUM_SECTIONS];
+
+    LockConfigurationStores();
+    lampGroupManager.ExportConfiguration(sections[CONFIGURATION_LAMP_GROUPS]);
+    presetManager.ExportConfiguration(sections[CONFIGURATION_PRESETS]);
+    transitionEffectManager.ExportConfiguration(sections[CONFIGURATION_TRANSITION_EFFECTS]);
+    pulseEffectManager.ExportConfiguration(sections[CONFIGURATION_PULSE_EFFECTS]);
+    sceneElementManager.ExportConfiguration(sections[CONFIGURATION_SCENE_ELEMENTS]);
+    sceneManager.ExportConfiguration(sections[CONFIGURATION_SCENES]);
+    masterSceneManager.ExportConfiguration(sections[CONFIGURATION_MASTER_SCENES]);
+    UnlockConfigurationStores();
+
+    stream << "LSFConfiguration " << LSF_CONFIGURATION_VERSION << '\n';
+    for (int section = 0; section < CONFIGURATION_NUM_SECTIONS; section++) {
+        stream << "Section " << ConfigurationSectionNames[section] << '\n';
+        stream << sections[section].str();
+        stream << "EndSection\n";
+    }
+    stream << "EndLSFConfiguration\n";
+    stream.flush();
+
+    return stream.good() ? LSF_OK : LSF_ERR_FAILURE;
+}
+
+LSFResponseCode ControllerService::ImportConfigurationAPI(std::istream& stream)
+{
+    QCC_DbgPrintf(("%s", __func__));
+
+    if (!UpdatesAllowed()) {
+        return LSF_ERR_BUSY;
+    }
+
+    std::string sections[CONFIGURATION_NUM_SECTIONS];
+    LSFResponseCode responseCode = ReadConfigurationSections(stream, sections);
+    if (LSF_OK != responseCode) {
+        return responseCode;
+    }
+
+    LampGroupMap lampGroups;
+    PresetMap presets;
+    TransitionEffectMap transitionEffects;
+    PulseEffectMap pulseEffects;
+    SceneElementMap sceneElements;
+    SceneWithSceneElementsMap scenes;
+    MasterSceneMap masterScenes;
+    size_t lampGroupsBlobLength = 0;
+    size_t presetsBlobLength = 0;
+    size_t transitionEffectsBlobLength = 0;
+    size_t pulseEffectsBlobLength = 0;
+    size_t sceneElementsBlobLength = 0;
+    size_t masterScenesBlobLength = 0;
+
+    ConfigurationChanges lampGroupChanges;
+    ConfigurationChanges presetChanges;
+    ConfigurationChanges transitionEffectChanges;
+    ConfigurationChanges pulseEffectChanges;
+    ConfigurationChanges sceneElementChanges;
+    ConfigurationChanges sceneChanges;
+    ConfigurationChanges masterSceneChanges;
+
+    LockConfigurationStores();
+
+    /*
+     * Stage every store before any of them is replaced, so that a failure
+     * leaves all of them untouched
+     */
+    if (LSF_OK == responseCode) {
+        BlobInputStream section(sections[CONFIGURATION_LAMP_GROUPS]);
+        responseCode = lampGroupManager.StageConfiguration(section, lampGroups, lampGroupsBlobLength);
+    }
+    if (LSF_OK == responseCode) {
+        BlobInputStream section(sections[CONFIGURATION_PRESETS]);
+        responseCode = presetManager.StageConfiguration(section, presets, presetsBlobLength);
+    }
+    if (LSF_OK == responseCode) {
+        BlobInputStream section(sections[CONFIGURATION_TRANSITION_EFFECTS]);
+        responseCode = transitionEffectManager.StageConfiguration(section, transitionEffects, transitionEffectsBlobLength);
+    }
+    if (LSF_OK == responseCode) {
+        BlobInputStream section(sections[CONFIGURATION_PULSE_EFFECTS]);
+        responseCode = pulseEffectManager.StageConfiguration(section, pulseEffects, pulseEffectsBlobLength);
+    }
+    if (LSF_OK == responseCode) {
+        BlobInputStream section(sections[CONFIGURATION_SCENE_ELEMENTS]);
+        responseCode = sceneElementManager.StageConfiguration(section, sceneElements, sceneElementsBlobLength);
+    }
+    if (LSF_OK == responseCode) {
+        BlobInputStream section(sections[CONFIGURATION_SCENES]);
+        responseCode = sceneManager.StageConfiguration(section, scenes);
+    }
+    if (LSF_OK == responseCode) {
+        BlobInputStream section(sections[CONFIGURATION_MASTER_SCENES]);
+        responseCode = masterSceneManager.StageConfiguration(section, masterScenes, masterScenesBlobLength);
+    }
+    if (LSF_OK == responseCode) {
+        responseCode = ValidateConfiguration(lampGroups, presets, transitionEffects, pulseEffects, sceneElements, scenes, masterScenes);
+    }
+
+    /*
+     * Scenes are rebuilt from the scene elements and effects, so those
+     * have to be in place before the scenes are committed
+     */
+    if (LSF_OK == responseCode) {
+        lampGroupManager.CommitConfiguration(lampGroups, lampGroupsBlobLength, lampGroupChanges);
+        presetManager.CommitConfiguration(presets, presetsBlobLength, presetChanges);
+        transitionEffectManager.CommitConfiguration(transitionEffects, transitionEffectsBlobLength, transitionEffectChanges);
+        pulseEffectManager.CommitConfiguration(pulseEffects, pulseEffectsBlobLength, pulseEffectChanges);
+        sceneElementManager.CommitConfiguration(sceneElements, sceneElementsBlobLength, sceneElementChanges);
+        sceneManager.CommitConfiguration(scenes, sceneChanges);
+        masterSceneManager.CommitConfiguration(masterScenes, masterScenesBlobLength, masterSceneChanges);
+    }
+
+    UnlockConfigurationStores();
+
+    if (LSF_OK == responseCode) {
+        lampGroupManager.SendConfigurationSignals(ControllerServiceLampGroupInterfaceName, "LampGroups", lampGroupChanges);
+        presetManager.SendConfigurationSignals(ControllerServicePresetInterfaceName, "Presets", presetChanges);
+        SendSignalWithoutArg(ControllerServicePresetInterfaceName, "DefaultLampStateChanged");
+        transitionEffectManager.SendConfigurationSignals(ControllerServiceTransitionEffectInterfaceName, "TransitionEffects", transitionEffectChanges);
+        pulseEffectManager.SendConfigurationSignals(ControllerServicePulseEffectInterfaceName, "PulseEffects", pulseEffectChanges);
+        sceneElementManager.SendConfigurationSignals(ControllerServiceSceneElementInterfaceName, "SceneElements", sceneElementChanges);
+        sceneManager.SendConfigurationSignals(ControllerServiceSceneInterfaceName, "Scenes", sceneChanges);
+        masterSceneManager.SendConfigurationSignals(ControllerServiceMasterSceneInterfaceName, "MasterScenes", masterSceneChanges);
+    }
+
+    return responseCode;
+}
+
+LSFResponseCode ControllerService::ExportConfiguration(const std::string& filePath)
+{
+    QCC_DbgTrace(("%s:filePath=%s", __func__, filePath.c_str()));
+    std::ofstream stream(filePath.c_str(), std::ios_base::out | std::ios_base::trunc);
+    if (!stream.is_open()) {
+        QCC_LogError(ER_FAIL, ("%s: Unable to open %s", __func__, filePath.c_str()));
+        return LSF_ERR_FAILURE;
+    }
+
+    return ExportConfigurationAPI(stream);
+}
+
+LSFResponseCode ControllerService::ImportConfiguration(const std::string& filePath)
+{
+    QCC_DbgTrace(("%s:filePath=%s", __func__, filePath.c_str()));
+    std::ifstream stream(filePath.c_str());
+    if (!stream.is_open()) {
+        QCC_LogError(ER_FAIL, ("%s: Unable to open %s", __func__, filePath.c_str()));
+        return LSF_ERR_NOT_FOUND;
+    }
+
+    return ImportConfigurationAPI(stream);
+}
+
 void ControllerService::GetControllerServiceVersion(Message& msg)
 {
     QCC_DbgPrintf(("%s:%s", __func__, msg->ToString().c_str()));
@@ -1276,40 +1735,184 @@ void ControllerService::GetControllerServiceVersion(Message& msg)
     SendMethodReplyWithUint32Value(msg, version);
 }
 
-lsf::Mutex methodCallCountMutex;
-uint32_t methodCallCount = 0;
+void ControllerService::RegisterPolledStatistics(void)
+{
+    methodCallsStatistic = statistics.Register("ControllerService.MethodCalls", LSF_STATISTIC_COUNTER);
+    executedCallsStatistic = statistics.Register("MethodCallExecutor.ExecutedCalls", LSF_STATISTIC_COUNTER);
+    rejectedCallsStatistic = statistics.Register("MethodCallExecutor.RejectedCalls", LSF_STATISTIC_COUNTER);
+    executorP50LatencyStatistic = statistics.Register("MethodCallExecutor.P50LatencyMs", LSF_STATISTIC_GAUGE);
+    executorP99LatencyStatistic = statistics.Register("MethodCallExecutor.P99LatencyMs", LSF_STATISTIC_GAUGE);
+    executorMaxLatencyStatistic = statistics.Register("MethodCallExecutor.MaxLatencyMs", LSF_STATISTIC_GAUGE);
+    lastFailoverStatistic = statistics.Register("LeaderElection.LastFailoverMs", LSF_STATISTIC_GAUGE);
+    blobRepliesStatistic = statistics.Register("LeaderElection.BlobReplies", LSF_STATISTIC_COUNTER);
+    averageBlobReplyLatencyStatistic = statistics.Register("LeaderElection.AverageBlobReplyLatencyMs", LSF_STATISTIC_GAUGE);
+    maxBlobReplyLatencyStatistic = statistics.Register("LeaderElection.MaxBlobReplyLatencyMs", LSF_STATISTIC_GAUGE);
+    lastSyncStatistic = statistics.Register("LeaderElection.LastSyncMs", LSF_STATISTIC_GAUGE);
+    lastSyncBlobsStatistic = statistics.Register("LeaderElection.LastSyncBlobs", LSF_STATISTIC_GAUGE);
+    traceRecordsStatistic = statistics.Register("RequestTracer.Records", LSF_STATISTIC_COUNTER);
+}
+
+void ControllerService::UpdatePolledStatistics(void)
+{
+    methodCallsStatistic->Set(methodCallCount);
+
+    uint64_t numCalls, numRejectedCalls;
+    uint32_t p50, p99, maxLatencyMs;
+    methodCallExecutor.GetLatencyInfo(numCalls, numRejectedCalls, p50, p99, maxLatencyMs);
+    executedCallsStatistic->Set(static_cast<int64_t>(numCalls));
+    rejectedCallsStatistic->Set(static_cast<int64_t>(numRejectedCalls));
+    executorP50LatencyStatistic->Set(p50);
+    executorP99LatencyStatistic->Set(p99);
+    executorMaxLatencyStatistic->Set(maxLatencyMs);
+
+    uint32_t numReplies;
+    uint64_t averageLatency, maxLatency;
+    elector.GetBlobReplyLatencyInfo(numReplies, averageLatency, maxLatency);
+    lastFailoverStatistic->Set(elector.GetLastFailoverTimeInMs());
+    blobRepliesStatistic->Set(numReplies);
+    averageBlobReplyLatencyStatistic->Set(static_cast<int64_t>(averageLatency));
+    maxBlobReplyLatencyStatistic->Set(static_cast<int64_t>(maxLatency));
+
+    uint32_t syncTime, syncBlobs;
+    elector.GetLastSyncInfo(syncTime, syncBlobs);
+    lastSyncStatistic->Set(syncTime);
+    lastSyncBlobsStatistic->Set(syncBlobs);
+
+    traceRecordsStatistic->Set(RequestTracer::GetNumRecords());
+}
+
+void ControllerService::GetControllerServiceStatistics(Message& msg)
+{
+    QCC_DbgPrintf(("%s:%s", __func__, msg->ToString().c_str()));
+
+    UpdatePolledStatistics();
+
+    size_t numStatistics = statistics.GetNumStatistics();
+    MsgArg* entries = new MsgArg[numStatistics ? numStatistics : 1];
+    for (size_t i = 0; i < numStatistics; i++) {
+        const LSFStatistic& statistic = statistics.GetStatistic(i);
+        uint32_t p50 = 0, p99 = 0, maxValue = 0;
+        if (statistic.GetType() == LSF_STATISTIC_HISTOGRAM) {
+            statistic.GetPercentiles(p50, p99, maxValue);
+        }
+        entries[i].Set("(suxuuu)", statistic.GetName(), static_cast<uint32_t>(statistic.GetType()), statistic.GetValue(), p50, p99, maxValue);
+    }
+
+    MsgArg replyArgs[2];
+    replyArgs[0].Set("u", LSF_OK);
+    replyArgs[1].Set("a(suxuuu)", numStatistics, entries);
+
+    SendMethodReply(msg, replyArgs, sizeof(replyArgs) / sizeof(MsgArg));
+
+    delete [] entries;
+}
+
+QStatus ControllerService::DumpStatistics(const std::string& filePath)
+{
+    QCC_DbgTrace(("%s:filePath=%s", __func__, filePath.c_str()));
+    UpdatePolledStatistics();
+    return statistics.DumpToFile(filePath);
+}
 
 void ControllerService::MethodCallDispatcher(const InterfaceDescription::Member* member, Message& msg)
 {
     bus.EnableConcurrentCallbacks();
+    LSF_TRACE_SCOPE(LSF_TRACE_ID(msg), "Dispatch");
 
     QCC_DbgPrintf(("%s: Received Method call %s from interface %s", __func__, msg->GetMemberName(), msg->GetInterface()));
-    uint32_t tempMethodCallCount = 0;
-
-    methodCallCountMutex.Lock();
-    methodCallCount++;
-    tempMethodCallCount = methodCallCount;
-    methodCallCountMutex.Unlock();
-
+    uint32_t tempMethodCallCount = static_cast<uint32_t>(qcc::IncrementAndFetch(&methodCallCount));
 
     QCC_DbgPrintf(("%s: Received Method call %s with method call count %u", __func__, msg->GetMemberName(), tempMethodCallCount));
 
+    if (dispatchTableFrozen) {
+        DispatchTable::const_iterator it = std::lower_bound(dispatchTable.begin(), dispatchTable.end(), member, DispatchTableEntryLess());
+        if ((it != dispatchTable.end()) && (it->first == member)) {
+            /*
+             * Run the handler on the executor so that the AllJoyn dispatcher
+             * threads are never held by a manager
+             */
+            if (!methodCallExecutor.Submit(it->second.handler, msg, it->second.serialKey)) {
+                SendMethodReplyWithResponseCodeOnly(member, msg, LSF_ERR_BUSY);
+            }
+        } else {
+            QCC_LogError(ER_FAIL, ("%s: Could not find handler for method call", __func__));
+        }
+        return;
+    }
+
     MethodHandlerBase* handler = NULL;
 
     messageHandlersLock.Lock();
-    DispatcherMap::iterator it = messageHandlers.find(msg->GetMemberName());
+    DispatcherMap::iterator it = messageHandlers.find(DispatcherKey(msg->GetInterface(), msg->GetMemberName()));
     if (it != messageHandlers.end()) {
         handler = it->second;
-    } else {
-        QCC_LogError(ER_FAIL, ("%s: Could not find handler for method call", __func__));
     }
     messageHandlersLock.Unlock();
 
+    if (!handler) {
+        QCC_LogError(ER_FAIL, ("%s: Could not find handler for method call", __func__));
+    }
+
     if (handler) {
         handler->Handle(msg);
     }
 }
 
+void ControllerService::FreezeMethodHandlers(void)
+{
+    QCC_DbgTrace(("%s", __func__));
+
+    const char* interfaceNames[] = {
+        ControllerServiceInterfaceName,
+        ControllerServiceLampInterfaceName,
+        ControllerServiceLampGroupInterfaceName,
+        ControllerServicePresetInterfaceName,
+        ControllerServiceTransitionEffectInterfaceName,
+        ControllerServicePulseEffectInterfaceName,
+        ControllerServiceSceneInterfaceName,
+        ControllerServiceSceneWithSceneElementsInterfaceName,
+        ControllerServiceSceneElementInterfaceName,
+        ControllerServiceMasterSceneInterfaceName,
+        ControllerServiceDataSetInterfaceName,
+        ControllerServiceStatisticsInterfaceName
+    };
+
+    dispatchTableFrozen = false;
+    dispatchTable.clear();
+
+    messageHandlersLock.Lock();
+    for (size_t i = 0; i < (sizeof(interfaceNames) / sizeof(interfaceNames[0])); i++) {
+        const InterfaceDescription* intf = bus.GetInterface(interfaceNames[i]);
+        if (!intf) {
+            continue;
+        }
+
+        size_t numMembers = intf->GetMembers();
+        const InterfaceDescription::Member** members = new const InterfaceDescription::Member*[numMembers];
+        intf->GetMembers(members, numMembers);
+        for (size_t j = 0; j < numMembers; j++) {
+            if (members[j]->memberType != MESSAGE_METHOD_CALL) {
+                continue;
+            }
+            DispatcherMap::iterator it = messageHandlers.find(DispatcherKey(interfaceNames[i], members[j]->name));
+            if (it != messageHandlers.end()) {
+                // Only the calls that modify a persistent store have to wait for each other
+                const void* serialKey = it->second->MutatesStore() ? it->second->GetObject() : NULL;
+                dispatchTable.push_back(std::make_pair(members[j], DispatchTarget(it->second, serialKey)));
+            } else {
+                QCC_LogError(ER_FAIL, ("%s: No handler for %s.%s", __func__, interfaceNames[i], members[j]->name.c_str()));
+            }
+        }
+        delete [] members;
+    }
+    messageHandlersLock.Unlock();
+
+    std::sort(dispatchTable.begin(), dispatchTable.end(), DispatchTableEntryLess());
+    dispatchTableFrozen = true;
+
+    QCC_DbgPrintf(("%s: %d method handlers frozen", __func__, dispatchTable.size()));
+}
+
 void ControllerService::SendMethodReply(const ajn::Message& msg, const ajn::MsgArg* args, size_t numArgs)
 {
     QCC_DbgPrintf(("%s: Method Reply for %s", __func__, msg->GetMemberName()));
@@ -1421,10 +2024,123 @@ void ControllerService::SendMethodReplyWithResponseCodeIDLanguageAndName(const a
     }
 }
 
-void ControllerService::ScheduleFileReadWrite(Manager* manager)
+/*
+ * Returns the position just past the complete type that starts at sig
+ */
+static const char* SkipCompleteType(const char* sig)
+{
+    if (*sig == 'a') {
+        return SkipCompleteType(sig + 1);
+    }
+
+    if ((*sig == '(') || (*sig == '{')) {
+        int depth = 0;
+        do {
+            if ((*sig == '(') || (*sig == '{')) {
+                depth++;
+            } else if ((*sig == ')') || (*sig == '}')) {
+                depth--;
+            }
+            sig++;
+        } while (*sig && depth);
+        return sig;
+    }
+
+    return (*sig) ? (sig + 1) : sig;
+}
+
+void ControllerService::SendBusyReply(const ajn::Message& msg)
+{
+    QCC_DbgPrintf(("%s: Rejecting method call %s", __func__, msg->GetMemberName()));
+
+    const InterfaceDescription* intf = bus.GetInterface(msg->GetInterface());
+    const InterfaceDescription::Member* member = intf ? intf->GetMember(msg->GetMemberName()) : NULL;
+    if (member) {
+        SendMethodReplyWithResponseCodeOnly(member, msg, LSF_ERR_BUSY);
+    } else {
+        QStatus status = ajn::BusObject::MethodReply(msg, ER_BUS_REPLY_IS_ERROR_MESSAGE);
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Error sending reply"));
+        }
+    }
+}
+
+void ControllerService::SendMethodReplyWithResponseCodeOnly(const InterfaceDescription::Member* member, const ajn::Message& msg, LSFResponseCode responseCode)
+{
+    QCC_DbgPrintf(("%s: Method Reply for %s", __func__, msg->GetMemberName()));
+
+    std::vector<qcc::String> replyTypes;
+    const char* sig = member->returnSignature.c_str();
+    while (*sig) {
+        const char* next = SkipCompleteType(sig);
+        replyTypes.push_back(qcc::String(sig, next - sig));
+        sig = next;
+    }
+
+    if (replyTypes.empty() || (replyTypes[0] != "u")) {
+        QStatus status = ajn::BusObject::MethodReply(msg, ER_BUS_REPLY_IS_ERROR_MESSAGE);
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Error sending reply"));
+        }
+        return;
+    }
+
+    MsgArg* replyArgs = new MsgArg[replyTypes.size()];
+    MsgArg variantValue("u", 0);
+    bool supported = true;
+
+    replyArgs[0].Set("u", responseCode);
+    for (size_t i = 1; i < replyTypes.size(); i++) {
+        switch (replyTypes[i][0]) {
+        case 's':
+            replyArgs[i].Set("s", "");
+            break;
+
+        case 'u':
+            replyArgs[i].Set("u", 0);
+            break;
+
+        case 't':
+            replyArgs[i].Set("t", static_cast<uint64_t>(0));
+            break;
+
+        case 'b':
+            replyArgs[i].Set("b", false);
+            break;
+
+        case 'v':
+            replyArgs[i].Set("v", &variantValue);
+            break;
+
+        case 'a':
+            replyArgs[i].Set(replyTypes[i].c_str(), static_cast<size_t>(0), static_cast<void*>(NULL));
+            break;
+
+        default:
+            supported = false;
+            break;
+        }
+    }
+
+    QStatus status;
+    if (supported) {
+        status = ajn::BusObject::MethodReply(msg, replyArgs, replyTypes.size());
+    } else {
+        status = ajn::BusObject::MethodReply(msg, ER_BUS_REPLY_IS_ERROR_MESSAGE);
+    }
+    if (status == ER_OK) {
+        QCC_DbgPrintf(("Successfully sent the reply"));
+    } else {
+        QCC_LogError(status, ("Error sending reply"));
+    }
+
+    delete [] replyArgs;
+}
+
+void ControllerService::ScheduleFileReadWrite(Manager* manager, bool write)
 {
     QCC_DbgTrace(("%s", __func__));
-    fileWriterThread.SignalReadWrite();
+    fileWriterThread.SignalReadWrite(manager, write);
 }
 
 uint32_t ControllerService::GetControllerServiceInterfaceVersion(void)
@@ -1461,6 +2177,8 @@ QStatus ControllerService::Get(const char*ifcName, const char*propName, MsgArg&
             status = val.Set("u", pulseEffectManager.GetControllerServicePulseEffectInterfaceVersion());
         } else if (0 == strcmp(ifcName, ControllerServiceDataSetInterfaceName)) {
             status = val.Set("u", lampManager.GetControllerServiceDataSetInterfaceVersion());
+        } else if (0 == strcmp(ifcName, ControllerServiceStatisticsInterfaceName)) {
+            status = val.Set("u", ControllerServiceStatisticsInterfaceVersion);
         } else {
             status = ER_BUS_OBJECT_NO_SUCH_INTERFACE;
         }
@@ -1471,7 +2189,7 @@ QStatus ControllerService::Get(const char*ifcName, const char*propName, MsgArg&
     return status;
 }
 
-QStatus ControllerService::SendBlobUpdate(LSFBlobType type, std::string blob, uint32_t checksum, uint64_t timestamp)
+QStatus ControllerService::SendBlobUpdate(LSFBlobType type, const std::string& blob, uint32_t checksum, uint64_t timestamp)
 {
     QCC_DbgTrace(("%s: (type=%d blob=%s checksum=%d timestamp=%llu)", __func__, type, blob.c_str(), checksum, timestamp));
     SessionId session = 0;
@@ -1487,7 +2205,7 @@ QStatus ControllerService::SendBlobUpdate(LSFBlobType type, std::string blob, ui
     }
 }
 
-void ControllerService::SendGetBlobReply(ajn::Message& message, LSFBlobType type, std::string blob, uint32_t checksum, uint64_t timestamp)
+void ControllerService::SendGetBlobReply(ajn::Message& message, LSFBlobType type, const std::string& blob, uint32_t checksum, uint64_t timestamp)
 {
     QCC_DbgTrace(("%s:type=%d blob=%s checksum=%d timestamp=%llu", __func__, type, blob.c_str(), checksum, timestamp));
     elector.SendGetBlobReply(message, type, blob, checksum, timestamp);
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifdef LSF_BINDINGS
+#include <lsf/controllerservice/DependencyIndex.h>
+#else
+#include <DependencyIndex.h>
+#endif
+
+using namespace lsf;
+
+#ifdef LSF_BINDINGS
+using namespace controllerservice;
+#endif
+
+void DependencyIndex::Add(const LSFString& userID, const LSFStringList& usedIDs)
+{
+    for (LSFStringList::const_iterator it = usedIDs.begin(); it != usedIDs.end(); ++it) {
+        Add(userID, *it);
+    }
+}
+
+void DependencyIndex::Add(const LSFString& userID, const LSFString& usedID)
+{
+    users[usedID][userID]++;
+}
+
+void DependencyIndex::Remove(const LSFString& userID, const LSFStringList& usedIDs)
+{
+    for (LSFStringList::const_iterator it = usedIDs.begin(); it != usedIDs.end(); ++it) {
+        Remove(userID, *it);
+    }
+}
+
+void DependencyIndex::Remove(const LSFString& userID, const LSFString& usedID)
+{
+    UsersMap::iterator uit = users.find(usedID);
+    if (uit == users.end()) {
+        return;
+    }
+
+    UserCountMap::iterator cit = uit->second.find(userID);
+    if (cit != uit->second.end()) {
+        if (--cit->second == 0) {
+            uit->second.erase(cit);
+        }
+    }
+
+    if (uit->second.empty()) {
+        users.erase(uit);
+    }
+}
+
+void DependencyIndex::GetUsers(const LSFString& usedID, LSFStringList& userIDs) const
+{
+    UsersMap::const_iterator uit = users.find(usedID);
+    if (uit != users.end()) {
+        for (UserCountMap::const_iterator cit = uit->second.begin(); cit != uit->second.end(); ++cit) {
+            userIDs.push_back(cit->first);
+        }
+    }
+}
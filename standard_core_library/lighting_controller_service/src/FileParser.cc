@@ -58,13 +58,13 @@ std::string ParseString(std::istream& stream)
     if (name[0] == '"') {
         name = name.substr(1, std::string::npos);
 
-        while (name[name.length() - 1] != '"') {
+        while ((name.empty() || (name[name.length() - 1] != '"')) && !stream.eof()) {
             std::string s;
             stream >> s;
             name += ' ' + s;
         }
 
-        if (name[name.length() - 1] == '"') {
+        if (!name.empty() && (name[name.length() - 1] == '"')) {
             name = name.substr(0, name.length() - 1);
         }
     }
@@ -84,5 +84,30 @@ std::ostream& WriteString(std::ostream& stream, const std::string& name)
     return stream;
 }
 
+size_t GetValueLength(uint32_t value)
+{
+    size_t length = 1;
+    while (value >= 10) {
+        value /= 10;
+        ++length;
+    }
+    return length;
+}
+
+size_t GetLampStateLength(const LampState& state)
+{
+    // two single digit flags and five separators
+    return 7 + GetValueLength(state.hue) + GetValueLength(state.saturation) + GetValueLength(state.colorTemp) + GetValueLength(state.brightness);
+}
+
+size_t GetIDListLength(const LSFStringList& list, size_t markupLength)
+{
+    size_t length = 0;
+    for (LSFStringList::const_iterator it = list.begin(); it != list.end(); ++it) {
+        length += markupLength + it->length();
+    }
+    return length;
+}
+
 OPTIONAL_NAMESPACE_CLOSE
 }
\ No newline at end of file
@@ -126,6 +126,7 @@ void LampClients::GetAllLamps(LampNameMap& lamps)
 
 LampClients::LampClients(ControllerService& controllerSvc)
     : Manager(controllerSvc),
+    lampStateChangesDueTimestamp(0),
     serviceHandler(new ServiceHandler(*this)),
     isRunning(false),
     lampStateChangedSignalHandlerRegistered(false),
@@ -135,6 +136,27 @@ LampClients::LampClients(ControllerService& controllerSvc)
     retryAlarm(this)
 {
     QCC_DbgTrace(("%s", __func__));
+    LSFStatisticsRegistry& statistics = controllerSvc.GetStatistics();
+    lampMethodCallsStatistic = statistics.Register("LampClients.MethodCalls", LSF_STATISTIC_COUNTER);
+    methodQueueDepthStatistic = statistics.Register("LampClients.MethodQueueDepth", LSF_STATISTIC_GAUGE);
+    pendingResponsesStatistic = statistics.Register("LampClients.PendingResponses", LSF_STATISTIC_GAUGE);
+    connectedLampsStatistic = statistics.Register("LampClients.ConnectedLamps", LSF_STATISTIC_GAUGE);
+    blacklistedLampsStatistic = statistics.Register("LampClients.BlacklistedLamps", LSF_STATISTIC_GAUGE);
+    internedStringsStatistic = statistics.Register("LampClients.InternedStrings", LSF_STATISTIC_GAUGE);
+    internedStringBytesStatistic = statistics.Register("LampClients.InternedStringBytes", LSF_STATISTIC_GAUGE);
+    lampIDCopiesStatistic = statistics.Register("LampClients.LampIDCopies", LSF_STATISTIC_COUNTER);
+    stateSignalsStatistic = statistics.Register("LampClients.StateChangedSignals", LSF_STATISTIC_COUNTER);
+    signalledStatesStatistic = statistics.Register("LampClients.SignalledLampStates", LSF_STATISTIC_COUNTER);
+
+    getMethod = LSFStringTable::Intern("Get");
+    getAllMethod = LSFStringTable::Intern("GetAll");
+    transitionLampStateMethod = LSFStringTable::Intern("TransitionLampState");
+    applyPulseEffectMethod = LSFStringTable::Intern("ApplyPulseEffect");
+    clearLampFaultMethod = LSFStringTable::Intern("ClearLampFault");
+    getAboutDataMethod = LSFStringTable::Intern("GetAboutData");
+    getConfigurationsMethod = LSFStringTable::Intern("GetConfigurations");
+    updateConfigurationsMethod = LSFStringTable::Intern("UpdateConfigurations");
+
     keyListener.SetPassCode(INITIAL_PASSCODE);
     methodQueue.clear();
     aboutsList.clear();
@@ -166,6 +188,7 @@ LampClients::~LampClients()
 
     getLampStateListLock.Lock();
     getLampStateList.clear();
+    lampStateRefreshes.clear();
     getLampStateListLock.Unlock();
 
     joinSessionCBListLock.Lock();
@@ -306,8 +329,8 @@ void LampClients::JoinSessionCB(QStatus status, SessionId sessionId, const Sessi
 
     QStatus tempStatus = ER_OK;
 
-    if (!connectToLamps) {
-        QCC_DbgPrintf(("%s: connectToLamps is false", __func__));
+    if (!KeepLampSessions()) {
+        QCC_DbgPrintf(("%s: Not keeping lamp sessions", __func__));
         tempStatus = ER_FAIL;
     } else {
         if (status != ER_OK) {
@@ -359,8 +382,8 @@ void LampClients::SessionLost(SessionId sessionId, SessionLostReason reason)
 {
     QCC_DbgPrintf(("%s: sessionId=0x%x reason=0x%x\n", __func__, sessionId, reason));
 
-    if (!connectToLamps) {
-        QCC_DbgPrintf(("%s: connectToLamps is false", __func__));
+    if (!KeepLampSessions()) {
+        QCC_DbgPrintf(("%s: Not keeping lamp sessions", __func__));
         return;
     }
 
@@ -431,7 +454,10 @@ void LampClients::QueueLampMethod(QueuedMethodCall* queuedCall)
 
                 QCC_DbgPrintf(("%s: Queuing Method call %s with method call count %u", __func__, queuedCall->inMsg->GetMemberName(), queuedCall->methodCallCount));
 
+                queuedCall->traceTimestamp = LSF_TRACE_TIMESTAMP();
                 methodQueue.push_back(queuedCall);
+                methodQueueDepthStatistic->Set(static_cast<int64_t>(methodQueue.size()));
+                lampMethodCallsStatistic->Increment();
             } else {
                 responseCode = LSF_ERR_NO_SLOT;
                 QCC_LogError(ER_OUT_OF_MEMORY, ("%s: No slot for new method call", __func__));
@@ -448,6 +474,7 @@ void LampClients::QueueLampMethod(QueuedMethodCall* queuedCall)
         QCC_DbgPrintf(("%s: Adding response counter with ID=%s to response map", __func__, queuedCall->responseID.c_str()));
         responseLock.Lock();
         responseMap.insert(std::make_pair(queuedCall->responseID, queuedCall->responseCounter));
+        pendingResponsesStatistic->Set(static_cast<int64_t>(responseMap.size()));
         responseLock.Unlock();
         wakeUp.Post();
     } else {
@@ -467,18 +494,37 @@ LSFResponseCode LampClients::DoMethodCallAsync(QueuedMethodCall* queuedCall)
     QStatus status = ER_OK;
     uint32_t notFound = 0;
     uint32_t failures = 0;
-    QueuedMethodCallElementList elementList = queuedCall->methodCallElements;
     QueuedMethodCallContext* ctx = NULL;
 
-    while (elementList.size()) {
-        QueuedMethodCallElement element = elementList.front();
-        LSFStringList lamps = element.lamps;
+    /*
+     * The last reply may free queuedCall before the loop below is done, so
+     * take the elements out of it rather than walking or copying its list
+     */
+    QueuedMethodCallElementList elementList;
+    elementList.swap(queuedCall->methodCallElements);
+    bool allLampsOperation = queuedCall->allLampsOperation;
+
+    LSF_TRACE_STAGE(queuedCall->traceId, "LampQueue", queuedCall->traceTimestamp);
+    LSF_TRACE_SCOPE(queuedCall->traceId, "AllJoynSend");
+
+    for (QueuedMethodCallElementList::const_iterator eit = elementList.begin(); eit != elementList.end(); ++eit) {
+        const QueuedMethodCallElement& element = *eit;
+        LSFStringHandle method = element.method;
+
+        /*
+         * Only an all lamps operation needs its own list of lamps
+         */
+        LSFStringList allLamps;
+        const LSFStringList& lamps = allLampsOperation ? allLamps : element.lamps;
 
-        if (queuedCall->allLampsOperation) {
+        if (allLampsOperation) {
             QCC_DbgPrintf(("%s: Processing All Lamps Operation", __func__));
+            allLamps = element.lamps;
             for (LampMap::iterator lit = activeLamps.begin(); lit != activeLamps.end(); lit++) {
-                lamps.push_back(lit->first);
+                allLamps.push_back(lit->first);
             }
+            // The only lamp IDs still copied on the way to the lamps
+            lampIDCopiesStatistic->Add(allLamps.size());
 
             queuedCall->responseCounter.AddLamps(lamps.size());
             responseLock.Lock();
@@ -496,20 +542,20 @@ LSFResponseCode LampClients::DoMethodCallAsync(QueuedMethodCall* queuedCall)
                 QCC_DbgPrintf(("%s: Found Lamp", __func__));
                 ctx = NULL;
                 if (lit->second->IsConnected()) {
-                    ctx = new QueuedMethodCallContext(*it, queuedCall, element.method);
+                    ctx = new QueuedMethodCallContext(lit->second->lampIdHandle, queuedCall, method);
                     if (!ctx) {
                         QCC_LogError(ER_FAIL, ("%s: Unable to allocate memory for context", __func__));
                         status = ER_FAIL;
                     } else {
                         ctx->timeSent = GetTimestampInMs();
-                        ctx->method = element.method;
+                        ctx->traceTimestamp = LSF_TRACE_TIMESTAMP();
                         if (0 == strcmp(element.interface.c_str(), ConfigServiceInterfaceName)) {
                             QCC_DbgPrintf(("%s: Config Call", __func__));
                             QCC_DbgPrintf(("%s: Calling %s on lamp %s for method call %s and count %u", __func__,
-                                           element.method.c_str(), (*it).c_str(), queuedCall->inMsg->GetMemberName(), queuedCall->methodCallCount));
+                                           element.method->c_str(), (*it).c_str(), queuedCall->inMsg->GetMemberName(), queuedCall->methodCallCount));
                             status = lit->second->configObject.MethodCallAsync(
                                 element.interface.c_str(),
-                                element.method.c_str(),
+                                element.method->c_str(),
                                 this,
                                 queuedCall->replyFunc,
                                 &element.args[0],
@@ -520,10 +566,10 @@ LSFResponseCode LampClients::DoMethodCallAsync(QueuedMethodCall* queuedCall)
                         } else if ((0 == strcmp(element.interface.c_str(), AboutInterfaceName)) && (lit->second->aboutObject != NULL)) {
                             QCC_DbgPrintf(("%s: About Call", __func__));
                             QCC_DbgPrintf(("%s: Calling %s on lamp %s for method call %s and count %u", __func__,
-                                           element.method.c_str(), (*it).c_str(), queuedCall->inMsg->GetMemberName(), queuedCall->methodCallCount));
+                                           element.method->c_str(), (*it).c_str(), queuedCall->inMsg->GetMemberName(), queuedCall->methodCallCount));
                             status = lit->second->aboutObject->MethodCallAsync(
                                 element.interface.c_str(),
-                                element.method.c_str(),
+                                element.method->c_str(),
                                 this,
                                 queuedCall->replyFunc,
                                 &element.args[0],
@@ -534,10 +580,10 @@ LSFResponseCode LampClients::DoMethodCallAsync(QueuedMethodCall* queuedCall)
                         } else {
                             QCC_DbgPrintf(("%s: LampService Call", __func__));
                             QCC_DbgPrintf(("%s: Calling %s on lamp %s for method call %s and count %u", __func__,
-                                           element.method.c_str(), (*it).c_str(), queuedCall->inMsg->GetMemberName(), queuedCall->methodCallCount));
+                                           element.method->c_str(), (*it).c_str(), queuedCall->inMsg->GetMemberName(), queuedCall->methodCallCount));
                             status = lit->second->object.MethodCallAsync(
                                 element.interface.c_str(),
-                                element.method.c_str(),
+                                element.method->c_str(),
                                 this,
                                 queuedCall->replyFunc,
                                 &element.args[0],
@@ -566,8 +612,6 @@ LSFResponseCode LampClients::DoMethodCallAsync(QueuedMethodCall* queuedCall)
                 notFound++;
             }
         }
-
-        elementList.pop_front();
     }
 
     if (notFound || failures) {
@@ -585,8 +629,8 @@ LSFResponseCode LampClients::DoGetLampState(QueuedMethodCallContext* ctx)
 
     MsgArg arg("s", LampServiceStateInterfaceName);
 
-    QCC_DbgPrintf(("%s: Processing for LampID=%s", __func__, ctx->lampID.c_str()));
-    LampMap::iterator lit = activeLamps.find(ctx->lampID);
+    QCC_DbgPrintf(("%s: Processing for LampID=%s", __func__, ctx->lampID->c_str()));
+    LampMap::iterator lit = activeLamps.find(*ctx->lampID);
     if (lit != activeLamps.end()) {
         QCC_DbgPrintf(("%s: Found Lamp", __func__));
         if (lit->second->IsConnected()) {
@@ -609,13 +653,16 @@ LSFResponseCode LampClients::DoGetLampState(QueuedMethodCallContext* ctx)
 
         if (status != ER_OK) {
             QCC_LogError(status, ("%s: MethodCallAsync failed", __func__));
-            if (ctx) {
-                delete ctx;
-            }
+            LampStateRefreshCompleted(*ctx->lampID);
+            delete ctx;
         } else {
             lit->second->pendingMethodCallCount++;
             QCC_DbgPrintf(("%s: Increased pendingMethodCallCount for lamp %s to %u", __func__, lit->first.c_str(), lit->second->pendingMethodCallCount));
         }
+    } else {
+        QCC_DbgPrintf(("%s: Lamp %s not found", __func__, ctx->lampID->c_str()));
+        LampStateRefreshCompleted(*ctx->lampID);
+        delete ctx;
     }
 
     return responseCode;
@@ -633,7 +680,7 @@ void LampClients::HandleGetLampStateReply(ajn::Message& message, void* context)
     }
 
     QCC_DbgTrace(("%s: Received reply to call %s on lamp %s in %lu msec", __func__,
-                  ctx->method.c_str(), ctx->lampID.c_str(), (GetTimestampInMs() - ctx->timeSent)));
+                  ctx->method->c_str(), ctx->lampID->c_str(), (GetTimestampInMs() - ctx->timeSent)));
 
     if (MESSAGE_METHOD_RET == message->GetType()) {
         size_t numArgs;
@@ -642,15 +689,76 @@ void LampClients::HandleGetLampStateReply(ajn::Message& message, void* context)
 
         if (numArgs == 1) {
             LampState state(args[0]);
-            controllerService.SendStateChangedSignal(ControllerServiceLampInterfaceName, "LampStateChanged", ctx->lampID, state);
+            QueueLampStateChanged(*ctx->lampID, state);
         } else {
             QCC_LogError(ER_BAD_ARG_COUNT, ("%s: Did not receive the expected number of arguments in the method reply", __func__));
         }
     }
 
+    LampStateRefreshCompleted(*ctx->lampID);
+
     delete ctx;
 }
 
+void LampClients::QueueLampStateChanged(const LSFString& lampID, const LampState& state)
+{
+    if ((OEM_CS_LAMP_STATE_CHANGED_COALESCE_MS == 0) && !OEM_CS_SEND_BATCHED_LAMP_STATE_UPDATES) {
+        controllerService.SendStateChangedSignal(ControllerServiceLampInterfaceName, "LampStateChanged", lampID, state);
+        stateSignalsStatistic->Increment();
+        signalledStatesStatistic->Increment();
+        return;
+    }
+
+    bool wake = false;
+
+    lampStateChangesLock.Lock();
+    if (lampStateChanges.empty()) {
+        lampStateChangesDueTimestamp = GetTimestampInMs() + OEM_CS_LAMP_STATE_CHANGED_COALESCE_MS;
+        wake = true;
+    }
+    // Only the latest state of a lamp is of interest
+    lampStateChanges[lampID] = state;
+    lampStateChangesLock.Unlock();
+
+    // Have Run() wait for the window to close
+    if (wake) {
+        wakeUp.Post();
+    }
+}
+
+uint64_t LampClients::SendLampStateChanges(void)
+{
+    LampStateMap changes;
+    uint64_t timeToWait = 0;
+    uint64_t currentTime = GetTimestampInMs();
+
+    lampStateChangesLock.Lock();
+    if (!lampStateChanges.empty()) {
+        if (lampStateChangesDueTimestamp <= currentTime) {
+            changes.swap(lampStateChanges);
+        } else {
+            timeToWait = lampStateChangesDueTimestamp - currentTime;
+        }
+    }
+    lampStateChangesLock.Unlock();
+
+    if (changes.size()) {
+        QCC_DbgPrintf(("%s: Signalling state changes of %d lamps", __func__, changes.size()));
+#if OEM_CS_SEND_BATCHED_LAMP_STATE_UPDATES
+        controllerService.SendLampsStateChangedSignal(changes);
+        stateSignalsStatistic->Increment();
+#else
+        for (LampStateMap::const_iterator it = changes.begin(); it != changes.end(); ++it) {
+            controllerService.SendStateChangedSignal(ControllerServiceLampInterfaceName, "LampStateChanged", it->first, it->second);
+        }
+        stateSignalsStatistic->Add(changes.size());
+#endif
+        signalledStatesStatistic->Add(changes.size());
+    }
+
+    return timeToWait;
+}
+
 void LampClients::GetLampState(const LSFString& lampID, Message& inMsg)
 {
     QCC_DbgTrace(("%s", __func__));
@@ -659,7 +767,7 @@ void LampClients::GetLampState(const LSFString& lampID, Message& inMsg)
         QCC_LogError(ER_FAIL, ("%s: Unable to allocate memory for call", __func__));
         return;
     }
-    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, "GetAll");
+    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, getAllMethod);
     element.args.push_back(MsgArg("s", LampServiceStateInterfaceName));
     queuedCall->AddMethodCallElement(element);
     queuedCall->responseCounter.standardReplyArgs.push_back(MsgArg("s", lampID.c_str()));
@@ -675,7 +783,7 @@ void LampClients::GetLampStateField(const LSFString& lampID, const LSFString& fi
         QCC_LogError(ER_FAIL, ("%s: Unable to allocate memory for call", __func__));
         return;
     }
-    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, "Get");
+    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, getMethod);
     element.args.push_back(MsgArg("s", LampServiceStateInterfaceName));
     element.args.push_back(MsgArg("s", field.c_str()));
     queuedCall->AddMethodCallElement(element);
@@ -694,7 +802,7 @@ void LampClients::GetLampDetails(const LSFString& lampID, Message& inMsg)
         QCC_LogError(ER_FAIL, ("%s: Unable to allocate memory for call", __func__));
         return;
     }
-    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, "GetAll");
+    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, getAllMethod);
     element.args.push_back(MsgArg("s", LampServiceDetailsInterfaceName));
     queuedCall->AddMethodCallElement(element);
     queuedCall->responseCounter.standardReplyArgs.push_back(MsgArg("s", lampID.c_str()));
@@ -710,7 +818,7 @@ void LampClients::GetLampParameters(const LSFString& lampID, Message& inMsg)
         QCC_LogError(ER_FAIL, ("%s: Unable to allocate memory for call", __func__));
         return;
     }
-    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, "GetAll");
+    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, getAllMethod);
     element.args.push_back(MsgArg("s", LampServiceParametersInterfaceName));
     queuedCall->AddMethodCallElement(element);
     queuedCall->responseCounter.standardReplyArgs.push_back(MsgArg("s", lampID.c_str()));
@@ -726,7 +834,7 @@ void LampClients::GetLampParametersField(const LSFString& lampID, const LSFStrin
         QCC_LogError(ER_FAIL, ("%s: Unable to allocate memory for call", __func__));
         return;
     }
-    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, "Get");
+    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, getMethod);
     element.args.push_back(MsgArg("s", LampServiceParametersInterfaceName));
     element.args.push_back(MsgArg("s", field.c_str()));
     queuedCall->AddMethodCallElement(element);
@@ -751,7 +859,8 @@ void LampClients::HandleGetReply(ajn::Message& message, void* context)
     QueuedMethodCall* queuedCall = ctx->queuedCallPtr;
 
     QCC_DbgTrace(("%s: Received reply to call %s on lamp %s in %lu msec", __func__,
-                  ctx->method.c_str(), ctx->lampID.c_str(), (GetTimestampInMs() - ctx->timeSent)));
+                  ctx->method->c_str(), ctx->lampID->c_str(), (GetTimestampInMs() - ctx->timeSent)));
+    LSF_TRACE_STAGE(ctx->queuedCallPtr->traceId, "Lamp", ctx->traceTimestamp);
 
     if (MESSAGE_METHOD_RET == message->GetType()) {
         size_t numArgs;
@@ -811,7 +920,7 @@ void LampClients::ChangeLampState(const ajn::Message& inMsg, bool groupOperation
             firstIteration = false;
         }
 
-        QueuedMethodCallElement element = QueuedMethodCallElement(transitionStateFieldParam.lamps, LampServiceStateInterfaceName, "TransitionLampState");
+        QueuedMethodCallElement element = QueuedMethodCallElement(transitionStateFieldParam.lamps, LampServiceStateInterfaceName, transitionLampStateMethod);
         MsgArg* arrayVals = new MsgArg[1];
         arrayVals[0].Set("{sv}", strdupnew(transitionStateFieldParam.field), new MsgArg(transitionStateFieldParam.value));
         arrayVals[0].SetOwnershipFlags(MsgArg::OwnsArgs | MsgArg::OwnsData);
@@ -835,7 +944,7 @@ void LampClients::ChangeLampState(const ajn::Message& inMsg, bool groupOperation
             firstIteration = false;
         }
 
-        QueuedMethodCallElement element = QueuedMethodCallElement(transitionStateParam.lamps, LampServiceStateInterfaceName, "TransitionLampState");
+        QueuedMethodCallElement element = QueuedMethodCallElement(transitionStateParam.lamps, LampServiceStateInterfaceName, transitionLampStateMethod);
 
         element.args.push_back(MsgArg("t", transitionStateParam.timestamp));
         element.args.push_back(transitionStateParam.state);
@@ -856,7 +965,7 @@ void LampClients::ChangeLampState(const ajn::Message& inMsg, bool groupOperation
             firstIteration = false;
         }
 
-        QueuedMethodCallElement element = QueuedMethodCallElement(pulseParam.lamps, LampServiceStateInterfaceName, "ApplyPulseEffect");
+        QueuedMethodCallElement element = QueuedMethodCallElement(pulseParam.lamps, LampServiceStateInterfaceName, applyPulseEffectMethod);
 
         element.args.push_back(pulseParam.oldState);
         element.args.push_back(pulseParam.newState);
@@ -880,6 +989,7 @@ void LampClients::ChangeLampState(const ajn::Message& inMsg, bool groupOperation
 void LampClients::DecrementWaitingAndSendResponse(QueuedMethodCall* queuedCall, uint32_t success, uint32_t failure, uint32_t notFound, const ajn::MsgArg* arg)
 {
     QCC_DbgPrintf(("%s: responseID=%s ", __func__, queuedCall->responseID.c_str()));
+    LSF_TRACE_SCOPE(queuedCall->traceId, "Reply");
     LSFResponseCode responseCode = LSF_ERR_UNEXPECTED;
     ResponseCounter responseCounter;
     bool sendResponse = false;
@@ -918,6 +1028,7 @@ void LampClients::DecrementWaitingAndSendResponse(QueuedMethodCall* queuedCall,
 
             responseCounter = it->second;
             responseMap.erase(it);
+            pendingResponsesStatistic->Set(static_cast<int64_t>(responseMap.size()));
             sendResponse = true;
         }
     } else {
@@ -958,12 +1069,13 @@ void LampClients::HandleReplyWithLampResponseCode(Message& message, void* contex
     }
 
     QCC_DbgTrace(("%s: Received reply to call %s on lamp %s in %lu msec", __func__,
-                  ctx->method.c_str(), ctx->lampID.c_str(), (GetTimestampInMs() - ctx->timeSent)));
+                  ctx->method->c_str(), ctx->lampID->c_str(), (GetTimestampInMs() - ctx->timeSent)));
+    LSF_TRACE_STAGE(ctx->queuedCallPtr->traceId, "Lamp", ctx->traceTimestamp);
 
     QueuedMethodCall* queuedCall = ctx->queuedCallPtr;
 
     QCC_DbgPrintf(("%s: Got %s for method call %s from lamp %s for lamp method call %s and count %u", __func__,
-                   ((MESSAGE_METHOD_RET == message->GetType()) ? "REPLY" : "ERROR"), queuedCall->inMsg->GetMemberName(), ctx->lampID.c_str(), ctx->method.c_str(),
+                   ((MESSAGE_METHOD_RET == message->GetType()) ? "REPLY" : "ERROR"), queuedCall->inMsg->GetMemberName(), ctx->lampID->c_str(), ctx->method->c_str(),
                    queuedCall->methodCallCount));
 
     if (MESSAGE_METHOD_RET == message->GetType()) {
@@ -974,7 +1086,7 @@ void LampClients::HandleReplyWithLampResponseCode(Message& message, void* contex
         uint32_t success = 0;
         uint32_t failure = 0;
 
-        if (((numArgs == 1) && (ctx->method != "ClearLampFault")) || ((numArgs == 2) && (ctx->method == "ClearLampFault"))) {
+        if (((numArgs == 1) && (ctx->method != clearLampFaultMethod)) || ((numArgs == 2) && (ctx->method == clearLampFaultMethod))) {
             LampResponseCode responseCode;
             args[0].Get("u", &responseCode);
 
@@ -1004,7 +1116,7 @@ void LampClients::GetLampFaults(const LSFString& lampID, ajn::Message& inMsg)
         QCC_LogError(ER_FAIL, ("%s: Unable to allocate memory for call", __func__));
         return;
     }
-    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, "Get");
+    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, getMethod);
     element.args.push_back(MsgArg("s", LampServiceInterfaceName));
     element.args.push_back(MsgArg("s", "LampFaults"));
     queuedCall->AddMethodCallElement(element);
@@ -1021,7 +1133,7 @@ void LampClients::GetLampVersion(const LSFString& lampID, ajn::Message& inMsg)
         QCC_LogError(ER_FAIL, ("%s: Unable to allocate memory for call", __func__));
         return;
     }
-    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, "Get");
+    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, getMethod);
     element.args.push_back(MsgArg("s", LampServiceInterfaceName));
     element.args.push_back(MsgArg("s", "LampServiceVersion"));
     queuedCall->AddMethodCallElement(element);
@@ -1044,7 +1156,8 @@ void LampClients::HandleReplyWithVariant(ajn::Message& message, void* context)
     QueuedMethodCall* queuedCall = ctx->queuedCallPtr;
 
     QCC_DbgTrace(("%s: Received reply to call %s on lamp %s in %lu msec", __func__,
-                  ctx->method.c_str(), ctx->lampID.c_str(), (GetTimestampInMs() - ctx->timeSent)));
+                  ctx->method->c_str(), ctx->lampID->c_str(), (GetTimestampInMs() - ctx->timeSent)));
+    LSF_TRACE_STAGE(ctx->queuedCallPtr->traceId, "Lamp", ctx->traceTimestamp);
 
     if (MESSAGE_METHOD_RET == message->GetType()) {
         size_t numArgs;
@@ -1074,7 +1187,7 @@ void LampClients::ClearLampFault(const LSFString& lampID, LampFaultCode faultCod
         QCC_LogError(ER_FAIL, ("%s: Unable to allocate memory for call", __func__));
         return;
     }
-    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, LampServiceInterfaceName, "ClearLampFault");
+    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, LampServiceInterfaceName, clearLampFaultMethod);
     element.args.push_back(MsgArg("u", faultCode));
     queuedCall->AddMethodCallElement(element);
 
@@ -1093,17 +1206,74 @@ void LampClients::LampStateChangedSignalHandler(const InterfaceDescription::Memb
     const MsgArg* args;
     message->GetArgs(numArgs, args);
 
+    if (!connectToLamps) {
+        // Warm standby followers do not signal lamp state to the clients
+        return;
+    }
+
     const char* uniqueId;
     args[0].Get("s", &uniqueId);
 
-    QueuedMethodCallContext* ctx = new QueuedMethodCallContext(uniqueId, "GetAll");
-    if (!ctx) {
-        QCC_LogError(ER_FAIL, ("%s: Unable to allocate memory for call", __func__));
+    RefreshLampState(uniqueId);
+}
+
+void LampClients::RefreshLampState(const LSFString& lampID)
+{
+    QCC_DbgTrace(("%s", __func__));
+    bool queued = false;
+
+    getLampStateListLock.Lock();
+    LampStateRefreshMap::iterator it = lampStateRefreshes.find(lampID);
+    if (it != lampStateRefreshes.end()) {
+        // The pending refresh may read the state before this change, so fetch once more after it
+        it->second = true;
     } else {
-        getLampStateListLock.Lock();
-        getLampStateList.push_back(ctx);
-        getLampStateListLock.Unlock();
-        QCC_DbgPrintf(("%s: Queued a GetLampState call to lamp %s in response to a LampStateChangedSignal", __func__, uniqueId));
+        QueuedMethodCallContext* ctx = new QueuedMethodCallContext(lampID, getAllMethod);
+        if (!ctx) {
+            QCC_LogError(ER_FAIL, ("%s: Unable to allocate memory for call", __func__));
+        } else {
+            lampStateRefreshes.insert(std::make_pair(lampID, false));
+            getLampStateList.push_back(ctx);
+            queued = true;
+        }
+    }
+    getLampStateListLock.Unlock();
+
+    if (queued) {
+        QCC_DbgPrintf(("%s: Queued a GetLampState call to lamp %s in response to a LampStateChangedSignal", __func__, lampID.c_str()));
+        wakeUp.Post();
+    } else {
+        QCC_DbgPrintf(("%s: GetLampState call to lamp %s already pending", __func__, lampID.c_str()));
+    }
+}
+
+void LampClients::LampStateRefreshCompleted(const LSFString& lampID)
+{
+    QCC_DbgTrace(("%s", __func__));
+    bool queued = false;
+
+    getLampStateListLock.Lock();
+    LampStateRefreshMap::iterator it = lampStateRefreshes.find(lampID);
+    if (it != lampStateRefreshes.end()) {
+        /*
+         * A change signalled while the call was outstanding is fetched again
+         * whether or not the call succeeded, otherwise a failed call would drop it
+         */
+        if (it->second) {
+            QueuedMethodCallContext* ctx = new QueuedMethodCallContext(lampID, getAllMethod);
+            if (ctx) {
+                it->second = false;
+                getLampStateList.push_back(ctx);
+                queued = true;
+            }
+        }
+        if (!queued) {
+            lampStateRefreshes.erase(it);
+        }
+    }
+    getLampStateListLock.Unlock();
+
+    if (queued) {
         wakeUp.Post();
     }
 }
@@ -1116,7 +1286,7 @@ void LampClients::GetLampSupportedLanguages(const LSFString& lampID, ajn::Messag
         QCC_LogError(ER_FAIL, ("%s: Unable to allocate memory for call", __func__));
         return;
     }
-    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, AboutInterfaceName, "GetAboutData");
+    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, AboutInterfaceName, getAboutDataMethod);
     element.args.push_back(MsgArg("s", "en"));
     queuedCall->AddMethodCallElement(element);
 
@@ -1140,7 +1310,8 @@ void LampClients::HandleReplyWithKeyValuePairs(Message& message, void* context)
     QueuedMethodCall* queuedCall = ctx->queuedCallPtr;
 
     QCC_DbgTrace(("%s: Received reply to call %s on lamp %s in %lu msec", __func__,
-                  ctx->method.c_str(), ctx->lampID.c_str(), (GetTimestampInMs() - ctx->timeSent)));
+                  ctx->method->c_str(), ctx->lampID->c_str(), (GetTimestampInMs() - ctx->timeSent)));
+    LSF_TRACE_STAGE(ctx->queuedCallPtr->traceId, "Lamp", ctx->traceTimestamp);
 
     if (MESSAGE_METHOD_RET == message->GetType()) {
         const MsgArg* args;
@@ -1192,7 +1363,8 @@ void LampClients::HandleDataSetReply(Message& message, void* context)
     ResponseCounter responseCounter;
 
     QCC_DbgTrace(("%s: Received reply to call %s on lamp %s in %lu msec", __func__,
-                  ctx->method.c_str(), ctx->lampID.c_str(), (GetTimestampInMs() - ctx->timeSent)));
+                  ctx->method->c_str(), ctx->lampID->c_str(), (GetTimestampInMs() - ctx->timeSent)));
+    LSF_TRACE_STAGE(ctx->queuedCallPtr->traceId, "Lamp", ctx->traceTimestamp);
 
     if (MESSAGE_METHOD_RET == message->GetType()) {
         const MsgArg* args;
@@ -1205,7 +1377,7 @@ void LampClients::HandleDataSetReply(Message& message, void* context)
 
             args[0].Get("a{sv}", &numEntries, &entries);
 
-            if (0 == strcmp(ctx->method.c_str(), "GetConfigurations")) {
+            if (ctx->method == getConfigurationsMethod) {
                 for (size_t i = 0; i < numEntries; ++i) {
                     char* key;
                     MsgArg* value;
@@ -1247,6 +1419,7 @@ void LampClients::HandleDataSetReply(Message& message, void* context)
 
                                 responseCounter = it->second;
                                 responseMap.erase(it);
+                                pendingResponsesStatistic->Set(static_cast<int64_t>(responseMap.size()));
                                 sendResponse = true;
                             }
                         } else {
@@ -1256,7 +1429,7 @@ void LampClients::HandleDataSetReply(Message& message, void* context)
                         break;
                     }
                 }
-            } else if (0 == strcmp(ctx->method.c_str(), "GetAll")) {
+            } else if (ctx->method == getAllMethod) {
                 char* key;
                 MsgArg* value;
                 entries[1].Get("{sv}", &key, &value);
@@ -1297,6 +1470,7 @@ void LampClients::HandleDataSetReply(Message& message, void* context)
 
                             responseCounter = it->second;
                             responseMap.erase(it);
+                            pendingResponsesStatistic->Set(static_cast<int64_t>(responseMap.size()));
                             sendResponse = true;
                         }
                     } else {
@@ -1339,6 +1513,7 @@ void LampClients::HandleDataSetReply(Message& message, void* context)
 
                             responseCounter = it->second;
                             responseMap.erase(it);
+                            pendingResponsesStatistic->Set(static_cast<int64_t>(responseMap.size()));
                             sendResponse = true;
                         }
                     } else {
@@ -1381,6 +1556,7 @@ void LampClients::HandleDataSetReply(Message& message, void* context)
 
                             responseCounter = it->second;
                             responseMap.erase(it);
+                            pendingResponsesStatistic->Set(static_cast<int64_t>(responseMap.size()));
                             sendResponse = true;
                         }
                     } else {
@@ -1414,6 +1590,7 @@ void LampClients::HandleDataSetReply(Message& message, void* context)
 
                     responseCounter = it->second;
                     responseMap.erase(it);
+                    pendingResponsesStatistic->Set(static_cast<int64_t>(responseMap.size()));
                     sendResponse = true;
                 }
             } else {
@@ -1445,6 +1622,7 @@ void LampClients::HandleDataSetReply(Message& message, void* context)
 
                 responseCounter = it->second;
                 responseMap.erase(it);
+                pendingResponsesStatistic->Set(static_cast<int64_t>(responseMap.size()));
                 sendResponse = true;
             }
         } else {
@@ -1472,7 +1650,7 @@ void LampClients::GetLampName(const LSFString& lampID, const LSFString& language
         QCC_LogError(ER_FAIL, ("%s: Unable to allocate memory for call", __func__));
         return;
     }
-    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, ConfigServiceInterfaceName, "GetConfigurations");
+    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, ConfigServiceInterfaceName, getConfigurationsMethod);
     element.args.push_back(MsgArg("s", language.c_str()));
     queuedCall->AddMethodCallElement(element);
     queuedCall->responseCounter.standardReplyArgs.push_back(MsgArg("s", lampID.c_str()));
@@ -1489,24 +1667,24 @@ void LampClients::GetLampDataSet(const LSFString& lampID, const LSFString& langu
         QCC_LogError(ER_FAIL, ("%s: Unable to allocate memory for call", __func__));
         return;
     }
-    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, ConfigServiceInterfaceName, "GetConfigurations");
+    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, ConfigServiceInterfaceName, getConfigurationsMethod);
     element.args.push_back(MsgArg("s", language.c_str()));
     queuedCall->AddMethodCallElement(element);
     queuedCall->responseCounter.standardReplyArgs.push_back(MsgArg("s", lampID.c_str()));
     queuedCall->responseCounter.standardReplyArgs.push_back(MsgArg("s", language.c_str()));
     queuedCall->responseCounter.customReplyArgs.push_back(MsgArg("s", "<ERROR>"));
 
-    QueuedMethodCallElement element1 = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, "GetAll");
+    QueuedMethodCallElement element1 = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, getAllMethod);
     element1.args.push_back(MsgArg("s", LampServiceDetailsInterfaceName));
     queuedCall->AddMethodCallElement(element1);
     queuedCall->responseCounter.customReplyArgs.push_back(MsgArg("a{sv}", 0, NULL));
 
-    QueuedMethodCallElement element2 = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, "GetAll");
+    QueuedMethodCallElement element2 = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, getAllMethod);
     element2.args.push_back(MsgArg("s", LampServiceStateInterfaceName));
     queuedCall->AddMethodCallElement(element2);
     queuedCall->responseCounter.customReplyArgs.push_back(MsgArg("a{sv}", 0, NULL));
 
-    QueuedMethodCallElement element3 = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, "GetAll");
+    QueuedMethodCallElement element3 = QueuedMethodCallElement(lampID, org::freedesktop::DBus::Properties::InterfaceName, getAllMethod);
     element3.args.push_back(MsgArg("s", LampServiceParametersInterfaceName));
     queuedCall->AddMethodCallElement(element3);
     queuedCall->responseCounter.customReplyArgs.push_back(MsgArg("a{sv}", 0, NULL));
@@ -1522,7 +1700,7 @@ void LampClients::GetLampManufacturer(const LSFString& lampID, const LSFString&
         QCC_LogError(ER_FAIL, ("%s: Unable to allocate memory for call", __func__));
         return;
     }
-    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, ConfigServiceInterfaceName, "GetConfigurations");
+    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, ConfigServiceInterfaceName, getConfigurationsMethod);
     element.args.push_back(MsgArg("s", language.c_str()));
     queuedCall->AddMethodCallElement(element);
     queuedCall->responseCounter.standardReplyArgs.push_back(MsgArg("s", lampID.c_str()));
@@ -1539,7 +1717,7 @@ void LampClients::SetLampName(const LSFString& lampID, const LSFString& name, co
         QCC_LogError(ER_FAIL, ("%s: Unable to allocate memory for call", __func__));
         return;
     }
-    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, ConfigServiceInterfaceName, "UpdateConfigurations");
+    QueuedMethodCallElement element = QueuedMethodCallElement(lampID, ConfigServiceInterfaceName, updateConfigurationsMethod);
 
     MsgArg name_arg("s", name.c_str());
     MsgArg arg("{sv}", "DeviceName", &name_arg);
@@ -1565,8 +1743,8 @@ void LampClients::IntrospectCB(QStatus status, ajn::ProxyBusObject* obj, void* c
 
     LampConnection* connection = static_cast<LampConnection*>(context);
 
-    if (!connectToLamps) {
-        QCC_DbgPrintf(("%s: connectToLamps is false", __func__));
+    if (!KeepLampSessions()) {
+        QCC_DbgPrintf(("%s: Not keeping lamp sessions", __func__));
         return;
     }
 
@@ -1666,14 +1844,28 @@ void LampClients::Run(void)
         /*
          * Wait for something to happen
          */
+        uint64_t timeToWait = SendLampStateChanges();
         QCC_DbgPrintf(("%s: Waiting on wakeUp", __func__));
-        wakeUp.Wait();
+        if (timeToWait) {
+            wakeUp.TimedWait(static_cast<uint32_t>(timeToWait));
+        } else {
+            wakeUp.Wait();
+        }
         QStatus status = ER_OK;
 
-        if (connectToLamps) {
+        bool maintainLampSessions = connectToLamps;
+#if OEM_CS_WARM_STANDBY_LAMP_SESSIONS
+        /*
+         * A warm standby follower keeps its lamp sessions once the state that only
+         * the leader needs has been cleaned up
+         */
+        maintainLampSessions = (connectToLamps || oneTimeCleanupDone);
+#endif
+
+        if (maintainLampSessions) {
             QCC_DbgPrintf(("%s: In the ConnectToLamps loop", __func__));
 
-            if (oneTimeCleanupDone) {
+            if (connectToLamps && oneTimeCleanupDone) {
                 oneTimeCleanupDone = false;
             }
 
@@ -1714,7 +1906,7 @@ void LampClients::Run(void)
             /*
              * Send the lost lamps signal if required
              */
-            if (lostLamps.size()) {
+            if (lostLamps.size() && connectToLamps) {
                 controllerService.SendSignal(ControllerServiceLampInterfaceName, "LampsLost", lostLamps);
             }
 
@@ -1827,7 +2019,7 @@ void LampClients::Run(void)
             /*
              * Send out the LampNameChanged signal if required
              */
-            for (NameChangedMap::iterator it = nameChangedList.begin(); it != nameChangedList.end(); it++) {
+            for (NameChangedMap::iterator it = nameChangedList.begin(); (it != nameChangedList.end()) && connectToLamps; it++) {
                 controllerService.SendNameChangedSignal(ControllerServiceLampInterfaceName, "LampNameChanged", it->first, it->second);
             }
 
@@ -1918,7 +2110,7 @@ void LampClients::Run(void)
             /*
              * Send the found lamps signal if required
              */
-            if (foundLamps.size()) {
+            if (foundLamps.size() && connectToLamps) {
                 controllerService.SendSignal(ControllerServiceLampInterfaceName, "LampsFound", foundLamps);
             }
 
@@ -1977,6 +2169,7 @@ void LampClients::Run(void)
                  */
                 tempMethodQueue = methodQueue;
                 methodQueue.clear();
+                methodQueueDepthStatistic->Set(0);
                 status = queueLock.Unlock();
                 if (status != ER_OK) {
                     QCC_LogError(status, ("%s: queueLock.Unlock() failed", __func__));
@@ -2001,6 +2194,7 @@ void LampClients::Run(void)
                         delete queuedCall;
                         methodQueue.pop_front();
                     }
+                    methodQueueDepthStatistic->Set(0);
                     QCC_DbgPrintf(("%s: Cleared methodQueue", __func__));
                     status = queueLock.Unlock();
                     if (status != ER_OK) {
@@ -2008,6 +2202,7 @@ void LampClients::Run(void)
                     }
                 }
 
+#if !OEM_CS_WARM_STANDBY_LAMP_SESSIONS
                 for (LampMap::iterator it = activeLamps.begin(); it != activeLamps.end(); ++it) {
                     LampConnection* conn = it->second;
                     if (it->second->sessionID) {
@@ -2040,6 +2235,7 @@ void LampClients::Run(void)
                 if (ER_OK != status) {
                     QCC_LogError(status, ("%s: lostSessionListLock.Unlock() failed", __func__));
                 }
+#endif
 
                 status = getAllLampIDsLock.Lock();
                 if (ER_OK != status) {
@@ -2053,6 +2249,10 @@ void LampClients::Run(void)
                     }
                 }
                 oneTimeCleanupDone = true;
+#if OEM_CS_WARM_STANDBY_LAMP_SESSIONS
+                // Pick up the lamp sessions from here on
+                wakeUp.Post();
+#endif
             } else {
                 /*
                  * Handle announcements
@@ -2101,6 +2301,25 @@ void LampClients::Run(void)
             }
         }
 
+        UpdateLampStatistics();
+
         QCC_DbgPrintf(("%s: Exited", __func__));
     }
 }
+
+void LampClients::UpdateLampStatistics(void)
+{
+    int32_t numConnected = 0;
+    int32_t numBlacklisted = 0;
+    for (LampMap::const_iterator it = activeLamps.begin(); it != activeLamps.end(); ++it) {
+        if (it->second->connectionState == CONNECTED) {
+            numConnected++;
+        } else if (it->second->connectionState == BLACKLISTED) {
+            numBlacklisted++;
+        }
+    }
+    connectedLampsStatistic->Set(numConnected);
+    blacklistedLampsStatistic->Set(numBlacklisted);
+    internedStringsStatistic->Set(static_cast<int64_t>(LSFStringTable::GetNumStrings()));
+    internedStringBytesStatistic->Set(static_cast<int64_t>(LSFStringTable::GetNumBytes()));
+}
@@ -96,6 +96,7 @@ LSFResponseCode LampGroupManager::Reset(void)
          */
         lampGroups.clear();
         lampGroupUpdates.clear();
+        subGroupUsers.Clear();
         blobLength = 0;
 
         ScheduleFileWrite();
@@ -129,11 +130,8 @@ LSFResponseCode LampGroupManager::IsDependentOnLampGroup(LSFString& lampGroupID)
 
     QStatus status = lampGroupsLock.Lock();
     if (ER_OK == status) {
-        for (LampGroupMap::iterator it = lampGroups.begin(); it != lampGroups.end(); ++it) {
-            responseCode = it->second.second.IsDependentLampGroup(lampGroupID);
-            if (LSF_OK != responseCode) {
-                break;
-            }
+        if (subGroupUsers.IsUsed(lampGroupID)) {
+            responseCode = LSF_ERR_DEPENDENCY;
         }
         status = lampGroupsLock.Unlock();
         if (ER_OK != status) {
@@ -340,16 +338,16 @@ void LampGroupManager::CreateLampGroup(Message& message)
         QStatus status = lampGroupsLock.Lock();
         if (ER_OK == status) {
             if (lampGroups.size() < OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY) {
-                std::string newGroupStr = GetString(name, lampGroupID, lampGroup);
                 /*
                  * We have to add the lampGroupID length because we need to store
                  * the IDs of the updated lamp groups to the updates file
                  */
-                size_t newlen = blobLength + newGroupStr.length() + lampGroupID.length();
+                size_t newlen = blobLength + GetStringLength(name, lampGroupID, lampGroup) + lampGroupID.length();
                 if (newlen < MAX_FILE_LEN) {
                     blobLength = newlen;
+                    subGroupUsers.Add(lampGroupID, lampGroup.lampGroups);
                     lampGroups[lampGroupID].first = name;
-                    lampGroups[lampGroupID].second = lampGroup;
+                    lampGroups[lampGroupID].second.Swap(lampGroup);
                     created = true;
                     ScheduleFileWrite();
                 } else {
@@ -382,6 +380,113 @@ void LampGroupManager::CreateLampGroup(Message& message)
     }
 }
 
+void LampGroupManager::CreateLampGroups(Message& message)
+{
+    QCC_DbgPrintf(("%s: %s", __func__, message->ToString().c_str()));
+
+    LSFResponseCode responseCode = LSF_OK;
+    LSFStringList lampGroupIDs;
+
+    if (!controllerService.UpdatesAllowed()) {
+        controllerService.SendMethodReplyWithResponseCodeAndListOfIDs(message, LSF_ERR_BUSY, lampGroupIDs);
+        return;
+    }
+
+    const ajn::MsgArg* inputArgs;
+    size_t numInputArgs;
+    message->GetArgs(numInputArgs, inputArgs);
+
+    if (controllerService.CheckNumArgsInMessage(numInputArgs, 2)  != LSF_OK) {
+        return;
+    }
+
+    MsgArg* groupArgs;
+    size_t numGroups;
+    inputArgs[0].Get("a(asass)", &numGroups, &groupArgs);
+    LSFString language = static_cast<LSFString>(inputArgs[1].v_string.str);
+
+    /*
+     * Validate every lamp group before touching the map so that the request
+     * is applied completely or not at all
+     */
+    std::list<std::pair<LSFString, LampGroup> > newGroups;
+
+    if (0 != strcmp("en", language.c_str())) {
+        QCC_LogError(ER_FAIL, ("%s: Language %s not supported", __func__, language.c_str()));
+        responseCode = LSF_ERR_INVALID_ARGS;
+    } else if (numGroups == 0) {
+        QCC_LogError(ER_FAIL, ("%s: No lamp groups", __func__));
+        responseCode = LSF_ERR_INVALID_ARGS;
+    }
+
+    for (size_t i = 0; (i < numGroups) && (LSF_OK == responseCode); i++) {
+        const MsgArg* members = groupArgs[i].v_struct.members;
+        LSFString name = static_cast<LSFString>(members[2].v_string.str);
+
+        newGroups.push_back(std::make_pair(name, LampGroup(members[0], members[1])));
+        const LampGroup& lampGroup = newGroups.back().second;
+
+        if (name.empty()) {
+            QCC_LogError(ER_FAIL, ("%s: group name is empty", __func__));
+            responseCode = LSF_ERR_EMPTY_NAME;
+        } else if (name.length() > LSF_MAX_NAME_LENGTH) {
+            QCC_LogError(ER_FAIL, ("%s: name length exceeds %d", __func__, LSF_MAX_NAME_LENGTH));
+            responseCode = LSF_ERR_INVALID_ARGS;
+        } else if (lampGroup.lamps.empty() && lampGroup.lampGroups.empty()) {
+            QCC_LogError(ER_FAIL, ("%s: Empty Lamps and LampGroups list", __func__));
+            responseCode = LSF_ERR_INVALID_ARGS;
+        } else {
+            lampGroupIDs.push_back(GenerateUniqueID("LAMP_GROUP"));
+        }
+    }
+
+    if (LSF_OK == responseCode) {
+        QStatus status = lampGroupsLock.Lock();
+        if (ER_OK == status) {
+            if ((lampGroups.size() + newGroups.size()) <= OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY) {
+                size_t newlen = blobLength;
+                LSFStringList::const_iterator idIt = lampGroupIDs.begin();
+                for (std::list<std::pair<LSFString, LampGroup> >::const_iterator it = newGroups.begin(); it != newGroups.end(); ++it, ++idIt) {
+                    newlen += GetStringLength(it->first, *idIt, it->second) + idIt->length();
+                }
+
+                if (newlen < MAX_FILE_LEN) {
+                    blobLength = newlen;
+                    idIt = lampGroupIDs.begin();
+                    for (std::list<std::pair<LSFString, LampGroup> >::iterator it = newGroups.begin(); it != newGroups.end(); ++it, ++idIt) {
+                        subGroupUsers.Add(*idIt, it->second.lampGroups);
+                        lampGroups[*idIt].first = it->first;
+                        lampGroups[*idIt].second.Swap(it->second);
+                    }
+                    ScheduleFileWrite();
+                } else {
+                    responseCode = LSF_ERR_RESOURCES;
+                }
+            } else {
+                QCC_LogError(ER_FAIL, ("%s: No slot for %u new LampGroups", __func__, newGroups.size()));
+                responseCode = LSF_ERR_NO_SLOT;
+            }
+            status = lampGroupsLock.Unlock();
+            if (ER_OK != status) {
+                QCC_LogError(status, ("%s: lampGroupsLock.Unlock() failed", __func__));
+            }
+        } else {
+            responseCode = LSF_ERR_BUSY;
+            QCC_LogError(status, ("%s: lampGroupsLock.Lock() failed", __func__));
+        }
+    }
+
+    if (LSF_OK != responseCode) {
+        lampGroupIDs.clear();
+    }
+
+    controllerService.SendMethodReplyWithResponseCodeAndListOfIDs(message, responseCode, lampGroupIDs);
+
+    if (LSF_OK == responseCode) {
+        controllerService.SendSignal(ControllerServiceLampGroupInterfaceName, "LampGroupsCreated", lampGroupIDs);
+    }
+}
+
 void LampGroupManager::UpdateLampGroup(Message& message)
 {
     QCC_DbgPrintf(("%s: %s", __func__, message->ToString().c_str()));
@@ -419,12 +524,14 @@ void LampGroupManager::UpdateLampGroup(Message& message)
 
                 size_t newlen = blobLength;
                 // sub len of old group, add len of new group
-                newlen -= GetString(it->second.first, lampGroupID, it->second.second).length();
-                newlen += GetString(it->second.first, lampGroupID, lampGroup).length();
+                newlen -= GetStringLength(it->second.first, lampGroupID, it->second.second);
+                newlen += GetStringLength(it->second.first, lampGroupID, lampGroup);
 
                 if (newlen < MAX_FILE_LEN) {
                     blobLength = newlen;
-                    it->second.second = lampGroup;
+                    subGroupUsers.Remove(lampGroupID, it->second.second.lampGroups);
+                    subGroupUsers.Add(lampGroupID, lampGroup.lampGroups);
+                    it->second.second.Swap(lampGroup);
                     responseCode = LSF_OK;
                     if (lampGroupUpdates.find(lampGroupID) == lampGroupUpdates.end()) {
                         lampGroupUpdates.insert(lampGroupID);
@@ -486,8 +593,9 @@ void LampGroupManager::DeleteLampGroup(Message& message)
         if (ER_OK == status) {
             LampGroupMap::iterator it = lampGroups.find(lampGroupId);
             if (it != lampGroups.end()) {
-                blobLength -= ((GetString(it->second.first, lampGroupId, it->second.second).length()) + lampGroupID.length());
+                blobLength -= (GetStringLength(it->second.first, lampGroupId, it->second.second) + lampGroupID.length());
 
+                subGroupUsers.Remove(lampGroupID, it->second.second.lampGroups);
                 lampGroups.erase(it);
                 if (lampGroupUpdates.find(lampGroupID) != lampGroupUpdates.end()) {
                     lampGroupUpdates.erase(lampGroupID);
@@ -516,6 +624,93 @@ void LampGroupManager::DeleteLampGroup(Message& message)
     }
 }
 
+void LampGroupManager::DeleteLampGroups(Message& message)
+{
+    QCC_DbgPrintf(("%s: %s", __func__, message->ToString().c_str()));
+    LSFResponseCode responseCode = LSF_OK;
+
+    size_t numArgs;
+    const MsgArg* args;
+    message->GetArgs(numArgs, args);
+
+    if (controllerService.CheckNumArgsInMessage(numArgs, 1)  != LSF_OK) {
+        return;
+    }
+
+    MsgArg* idsArray;
+    size_t idsSize;
+    args[0].Get("as", &idsSize, &idsArray);
+
+    LSFStringList lampGroupIDs;
+    CreateUniqueList(lampGroupIDs, idsArray, idsSize);
+
+    if (!controllerService.UpdatesAllowed()) {
+        controllerService.SendMethodReplyWithResponseCodeAndListOfIDs(message, LSF_ERR_BUSY, lampGroupIDs);
+        return;
+    }
+
+    if (lampGroupIDs.empty()) {
+        QCC_LogError(ER_FAIL, ("%s: No lamp groups", __func__));
+        responseCode = LSF_ERR_INVALID_ARGS;
+    }
+
+    for (LSFStringList::iterator it = lampGroupIDs.begin(); (it != lampGroupIDs.end()) && (LSF_OK == responseCode); ++it) {
+        responseCode = sceneElementManagerPtr->IsDependentOnLampGroup(*it);
+    }
+
+    if (LSF_OK == responseCode) {
+        /*
+         * A lamp group may only be nested by lamp groups that are deleted
+         * along with it. Nothing is erased unless every entry passes.
+         */
+        std::set<LSFString> batch(lampGroupIDs.begin(), lampGroupIDs.end());
+
+        QStatus status = lampGroupsLock.Lock();
+        if (ER_OK == status) {
+            for (LSFStringList::const_iterator it = lampGroupIDs.begin(); (it != lampGroupIDs.end()) && (LSF_OK == responseCode); ++it) {
+                if (lampGroups.find(*it) == lampGroups.end()) {
+                    responseCode = LSF_ERR_NOT_FOUND;
+                } else {
+                    LSFStringList users;
+                    subGroupUsers.GetUsers(*it, users);
+                    for (LSFStringList::const_iterator uit = users.begin(); uit != users.end(); ++uit) {
+                        if (batch.find(*uit) == batch.end()) {
+                            QCC_LogError(ER_FAIL, ("%s: %s is nested by %s", __func__, it->c_str(), uit->c_str()));
+                            responseCode = LSF_ERR_DEPENDENCY;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            if (LSF_OK == responseCode) {
+                for (LSFStringList::const_iterator it = lampGroupIDs.begin(); it != lampGroupIDs.end(); ++it) {
+                    LampGroupMap::iterator git = lampGroups.find(*it);
+                    blobLength -= (GetStringLength(git->second.first, *it, git->second.second) + it->length());
+                    subGroupUsers.Remove(*it, git->second.second.lampGroups);
+                    lampGroups.erase(git);
+                    lampGroupUpdates.erase(*it);
+                }
+                ScheduleFileWrite();
+            }
+
+            status = lampGroupsLock.Unlock();
+            if (ER_OK != status) {
+                QCC_LogError(status, ("%s: lampGroupsLock.Unlock() failed", __func__));
+            }
+        } else {
+            responseCode = LSF_ERR_BUSY;
+            QCC_LogError(status, ("%s: lampGroupsLock.Lock() failed", __func__));
+        }
+    }
+
+    controllerService.SendMethodReplyWithResponseCodeAndListOfIDs(message, responseCode, lampGroupIDs);
+
+    if (LSF_OK == responseCode) {
+        controllerService.SendSignal(ControllerServiceLampGroupInterfaceName, "LampGroupsDeleted", lampGroupIDs);
+    }
+}
+
 void LampGroupManager::GetLampGroup(Message& message)
 {
     QCC_DbgPrintf(("%s: %s", __func__, message->ToString().c_str()));
@@ -835,6 +1030,7 @@ LSFResponseCode LampGroupManager::ChangeLampGroupStateAndField(Message& message,
                                                                bool groupOperation, bool allLamps, bool sceneOperation, LSFString sceneOrMasterSceneID, bool effectOperation)
 {
     QCC_DbgPrintf(("%s: allLamps=%u", __func__, allLamps));
+    LSF_TRACE_SCOPE(LSF_TRACE_ID(message), "GroupExpansion");
     LSFResponseCode responseCode = LSF_OK;
 
     LampsAndStateList transitionToStateList;
@@ -993,7 +1189,7 @@ LSFResponseCode LampGroupManager::GetAllGroupLampsInternal(LSFStringList& lampGr
 void LampGroupManager::ReadSavedData()
 {
     QCC_DbgTrace(("%s", __func__));
-    std::istringstream stream;
+    BlobSnapshotStream stream;
     if (!ValidateFileAndRead(stream)) {
         /*
          * If there is no file present / CRC check failed on the file create a new
@@ -1005,16 +1201,17 @@ void LampGroupManager::ReadSavedData()
         return;
     }
 
-    blobLength = stream.str().size();
     ReplaceMap(stream);
+    blobLength = GetBlobLength(lampGroups);
+    RebuildDependencyIndex();
 
-    std::istringstream updateStream;
+    BlobSnapshotStream updateStream;
     if (ValidateUpdateFileAndRead(updateStream)) {
         ReplaceUpdatesList(updateStream);
     }
 }
 
-void LampGroupManager::ReplaceMap(std::istringstream& stream)
+void LampGroupManager::ReplaceMap(std::istream& stream)
 {
     QCC_DbgTrace(("%s", __func__));
     bool firstIteration = true;
@@ -1038,7 +1235,6 @@ void LampGroupManager::ReplaceMap(std::istringstream& stream)
                     lampGroups.clear();
                     firstIteration = false;
                 }
-                blobLength += id.length();
                 LampGroup group;
                 do {
                     token = ParseString(stream);
@@ -1054,14 +1250,14 @@ void LampGroupManager::ReplaceMap(std::istringstream& stream)
                     }
                 } while (token != "EndLampGroup");
 
-                std::pair<LSFString, LampGroup> thePair(name, group);
-                lampGroups[id] = thePair;
+                lampGroups[id].first = name;
+                lampGroups[id].second.Swap(group);
             }
         }
     }
 }
 
-void LampGroupManager::ReplaceUpdatesList(std::istringstream& stream)
+void LampGroupManager::ReplaceUpdatesList(std::istream& stream)
 {
     QCC_DbgTrace(("%s", __func__));
     bool firstIteration = true;
@@ -1085,6 +1281,15 @@ void LampGroupManager::ReplaceUpdatesList(std::istringstream& stream)
     }
 }
 
+void LampGroupManager::RebuildDependencyIndex(void)
+{
+    QCC_DbgTrace(("%s", __func__));
+    subGroupUsers.Clear();
+    for (LampGroupMap::const_iterator it = lampGroups.begin(); it != lampGroups.end(); ++it) {
+        subGroupUsers.Add(it->first, it->second.second.lampGroups);
+    }
+}
+
 std::string LampGroupManager::GetString(const std::string& name, const std::string& id, const LampGroup& group)
 {
     std::ostringstream stream;
@@ -1101,6 +1306,22 @@ std::string LampGroupManager::GetString(const std::string& name, const std::stri
     return stream.str();
 }
 
+size_t LampGroupManager::GetStringLength(const std::string& name, const std::string& id, const LampGroup& group)
+{
+    return (sizeof("LampGroup  \"\" EndLampGroup\n") - 1) + id.length() + name.length()
+           + GetIDListLength(group.lamps, sizeof(" Lamp ") - 1)
+           + GetIDListLength(group.lampGroups, sizeof(" LampGroup ") - 1);
+}
+
+size_t LampGroupManager::GetBlobLength(const LampGroupMap& items)
+{
+    size_t length = 0;
+    for (LampGroupMap::const_iterator it = items.begin(); it != items.end(); ++it) {
+        length += GetStringLength(it->second.first, it->first, it->second.second) + it->first.length();
+    }
+    return length;
+}
+
 std::string LampGroupManager::GetString(const LampGroupMap& items)
 {
     QCC_DbgTrace(("%s", __func__));
@@ -1203,14 +1424,16 @@ bool LampGroupManager::GetString(std::string& output, std::string& updates, uint
     return ret;
 }
 
-void LampGroupManager::HandleReceivedBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp)
+void LampGroupManager::HandleReceivedBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp)
 {
     QCC_DbgPrintf(("%s", __func__));
     uint64_t currentTimestamp = GetTimestampInMs();
     lampGroupsLock.Lock();
     if (((timeStamp == 0) || ((currentTimestamp - timeStamp) > timestamp)) && (checkSum != checksum)) {
-        std::istringstream stream(blob.c_str());
+        BlobInputStream stream(blob, length);
         ReplaceMap(stream);
+        blobLength = GetBlobLength(lampGroups);
+        RebuildDependencyIndex();
         timeStamp = currentTimestamp;
         checkSum = checksum;
         ScheduleFileWrite(true);
@@ -1218,13 +1441,13 @@ void LampGroupManager::HandleReceivedBlob(const std::string& blob, uint32_t chec
     lampGroupsLock.Unlock();
 }
 
-void LampGroupManager::HandleReceivedUpdateBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp)
+void LampGroupManager::HandleReceivedUpdateBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp)
 {
     QCC_DbgPrintf(("%s", __func__));
     uint64_t currentTimestamp = GetTimestampInMs();
     lampGroupsLock.Lock();
     if (((updatesTimeStamp == 0) || ((currentTimestamp - updatesTimeStamp) > timestamp)) && (updatesCheckSum != checksum)) {
-        std::istringstream stream(blob.c_str());
+        BlobInputStream stream(blob, length);
         ReplaceUpdatesList(stream);
         updatesTimeStamp = currentTimestamp;
         updatesCheckSum = checksum;
@@ -1269,7 +1492,7 @@ void LampGroupManager::ReadWriteFile()
     std::list<ajn::Message> tempUpdateMessageList;
 
     readMutex.Lock();
-    if (read) {
+    if (read && !status) {
         tempMessageList = readBlobMessages;
         readBlobMessages.clear();
         tempUpdateMessageList = readUpdateBlobMessages;
@@ -1278,8 +1501,10 @@ void LampGroupManager::ReadWriteFile()
     }
     readMutex.Unlock();
 
+    ScheduleDeferredReads();
+
     if ((tempMessageList.size() || tempUpdateMessageList.size() || sendUpdate) && !status) {
-        std::istringstream stream;
+        BlobSnapshotStream stream;
         bool fileStatus = ValidateFileAndReadInternal(checksum, timestamp, stream);
         if (fileStatus) {
             output = stream.str();
@@ -1292,7 +1517,7 @@ void LampGroupManager::ReadWriteFile()
             QCC_LogError(ER_FAIL, ("%s: Lamp Group persistent store corrupted", __func__));
         }
 
-        std::istringstream updateStream;
+        BlobSnapshotStream updateStream;
         bool updateStatus = ValidateUpdateFileAndReadInternal(updateChecksum, updateTimestamp, updateStream);
         if (updateStatus) {
             updates = updateStream.str();
@@ -1314,6 +1539,57 @@ void LampGroupManager::ReadWriteFile()
     }
 }
 
+void LampGroupManager::ExportConfiguration(std::ostream& stream)
+{
+    QCC_DbgTrace(("%s", __func__));
+    for (LampGroupMap::const_iterator it = lampGroups.begin(); it != lampGroups.end(); ++it) {
+        stream << GetString(it->second.first, it->first, it->second.second);
+    }
+}
+
+LSFResponseCode LampGroupManager::StageConfiguration(std::istream& stream, LampGroupMap& staged, size_t& stagedBlobLength)
+{
+    QCC_DbgTrace(("%s", __func__));
+    /*
+     * ReplaceMap parses into the live map, so swap in an empty one and
+     * put the live lamp groups back once the section has been read
+     */
+    LampGroupMap live;
+    live.swap(lampGroups);
+    ReplaceMap(stream);
+    staged.swap(lampGroups);
+    lampGroups.swap(live);
+
+    if (staged.size() > OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY) {
+        QCC_LogError(ER_FAIL, ("%s: %d lamp groups exceed the supported number", __func__, staged.size()));
+        return LSF_ERR_NO_SLOT;
+    }
+
+    stagedBlobLength = GetBlobLength(staged);
+    if (stagedBlobLength >= MAX_FILE_LEN) {
+        QCC_LogError(ER_FAIL, ("%s: lamp groups do not fit in the persistent store", __func__));
+        return LSF_ERR_RESOURCES;
+    }
+
+    return LSF_OK;
+}
+
+void LampGroupManager::CommitConfiguration(LampGroupMap& staged, size_t stagedBlobLength, ConfigurationChanges& changes)
+{
+    QCC_DbgTrace(("%s", __func__));
+    GetConfigurationChanges(lampGroups, staged, changes);
+    lampGroups.swap(staged);
+    blobLength = stagedBlobLength;
+    RebuildDependencyIndex();
+
+    for (LSFStringList::const_iterator it = changes.deleted.begin(); it != changes.deleted.end(); ++it) {
+        lampGroupUpdates.erase(*it);
+    }
+    lampGroupUpdates.insert(changes.updated.begin(), changes.updated.end());
+
+    ScheduleFileWrite();
+}
+
 uint32_t LampGroupManager::GetControllerServiceLampGroupInterfaceVersion(void)
 {
     QCC_DbgPrintf(("%s: controllerLampGroupInterfaceVersion=%d", __func__, ControllerServiceLampGroupInterfaceVersion));
@@ -19,11 +19,13 @@
 #include <lsf/controllerservice/ServiceDescription.h>
 #include <lsf/controllerservice/ControllerService.h>
 #include <lsf/controllerservice/OEM_CS_Config.h>
+#include <lsf/controllerservice/BlobCompression.h>
 #else
 #include <LeaderElectionObject.h>
 #include <ServiceDescription.h>
 #include <ControllerService.h>
 #include <OEM_CS_Config.h>
+#include <BlobCompression.h>
 #endif
 
 #include <qcc/Debug.h>
@@ -33,14 +35,6 @@
 
 #define QCC_MODULE "LEADER_ELECTION"
 
-#define ELECTION_INTERVAL_IN_SECONDS 1
-
-#define LEADER_ANNOUNCEMENT_WAIT_INTERVAL_IN_SECONDS 2
-
-#define OVERTHROW_TIMEOUT_IN_SEC 5
-
-#define OVERTHROW_TIMEOUT_IN_M_SEC 5000
-
 bool g_IsLeader = false;
 
 using namespace lsf;
@@ -57,6 +51,7 @@ static const char* ControllerServiceInterface[] = {
 class LeaderElectionObject::Handler : public AboutListener,
     public BusAttachment::JoinSessionAsyncCB,
     public BusAttachment::SetLinkTimeoutAsyncCB,
+    public ProxyBusObject::Listener,
     public SessionListener {
   public:
     Handler(LeaderElectionObject& elector) : elector(elector) { }
@@ -75,6 +70,18 @@ class LeaderElectionObject::Handler : public AboutListener,
         QCC_DbgTrace(("SetLinkTimeoutCB(%s, %u)", QCC_StatusText(status), timeout));
     }
 
+    void HeartbeatReplyCB(QStatus status, ProxyBusObject* obj, const MsgArg& value, void* context) {
+        QCC_DbgTrace(("%s: (status=%s)", __func__, QCC_StatusText(status)));
+        elector.bus.EnableConcurrentCallbacks();
+        elector.OnLeaderHeartbeatReply(status, static_cast<SessionId>(reinterpret_cast<uintptr_t>(context)));
+    }
+
+    void VersionReplyCB(QStatus status, ProxyBusObject* obj, const MsgArg& value, void* context) {
+        QCC_DbgTrace(("%s: (status=%s)", __func__, QCC_StatusText(status)));
+        elector.bus.EnableConcurrentCallbacks();
+        elector.OnLeaderVersionReply(status, value, static_cast<SessionId>(reinterpret_cast<uintptr_t>(context)));
+    }
+
     virtual void SessionMemberRemoved(SessionId sessionId, const char* uniqueName) {
         QCC_DbgTrace(("%s: (sessionId=%u, uniqueName=%s)", __func__, sessionId, uniqueName));
         elector.bus.EnableConcurrentCallbacks();
@@ -140,12 +147,23 @@ LeaderElectionObject::LeaderElectionObject(ControllerService& controller)
     myRank(),
     isRunning(false),
     blobChangedSignal(NULL),
+    compressedBlobChangedSignal(NULL),
     electionAlarm(this),
     alarmTriggered(false),
     isLeader(false),
     startElection(true),
     okToSetAlarm(true),
-    gotOverthrowReply(false)
+    gotOverthrowReply(false),
+    numBlobReplies(0),
+    totalBlobReplyLatency(0),
+    maxBlobReplyLatency(0),
+    missedHeartbeats(0),
+    nextHeartbeatTimestamp(0),
+    leaderLostTimestamp(0),
+    lastFailoverTimeInMs(0),
+    syncStartTimestamp(0),
+    lastSyncTimeInMs(0),
+    lastSyncNumBlobs(0)
 {
     QCC_DbgTrace(("%s", __func__));
     currentLeader.Clear();
@@ -168,6 +186,15 @@ LeaderElectionObject::~LeaderElectionObject()
         QCC_LogError(status, ("%s: Failed to unregister BlobChanged Handler", __func__));
     }
 
+    status = bus.UnregisterSignalHandler(
+        this,
+        static_cast<MessageReceiver::SignalHandler>(&LeaderElectionObject::OnCompressedBlobChanged),
+        compressedBlobChangedSignal,
+        LeaderElectionAndStateSyncObjectPath);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("%s: Failed to unregister CompressedBlobChanged Handler", __func__));
+    }
+
     electionAlarmMutex.Lock();
     electionAlarm.Stop();
     electionAlarm.Join();
@@ -208,7 +235,7 @@ void LeaderElectionObject::OnAnnounced(ajn::SessionPort port, const char* busNam
         if ((rank > lastTrackedRank) || (rank == lastTrackedRank)) {
             electionAlarmMutex.Lock();
             QCC_DbgPrintf(("%s: Reloading alarm", __func__));
-            electionAlarm.SetAlarm(LEADER_ANNOUNCEMENT_WAIT_INTERVAL_IN_SECONDS);
+            electionAlarm.SetAlarmInMs(OEM_CS_LEADER_ANNOUNCEMENT_WAIT_MS);
             electionAlarmMutex.Unlock();
         }
     } else {
@@ -225,6 +252,61 @@ void LeaderElectionObject::OnSessionLost(SessionId sessionId)
     wakeSem.Post();
 }
 
+void LeaderElectionObject::SendLeaderHeartbeat(void)
+{
+    QCC_DbgTrace(("%s", __func__));
+    ProxyBusObject proxyObj;
+    currentLeaderMutex.Lock();
+    proxyObj = currentLeader.proxyObj;
+    currentLeaderMutex.Unlock();
+
+    if (!proxyObj.IsValid()) {
+        return;
+    }
+
+    /*
+     * Any reply, including an error reply from a leader that does not serve the
+     * Version property, shows that the leader is alive. Only timeouts count as misses
+     */
+    QStatus status = proxyObj.GetPropertyAsync(
+        LeaderElectionAndStateSyncInterfaceName,
+        "Version",
+        handler,
+        static_cast<ProxyBusObject::Listener::GetPropertyCB>(&LeaderElectionObject::Handler::HeartbeatReplyCB),
+        reinterpret_cast<void*>(static_cast<uintptr_t>(proxyObj.GetSessionId())),
+        OEM_CS_LEADER_HEARTBEAT_INTERVAL_MS);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("%s: GetPropertyAsync failed", __func__));
+    }
+}
+
+void LeaderElectionObject::OnLeaderHeartbeatReply(QStatus status, SessionId sessionId)
+{
+    QCC_DbgTrace(("%s: (status=%s, sessionId=%u)", __func__, QCC_StatusText(status), sessionId));
+
+    currentLeaderMutex.Lock();
+    bool currentSession = (currentLeader.proxyObj.IsValid() && (currentLeader.proxyObj.GetSessionId() == sessionId));
+    currentLeaderMutex.Unlock();
+
+    if (!currentSession) {
+        return;
+    }
+
+    if (status != ER_TIMEOUT) {
+        missedHeartbeats = 0;
+        return;
+    }
+
+    missedHeartbeats++;
+    QCC_DbgPrintf(("%s: Leader missed %d heartbeats", __func__, missedHeartbeats));
+    if (missedHeartbeats >= OEM_CS_LEADER_HEARTBEAT_MISSES) {
+        QCC_LogError(ER_TIMEOUT, ("%s: Leader stopped responding. Leaving the leader session", __func__));
+        missedHeartbeats = 0;
+        controller.DoLeaveSessionAsync(sessionId);
+        OnSessionLost(sessionId);
+    }
+}
+
 void LeaderElectionObject::OnSessionMemberRemoved(SessionId sessionId, const char* uniqueName)
 {
     QCC_DbgTrace(("%s: (%u, %s)", __func__, sessionId, uniqueName));
@@ -234,84 +316,220 @@ void LeaderElectionObject::OnSessionMemberRemoved(SessionId sessionId, const cha
     wakeSem.Post();
 }
 
-void LeaderElectionObject::OnGetBlobReply(ajn::Message& message, void* context)
+/*
+ * Compressed blobs travel as (u blobType, ay blob, u uncompressedLength, u checksum, t timestamp)
+ */
+static void PackCompressedBlobArgs(MsgArg* args, LSFBlobType type, const std::string& blob, uint32_t checksum, uint64_t timestamp)
 {
-    QCC_DbgTrace(("%s", __func__));
-    bus.EnableConcurrentCallbacks();
+    std::string compressed;
+    CompressBlob(blob, compressed);
 
-    QCC_DbgPrintf(("%s: %s", __func__, (MESSAGE_METHOD_RET == message->GetType()) ? message->ToString().c_str() : "ERROR"));
+    uint8_t* data = new uint8_t[compressed.size()];
+    memcpy(data, compressed.data(), compressed.size());
 
-    if (message->GetType() == ajn::MESSAGE_METHOD_RET) {
-        size_t numArgs;
-        const MsgArg* args;
-        message->GetArgs(numArgs, args);
+    args[0].Set("u", static_cast<uint32_t>(type));
+    args[1].Set("ay", compressed.size(), data);
+    args[1].SetOwnershipFlags(MsgArg::OwnsData);
+    args[2].Set("u", static_cast<uint32_t>(blob.size()));
+    args[3].Set("u", checksum);
+    args[4].Set("t", timestamp);
 
-        if (controller.CheckNumArgsInMessage(numArgs, 4)  != LSF_OK) {
-            return;
-        }
+    QCC_DbgPrintf(("%s: type=%d %u bytes compressed to %u bytes", __func__, type, blob.size(), compressed.size()));
+}
 
-        if (args[1].v_string.len) {
-            switch (args[0].v_uint32) {
-            case LSF_PRESET:
-                controller.GetPresetManager().HandleReceivedBlob(args[1].v_string.str, args[2].v_uint32, args[3].v_uint64);
-                break;
+static bool UnpackCompressedBlobArgs(const MsgArg* args, LSFBlobType& type, std::string& blob, uint32_t& checksum, uint64_t& timestamp)
+{
+    uint8_t* data = NULL;
+    size_t len = 0;
+    uint32_t uncompressedLen = 0;
 
-            case LSF_LAMP_GROUP:
-                controller.GetLampGroupManager().HandleReceivedBlob(args[1].v_string.str, args[2].v_uint32, args[3].v_uint64);
-                break;
+    QStatus status = args[1].Get("ay", &len, &data);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("%s: Invalid compressed blob argument", __func__));
+        return false;
+    }
 
-            case LSF_SCENE:
-                controller.GetSceneManager().HandleReceivedBlob(args[1].v_string.str, args[2].v_uint32, args[3].v_uint64);
-                break;
+    type = static_cast<LSFBlobType>(args[0].v_uint32);
+    uncompressedLen = args[2].v_uint32;
+    checksum = args[3].v_uint32;
+    timestamp = args[4].v_uint64;
 
-            case LSF_MASTER_SCENE:
-                controller.GetMasterSceneManager().HandleReceivedBlob(args[1].v_string.str, args[2].v_uint32, args[3].v_uint64);
-                break;
+    if ((uncompressedLen > Manager::MAX_FILE_LEN) || !DecompressBlob(data, len, uncompressedLen, blob)) {
+        QCC_LogError(ER_FAIL, ("%s: Failed to decompress blob of type %d", __func__, type));
+        blob.clear();
+        return false;
+    }
 
-            case LSF_TRANSITION_EFFECT:
-                controller.GetTransitionEffectManager().HandleReceivedBlob(args[1].v_string.str, args[2].v_uint32, args[3].v_uint64);
-                break;
+    return true;
+}
 
-            case LSF_PULSE_EFFECT:
-                controller.GetPulseEffectManager().HandleReceivedBlob(args[1].v_string.str, args[2].v_uint32, args[3].v_uint64);
-                break;
+void LeaderElectionObject::DispatchReceivedBlob(LSFBlobType type, const char* blob, size_t blobLength, uint32_t checksum, uint64_t timestamp)
+{
+    switch (type) {
+    case LSF_PRESET:
+        controller.GetPresetManager().HandleReceivedBlob(blob, blobLength, checksum, timestamp);
+        break;
 
-            case LSF_PRESET_UPDATE:
-                controller.GetPresetManager().HandleReceivedUpdateBlob(args[1].v_string.str, args[2].v_uint32, args[3].v_uint64);
-                break;
+    case LSF_LAMP_GROUP:
+        controller.GetLampGroupManager().HandleReceivedBlob(blob, blobLength, checksum, timestamp);
+        break;
 
-            case LSF_MASTER_SCENE_UPDATE:
-                controller.GetMasterSceneManager().HandleReceivedUpdateBlob(args[1].v_string.str, args[2].v_uint32, args[3].v_uint64);
-                break;
+    case LSF_SCENE:
+        controller.GetSceneManager().HandleReceivedBlob(blob, blobLength, checksum, timestamp);
+        break;
 
-            case LSF_LAMP_GROUP_UPDATE:
-                controller.GetLampGroupManager().HandleReceivedUpdateBlob(args[1].v_string.str, args[2].v_uint32, args[3].v_uint64);
-                break;
+    case LSF_MASTER_SCENE:
+        controller.GetMasterSceneManager().HandleReceivedBlob(blob, blobLength, checksum, timestamp);
+        break;
 
-            case LSF_SCENE_UPDATE:
-                controller.GetSceneManager().HandleReceivedUpdateBlob(args[1].v_string.str, args[2].v_uint32, args[3].v_uint64);
-                break;
+    case LSF_TRANSITION_EFFECT:
+        controller.GetTransitionEffectManager().HandleReceivedBlob(blob, blobLength, checksum, timestamp);
+        break;
 
-            case LSF_TRANSITION_EFFECT_UPDATE:
-                controller.GetTransitionEffectManager().HandleReceivedUpdateBlob(args[1].v_string.str, args[2].v_uint32, args[3].v_uint64);
-                break;
+    case LSF_PULSE_EFFECT:
+        controller.GetPulseEffectManager().HandleReceivedBlob(blob, blobLength, checksum, timestamp);
+        break;
 
-            case LSF_PULSE_EFFECT_UPDATE:
-                controller.GetPulseEffectManager().HandleReceivedUpdateBlob(args[1].v_string.str, args[2].v_uint32, args[3].v_uint64);
-                break;
+    case LSF_PRESET_UPDATE:
+        controller.GetPresetManager().HandleReceivedUpdateBlob(blob, blobLength, checksum, timestamp);
+        break;
 
-            case LSF_SCENE_ELEMENT:
-                controller.GetSceneElementManager().HandleReceivedBlob(args[1].v_string.str, args[2].v_uint32, args[3].v_uint64);
-                break;
+    case LSF_LAMP_GROUP_UPDATE:
+        controller.GetLampGroupManager().HandleReceivedUpdateBlob(blob, blobLength, checksum, timestamp);
+        break;
 
-            case LSF_SCENE_2:
-                controller.GetSceneManager().HandleReceivedScene2Blob(args[1].v_string.str, args[2].v_uint32, args[3].v_uint64);
-                break;
+    case LSF_SCENE_UPDATE:
+        controller.GetSceneManager().HandleReceivedUpdateBlob(blob, blobLength, checksum, timestamp);
+        break;
 
-            case LSF_BLOB_TYPE_LAST_VALUE:
-            default:
-                QCC_LogError(ER_FAIL, ("%s: Unknown blob type requested", __func__));
-                break;
+    case LSF_MASTER_SCENE_UPDATE:
+        controller.GetMasterSceneManager().HandleReceivedUpdateBlob(blob, blobLength, checksum, timestamp);
+        break;
+
+    case LSF_TRANSITION_EFFECT_UPDATE:
+        controller.GetTransitionEffectManager().HandleReceivedUpdateBlob(blob, blobLength, checksum, timestamp);
+        break;
+
+    case LSF_PULSE_EFFECT_UPDATE:
+        controller.GetPulseEffectManager().HandleReceivedUpdateBlob(blob, blobLength, checksum, timestamp);
+        break;
+
+    case LSF_SCENE_ELEMENT:
+        controller.GetSceneElementManager().HandleReceivedBlob(blob, blobLength, checksum, timestamp);
+        break;
+
+    case LSF_SCENE_2:
+        controller.GetSceneManager().HandleReceivedScene2Blob(blob, blobLength, checksum, timestamp);
+        break;
+
+    case LSF_BLOB_TYPE_LAST_VALUE:
+    default:
+        QCC_LogError(ER_FAIL, ("%s: Unknown blob type received", __func__));
+        break;
+    }
+}
+
+bool LeaderElectionObject::CheckLeaderSupportsBlobCompression(void)
+{
+    ajn::ProxyBusObject proxyObj;
+
+    currentLeaderMutex.Lock();
+    if (currentLeader.versionChecked) {
+        bool supported = currentLeader.supportsBlobCompression;
+        currentLeaderMutex.Unlock();
+        return supported;
+    }
+    proxyObj = currentLeader.proxyObj;
+    currentLeaderMutex.Unlock();
+
+    if (!proxyObj.IsValid()) {
+        return false;
+    }
+
+    /*
+     * The version is normally known by now from QueryLeaderVersion. Fall back to
+     * asking for it if that query has not completed
+     */
+    MsgArg arg;
+    QStatus status = proxyObj.GetProperty(LeaderElectionAndStateSyncInterfaceName, "Version", arg, OEM_CS_OVERTHROW_TIMEOUT_MS);
+    return SetLeaderVersion(proxyObj.GetSessionId(), status, arg);
+}
+
+void LeaderElectionObject::QueryLeaderVersion(ajn::ProxyBusObject& proxyObj)
+{
+    QCC_DbgTrace(("%s", __func__));
+    QStatus status = proxyObj.GetPropertyAsync(
+        LeaderElectionAndStateSyncInterfaceName,
+        "Version",
+        handler,
+        static_cast<ProxyBusObject::Listener::GetPropertyCB>(&LeaderElectionObject::Handler::VersionReplyCB),
+        reinterpret_cast<void*>(static_cast<uintptr_t>(proxyObj.GetSessionId())),
+        OEM_CS_OVERTHROW_TIMEOUT_MS);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("%s: GetPropertyAsync failed", __func__));
+    }
+}
+
+void LeaderElectionObject::OnLeaderVersionReply(QStatus status, const ajn::MsgArg& value, SessionId sessionId)
+{
+    QCC_DbgTrace(("%s: (status=%s, sessionId=%u)", __func__, QCC_StatusText(status), sessionId));
+    if (status == ER_TIMEOUT) {
+        // Leave the version unknown so that it is asked for again when it is needed
+        return;
+    }
+    SetLeaderVersion(sessionId, status, value);
+}
+
+bool LeaderElectionObject::SetLeaderVersion(SessionId sessionId, QStatus status, const ajn::MsgArg& value)
+{
+    /*
+     * Leaders running an older version of the service do not serve the Version
+     * property on this object. Treat that the same as version 1
+     */
+    uint32_t version = 1;
+    if (status == ER_OK) {
+        value.Get("u", &version);
+    }
+    bool supported = (version >= LSF_BLOB_COMPRESSION_MIN_INTERFACE_VERSION);
+    QCC_DbgPrintf(("%s: Leader LeaderElectionAndStateSync version=%u compression=%d", __func__, version, supported));
+
+    currentLeaderMutex.Lock();
+    if (currentLeader.proxyObj.GetSessionId() == sessionId) {
+        currentLeader.versionChecked = true;
+        currentLeader.supportsBlobCompression = supported;
+    }
+    currentLeaderMutex.Unlock();
+
+    return supported;
+}
+
+void LeaderElectionObject::OnGetBlobReply(ajn::Message& message, void* context)
+{
+    QCC_DbgTrace(("%s", __func__));
+    bus.EnableConcurrentCallbacks();
+
+    QCC_DbgPrintf(("%s: %s", __func__, (MESSAGE_METHOD_RET == message->GetType()) ? message->ToString().c_str() : "ERROR"));
+
+    if (message->GetType() == ajn::MESSAGE_METHOD_RET) {
+        size_t numArgs;
+        const MsgArg* args;
+        message->GetArgs(numArgs, args);
+
+        if ((numArgs == 5) && (args[1].typeId == ALLJOYN_BYTE_ARRAY)) {
+            LSFBlobType type;
+            std::string blob;
+            uint32_t checksum;
+            uint64_t timestamp;
+            if (UnpackCompressedBlobArgs(args, type, blob, checksum, timestamp) && !blob.empty()) {
+                DispatchReceivedBlob(type, blob.data(), blob.size(), checksum, timestamp);
+            }
+        } else {
+            if (controller.CheckNumArgsInMessage(numArgs, 4)  != LSF_OK) {
+                return;
+            }
+
+            if (args[1].v_string.len) {
+                DispatchReceivedBlob(static_cast<LSFBlobType>(args[0].v_uint32), args[1].v_string.str, args[1].v_string.len, args[2].v_uint32, args[3].v_uint64);
             }
         }
     }
@@ -320,6 +538,7 @@ void LeaderElectionObject::OnGetBlobReply(ajn::Message& message, void* context)
     if (0 == qcc::DecrementAndFetch(&sync->numWaiting)) {
         // we're finished synchronizing!
         QCC_DbgPrintf(("Finished synchronizing!"));
+        SyncCompleted(sync->numBlobs);
         delete sync;
 
         ControllerEntry outGoingLeaderCopy;
@@ -333,7 +552,7 @@ void LeaderElectionObject::OnGetBlobReply(ajn::Message& message, void* context)
                 "Overthrow",
                 this,
                 static_cast<MessageReceiver::ReplyHandler>(&LeaderElectionObject::OnOverthrowReply),
-                NULL, 0, NULL, OVERTHROW_TIMEOUT_IN_M_SEC);
+                NULL, 0, NULL, OEM_CS_OVERTHROW_TIMEOUT_MS);
 
             if (status != ER_OK) {
                 QCC_LogError(status, ("%s: MethodCallAsync for Overthrow failed", __func__));
@@ -346,6 +565,17 @@ void LeaderElectionObject::OnGetBlobReply(ajn::Message& message, void* context)
     }
 }
 
+void LeaderElectionObject::SyncCompleted(uint32_t numBlobs)
+{
+    /*
+     * syncStartTimestamp is set before the checksums are requested and not
+     * again until the session with the leader is rejoined
+     */
+    lastSyncTimeInMs = static_cast<uint32_t>(GetTimestampInMs() - syncStartTimestamp);
+    lastSyncNumBlobs = numBlobs;
+    QCC_DbgPrintf(("%s: Synchronized %u stores in %u ms", __func__, lastSyncNumBlobs, lastSyncTimeInMs));
+}
+
 void LeaderElectionObject::OnGetChecksumAndModificationTimestampReply(ajn::Message& message, void* context)
 {
     QCC_DbgTrace(("%s", __func__));
@@ -537,9 +767,11 @@ void LeaderElectionObject::OnGetChecksumAndModificationTimestampReply(ajn::Messa
                 return;
             }
             sync->numWaiting = storesToFetch.size();
+            sync->numBlobs = storesToFetch.size();
             QCC_DbgPrintf(("Going to synchronize %d types", sync->numWaiting));
 
             uint8_t methodCallFailCount = 0;
+            const char* getBlobMethod = CheckLeaderSupportsBlobCompression() ? "GetCompressedBlob" : "GetBlob";
 
             for (std::list<LSFBlobType>::iterator it = storesToFetch.begin(); it != storesToFetch.end(); ++it) {
                 LSFBlobType type = *it;
@@ -551,13 +783,13 @@ void LeaderElectionObject::OnGetChecksumAndModificationTimestampReply(ajn::Messa
                 if (currentLeader.proxyObj.IsValid()) {
                     status = currentLeader.proxyObj.MethodCallAsync(
                         LeaderElectionAndStateSyncInterfaceName,
-                        "GetBlob",
+                        getBlobMethod,
                         this,
                         static_cast<MessageReceiver::ReplyHandler>(&LeaderElectionObject::OnGetBlobReply),
                         &arg,
                         1,
                         sync,
-                        OVERTHROW_TIMEOUT_IN_M_SEC);
+                        OEM_CS_OVERTHROW_TIMEOUT_MS);
                 } else {
                     status = ER_FAIL;
                 }
@@ -577,6 +809,7 @@ void LeaderElectionObject::OnGetChecksumAndModificationTimestampReply(ajn::Messa
             }
         } else {
             QCC_DbgTrace(("%s: Nothing to fetch", __func__));
+            SyncCompleted(0);
             gotOverthrowReply = true;
             wakeSem.Post();
         }
@@ -666,6 +899,9 @@ void LeaderElectionObject::ClearState(void)
     gotOverthrowReply = false;
     okToSetAlarm = true;
     startElection = true;
+    missedHeartbeats = 0;
+    nextHeartbeatTimestamp = 0;
+    leaderLostTimestamp = 0;
 
     currentLeaderMutex.Lock();
     currentLeader.Clear();
@@ -701,7 +937,30 @@ void LeaderElectionObject::Run(void)
     QCC_DbgPrintf(("%s", __func__));
 
     while (isRunning) {
+#if (OEM_CS_LEADER_HEARTBEAT_INTERVAL_MS > 0)
+        bool connectedToLeader = false;
+        if (!isLeader) {
+            currentLeaderMutex.Lock();
+            connectedToLeader = currentLeader.proxyObj.IsValid();
+            currentLeaderMutex.Unlock();
+        }
+
+        if (connectedToLeader) {
+            uint64_t now = GetTimestampInMs();
+            if (now >= nextHeartbeatTimestamp) {
+                SendLeaderHeartbeat();
+                nextHeartbeatTimestamp = now + OEM_CS_LEADER_HEARTBEAT_INTERVAL_MS;
+            }
+            if (!wakeSem.TimedWait(static_cast<uint32_t>(nextHeartbeatTimestamp - now))) {
+                // Only the next heartbeat is due, there is nothing else to process
+                continue;
+            }
+        } else {
+            wakeSem.Wait();
+        }
+#else
         wakeSem.Wait();
+#endif
         QCC_DbgPrintf(("%s: wakeSem posted", __func__));
 
         /*
@@ -846,7 +1105,7 @@ void LeaderElectionObject::Run(void)
                                  */
                                 electionAlarmMutex.Lock();
                                 QCC_DbgPrintf(("%s: Extended overthrow alarm", __func__));
-                                electionAlarm.SetAlarm(OVERTHROW_TIMEOUT_IN_SEC);
+                                electionAlarm.SetAlarmInMs(OEM_CS_OVERTHROW_TIMEOUT_MS);
                                 electionAlarmMutex.Unlock();
                                 QCC_DbgPrintf(("%s: Identified upcoming leader %s", __func__, upComingLeader.busName.c_str()));
                                 break;
@@ -931,7 +1190,7 @@ void LeaderElectionObject::Run(void)
                     controller.GetLampManager().DisconnectFromLamps();
                     controller.SetIsLeader(false);
                     electionAlarmMutex.Lock();
-                    electionAlarm.SetAlarm(ELECTION_INTERVAL_IN_SECONDS);
+                    electionAlarm.SetAlarmInMs(OEM_CS_ELECTION_INTERVAL_MS);
                     electionAlarmMutex.Unlock();
                 } else {
                     QCC_DbgPrintf(("%s: Third loop", __func__));
@@ -1152,12 +1411,23 @@ void LeaderElectionObject::Run(void)
 
                                     const InterfaceDescription* stateSyncInterface = bus.GetInterface(LeaderElectionAndStateSyncInterfaceName);
                                     currentLeader.proxyObj.AddInterface(*stateSyncInterface);
+                                    currentLeader.versionChecked = false;
+                                    currentLeader.supportsBlobCompression = false;
+                                    missedHeartbeats = 0;
+                                    nextHeartbeatTimestamp = 0;
+
+                                    /*
+                                     * Find out the version of the leader while the checksums are being
+                                     * fetched, so that the blob requests can be sent as soon as they arrive
+                                     */
+                                    QueryLeaderVersion(currentLeader.proxyObj);
 
                                     ControllerEntry outGoingLeaderCopy;
                                     outGoingLeaderMutex.Lock();
                                     outGoingLeaderCopy = outGoingLeader;
                                     outGoingLeaderMutex.Unlock();
 
+                                    syncStartTimestamp = GetTimestampInMs();
                                     if (!outGoingLeaderCopy.busName.empty()) {
                                         /*
                                          * Try to get current state from outgoing leader
@@ -1167,7 +1437,7 @@ void LeaderElectionObject::Run(void)
                                             "GetChecksumAndModificationTimestamp",
                                             this,
                                             static_cast<MessageReceiver::ReplyHandler>(&LeaderElectionObject::OnGetChecksumAndModificationTimestampReply),
-                                            NULL, 0, NULL, OVERTHROW_TIMEOUT_IN_M_SEC);
+                                            NULL, 0, NULL, OEM_CS_OVERTHROW_TIMEOUT_MS);
 
                                         if (status != ER_OK) {
                                             QCC_LogError(status, ("%s: MethodCallAsync for GetChecksumAndModificationTimestamp failed", __func__));
@@ -1292,6 +1562,8 @@ void LeaderElectionObject::Run(void)
 
                         if (lostSessionWithLeader) {
                             QCC_DbgPrintf(("%s: SessionLost", __func__));
+                            leaderLostTimestamp = GetTimestampInMs();
+                            missedHeartbeats = 0;
                             ControllerEntry failedConnectToLeader;
 
                             currentLeaderMutex.Lock();
@@ -1364,6 +1636,21 @@ void LeaderElectionObject::Run(void)
                 }
             }
         }
+
+        if (leaderLostTimestamp) {
+            bool leaderFound = isLeader;
+            if (!leaderFound) {
+                currentLeaderMutex.Lock();
+                leaderFound = currentLeader.proxyObj.IsValid();
+                currentLeaderMutex.Unlock();
+            }
+
+            if (leaderFound) {
+                lastFailoverTimeInMs = static_cast<uint32_t>(GetTimestampInMs() - leaderLostTimestamp);
+                leaderLostTimestamp = 0;
+                QCC_DbgPrintf(("%s: Failed over to a new leader in %u ms", __func__, lastFailoverTimeInMs));
+            }
+        }
     }
 
 _Exit:
@@ -1422,6 +1709,7 @@ QStatus LeaderElectionObject::Start(Rank& rank)
     const MethodEntry methodEntries[] = {
         { stateSyncInterface->GetMember("GetChecksumAndModificationTimestamp"), static_cast<MessageReceiver::MethodHandler>(&LeaderElectionObject::GetChecksumAndModificationTimestamp) },
         { stateSyncInterface->GetMember("GetBlob"), static_cast<MessageReceiver::MethodHandler>(&LeaderElectionObject::GetBlob) },
+        { stateSyncInterface->GetMember("GetCompressedBlob"), static_cast<MessageReceiver::MethodHandler>(&LeaderElectionObject::GetBlob) },
         { stateSyncInterface->GetMember("Overthrow"), static_cast<MessageReceiver::MethodHandler>(&LeaderElectionObject::Overthrow) }
     };
 
@@ -1442,6 +1730,17 @@ QStatus LeaderElectionObject::Start(Rank& rank)
         return status;
     }
 
+    compressedBlobChangedSignal = stateSyncInterface->GetSignal("CompressedBlobChanged");
+    status = bus.RegisterSignalHandler(
+        this,
+        static_cast<MessageReceiver::SignalHandler>(&LeaderElectionObject::OnCompressedBlobChanged),
+        compressedBlobChangedSignal,
+        LeaderElectionAndStateSyncObjectPath);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("%s: Failed to register CompressedBlobChanged signal handler", __func__));
+        return status;
+    }
+
     status = bus.RegisterBusObject(*this);
     if (status != ER_OK) {
         QCC_LogError(status, ("%s: Failed to register BusObject for the Leader Object", __func__));
@@ -1485,7 +1784,7 @@ void LeaderElectionObject::Overthrow(const InterfaceDescription::Member* member,
     if (0 == strcmp(msg->GetSender(), upcomingLeaderCopy.busName.c_str())) {
         electionAlarmMutex.Lock();
         QCC_DbgPrintf(("%s: Extended overthrow alarm", __func__));
-        electionAlarm.SetAlarm(OVERTHROW_TIMEOUT_IN_SEC);
+        electionAlarm.SetAlarmInMs(OEM_CS_OVERTHROW_TIMEOUT_MS);
         electionAlarmMutex.Unlock();
     }
 
@@ -1521,24 +1820,31 @@ void LeaderElectionObject::OnOverthrowReply(Message& message, void* context)
     wakeSem.Post();
 }
 
-QStatus LeaderElectionObject::SendBlobUpdate(SessionId session, LSFBlobType type, std::string blob, uint32_t checksum, uint64_t timestamp)
+QStatus LeaderElectionObject::SendBlobUpdate(SessionId session, LSFBlobType type, const std::string& blob, uint32_t checksum, uint64_t timestamp)
 {
     if (!controller.IsLeader()) {
         return ER_OK;
     }
 
     QCC_DbgTrace(("%s: Signal(session=%u)", __func__, session));
+
+#if OEM_CS_SEND_COMPRESSED_BLOB_UPDATES
+    MsgArg args[5];
+    PackCompressedBlobArgs(args, type, blob, checksum, timestamp);
+
+    return Signal(NULL, session, *compressedBlobChangedSignal, args, 5);
+#else
     MsgArg args[4];
     args[0].Set("u", static_cast<uint32_t>(type));
-    args[1].Set("s", strdupnew(blob.c_str()));
-    args[1].SetOwnershipFlags(MsgArg::OwnsData);
+    args[1].Set("s", blob.c_str());
     args[2].Set("u", checksum);
     args[3].Set("t", timestamp);
 
     return Signal(NULL, session, *blobChangedSignal, args, 4);
+#endif
 }
 
-QStatus LeaderElectionObject::SendBlobUpdate(LSFBlobType type, std::string blob, uint32_t checksum, uint64_t timestamp)
+QStatus LeaderElectionObject::SendBlobUpdate(LSFBlobType type, const std::string& blob, uint32_t checksum, uint64_t timestamp)
 {
     QCC_DbgTrace(("%s", __func__));
 
@@ -1550,11 +1856,15 @@ QStatus LeaderElectionObject::SendBlobUpdate(LSFBlobType type, std::string blob,
     }
     currentLeaderMutex.Unlock();
 
-    if (session) {
+    if (session && CheckLeaderSupportsBlobCompression()) {
+        MsgArg args[5];
+        PackCompressedBlobArgs(args, type, blob, checksum, timestamp);
+        QCC_DbgTrace(("%s: Signal(session=%u)", __func__, session));
+        return Signal(NULL, session, *compressedBlobChangedSignal, args, 5);
+    } else if (session) {
         MsgArg args[4];
         args[0].Set("u", static_cast<uint32_t>(type));
-        args[1].Set("s", strdupnew(blob.c_str()));
-        args[1].SetOwnershipFlags(MsgArg::OwnsData);
+        args[1].Set("s", blob.c_str());
         args[2].Set("u", checksum);
         args[3].Set("t", timestamp);
         QCC_DbgTrace(("%s: Signal(session=%u)", __func__, session));
@@ -1564,13 +1874,34 @@ QStatus LeaderElectionObject::SendBlobUpdate(LSFBlobType type, std::string blob,
     return ER_FAIL;
 }
 
-void LeaderElectionObject::SendGetBlobReply(ajn::Message& message, LSFBlobType type, std::string blob, uint32_t checksum, uint64_t timestamp)
+void LeaderElectionObject::SendGetBlobReply(ajn::Message& message, LSFBlobType type, const std::string& blob, uint32_t checksum, uint64_t timestamp)
 {
     QCC_DbgTrace(("%s", __func__));
+
+    blobRequestsMutex.Lock();
+    PendingBlobRequestMap::iterator it = pendingBlobRequests.find(std::make_pair(message->GetSender(), message->GetCallSerial()));
+    if (it != pendingBlobRequests.end()) {
+        uint64_t latency = GetTimestampInMs() - it->second;
+        pendingBlobRequests.erase(it);
+        numBlobReplies++;
+        totalBlobReplyLatency += latency;
+        if (latency > maxBlobReplyLatency) {
+            maxBlobReplyLatency = latency;
+        }
+        QCC_DbgPrintf(("%s: Replying to GetBlob for type %d after %llu ms", __func__, type, latency));
+    }
+    blobRequestsMutex.Unlock();
+
+    if (0 == strcmp(message->GetMemberName(), "GetCompressedBlob")) {
+        MsgArg args[5];
+        PackCompressedBlobArgs(args, type, blob, checksum, timestamp);
+        controller.SendMethodReply(message, args, 5);
+        return;
+    }
+
     MsgArg args[4];
     args[0].Set("u", static_cast<uint32_t>(type));
-    args[1].Set("s", strdupnew(blob.c_str()));
-    args[1].SetOwnershipFlags(MsgArg::OwnsData);
+    args[1].Set("s", blob.c_str());
     args[2].Set("u", checksum);
     args[3].Set("t", timestamp);
 
@@ -1592,7 +1923,7 @@ void LeaderElectionObject::GetChecksumAndModificationTimestamp(const ajn::Interf
     if (0 == strcmp(message->GetSender(), upcomingLeaderCopy.busName.c_str())) {
         electionAlarmMutex.Lock();
         QCC_DbgPrintf(("%s: Extended overthrow alarm", __func__));
-        electionAlarm.SetAlarm(OVERTHROW_TIMEOUT_IN_SEC);
+        electionAlarm.SetAlarmInMs(OEM_CS_OVERTHROW_TIMEOUT_MS);
         electionAlarmMutex.Unlock();
     }
 
@@ -1753,10 +2084,18 @@ void LeaderElectionObject::GetBlob(const ajn::InterfaceDescription::Member* memb
     if (0 == strcmp(message->GetSender(), upcomingLeaderCopy.busName.c_str())) {
         electionAlarmMutex.Lock();
         QCC_DbgPrintf(("%s: Extended overthrow alarm", __func__));
-        electionAlarm.SetAlarm(OVERTHROW_TIMEOUT_IN_SEC);
+        electionAlarm.SetAlarmInMs(OEM_CS_OVERTHROW_TIMEOUT_MS);
         electionAlarmMutex.Unlock();
     }
 
+    blobRequestsMutex.Lock();
+    // Requests that are never answered, such as for a corrupted store, must not pile up
+    if (pendingBlobRequests.size() >= LSF_BLOB_TYPE_LAST_VALUE * 4) {
+        pendingBlobRequests.clear();
+    }
+    pendingBlobRequests[std::make_pair(message->GetSender(), message->GetCallSerial())] = GetTimestampInMs();
+    blobRequestsMutex.Unlock();
+
     switch (static_cast<LSFBlobType>(args[0].v_uint32)) {
     case LSF_PRESET:
         controller.GetPresetManager().ScheduleFileRead(message);
@@ -1834,78 +2173,68 @@ void LeaderElectionObject::OnBlobChanged(const InterfaceDescription::Member* mem
     }
 
     LSFBlobType type = static_cast<LSFBlobType>(args[0].v_uint32);
-    std::string blob = args[1].v_string.str;
     uint32_t checksum = args[2].v_uint32;
     uint64_t timestamp = args[3].v_uint64;
 
-    switch (type) {
-    case LSF_PRESET:
-        controller.GetPresetManager().HandleReceivedBlob(blob, checksum, timestamp);
-        break;
+    /* Parse the blob in place, the message owns the buffer until we return */
+    DispatchReceivedBlob(type, args[1].v_string.str, args[1].v_string.len, checksum, timestamp);
 
-    case LSF_LAMP_GROUP:
-        controller.GetLampGroupManager().HandleReceivedBlob(blob, checksum, timestamp);
-        break;
-
-    case LSF_SCENE:
-        controller.GetSceneManager().HandleReceivedBlob(blob, checksum, timestamp);
-        break;
-
-    case LSF_MASTER_SCENE:
-        controller.GetMasterSceneManager().HandleReceivedBlob(blob, checksum, timestamp);
-        break;
-
-    case LSF_TRANSITION_EFFECT:
-        controller.GetTransitionEffectManager().HandleReceivedBlob(blob, checksum, timestamp);
-        break;
-
-    case LSF_PULSE_EFFECT:
-        controller.GetPulseEffectManager().HandleReceivedBlob(blob, checksum, timestamp);
-        break;
-
-    case LSF_PRESET_UPDATE:
-        controller.GetPresetManager().HandleReceivedUpdateBlob(blob, checksum, timestamp);
-        break;
-
-    case LSF_LAMP_GROUP_UPDATE:
-        controller.GetLampGroupManager().HandleReceivedUpdateBlob(blob, checksum, timestamp);
-        break;
-
-    case LSF_SCENE_UPDATE:
-        controller.GetSceneManager().HandleReceivedUpdateBlob(blob, checksum, timestamp);
-        break;
-
-    case LSF_MASTER_SCENE_UPDATE:
-        controller.GetMasterSceneManager().HandleReceivedUpdateBlob(blob, checksum, timestamp);
-        break;
-
-    case LSF_TRANSITION_EFFECT_UPDATE:
-        controller.GetTransitionEffectManager().HandleReceivedUpdateBlob(blob, checksum, timestamp);
-        break;
-
-    case LSF_PULSE_EFFECT_UPDATE:
-        controller.GetPulseEffectManager().HandleReceivedUpdateBlob(blob, checksum, timestamp);
-        break;
+    controller.GetSceneManager().RefreshSceneData();
+}
 
-    case LSF_SCENE_ELEMENT:
-        controller.GetSceneElementManager().HandleReceivedBlob(blob, checksum, timestamp);
-        break;
+void LeaderElectionObject::OnCompressedBlobChanged(const InterfaceDescription::Member* member, const char* sourcePath, Message& message)
+{
+    QCC_DbgTrace(("%s", __func__));
+    bus.EnableConcurrentCallbacks();
+    size_t numArgs;
+    const MsgArg* args;
+    message->GetArgs(numArgs, args);
 
-    case LSF_SCENE_2:
-        controller.GetSceneManager().HandleReceivedScene2Blob(blob, checksum, timestamp);
-        break;
+    if (controller.CheckNumArgsInMessage(numArgs, 5)  != LSF_OK) {
+        return;
+    }
 
-    case LSF_BLOB_TYPE_LAST_VALUE:
-    default:
-        QCC_LogError(ER_FAIL, ("%s: Unsupported blob type requested", __func__));
-        break;
+    LSFBlobType type;
+    std::string blob;
+    uint32_t checksum;
+    uint64_t timestamp;
+    if (!UnpackCompressedBlobArgs(args, type, blob, checksum, timestamp)) {
+        return;
     }
 
+    DispatchReceivedBlob(type, blob.data(), blob.size(), checksum, timestamp);
+
     controller.GetSceneManager().RefreshSceneData();
 }
 
+void LeaderElectionObject::GetBlobReplyLatencyInfo(uint32_t& numReplies, uint64_t& averageLatency, uint64_t& maxLatency)
+{
+    blobRequestsMutex.Lock();
+    numReplies = numBlobReplies;
+    averageLatency = (numBlobReplies) ? (totalBlobReplyLatency / numBlobReplies) : 0;
+    maxLatency = maxBlobReplyLatency;
+    blobRequestsMutex.Unlock();
+}
+
 uint32_t LeaderElectionObject::GetLeaderElectionAndStateSyncInterfaceVersion(void)
 {
     QCC_DbgPrintf(("%s: LeaderElectionAndStateSyncInterfaceVersion=%d", __func__, ControllerServiceLeaderElectionAndStateSyncInterfaceVersion));
     return ControllerServiceLeaderElectionAndStateSyncInterfaceVersion;
 }
+
+QStatus LeaderElectionObject::Get(const char* ifcName, const char* propName, MsgArg& val)
+{
+    QCC_DbgPrintf(("%s", __func__));
+    QStatus status = ER_OK;
+    if (0 == strcmp("Version", propName)) {
+        if (0 == strcmp(ifcName, LeaderElectionAndStateSyncInterfaceName)) {
+            status = val.Set("u", GetLeaderElectionAndStateSyncInterfaceVersion());
+        } else {
+            status = ER_BUS_OBJECT_NO_SUCH_INTERFACE;
+        }
+    } else {
+        status = ER_BUS_NO_SUCH_PROPERTY;
+    }
+
+    return status;
+}
@@ -26,6 +26,7 @@
 #include <OEM_CS_Config.h>
 #include <AJInitializer.h>
 #include <ControllerServiceManagerInit.h>
+#include <RequestTracer.h>
 
 #ifdef LSF_BINDINGS
 using namespace lsf::controllerservice;
@@ -81,6 +82,10 @@ static std::string sceneWithSceneElementFilePath = sceneWithSceneElementFile;
 static std::string masterSceneFilePath = masterSceneFile;
 static std::string storeFilePath = storeFile;
 static std::string storeLocation;
+static std::string statisticsFilePath;
+static std::string traceFilePath;
+static std::string exportFilePath;
+static std::string importFilePath;
 static bool runForeground = false;
 static bool disableBackgroundLogging = true;
 
@@ -94,6 +99,10 @@ static void usage(int argc, char** argv)
     printf("   -k <absolute_directory_path>   = The absolute path to a directory required to store the AllJoyn KeyStore, Persistent Store and read/write the Config FilePaths\n\n");
     printf("   -v                    = Print the version number and exit\n");
     printf("   -l                    = Enable background logging\n");
+    printf("   -s <file_path>        = Periodically write the Controller Service statistics to a file\n");
+    printf("   -t <file_path>        = Periodically write the request trace to a file in the Chrome trace event format. Requires OEM_CS_REQUEST_TRACING\n");
+    printf("   -e <file_path>        = Periodically export the lighting data to a configuration snapshot file\n");
+    printf("   -i <file_path>        = Replace the lighting data with a configuration snapshot file once the Controller Service is up\n");
     printf("Default:\n");
     printf("    %s\n", argv[0]);
 }
@@ -137,6 +146,42 @@ static void parseCommandLine(int argc, char** argv)
             runForeground = true;
         } else if (0 == strcmp("-l", argv[i])) {
             disableBackgroundLogging = false;
+        } else if (0 == strcmp("-s", argv[i])) {
+            ++i;
+            if (i == argc) {
+                printf("option %s requires a parameter\n", argv[i - 1]);
+                usage(argc, argv);
+                exit(1);
+            } else {
+                statisticsFilePath = argv[i];
+            }
+        } else if (0 == strcmp("-t", argv[i])) {
+            ++i;
+            if (i == argc) {
+                printf("option %s requires a parameter\n", argv[i - 1]);
+                usage(argc, argv);
+                exit(1);
+            } else {
+                traceFilePath = argv[i];
+            }
+        } else if (0 == strcmp("-e", argv[i])) {
+            ++i;
+            if (i == argc) {
+                printf("option %s requires a parameter\n", argv[i - 1]);
+                usage(argc, argv);
+                exit(1);
+            } else {
+                exportFilePath = argv[i];
+            }
+        } else if (0 == strcmp("-i", argv[i])) {
+            ++i;
+            if (i == argc) {
+                printf("option %s requires a parameter\n", argv[i - 1]);
+                usage(argc, argv);
+                exit(1);
+            } else {
+                importFilePath = argv[i];
+            }
         } else {
             printf("Unknown option %s\n", argv[i]);
             usage(argc, argv);
@@ -181,6 +226,28 @@ static void RunService(bool listenToInterrupts)
     if (status == ER_OK) {
         while (g_running && controllerSvcManagerPtr->IsRunning()) {
             lsf_Sleep(OEM_CS_TIMEOUT_MS_CONNECTED_TO_ROUTING_NODE);
+            if (!statisticsFilePath.empty()) {
+                controllerSvcManagerPtr->DumpStatistics(statisticsFilePath);
+            }
+            if (!traceFilePath.empty()) {
+                RequestTracer::DumpChromeTrace(traceFilePath);
+            }
+            if (!importFilePath.empty()) {
+                /*
+                 * Updates are only allowed once the leader election has
+                 * settled, so keep trying until then
+                 */
+                LSFResponseCode responseCode = controllerSvcManagerPtr->ImportConfiguration(importFilePath);
+                if (LSF_ERR_BUSY != responseCode) {
+                    if (LSF_OK != responseCode) {
+                        QCC_LogError(ER_FAIL, ("%s: Failed to import %s: %s", __func__, importFilePath.c_str(), LSFResponseCodeText(responseCode)));
+                    }
+                    importFilePath.clear();
+                }
+            }
+            if (!exportFilePath.empty()) {
+                controllerSvcManagerPtr->ExportConfiguration(exportFilePath);
+            }
         }
     }
 
@@ -194,6 +261,10 @@ static void RunService(bool listenToInterrupts)
         QCC_DbgPrintf(("%s: After delete controllerSvcManagerPtr", __func__));
     }
 
+    if (!traceFilePath.empty()) {
+        RequestTracer::DumpChromeTrace(traceFilePath);
+    }
+
     isRunning = false;
 }
 
@@ -30,6 +30,15 @@
 #include <sstream>
 #include <streambuf>
 
+/*
+ * The SSSE3 Adler-32 path is compiled for SSSE3 whatever the build flags
+ * and selected at run time, so x86 builds for baseline CPUs still use it
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LSF_ADLER32_SSSE3
+#include <tmmintrin.h>
+#endif
+
 #ifdef LSF_BINDINGS
 #define QCC_MODULE "CONTROLLER_MANAGER"
 #else
@@ -51,12 +60,40 @@ Manager::Manager(ControllerService& controllerSvc, const std::string& filePath)
     updatesTimeStamp(0),
     blobUpdateCycle(false),
     initialState(false),
-    sendUpdate(false)
+    sendUpdate(false),
+    lastPersistedTimestamp(0),
+    lastWriteLatency(0),
+    maxWriteLatency(0),
+    numWriteCycles(0),
+    numWriteRequests(0),
+    blobSnapshot(NULL),
+    updateBlobSnapshot(NULL),
+    blobSnapshotVersion(0),
+    writeLatencyStatistic(NULL),
+    blobBytesStatistic(NULL)
 {
     QCC_DbgTrace(("%s", __func__));
     readBlobMessages.clear();
     readUpdateBlobMessages.clear();
 
+    /*
+     * Name the statistics of a store after its file, e.g. LampGroups.lsf
+     * reports LampGroups.WriteLatencyMs
+     */
+    if (!filePath.empty()) {
+        std::string statisticsPrefix = filePath;
+        size_t nameStart = statisticsPrefix.find_last_of('/');
+        if (nameStart != std::string::npos) {
+            statisticsPrefix.erase(0, nameStart + 1);
+        }
+        size_t extensionStart = statisticsPrefix.rfind(".lsf");
+        if (extensionStart != std::string::npos) {
+            statisticsPrefix.erase(extensionStart);
+        }
+        writeLatencyStatistic = controllerService.GetStatistics().Register((statisticsPrefix + ".WriteLatencyMs").c_str(), LSF_STATISTIC_HISTOGRAM);
+        blobBytesStatistic = controllerService.GetStatistics().Register((statisticsPrefix + ".BlobBytes").c_str(), LSF_STATISTIC_GAUGE);
+    }
+
     updateFilePath = filePath;
     QCC_DbgPrintf(("Original = %s", filePath.c_str()));
 
@@ -69,17 +106,132 @@ Manager::Manager(ControllerService& controllerSvc, const std::string& filePath)
     }
 }
 
+Manager::~Manager()
+{
+    QCC_DbgTrace(("%s", __func__));
+    blobSnapshotMutex.Lock();
+    if (blobSnapshot) {
+        blobSnapshot->Release();
+        blobSnapshot = NULL;
+    }
+    if (updateBlobSnapshot) {
+        updateBlobSnapshot->Release();
+        updateBlobSnapshot = NULL;
+    }
+    blobSnapshotMutex.Unlock();
+}
+
+/*
+ * ADLER32_NMAX is the largest n such that 255n(n+1)/2 + (n+1)(ADLER32_BASE-1) <= 2^32-1,
+ * i.e. the number of bytes that can be summed before the modulo must be taken
+ */
+#define ADLER32_BASE 65521
+#define ADLER32_NMAX 5552
+
+#if defined(LSF_ADLER32_SSSE3)
+/*
+ * Sums 32 byte blocks with SSSE3. Returns the number of bytes consumed.
+ * Must only be called if CPUSupportsSSSE3()
+ */
+__attribute__((target("ssse3")))
+static size_t Adler32Blocks(uint32_t& a, uint32_t& b, const uint8_t* data, size_t len)
+{
+    const size_t BLOCK_SIZE = 32;
+    size_t blocks = len / BLOCK_SIZE;
+    size_t consumed = blocks * BLOCK_SIZE;
+
+    const __m128i tap1 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17);
+    const __m128i tap2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+
+    while (blocks) {
+        size_t n = ADLER32_NMAX / BLOCK_SIZE;
+        if (n > blocks) {
+            n = blocks;
+        }
+        blocks -= n;
+
+        // v_ps accumulates the value of a at the start of every block
+        __m128i v_ps = _mm_set_epi32(0, 0, 0, a * n);
+        __m128i v_s2 = _mm_set_epi32(0, 0, 0, b);
+        __m128i v_s1 = _mm_setzero_si128();
+
+        do {
+            const __m128i bytes1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            const __m128i bytes2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+            v_ps = _mm_add_epi32(v_ps, v_s1);
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes1, zero));
+            v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_maddubs_epi16(bytes1, tap1), ones));
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes2, zero));
+            v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_maddubs_epi16(bytes2, tap2), ones));
+            data += BLOCK_SIZE;
+        } while (--n);
+
+        v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(v_ps, 5));
+
+        v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, _MM_SHUFFLE(2, 3, 0, 1)));
+        v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, _MM_SHUFFLE(1, 0, 3, 2)));
+        a += _mm_cvtsi128_si32(v_s1);
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(2, 3, 0, 1)));
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(1, 0, 3, 2)));
+        b = _mm_cvtsi128_si32(v_s2);
+
+        a %= ADLER32_BASE;
+        b %= ADLER32_BASE;
+    }
+
+    return consumed;
+}
+
+static bool CPUSupportsSSSE3(void)
+{
+    static const bool supported = __builtin_cpu_supports("ssse3");
+    return supported;
+}
+#endif
+
 static uint32_t GetAdler32Checksum(const uint8_t* data, size_t len) {
     QCC_DbgTrace(("%s: len = %d", __func__, len));
     uint32_t adler = 1;
-    uint32_t adlerPrime = 65521;
     uint32_t a = adler & 0xFFFF;
     uint32_t b = adler >> 16;
-    while (data && len) {
-        a = (a + *data++) % adlerPrime;
-        b = (b + a) % adlerPrime;
-        len--;
+
+    if (!data) {
+        return adler;
     }
+
+#if defined(LSF_ADLER32_SSSE3)
+    if (CPUSupportsSSSE3()) {
+        size_t consumed = Adler32Blocks(a, b, data, len);
+        data += consumed;
+        len -= consumed;
+    }
+#endif
+
+    while (len) {
+        size_t n = (len < ADLER32_NMAX) ? len : ADLER32_NMAX;
+        len -= n;
+        while (n >= 8) {
+            a += data[0]; b += a;
+            a += data[1]; b += a;
+            a += data[2]; b += a;
+            a += data[3]; b += a;
+            a += data[4]; b += a;
+            a += data[5]; b += a;
+            a += data[6]; b += a;
+            a += data[7]; b += a;
+            data += 8;
+            n -= 8;
+        }
+        while (n--) {
+            a += *data++;
+            b += a;
+        }
+        a %= ADLER32_BASE;
+        b %= ADLER32_BASE;
+    }
+
     adler = (b << 16) | a;
     QCC_DbgTrace(("%s: adler=0x%x", __func__, adler));
     return adler;
@@ -104,6 +256,8 @@ void Manager::WriteFileWithChecksumAndTimestamp(const std::string& str, uint32_t
     fstream << checksum << std::endl;
     fstream << str;
     fstream.close();
+
+    SetBlobSnapshot(blobSnapshot, str, checksum, timestamp, true);
 }
 
 void Manager::WriteUpdatesFileWithChecksumAndTimestamp(const std::string& str, uint32_t checksum, uint64_t timestamp)
@@ -119,9 +273,11 @@ void Manager::WriteUpdatesFileWithChecksumAndTimestamp(const std::string& str, u
     fstream << checksum << std::endl;
     fstream << str;
     fstream.close();
+
+    SetBlobSnapshot(updateBlobSnapshot, str, checksum, timestamp, false);
 }
 
-bool Manager::ValidateFileAndRead(std::istringstream& filestream)
+bool Manager::ValidateFileAndRead(BlobSnapshotStream& filestream)
 {
     QCC_DbgTrace(("%s", __func__));
     uint32_t checksum;
@@ -137,7 +293,7 @@ bool Manager::ValidateFileAndRead(std::istringstream& filestream)
     return b;
 }
 
-bool Manager::ValidateUpdateFileAndRead(std::istringstream& filestream)
+bool Manager::ValidateUpdateFileAndRead(BlobSnapshotStream& filestream)
 {
     QCC_DbgTrace(("%s", __func__));
     uint32_t checksum;
@@ -153,7 +309,7 @@ bool Manager::ValidateUpdateFileAndRead(std::istringstream& filestream)
     return b;
 }
 
-bool Manager::ValidateFileAndReadInternal(uint32_t& checksum, uint64_t& timestamp, std::istringstream& filestream)
+bool Manager::ValidateFileAndReadInternal(uint32_t& checksum, uint64_t& timestamp, BlobSnapshotStream& filestream)
 {
     QCC_DbgPrintf(("%s: filePath=%s", __func__, filePath.c_str()));
 
@@ -161,6 +317,11 @@ bool Manager::ValidateFileAndReadInternal(uint32_t& checksum, uint64_t& timestam
         return false;
     }
 
+    // The snapshot holds what was last written to or read from the file
+    if (ReadBlobSnapshot(blobSnapshot, checksum, timestamp, filestream)) {
+        return true;
+    }
+
     std::ifstream stream(filePath.c_str());
 
     if (!stream.is_open()) {
@@ -171,8 +332,8 @@ bool Manager::ValidateFileAndReadInternal(uint32_t& checksum, uint64_t& timestam
     stream >> timestamp;
 
     uint64_t currenttime = GetTimestampInMs();
-    QCC_DbgPrintf(("%s: timestamp=%llu", __func__, timestamp));
-    QCC_DbgPrintf(("%s: Updated %llu ticks ago", __func__, (currenttime - timestamp)));
+    QCC_DbgPrintf(("%s: timestamp=%llu", __func__, static_cast<unsigned long long>(timestamp)));
+    QCC_DbgPrintf(("%s: Updated %llu ticks ago", __func__, static_cast<unsigned long long>(currenttime - timestamp)));
 
     stream >> checksum;
 
@@ -183,16 +344,21 @@ bool Manager::ValidateFileAndReadInternal(uint32_t& checksum, uint64_t& timestam
     stream >> &rest;
     std::string data = rest.str();
     data.erase(std::remove(data.begin(), ++data.begin(), '\n'), ++data.begin());
-    filestream.str(data);
 
     // check the adler checksum
     uint32_t adler = GetChecksum(data);
 
     stream.close();
-    return adler == checksum;
+
+    if (adler != checksum) {
+        return false;
+    }
+
+    SetBlobSnapshot(blobSnapshot, data, checksum, timestamp, true);
+    return ReadBlobSnapshot(blobSnapshot, checksum, timestamp, filestream);
 }
 
-bool Manager::ValidateUpdateFileAndReadInternal(uint32_t& checksum, uint64_t& timestamp, std::istringstream& filestream)
+bool Manager::ValidateUpdateFileAndReadInternal(uint32_t& checksum, uint64_t& timestamp, BlobSnapshotStream& filestream)
 {
     QCC_DbgPrintf(("%s: updateFilePath=%s", __func__, updateFilePath.c_str()));
 
@@ -200,6 +366,11 @@ bool Manager::ValidateUpdateFileAndReadInternal(uint32_t& checksum, uint64_t& ti
         return false;
     }
 
+    // The snapshot holds what was last written to or read from the file
+    if (ReadBlobSnapshot(updateBlobSnapshot, checksum, timestamp, filestream)) {
+        return true;
+    }
+
     std::ifstream stream(updateFilePath.c_str());
 
     if (!stream.is_open()) {
@@ -210,8 +381,8 @@ bool Manager::ValidateUpdateFileAndReadInternal(uint32_t& checksum, uint64_t& ti
     stream >> timestamp;
 
     uint64_t currenttime = GetTimestampInMs();
-    QCC_DbgPrintf(("%s: timestamp=%llu", __func__, timestamp));
-    QCC_DbgPrintf(("%s: Updated %llu ticks ago", __func__, (currenttime - timestamp)));
+    QCC_DbgPrintf(("%s: timestamp=%llu", __func__, static_cast<unsigned long long>(timestamp)));
+    QCC_DbgPrintf(("%s: Updated %llu ticks ago", __func__, static_cast<unsigned long long>(currenttime - timestamp)));
 
     stream >> checksum;
 
@@ -222,13 +393,18 @@ bool Manager::ValidateUpdateFileAndReadInternal(uint32_t& checksum, uint64_t& ti
     stream >> &rest;
     std::string data = rest.str();
     data.erase(std::remove(data.begin(), ++data.begin(), '\n'), ++data.begin());
-    filestream.str(data);
 
     // check the adler checksum
     uint32_t adler = GetChecksum(data);
 
     stream.close();
-    return adler == checksum;
+
+    if (adler != checksum) {
+        return false;
+    }
+
+    SetBlobSnapshot(updateBlobSnapshot, data, checksum, timestamp, false);
+    return ReadBlobSnapshot(updateBlobSnapshot, checksum, timestamp, filestream);
 }
 
 LSFString Manager::GenerateUniqueID(const LSFString& prefix) const
@@ -245,12 +421,132 @@ void Manager::ScheduleFileWrite(bool blobUpdate, bool initState)
     updated = true;
     blobUpdateCycle = blobUpdate;
     initialState = initState;
-    controllerService.ScheduleFileReadWrite(this);
+    controllerService.ScheduleFileReadWrite(this, true);
+}
+
+void Manager::WriteCompleted(uint64_t writeRequestedTimestamp, uint32_t numRequests)
+{
+    uint64_t currentTime = GetTimestampInMs();
+    uint64_t latency = currentTime - writeRequestedTimestamp;
+    QCC_DbgPrintf(("%s: %s written %llu ms after the first change, %u requests coalesced", __func__, filePath.c_str(), static_cast<unsigned long long>(latency), numRequests));
+
+    writeStatsMutex.Lock();
+    lastPersistedTimestamp = currentTime;
+    lastWriteLatency = latency;
+    if (latency > maxWriteLatency) {
+        maxWriteLatency = latency;
+    }
+    numWriteCycles++;
+    numWriteRequests += numRequests;
+    writeStatsMutex.Unlock();
+
+    if (writeLatencyStatistic) {
+        writeLatencyStatistic->Record(static_cast<uint32_t>(latency));
+    }
+}
+
+void Manager::GetWriteLatencyInfo(uint64_t& lastPersisted, uint64_t& lastLatency, uint64_t& maxLatency, uint32_t& numWrites, uint32_t& numRequests)
+{
+    writeStatsMutex.Lock();
+    lastPersisted = lastPersistedTimestamp;
+    lastLatency = lastWriteLatency;
+    maxLatency = maxWriteLatency;
+    numWrites = numWriteCycles;
+    numRequests = numWriteRequests;
+    writeStatsMutex.Unlock();
+}
+
+void Manager::SendConfigurationSignals(const char* ifaceName, const char* entities, const ConfigurationChanges& changes)
+{
+    QCC_DbgTrace(("%s: %s created=%u updated=%u deleted=%u", __func__, entities, changes.created.size(), changes.updated.size(), changes.deleted.size()));
+    std::string prefix(entities);
+
+    if (!changes.deleted.empty()) {
+        controllerService.SendSignal(ifaceName, (prefix + "Deleted").c_str(), changes.deleted);
+    }
+    if (!changes.created.empty()) {
+        controllerService.SendSignal(ifaceName, (prefix + "Created").c_str(), changes.created);
+    }
+    if (!changes.updated.empty()) {
+        controllerService.SendSignal(ifaceName, (prefix + "Updated").c_str(), changes.updated);
+    }
+}
+
+void Manager::SetBlobSnapshot(BlobSnapshot*& snapshot, const std::string& blob, uint32_t checksum, uint64_t timestamp, bool mainStore)
+{
+    QCC_DbgTrace(("%s", __func__));
+    blobSnapshotMutex.Lock();
+    BlobSnapshot* oldSnapshot = snapshot;
+    snapshot = new BlobSnapshot(blob, checksum, timestamp, ++blobSnapshotVersion);
+    blobSnapshotMutex.Unlock();
+
+    if (blobBytesStatistic && mainStore) {
+        blobBytesStatistic->Set(static_cast<int64_t>(blob.size()));
+    }
+
+    if (oldSnapshot) {
+        oldSnapshot->Release();
+    }
+}
+
+Manager::BlobSnapshot* Manager::GetBlobSnapshot(BlobSnapshot* const& snapshot)
+{
+    blobSnapshotMutex.Lock();
+    BlobSnapshot* ret = snapshot;
+    if (ret) {
+        ret->AddRef();
+    }
+    blobSnapshotMutex.Unlock();
+    return ret;
+}
+
+bool Manager::SendBlobSnapshot(Message& message, BlobSnapshot* const& snapshot)
+{
+    QCC_DbgTrace(("%s", __func__));
+
+    if (updated) {
+        // A write is pending. Serve the request once the change has been written
+        return false;
+    }
+
+    const MsgArg* arg = message->GetArg(0);
+    if (!arg) {
+        return false;
+    }
+
+    BlobSnapshot* current = GetBlobSnapshot(snapshot);
+    if (!current) {
+        return false;
+    }
+
+    QCC_DbgPrintf(("%s: Serving snapshot version %u", __func__, current->version));
+    uint64_t currentTime = GetTimestampInMs();
+    controllerService.SendGetBlobReply(message, static_cast<LSFBlobType>(arg->v_uint32), current->blob, current->checksum, (currentTime - current->timestamp));
+    current->Release();
+    return true;
+}
+
+bool Manager::ReadBlobSnapshot(BlobSnapshot* const& snapshot, uint32_t& checksum, uint64_t& timestamp, BlobSnapshotStream& filestream)
+{
+    BlobSnapshot* current = GetBlobSnapshot(snapshot);
+    if (!current) {
+        return false;
+    }
+
+    checksum = current->checksum;
+    timestamp = current->timestamp;
+    // The stream keeps the reference
+    filestream.Attach(current);
+    return true;
 }
 
 void Manager::ScheduleFileRead(Message& message)
 {
     QCC_DbgTrace(("%s", __func__));
+    if (SendBlobSnapshot(message, blobSnapshot)) {
+        return;
+    }
+
     readMutex.Lock();
     readBlobMessages.push_back(message);
     read = true;
@@ -261,6 +557,10 @@ void Manager::ScheduleFileRead(Message& message)
 void Manager::ScheduleUpdateFileRead(Message& message)
 {
     QCC_DbgTrace(("%s", __func__));
+    if (SendBlobSnapshot(message, updateBlobSnapshot)) {
+        return;
+    }
+
     readMutex.Lock();
     readUpdateBlobMessages.push_back(message);
     read = true;
@@ -275,6 +575,19 @@ void Manager::TriggerUpdate(void)
     controllerService.ScheduleFileReadWrite(this);
 }
 
+void Manager::ScheduleDeferredReads(void)
+{
+    QCC_DbgTrace(("%s", __func__));
+    readMutex.Lock();
+    bool readPending = read;
+    readMutex.Unlock();
+
+    if (readPending) {
+        // The store has just been written. Serve the queued reads from it in the next cycle
+        controllerService.ScheduleFileReadWrite(this);
+    }
+}
+
 void Manager::GetBlobInfoInternal(uint32_t& checksum, uint64_t& timestamp)
 {
     QCC_DbgTrace(("%s", __func__));
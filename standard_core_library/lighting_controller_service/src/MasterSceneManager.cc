@@ -89,6 +89,7 @@ LSFResponseCode MasterSceneManager::Reset(void)
          */
         masterScenes.clear();
         masterSceneUpdates.clear();
+        sceneUsers.Clear();
         blobLength = 0;
         ScheduleFileWrite();
         tempStatus = masterScenesLock.Unlock();
@@ -120,11 +121,8 @@ LSFResponseCode MasterSceneManager::IsDependentOnScene(LSFString& sceneID)
 
     QStatus status = masterScenesLock.Lock();
     if (ER_OK == status) {
-        for (MasterSceneMap::iterator it = masterScenes.begin(); it != masterScenes.end(); ++it) {
-            responseCode = it->second.second.IsDependentOnScene(sceneID);
-            if (LSF_OK != responseCode) {
-                break;
-            }
+        if (sceneUsers.IsUsed(sceneID)) {
+            responseCode = LSF_ERR_DEPENDENCY;
         }
         status = masterScenesLock.Unlock();
         if (ER_OK != status) {
@@ -348,16 +346,16 @@ void MasterSceneManager::CreateMasterScene(Message& message)
         QStatus status = masterScenesLock.Lock();
         if (ER_OK == status) {
             if (masterScenes.size() < OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY) {
-                std::string newMasterSceneStr = GetString(name, masterSceneID, masterScene);
                 /*
                  * We have to add the masterSceneID length because we need to store
                  * the IDs of the updated master scenes to the updates file
                  */
-                size_t newlen = blobLength + newMasterSceneStr.length() + masterSceneID.length();
+                size_t newlen = blobLength + GetStringLength(name, masterSceneID, masterScene) + masterSceneID.length();
                 if (newlen < MAX_FILE_LEN) {
                     blobLength = newlen;
+                    sceneUsers.Add(masterSceneID, masterScene.scenes);
                     masterScenes[masterSceneID].first = name;
-                    masterScenes[masterSceneID].second = masterScene;
+                    masterScenes[masterSceneID].second.Swap(masterScene);
                     created = true;
                     ScheduleFileWrite();
                 } else {
@@ -427,12 +425,14 @@ void MasterSceneManager::UpdateMasterScene(Message& message)
             if (it != masterScenes.end()) {
                 size_t newlen = blobLength;
                 // sub len of old master scene, add len of new master scene
-                newlen -= GetString(it->second.first, masterSceneID, it->second.second).length();
-                newlen += GetString(it->second.first, masterSceneID, masterScene).length();
+                newlen -= GetStringLength(it->second.first, masterSceneID, it->second.second);
+                newlen += GetStringLength(it->second.first, masterSceneID, masterScene);
 
                 if (newlen < MAX_FILE_LEN) {
                     blobLength = newlen;
-                    masterScenes[masterSceneID].second = masterScene;
+                    sceneUsers.Remove(masterSceneID, it->second.second.scenes);
+                    sceneUsers.Add(masterSceneID, masterScene.scenes);
+                    masterScenes[masterSceneID].second.Swap(masterScene);
                     responseCode = LSF_OK;
                     if (masterSceneUpdates.find(masterSceneID) == masterSceneUpdates.end()) {
                         masterSceneUpdates.insert(masterSceneID);
@@ -492,8 +492,8 @@ void MasterSceneManager::DeleteMasterScene(Message& message)
     if (ER_OK == status) {
         MasterSceneMap::iterator it = masterScenes.find(uniqueId);
         if (it != masterScenes.end()) {
-            blobLength -= GetString(it->second.first, uniqueId, it->second.second).length();
-            blobLength -= ((GetString(it->second.first, uniqueId, it->second.second).length()) + masterSceneID.length());
+            blobLength -= (GetStringLength(it->second.first, uniqueId, it->second.second) + masterSceneID.length());
+            sceneUsers.Remove(masterSceneID, it->second.second.scenes);
             masterScenes.erase(it);
             if (masterSceneUpdates.find(masterSceneID) != masterSceneUpdates.end()) {
                 masterSceneUpdates.erase(masterSceneID);
@@ -616,7 +616,7 @@ void MasterSceneManager::ApplyMasterScene(ajn::Message& message)
 void MasterSceneManager::ReadSavedData()
 {
     QCC_DbgTrace(("%s", __func__));
-    std::istringstream stream;
+    BlobSnapshotStream stream;
     if (!ValidateFileAndRead(stream)) {
         /*
          * If there is no file present / CRC check failed on the file create a new
@@ -628,16 +628,26 @@ void MasterSceneManager::ReadSavedData()
         return;
     }
 
-    blobLength = stream.str().size();
     ReplaceMap(stream);
+    blobLength = GetBlobLength(masterScenes);
+    RebuildDependencyIndex();
 
-    std::istringstream updateStream;
+    BlobSnapshotStream updateStream;
     if (ValidateUpdateFileAndRead(updateStream)) {
         ReplaceUpdatesList(updateStream);
     }
 }
 
-void MasterSceneManager::ReplaceMap(std::istringstream& stream)
+void MasterSceneManager::RebuildDependencyIndex(void)
+{
+    QCC_DbgTrace(("%s", __func__));
+    sceneUsers.Clear();
+    for (MasterSceneMap::const_iterator it = masterScenes.begin(); it != masterScenes.end(); ++it) {
+        sceneUsers.Add(it->first, it->second.second.scenes);
+    }
+}
+
+void MasterSceneManager::ReplaceMap(std::istream& stream)
 {
     QCC_DbgTrace(("%s", __func__));
     bool firstIteration = true;
@@ -660,7 +670,6 @@ void MasterSceneManager::ReplaceMap(std::istringstream& stream)
                     masterScenes.clear();
                     firstIteration = false;
                 }
-                blobLength += id.length();
                 LSFStringList subScenes;
 
                 do {
@@ -670,17 +679,16 @@ void MasterSceneManager::ReplaceMap(std::istringstream& stream)
                         std::string scene = ParseString(stream);
                         subScenes.push_back(scene);
                     }
-                } while (token != "EndMasterScene");
+                } while ((token != "EndMasterScene") && !stream.eof());
 
-                MasterScene msc(subScenes);
-                std::pair<LSFString, MasterScene> thePair(name, msc);
-                masterScenes[id] = thePair;
+                masterScenes[id].first = name;
+                masterScenes[id].second.scenes.swap(subScenes);
             }
         }
     }
 }
 
-void MasterSceneManager::ReplaceUpdatesList(std::istringstream& stream)
+void MasterSceneManager::ReplaceUpdatesList(std::istream& stream)
 {
     QCC_DbgTrace(("%s", __func__));
     bool firstIteration = true;
@@ -717,6 +725,21 @@ std::string MasterSceneManager::GetString(const std::string& name, const std::st
     return stream.str();
 }
 
+size_t MasterSceneManager::GetStringLength(const std::string& name, const std::string& id, const MasterScene& msc)
+{
+    return (sizeof("MasterScene  \"\" EndMasterScene\n") - 1) + id.length() + name.length()
+           + GetIDListLength(msc.scenes, sizeof(" Scene ") - 1);
+}
+
+size_t MasterSceneManager::GetBlobLength(const MasterSceneMap& items)
+{
+    size_t length = 0;
+    for (MasterSceneMap::const_iterator it = items.begin(); it != items.end(); ++it) {
+        length += GetStringLength(it->second.first, it->first, it->second.second) + it->first.length();
+    }
+    return length;
+}
+
 std::string MasterSceneManager::GetString(const MasterSceneMap& items)
 {
     QCC_DbgTrace(("%s", __func__));
@@ -817,14 +840,16 @@ bool MasterSceneManager::GetString(std::string& output, std::string& updates, ui
     return ret;
 }
 
-void MasterSceneManager::HandleReceivedBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp)
+void MasterSceneManager::HandleReceivedBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp)
 {
     QCC_DbgPrintf(("%s", __func__));
     uint64_t currentTimestamp = GetTimestampInMs();
     masterScenesLock.Lock();
     if (((timeStamp == 0) || ((currentTimestamp - timeStamp) > timestamp)) && (checkSum != checksum)) {
-        std::istringstream stream(blob.c_str());
+        BlobInputStream stream(blob, length);
         ReplaceMap(stream);
+        blobLength = GetBlobLength(masterScenes);
+        RebuildDependencyIndex();
         timeStamp = currentTimestamp;
         checkSum = checksum;
         ScheduleFileWrite(true);
@@ -832,13 +857,13 @@ void MasterSceneManager::HandleReceivedBlob(const std::string& blob, uint32_t ch
     masterScenesLock.Unlock();
 }
 
-void MasterSceneManager::HandleReceivedUpdateBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp)
+void MasterSceneManager::HandleReceivedUpdateBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp)
 {
     QCC_DbgPrintf(("%s", __func__));
     uint64_t currentTimestamp = GetTimestampInMs();
     masterScenesLock.Lock();
     if (((updatesTimeStamp == 0) || ((currentTimestamp - updatesTimeStamp) > timestamp)) && (updatesCheckSum != checksum)) {
-        std::istringstream stream(blob.c_str());
+        BlobInputStream stream(blob, length);
         ReplaceUpdatesList(stream);
         updatesTimeStamp = currentTimestamp;
         updatesCheckSum = checksum;
@@ -883,7 +908,7 @@ void MasterSceneManager::ReadWriteFile()
     std::list<ajn::Message> tempUpdateMessageList;
 
     readMutex.Lock();
-    if (read) {
+    if (read && !status) {
         tempMessageList = readBlobMessages;
         readBlobMessages.clear();
         tempUpdateMessageList = readUpdateBlobMessages;
@@ -892,8 +917,10 @@ void MasterSceneManager::ReadWriteFile()
     }
     readMutex.Unlock();
 
+    ScheduleDeferredReads();
+
     if ((tempMessageList.size() || tempUpdateMessageList.size() || sendUpdate) && !status) {
-        std::istringstream stream;
+        BlobSnapshotStream stream;
         bool fileStatus = ValidateFileAndReadInternal(checksum, timestamp, stream);
         if (fileStatus) {
             output = stream.str();
@@ -906,7 +933,7 @@ void MasterSceneManager::ReadWriteFile()
             QCC_LogError(ER_FAIL, ("%s: MasterScene persistent store corrupted", __func__));
         }
 
-        std::istringstream updateStream;
+        BlobSnapshotStream updateStream;
         bool updateStatus = ValidateUpdateFileAndReadInternal(updateChecksum, updateTimestamp, updateStream);
         if (updateStatus) {
             updates = updateStream.str();
@@ -928,6 +955,57 @@ void MasterSceneManager::ReadWriteFile()
     }
 }
 
+void MasterSceneManager::ExportConfiguration(std::ostream& stream)
+{
+    QCC_DbgTrace(("%s", __func__));
+    for (MasterSceneMap::const_iterator it = masterScenes.begin(); it != masterScenes.end(); ++it) {
+        stream << GetString(it->second.first, it->first, it->second.second);
+    }
+}
+
+LSFResponseCode MasterSceneManager::StageConfiguration(std::istream& stream, MasterSceneMap& staged, size_t& stagedBlobLength)
+{
+    QCC_DbgTrace(("%s", __func__));
+    /*
+     * ReplaceMap parses into the live map, so swap in an empty one and
+     * put the live master scenes back once the section has been read
+     */
+    MasterSceneMap live;
+    live.swap(masterScenes);
+    ReplaceMap(stream);
+    staged.swap(masterScenes);
+    masterScenes.swap(live);
+
+    if (staged.size() > OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY) {
+        QCC_LogError(ER_FAIL, ("%s: %d master scenes exceed the supported number", __func__, staged.size()));
+        return LSF_ERR_NO_SLOT;
+    }
+
+    stagedBlobLength = GetBlobLength(staged);
+    if (stagedBlobLength >= MAX_FILE_LEN) {
+        QCC_LogError(ER_FAIL, ("%s: master scenes do not fit in the persistent store", __func__));
+        return LSF_ERR_RESOURCES;
+    }
+
+    return LSF_OK;
+}
+
+void MasterSceneManager::CommitConfiguration(MasterSceneMap& staged, size_t stagedBlobLength, ConfigurationChanges& changes)
+{
+    QCC_DbgTrace(("%s", __func__));
+    GetConfigurationChanges(masterScenes, staged, changes);
+    masterScenes.swap(staged);
+    blobLength = stagedBlobLength;
+    RebuildDependencyIndex();
+
+    for (LSFStringList::const_iterator it = changes.deleted.begin(); it != changes.deleted.end(); ++it) {
+        masterSceneUpdates.erase(*it);
+    }
+    masterSceneUpdates.insert(changes.updated.begin(), changes.updated.end());
+
+    ScheduleFileWrite();
+}
+
 uint32_t MasterSceneManager::GetControllerServiceMasterSceneInterfaceVersion(void)
 {
     QCC_DbgPrintf(("%s: controllerMasterSceneInterfaceVersion=%d", __func__, ControllerServiceMasterSceneInterfaceVersion));
@@ -0,0 +1,270 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <qcc/Debug.h>
+
+#ifdef LSF_BINDINGS
+#include <lsf/controllerservice/MethodCallExecutor.h>
+#else
+#include <MethodCallExecutor.h>
+#endif
+
+#include <LSFTypes.h>
+
+using namespace lsf;
+using namespace ajn;
+
+#ifdef LSF_BINDINGS
+using namespace controllerservice;
+#endif
+
+#define QCC_MODULE "METHOD_CALL_EXECUTOR"
+
+MethodCallExecutor::MethodCallExecutor()
+    : running(false),
+    numSerialWorkers(0),
+    maxSerialWorkers((OEM_CS_NUM_METHOD_CALL_WORKERS > 1) ? (OEM_CS_NUM_METHOD_CALL_WORKERS - 1) : 1),
+    numExecuted(0),
+    numRejected(0),
+    maxLatency(0)
+{
+    QCC_DbgTrace(("%s", __func__));
+    for (size_t i = 0; i < OEM_CS_NUM_METHOD_CALL_WORKERS; i++) {
+        workers[i] = NULL;
+    }
+    for (size_t i = 0; i < METHOD_CALL_LATENCY_BUCKETS; i++) {
+        latencyBuckets[i] = 0;
+    }
+}
+
+MethodCallExecutor::~MethodCallExecutor()
+{
+    QCC_DbgTrace(("%s", __func__));
+    /*
+     * Stop may not have run, e.g. after a failed start, and the workers
+     * would then never return from the semaphore
+     */
+    StopWorkers();
+    Join();
+}
+
+QStatus MethodCallExecutor::Start(void)
+{
+    QCC_DbgTrace(("%s", __func__));
+    QStatus status = ER_FAIL;
+
+    running = true;
+    for (size_t i = 0; i < OEM_CS_NUM_METHOD_CALL_WORKERS; i++) {
+        workers[i] = new Worker(*this);
+        if (workers[i]->Start() == ER_OK) {
+            status = ER_OK;
+        } else {
+            QCC_LogError(ER_FAIL, ("%s: Failed to start method call worker %d", __func__, i));
+            delete workers[i];
+            workers[i] = NULL;
+        }
+    }
+
+    if (status != ER_OK) {
+        running = false;
+    }
+    return status;
+}
+
+void MethodCallExecutor::Stop(std::list<Message>& droppedCalls)
+{
+    QCC_DbgTrace(("%s", __func__));
+    /*
+     * Submit checks running under the queue lock, so nothing is queued after
+     * the queue has been emptied here
+     */
+    queueLock.Lock();
+    running = false;
+    for (std::list<QueuedMethodCall>::iterator it = queue.begin(); it != queue.end(); ++it) {
+        droppedCalls.push_back(it->msg);
+    }
+    queue.clear();
+    queueLock.Unlock();
+
+    StopWorkers();
+}
+
+void MethodCallExecutor::StopWorkers(void)
+{
+    QCC_DbgTrace(("%s", __func__));
+    queueLock.Lock();
+    running = false;
+    queueLock.Unlock();
+
+    for (size_t i = 0; i < OEM_CS_NUM_METHOD_CALL_WORKERS; i++) {
+        semaphore.Post();
+    }
+}
+
+void MethodCallExecutor::Join(void)
+{
+    QCC_DbgTrace(("%s", __func__));
+    for (size_t i = 0; i < OEM_CS_NUM_METHOD_CALL_WORKERS; i++) {
+        if (workers[i]) {
+            workers[i]->Join();
+            delete workers[i];
+            workers[i] = NULL;
+        }
+    }
+
+    queueLock.Lock();
+    queue.clear();
+    busyKeys.clear();
+    numSerialWorkers = 0;
+    queueLock.Unlock();
+}
+
+bool MethodCallExecutor::Submit(MethodCallHandler* handler, const Message& msg, const void* serialKey)
+{
+    bool queued = false;
+
+    queueLock.Lock();
+    if (running && (queue.size() < OEM_CS_MAX_METHOD_CALL_QUEUE_SIZE)) {
+        queue.push_back(QueuedMethodCall(handler, msg, serialKey, GetTimestampInMs()));
+        queued = true;
+    }
+    queueLock.Unlock();
+
+    if (queued) {
+        semaphore.Post();
+    } else {
+        statsLock.Lock();
+        numRejected++;
+        statsLock.Unlock();
+        QCC_DbgPrintf(("%s: Rejecting method call %s", __func__, msg->GetMemberName()));
+    }
+
+    return queued;
+}
+
+void MethodCallExecutor::ExecuteMethodCalls(void)
+{
+    QCC_DbgTrace(("%s", __func__));
+    while (running) {
+        semaphore.Wait();
+
+        if (!running) {
+            break;
+        }
+
+        std::list<QueuedMethodCall> taken;
+        bool morePending = false;
+
+        queueLock.Lock();
+        /*
+         * The first call found for a key that is not busy is also the oldest
+         * queued call for that key, so calls for a key run in arrival order
+         */
+        for (std::list<QueuedMethodCall>::iterator it = queue.begin(); it != queue.end(); ++it) {
+            if (it->serialKey) {
+                if ((numSerialWorkers >= maxSerialWorkers) || (busyKeys.find(it->serialKey) != busyKeys.end())) {
+                    continue;
+                }
+                busyKeys.insert(it->serialKey);
+                numSerialWorkers++;
+            }
+            taken.splice(taken.begin(), queue, it);
+            break;
+        }
+        morePending = !queue.empty();
+        queueLock.Unlock();
+
+        if (taken.empty()) {
+            continue;
+        }
+
+        // Another call may be runnable now, do not wait for the next Submit
+        if (morePending) {
+            semaphore.Post();
+        }
+
+        QueuedMethodCall& call = taken.front();
+        LSF_TRACE_STAGE(LSF_TRACE_ID(call.msg), "ExecutorQueue", call.traceTimestamp);
+        {
+            LSF_TRACE_SCOPE(LSF_TRACE_ID(call.msg), "Handler");
+            call.handler->Handle(call.msg);
+        }
+
+        RecordLatency(GetTimestampInMs() - call.submittedTimestamp);
+
+        if (call.serialKey) {
+            queueLock.Lock();
+            busyKeys.erase(call.serialKey);
+            numSerialWorkers--;
+            morePending = !queue.empty();
+            queueLock.Unlock();
+
+            // Calls for this key may have been skipped while it was busy
+            if (morePending) {
+                semaphore.Post();
+            }
+        }
+    }
+}
+
+void MethodCallExecutor::RecordLatency(uint64_t latency)
+{
+    size_t bucket = 0;
+    while ((bucket < (METHOD_CALL_LATENCY_BUCKETS - 1)) && (latency >= (static_cast<uint64_t>(1) << bucket))) {
+        bucket++;
+    }
+
+    statsLock.Lock();
+    latencyBuckets[bucket]++;
+    numExecuted++;
+    if (latency > maxLatency) {
+        maxLatency = static_cast<uint32_t>(latency);
+    }
+    statsLock.Unlock();
+}
+
+void MethodCallExecutor::GetLatencyInfo(uint64_t& numCalls, uint64_t& numRejectedCalls, uint32_t& p50, uint32_t& p99, uint32_t& maxLatencyMs)
+{
+    statsLock.Lock();
+    numCalls = numExecuted;
+    numRejectedCalls = numRejected;
+    maxLatencyMs = maxLatency;
+    p50 = 0;
+    p99 = 0;
+
+    uint64_t seen = 0;
+    bool p50Found = false;
+    for (size_t i = 0; (i < METHOD_CALL_LATENCY_BUCKETS) && numExecuted; i++) {
+        seen += latencyBuckets[i];
+        uint32_t upperBound = static_cast<uint32_t>(1) << i;
+        if (!p50Found && ((seen * 100) >= (numExecuted * 50))) {
+            p50 = upperBound;
+            p50Found = true;
+        }
+        if ((seen * 100) >= (numExecuted * 99)) {
+            p99 = upperBound;
+            break;
+        }
+    }
+    statsLock.Unlock();
+
+    if (p50 > maxLatencyMs) {
+        p50 = maxLatencyMs;
+    }
+    if (p99 > maxLatencyMs) {
+        p99 = maxLatencyMs;
+    }
+}
@@ -19,9 +19,11 @@
 #ifdef LSF_BINDINGS
 #include <lsf/controllerservice/PersistenceThread.h>
 #include <lsf/controllerservice/ControllerService.h>
+#include <lsf/controllerservice/Manager.h>
 #else
 #include <PersistenceThread.h>
 #include <ControllerService.h>
+#include <Manager.h>
 #endif
 
 using namespace lsf;
@@ -37,6 +39,9 @@ PersistenceThread::PersistenceThread(ControllerService& service)
     running(true)
 {
     QCC_DbgTrace(("%s", __func__));
+    for (size_t i = 0; i < OEM_CS_NUM_PERSISTENCE_WORKERS; i++) {
+        workers[i] = NULL;
+    }
 }
 
 PersistenceThread::~PersistenceThread()
@@ -46,37 +51,165 @@ PersistenceThread::~PersistenceThread()
 
 
 void PersistenceThread::Run()
+{
+    QCC_DbgTrace(("%s", __func__));
+
+    // This thread is the first worker
+    for (size_t i = 1; i < OEM_CS_NUM_PERSISTENCE_WORKERS; i++) {
+        workers[i] = new Worker(*this);
+        if (workers[i]->Start() != ER_OK) {
+            QCC_LogError(ER_FAIL, ("%s: Failed to start persistence worker %d", __func__, i));
+            delete workers[i];
+            workers[i] = NULL;
+        }
+    }
+
+    ServiceDirtyManagers();
+
+    for (size_t i = 1; i < OEM_CS_NUM_PERSISTENCE_WORKERS; i++) {
+        if (workers[i]) {
+            workers[i]->Join();
+            delete workers[i];
+            workers[i] = NULL;
+        }
+    }
+
+    // Do not lose writes that were still inside the coalescing window
+    dirtyManagersLock.Lock();
+    std::list<DirtyManager> remaining = dirtyManagers;
+    dirtyManagers.clear();
+    dirtyManagersLock.Unlock();
+
+    for (std::list<DirtyManager>::iterator it = remaining.begin(); it != remaining.end(); ++it) {
+        if (it->writeRequestedTimestamp) {
+            it->manager->ReadWriteFile();
+            it->manager->WriteCompleted(it->writeRequestedTimestamp, it->numWriteRequests);
+        }
+    }
+    QCC_DbgPrintf(("%s: Exited", __func__));
+}
+
+void PersistenceThread::ServiceDirtyManagers(void)
 {
     QCC_DbgTrace(("%s", __func__));
     while (running) {
+        uint64_t nextDue = 0;
+        bool idle = true;
+
+        dirtyManagersLock.Lock();
+        for (std::list<DirtyManager>::iterator it = dirtyManagers.begin(); it != dirtyManagers.end(); ++it) {
+            if ((busyManagers.find(it->manager) == busyManagers.end()) && (idle || (it->dueTimestamp < nextDue))) {
+                nextDue = it->dueTimestamp;
+                idle = false;
+            }
+        }
+        dirtyManagersLock.Unlock();
+
         // wait!
-        semaphore.Wait();
-
-        if (running) {
-            service.GetLampGroupManager().ReadWriteFile();
-            service.GetMasterSceneManager().ReadWriteFile();
-            service.GetPresetManager().ReadWriteFile();
-            service.GetSceneElementManager().ReadWriteFile();
-            service.GetSceneManager().ReadWriteFile();
-            service.GetTransitionEffectManager().ReadWriteFile();
-            service.GetPulseEffectManager().ReadWriteFile();
+        if (idle) {
+            semaphore.Wait();
+        } else {
+            uint64_t currentTime = GetTimestampInMs();
+            if (nextDue > currentTime) {
+                semaphore.TimedWait(static_cast<uint32_t>(nextDue - currentTime));
+            }
+        }
+
+        if (!running) {
+            break;
+        }
+
+        DirtyManager dirty;
+        dirty.manager = NULL;
+        uint64_t currentTime = GetTimestampInMs();
+
+        dirtyManagersLock.Lock();
+        for (std::list<DirtyManager>::iterator it = dirtyManagers.begin(); it != dirtyManagers.end(); ++it) {
+            if ((it->dueTimestamp <= currentTime) && (busyManagers.find(it->manager) == busyManagers.end())) {
+                dirty = *it;
+                dirtyManagers.erase(it);
+                busyManagers.insert(dirty.manager);
+                break;
+            }
+        }
+        dirtyManagersLock.Unlock();
+
+        if (dirty.manager) {
+            dirty.manager->ReadWriteFile();
+
+            if (dirty.writeRequestedTimestamp) {
+                dirty.manager->WriteCompleted(dirty.writeRequestedTimestamp, dirty.numWriteRequests);
+            }
+
+            dirtyManagersLock.Lock();
+            busyManagers.erase(dirty.manager);
+            /*
+             * If the manager was marked dirty again while it was being serviced, the
+             * wakeup for it may have been consumed by a worker that found it busy
+             */
+            bool pending = !dirtyManagers.empty();
+            dirtyManagersLock.Unlock();
+
+            if (pending) {
+                semaphore.Post();
+            }
         }
     }
-    QCC_DbgPrintf(("%s: Exited", __func__));
 }
 
-void PersistenceThread::SignalReadWrite()
+void PersistenceThread::SignalReadWrite(Manager* manager, bool write)
 {
     QCC_DbgTrace(("%s", __func__));
+
+    uint64_t currentTime = GetTimestampInMs();
+    uint64_t dueTimestamp = write ? (currentTime + OEM_CS_PERSISTENCE_WRITE_COALESCE_MS) : currentTime;
+
+    bool wake = false;
+
+    dirtyManagersLock.Lock();
+    std::list<DirtyManager>::iterator it = dirtyManagers.begin();
+    while ((it != dirtyManagers.end()) && (it->manager != manager)) {
+        ++it;
+    }
+    if (it == dirtyManagers.end()) {
+        DirtyManager dirty;
+        dirty.manager = manager;
+        dirty.dueTimestamp = dueTimestamp;
+        dirty.writeRequestedTimestamp = write ? currentTime : 0;
+        dirty.numWriteRequests = write ? 1 : 0;
+        dirtyManagers.push_back(dirty);
+        wake = true;
+    } else {
+        /*
+         * The window starts with the first write request and is not extended by
+         * later ones, so a change is never held back for longer than the window
+         */
+        if (dueTimestamp < it->dueTimestamp) {
+            it->dueTimestamp = dueTimestamp;
+            wake = true;
+        }
+        if (write) {
+            if (!it->writeRequestedTimestamp) {
+                it->writeRequestedTimestamp = currentTime;
+            }
+            it->numWriteRequests++;
+        }
+    }
+    dirtyManagersLock.Unlock();
+
     // signal
-    semaphore.Post();
+    if (wake) {
+        semaphore.Post();
+    }
 }
 
 void PersistenceThread::Stop()
 {
     QCC_DbgTrace(("%s", __func__));
     running = false;
-    SignalReadWrite();
+    for (size_t i = 0; i < OEM_CS_NUM_PERSISTENCE_WORKERS; i++) {
+        semaphore.Post();
+    }
 }
 
 void PersistenceThread::Join()
@@ -84,4 +217,3 @@ void PersistenceThread::Join()
     QCC_DbgTrace(("%s", __func__));
     Thread::Join();
 }
-
@@ -128,7 +128,7 @@ LSFResponseCode PresetManager::ResetDefaultState(void)
     PresetMap::iterator it = presets.find(defaultLampStateID);
     if (it != presets.end()) {
         QCC_DbgPrintf(("%s: Removing the default lamp state entry", __func__));
-        blobLength -= GetString(it->second.first, defaultLampStateID, it->second.second).length();
+        blobLength -= GetStringLength(it->second.first, defaultLampStateID, it->second.second);
         presets.erase(it);
         erased = true;
     }
@@ -361,6 +361,110 @@ void PresetManager::CreatePreset(Message& msg)
     }
 }
 
+void PresetManager::CreatePresets(Message& msg)
+{
+    QCC_DbgPrintf(("%s: %s", __func__, msg->ToString().c_str()));
+
+    LSFResponseCode responseCode = LSF_OK;
+    LSFStringList presetIDs;
+
+    if (!controllerService.UpdatesAllowed()) {
+        controllerService.SendMethodReplyWithResponseCodeAndListOfIDs(msg, LSF_ERR_BUSY, presetIDs);
+        return;
+    }
+
+    const ajn::MsgArg* inputArgs;
+    size_t numInputArgs;
+    msg->GetArgs(numInputArgs, inputArgs);
+
+    if (controllerService.CheckNumArgsInMessage(numInputArgs, 2)  != LSF_OK) {
+        return;
+    }
+
+    MsgArg* presetArgs;
+    size_t numPresets;
+    inputArgs[0].Get("a(a{sv}s)", &numPresets, &presetArgs);
+    LSFString language = static_cast<LSFString>(inputArgs[1].v_string.str);
+
+    /*
+     * Validate every preset before touching the map so that the request
+     * is applied completely or not at all
+     */
+    std::list<std::pair<LSFString, LampState> > newPresets;
+
+    if (0 != strcmp("en", language.c_str())) {
+        QCC_LogError(ER_FAIL, ("%s: Language %s not supported", __func__, language.c_str()));
+        responseCode = LSF_ERR_INVALID_ARGS;
+    } else if (numPresets == 0) {
+        QCC_LogError(ER_FAIL, ("%s: No presets", __func__));
+        responseCode = LSF_ERR_INVALID_ARGS;
+    }
+
+    for (size_t i = 0; (i < numPresets) && (LSF_OK == responseCode); i++) {
+        const MsgArg* members = presetArgs[i].v_struct.members;
+        LSFString name = static_cast<LSFString>(members[1].v_string.str);
+
+        newPresets.push_back(std::make_pair(name, LampState(members[0])));
+
+        if (name.empty()) {
+            QCC_LogError(ER_FAIL, ("%s: preset name is empty", __func__));
+            responseCode = LSF_ERR_EMPTY_NAME;
+        } else if (newPresets.back().second.nullState) {
+            QCC_LogError(ER_FAIL, ("%s: Cannot save NULL state as a Preset", __func__));
+            responseCode = LSF_ERR_INVALID_ARGS;
+        } else if (name.length() > LSF_MAX_NAME_LENGTH) {
+            QCC_LogError(ER_FAIL, ("%s: name length exceeds %d", __func__, LSF_MAX_NAME_LENGTH));
+            responseCode = LSF_ERR_INVALID_ARGS;
+        } else {
+            presetIDs.push_back(GenerateUniqueID("PRESET"));
+        }
+    }
+
+    if (LSF_OK == responseCode) {
+        QStatus status = presetsLock.Lock();
+        if (ER_OK == status) {
+            if ((presets.size() + newPresets.size()) <= OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY) {
+                size_t newlen = blobLength;
+                LSFStringList::const_iterator idIt = presetIDs.begin();
+                for (std::list<std::pair<LSFString, LampState> >::const_iterator it = newPresets.begin(); it != newPresets.end(); ++it, ++idIt) {
+                    newlen += GetStringLength(it->first, *idIt, it->second) + idIt->length();
+                }
+
+                if (newlen < MAX_FILE_LEN) {
+                    blobLength = newlen;
+                    idIt = presetIDs.begin();
+                    for (std::list<std::pair<LSFString, LampState> >::const_iterator it = newPresets.begin(); it != newPresets.end(); ++it, ++idIt) {
+                        presets[*idIt] = *it;
+                    }
+                    ScheduleFileWrite();
+                } else {
+                    responseCode = LSF_ERR_RESOURCES;
+                }
+            } else {
+                QCC_LogError(ER_FAIL, ("%s: No slot for %u new Presets", __func__, newPresets.size()));
+                responseCode = LSF_ERR_NO_SLOT;
+            }
+            status = presetsLock.Unlock();
+            if (ER_OK != status) {
+                QCC_LogError(status, ("%s: presetsLock.Unlock() failed", __func__));
+            }
+        } else {
+            responseCode = LSF_ERR_BUSY;
+            QCC_LogError(status, ("%s: presetsLock.Lock() failed", __func__));
+        }
+    }
+
+    if (LSF_OK != responseCode) {
+        presetIDs.clear();
+    }
+
+    controllerService.SendMethodReplyWithResponseCodeAndListOfIDs(msg, responseCode, presetIDs);
+
+    if (LSF_OK == responseCode) {
+        controllerService.SendSignal(ControllerServicePresetInterfaceName, "PresetsCreated", presetIDs);
+    }
+}
+
 void PresetManager::UpdatePreset(Message& msg)
 {
     QCC_DbgPrintf(("%s: %s", __func__, msg->ToString().c_str()));
@@ -398,8 +502,8 @@ void PresetManager::UpdatePreset(Message& msg)
             if (it != presets.end()) {
                 size_t newlen = blobLength;
                 // sub len of old preset, add len of new preset
-                newlen -= GetString(it->second.first, presetID, it->second.second).length();
-                newlen += GetString(it->second.first, presetID, preset).length();
+                newlen -= GetStringLength(it->second.first, presetID, it->second.second);
+                newlen += GetStringLength(it->second.first, presetID, preset);
 
                 if (newlen < MAX_FILE_LEN) {
                     blobLength = newlen;
@@ -437,6 +541,116 @@ void PresetManager::UpdatePreset(Message& msg)
     }
 }
 
+void PresetManager::UpdatePresets(Message& msg)
+{
+    QCC_DbgPrintf(("%s: %s", __func__, msg->ToString().c_str()));
+
+    LSFResponseCode responseCode = LSF_OK;
+    LSFStringList presetIDs;
+
+    if (!controllerService.UpdatesAllowed()) {
+        controllerService.SendMethodReplyWithResponseCodeAndListOfIDs(msg, LSF_ERR_BUSY, presetIDs);
+        return;
+    }
+
+    size_t numArgs;
+    const MsgArg* args;
+    msg->GetArgs(numArgs, args);
+
+    if (controllerService.CheckNumArgsInMessage(numArgs, 1)  != LSF_OK) {
+        return;
+    }
+
+    MsgArg* presetArgs;
+    size_t numPresets;
+    args[0].Get("a(sa{sv})", &numPresets, &presetArgs);
+
+    std::list<LampState> newStates;
+    std::set<LSFString> uniqueIDs;
+
+    if (numPresets == 0) {
+        QCC_LogError(ER_FAIL, ("%s: No presets", __func__));
+        responseCode = LSF_ERR_INVALID_ARGS;
+    }
+
+    for (size_t i = 0; (i < numPresets) && (LSF_OK == responseCode); i++) {
+        const MsgArg* members = presetArgs[i].v_struct.members;
+        LSFString presetID = static_cast<LSFString>(members[0].v_string.str);
+
+        newStates.push_back(LampState(members[1]));
+
+        if (newStates.back().nullState) {
+            QCC_LogError(ER_FAIL, ("%s: Empty state", __func__));
+            responseCode = LSF_ERR_INVALID_ARGS;
+        } else if (!uniqueIDs.insert(presetID).second) {
+            QCC_LogError(ER_FAIL, ("%s: Preset %s listed more than once", __func__, presetID.c_str()));
+            responseCode = LSF_ERR_INVALID_ARGS;
+        } else {
+            presetIDs.push_back(presetID);
+        }
+    }
+
+    if (LSF_OK == responseCode) {
+        QStatus status = presetsLock.Lock();
+        if (ER_OK == status) {
+            size_t newlen = blobLength;
+            LSFStringList::const_iterator idIt = presetIDs.begin();
+            for (std::list<LampState>::const_iterator it = newStates.begin(); it != newStates.end(); ++it, ++idIt) {
+                PresetMap::iterator pit = presets.find(*idIt);
+                if (pit == presets.end()) {
+                    QCC_LogError(ER_FAIL, ("%s: Preset %s not found", __func__, idIt->c_str()));
+                    responseCode = LSF_ERR_NOT_FOUND;
+                    break;
+                }
+                // sub len of old preset, add len of new preset
+                newlen -= GetStringLength(pit->second.first, *idIt, pit->second.second);
+                newlen += GetStringLength(pit->second.first, *idIt, *it);
+            }
+
+            if (LSF_OK == responseCode) {
+                if (newlen < MAX_FILE_LEN) {
+                    blobLength = newlen;
+                    idIt = presetIDs.begin();
+                    for (std::list<LampState>::const_iterator it = newStates.begin(); it != newStates.end(); ++it, ++idIt) {
+                        presets[*idIt].second = *it;
+                        presetUpdates.insert(*idIt);
+                    }
+                    ScheduleFileWrite();
+                } else {
+                    responseCode = LSF_ERR_RESOURCES;
+                }
+            }
+            status = presetsLock.Unlock();
+            if (ER_OK != status) {
+                QCC_LogError(status, ("%s: presetsLock.Unlock() failed", __func__));
+            }
+        } else {
+            responseCode = LSF_ERR_BUSY;
+            QCC_LogError(status, ("%s: presetsLock.Lock() failed", __func__));
+        }
+    }
+
+    if (LSF_OK != responseCode) {
+        presetIDs.clear();
+    }
+
+    controllerService.SendMethodReplyWithResponseCodeAndListOfIDs(msg, responseCode, presetIDs);
+
+    if (LSF_OK == responseCode) {
+        controllerService.SendSignal(ControllerServicePresetInterfaceName, "PresetsUpdated", presetIDs);
+        /*
+         * Refresh the scene data once for the whole batch rather than once
+         * per dependent preset
+         */
+        for (LSFStringList::iterator it = presetIDs.begin(); it != presetIDs.end(); ++it) {
+            if (LSF_ERR_DEPENDENCY == sceneElementManagerPtr->IsDependentOnEffect(*it)) {
+                controllerService.GetSceneManager().RefreshSceneData();
+                break;
+            }
+        }
+    }
+}
+
 void PresetManager::DeletePreset(Message& msg)
 {
     QCC_DbgPrintf(("%s: %s", __func__, msg->ToString().c_str()));
@@ -469,7 +683,7 @@ void PresetManager::DeletePreset(Message& msg)
         if (ER_OK == status) {
             PresetMap::iterator it = presets.find(presetId);
             if (it != presets.end()) {
-                blobLength -= ((GetString(it->second.first, presetId, it->second.second).length()) + presetID.length());
+                blobLength -= (GetStringLength(it->second.first, presetId, it->second.second) + presetID.length());
                 presets.erase(it);
                 if (presetUpdates.find(presetID) != presetUpdates.end()) {
                     presetUpdates.erase(presetID);
@@ -498,6 +712,76 @@ void PresetManager::DeletePreset(Message& msg)
     }
 }
 
+void PresetManager::DeletePresets(Message& msg)
+{
+    QCC_DbgPrintf(("%s: %s", __func__, msg->ToString().c_str()));
+    LSFResponseCode responseCode = LSF_OK;
+
+    size_t numArgs;
+    const MsgArg* args;
+    msg->GetArgs(numArgs, args);
+
+    if (controllerService.CheckNumArgsInMessage(numArgs, 1)  != LSF_OK) {
+        return;
+    }
+
+    MsgArg* idsArray;
+    size_t idsSize;
+    args[0].Get("as", &idsSize, &idsArray);
+
+    LSFStringList presetIDs;
+    CreateUniqueList(presetIDs, idsArray, idsSize);
+
+    if (!controllerService.UpdatesAllowed()) {
+        controllerService.SendMethodReplyWithResponseCodeAndListOfIDs(msg, LSF_ERR_BUSY, presetIDs);
+        return;
+    }
+
+    if (presetIDs.empty()) {
+        QCC_LogError(ER_FAIL, ("%s: No presets", __func__));
+        responseCode = LSF_ERR_INVALID_ARGS;
+    }
+
+    for (LSFStringList::iterator it = presetIDs.begin(); (it != presetIDs.end()) && (LSF_OK == responseCode); ++it) {
+        responseCode = sceneElementManagerPtr->IsDependentOnEffect(*it);
+    }
+
+    if (LSF_OK == responseCode) {
+        QStatus status = presetsLock.Lock();
+        if (ER_OK == status) {
+            for (LSFStringList::const_iterator it = presetIDs.begin(); (it != presetIDs.end()) && (LSF_OK == responseCode); ++it) {
+                if (presets.find(*it) == presets.end()) {
+                    responseCode = LSF_ERR_NOT_FOUND;
+                }
+            }
+
+            if (LSF_OK == responseCode) {
+                for (LSFStringList::const_iterator it = presetIDs.begin(); it != presetIDs.end(); ++it) {
+                    PresetMap::iterator pit = presets.find(*it);
+                    blobLength -= (GetStringLength(pit->second.first, *it, pit->second.second) + it->length());
+                    presets.erase(pit);
+                    presetUpdates.erase(*it);
+                }
+                ScheduleFileWrite();
+            }
+
+            status = presetsLock.Unlock();
+            if (ER_OK != status) {
+                QCC_LogError(status, ("%s: presetsLock.Unlock() failed", __func__));
+            }
+        } else {
+            responseCode = LSF_ERR_BUSY;
+            QCC_LogError(status, ("%s: presetsLock.Lock() failed", __func__));
+        }
+    }
+
+    controllerService.SendMethodReplyWithResponseCodeAndListOfIDs(msg, responseCode, presetIDs);
+
+    if (LSF_OK == responseCode) {
+        controllerService.SendSignal(ControllerServicePresetInterfaceName, "PresetsDeleted", presetIDs);
+    }
+}
+
 void PresetManager::GetPreset(Message& msg)
 {
     QCC_DbgPrintf(("%s: %s", __func__, msg->ToString().c_str()));
@@ -607,8 +891,8 @@ LSFResponseCode PresetManager::SetDefaultLampStateInternal(LampState& preset)
         PresetMap::iterator it = presets.find(presetID);
         if (it != presets.end()) {
             size_t newlen = blobLength;
-            newlen -= GetString(it->second.first, presetID, it->second.second).length();
-            newlen += GetString(it->second.first, presetID, preset).length();
+            newlen -= GetStringLength(it->second.first, presetID, it->second.second);
+            newlen += GetStringLength(it->second.first, presetID, preset);
 
             if (newlen < MAX_FILE_LEN) {
                 blobLength = newlen;
@@ -618,7 +902,7 @@ LSFResponseCode PresetManager::SetDefaultLampStateInternal(LampState& preset)
                 responseCode = LSF_ERR_RESOURCES;
             }
         } else {
-            size_t newlen = blobLength + GetString(presetID, presetID, preset).length();
+            size_t newlen = blobLength + GetStringLength(presetID, presetID, preset);
 
             if (newlen < MAX_FILE_LEN) {
                 blobLength = newlen;
@@ -658,7 +942,7 @@ LSFResponseCode PresetManager::SetDefaultLampStateInternal(LampState& preset)
 void PresetManager::ReadSavedData(void)
 {
     QCC_DbgTrace(("%s", __func__));
-    std::istringstream stream;
+    BlobSnapshotStream stream;
     if (!ValidateFileAndRead(stream)) {
         /*
          * If there is no file present / CRC check failed on the file create a new
@@ -670,23 +954,24 @@ void PresetManager::ReadSavedData(void)
         return;
     }
 
-    blobLength = stream.str().size();
     ReplaceMap(stream);
+    blobLength = GetBlobLength(presets);
 
-    std::istringstream updateStream;
+    BlobSnapshotStream updateStream;
     if (ValidateUpdateFileAndRead(updateStream)) {
         ReplaceUpdatesList(updateStream);
     }
 }
 
-void PresetManager::HandleReceivedBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp)
+void PresetManager::HandleReceivedBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp)
 {
     QCC_DbgPrintf(("%s", __func__));
     uint64_t currentTimestamp = GetTimestampInMs();
     presetsLock.Lock();
     if (((timeStamp == 0) || ((currentTimestamp - timeStamp) > timestamp)) && (checkSum != checksum)) {
-        std::istringstream stream(blob.c_str());
+        BlobInputStream stream(blob, length);
         ReplaceMap(stream);
+        blobLength = GetBlobLength(presets);
         timeStamp = currentTimestamp;
         checkSum = checksum;
         ScheduleFileWrite(true);
@@ -694,7 +979,7 @@ void PresetManager::HandleReceivedBlob(const std::string& blob, uint32_t checksu
     presetsLock.Unlock();
 }
 
-void PresetManager::ReplaceMap(std::istringstream& stream)
+void PresetManager::ReplaceMap(std::istream& stream)
 {
     QCC_DbgTrace(("%s", __func__));
     bool firstIteration = true;
@@ -721,7 +1006,6 @@ void PresetManager::ReplaceMap(std::istringstream& stream)
                     presets.clear();
                     firstIteration = false;
                 }
-                blobLength += presetId.length();
                 LampState state;
                 ParseLampState(stream, state);
 
@@ -733,7 +1017,7 @@ void PresetManager::ReplaceMap(std::istringstream& stream)
     }
 }
 
-void PresetManager::ReplaceUpdatesList(std::istringstream& stream)
+void PresetManager::ReplaceUpdatesList(std::istream& stream)
 {
     QCC_DbgTrace(("%s", __func__));
     bool firstIteration = true;
@@ -780,8 +1064,7 @@ LSFResponseCode PresetManager::CreatePresetInternal(LampState& preset, LSFString
         QStatus status = presetsLock.Lock();
         if (ER_OK == status) {
             if (presets.size() < OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY) {
-                std::string newPresetStr = GetString(name, presetID, preset);
-                size_t newlen = blobLength + newPresetStr.length() + presetID.length();
+                size_t newlen = blobLength + GetStringLength(name, presetID, preset) + presetID.length();
                 if (newlen < MAX_FILE_LEN) {
                     blobLength = newlen;
                     presets[presetID].first = name;
@@ -829,6 +1112,29 @@ std::string PresetManager::GetString(const std::string& name, const std::string&
     return stream.str();
 }
 
+size_t PresetManager::GetStringLength(const std::string& name, const std::string& id, const LampState& state)
+{
+    size_t length = (sizeof("Preset  \"\" \n") - 1) + id.length() + name.length();
+    if (!state.nullState) {
+        length += GetLampStateLength(state);
+    } else {
+        length += 1;
+    }
+    return length;
+}
+
+size_t PresetManager::GetBlobLength(const PresetMap& items)
+{
+    size_t length = 0;
+    for (PresetMap::const_iterator it = items.begin(); it != items.end(); ++it) {
+        length += GetStringLength(it->second.first, it->first, it->second.second);
+        if (it->first != defaultLampStateID) {
+            length += it->first.length();
+        }
+    }
+    return length;
+}
+
 std::string PresetManager::GetString(const PresetMap& items)
 {
     std::ostringstream stream;
@@ -928,13 +1234,13 @@ bool PresetManager::GetString(std::string& output, std::string& updates, uint32_
     return ret;
 }
 
-void PresetManager::HandleReceivedUpdateBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp)
+void PresetManager::HandleReceivedUpdateBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp)
 {
     QCC_DbgPrintf(("%s", __func__));
     uint64_t currentTimestamp = GetTimestampInMs();
     presetsLock.Lock();
     if (((updatesTimeStamp == 0) || ((currentTimestamp - updatesTimeStamp) > timestamp)) && (updatesCheckSum != checksum)) {
-        std::istringstream stream(blob.c_str());
+        BlobInputStream stream(blob, length);
         ReplaceUpdatesList(stream);
         updatesTimeStamp = currentTimestamp;
         updatesCheckSum = checksum;
@@ -979,7 +1285,7 @@ void PresetManager::ReadWriteFile()
     std::list<ajn::Message> tempUpdateMessageList;
 
     readMutex.Lock();
-    if (read) {
+    if (read && !status) {
         tempMessageList = readBlobMessages;
         readBlobMessages.clear();
         tempUpdateMessageList = readUpdateBlobMessages;
@@ -988,8 +1294,10 @@ void PresetManager::ReadWriteFile()
     }
     readMutex.Unlock();
 
+    ScheduleDeferredReads();
+
     if ((tempMessageList.size() || tempUpdateMessageList.size() || sendUpdate) && !status) {
-        std::istringstream stream;
+        BlobSnapshotStream stream;
         bool fileStatus = ValidateFileAndReadInternal(checksum, timestamp, stream);
         if (fileStatus) {
             output = stream.str();
@@ -1002,7 +1310,7 @@ void PresetManager::ReadWriteFile()
             QCC_LogError(ER_FAIL, ("%s: Preset persistent store corrupted", __func__));
         }
 
-        std::istringstream updateStream;
+        BlobSnapshotStream updateStream;
         bool updateStatus = ValidateUpdateFileAndReadInternal(updateChecksum, updateTimestamp, updateStream);
         if (updateStatus) {
             updates = updateStream.str();
@@ -1024,6 +1332,68 @@ void PresetManager::ReadWriteFile()
     }
 }
 
+void PresetManager::ExportConfiguration(std::ostream& stream)
+{
+    QCC_DbgTrace(("%s", __func__));
+    for (PresetMap::const_iterator it = presets.begin(); it != presets.end(); ++it) {
+        stream << GetString(it->second.first, it->first, it->second.second);
+    }
+}
+
+LSFResponseCode PresetManager::StageConfiguration(std::istream& stream, PresetMap& staged, size_t& stagedBlobLength)
+{
+    QCC_DbgTrace(("%s", __func__));
+    /*
+     * ReplaceMap parses into the live map, so swap in an empty one and
+     * put the live presets back once the section has been read
+     */
+    PresetMap live;
+    live.swap(presets);
+    ReplaceMap(stream);
+    staged.swap(presets);
+    presets.swap(live);
+
+    if (staged.size() > OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY) {
+        QCC_LogError(ER_FAIL, ("%s: %d presets exceed the supported number", __func__, staged.size()));
+        return LSF_ERR_NO_SLOT;
+    }
+
+    stagedBlobLength = GetBlobLength(staged);
+    if (stagedBlobLength >= MAX_FILE_LEN) {
+        QCC_LogError(ER_FAIL, ("%s: presets do not fit in the persistent store", __func__));
+        return LSF_ERR_RESOURCES;
+    }
+
+    return LSF_OK;
+}
+
+void PresetManager::CommitConfiguration(PresetMap& staged, size_t stagedBlobLength, ConfigurationChanges& changes)
+{
+    QCC_DbgTrace(("%s", __func__));
+    /*
+     * Keep the default lamp state if the snapshot does not have one
+     */
+    PresetMap::const_iterator dit = presets.find(defaultLampStateID);
+    if ((dit != presets.end()) && (staged.find(defaultLampStateID) == staged.end())) {
+        stagedBlobLength += GetStringLength(dit->second.first, defaultLampStateID, dit->second.second);
+        staged.insert(*dit);
+    }
+
+    GetConfigurationChanges(presets, staged, changes);
+    changes.created.remove(defaultLampStateID);
+    changes.updated.remove(defaultLampStateID);
+    changes.deleted.remove(defaultLampStateID);
+    presets.swap(staged);
+    blobLength = stagedBlobLength;
+
+    for (LSFStringList::const_iterator it = changes.deleted.begin(); it != changes.deleted.end(); ++it) {
+        presetUpdates.erase(*it);
+    }
+    presetUpdates.insert(changes.updated.begin(), changes.updated.end());
+
+    ScheduleFileWrite();
+}
+
 uint32_t PresetManager::GetControllerServicePresetInterfaceVersion(void)
 {
     QCC_DbgPrintf(("%s: controllerPresetInterfaceVersion=%d", __func__, ControllerServicePresetInterfaceVersion));
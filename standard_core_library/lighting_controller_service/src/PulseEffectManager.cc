@@ -360,8 +360,8 @@ void PulseEffectManager::UpdatePulseEffect(Message& msg)
             if (it != pulseEffects.end()) {
                 size_t newlen = blobLength;
                 // sub len of old pulse effect, add len of new pulse effect
-                newlen -= GetString(it->second.first, pulseEffectID, it->second.second).length();
-                newlen += GetString(it->second.first, pulseEffectID, pulseEffect).length();
+                newlen -= GetStringLength(it->second.first, pulseEffectID, it->second.second);
+                newlen += GetStringLength(it->second.first, pulseEffectID, pulseEffect);
 
                 if (newlen < MAX_FILE_LEN) {
                     blobLength = newlen;
@@ -592,7 +592,7 @@ void PulseEffectManager::GetPulseEffect(Message& msg)
 void PulseEffectManager::ReadSavedData(void)
 {
     QCC_DbgTrace(("%s", __func__));
-    std::istringstream stream;
+    BlobSnapshotStream stream;
     if (!ValidateFileAndRead(stream)) {
         /*
          * If there is no file present / CRC check failed on the file create a new
@@ -604,23 +604,24 @@ void PulseEffectManager::ReadSavedData(void)
         return;
     }
 
-    blobLength = stream.str().size();
     ReplaceMap(stream);
+    blobLength = GetBlobLength(pulseEffects);
 
-    std::istringstream updateStream;
+    BlobSnapshotStream updateStream;
     if (ValidateUpdateFileAndRead(updateStream)) {
         ReplaceUpdatesList(updateStream);
     }
 }
 
-void PulseEffectManager::HandleReceivedBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp)
+void PulseEffectManager::HandleReceivedBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp)
 {
     QCC_DbgPrintf(("%s", __func__));
     uint64_t currentTimestamp = GetTimestampInMs();
     pulseEffectsLock.Lock();
     if (((timeStamp == 0) || ((currentTimestamp - timeStamp) > timestamp)) && (checkSum != checksum)) {
-        std::istringstream stream(blob.c_str());
+        BlobInputStream stream(blob, length);
         ReplaceMap(stream);
+        blobLength = GetBlobLength(pulseEffects);
         timeStamp = currentTimestamp;
         checkSum = checksum;
         ScheduleFileWrite(true);
@@ -628,13 +629,13 @@ void PulseEffectManager::HandleReceivedBlob(const std::string& blob, uint32_t ch
     pulseEffectsLock.Unlock();
 }
 
-void PulseEffectManager::HandleReceivedUpdateBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp)
+void PulseEffectManager::HandleReceivedUpdateBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp)
 {
     QCC_DbgPrintf(("%s", __func__));
     uint64_t currentTimestamp = GetTimestampInMs();
     pulseEffectsLock.Lock();
     if (((updatesTimeStamp == 0) || ((currentTimestamp - updatesTimeStamp) > timestamp)) && (updatesCheckSum != checksum)) {
-        std::istringstream stream(blob.c_str());
+        BlobInputStream stream(blob, length);
         ReplaceUpdatesList(stream);
         updatesTimeStamp = currentTimestamp;
         updatesCheckSum = checksum;
@@ -643,7 +644,7 @@ void PulseEffectManager::HandleReceivedUpdateBlob(const std::string& blob, uint3
     pulseEffectsLock.Unlock();
 }
 
-void PulseEffectManager::ReplaceMap(std::istringstream& stream)
+void PulseEffectManager::ReplaceMap(std::istream& stream)
 {
     QCC_DbgTrace(("%s", __func__));
     bool firstIteration = true;
@@ -670,7 +671,6 @@ void PulseEffectManager::ReplaceMap(std::istringstream& stream)
                     pulseEffects.clear();
                     firstIteration = false;
                 }
-                blobLength += pulseEffectId.length();
 
                 bool containsLampState = ParseValue<bool>(stream);
 
@@ -704,7 +704,7 @@ void PulseEffectManager::ReplaceMap(std::istringstream& stream)
     }
 }
 
-void PulseEffectManager::ReplaceUpdatesList(std::istringstream& stream)
+void PulseEffectManager::ReplaceUpdatesList(std::istream& stream)
 {
     QCC_DbgTrace(("%s", __func__));
     bool firstIteration = true;
@@ -752,8 +752,7 @@ LSFResponseCode PulseEffectManager::CreatePulseEffectInternal(PulseEffect& pulse
         QStatus status = pulseEffectsLock.Lock();
         if (ER_OK == status) {
             if (pulseEffects.size() < OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY) {
-                std::string newPulseEffectStr = GetString(name, pulseEffectID, pulseEffect);
-                size_t newlen = blobLength + newPulseEffectStr.length() + pulseEffectID.length();
+                size_t newlen = blobLength + GetStringLength(name, pulseEffectID, pulseEffect) + pulseEffectID.length();
                 if (newlen < MAX_FILE_LEN) {
                     blobLength = newlen;
                     pulseEffects[pulseEffectID].first = name;
@@ -802,7 +801,7 @@ LSFResponseCode PulseEffectManager::DeletePulseEffectInternal(LSFString& pulseEf
         if (ER_OK == status) {
             PulseEffectMap::iterator it = pulseEffects.find(pulseEffectID);
             if (it != pulseEffects.end()) {
-                blobLength -= ((GetString(it->second.first, pulseEffectID, it->second.second).length()) + pulseEffectID.length());
+                blobLength -= (GetStringLength(it->second.first, pulseEffectID, it->second.second) + pulseEffectID.length());
                 pulseEffects.erase(it);
                 if (pulseEffectUpdates.find(pulseEffectID) != pulseEffectUpdates.end()) {
                     pulseEffectUpdates.erase(pulseEffectID);
@@ -870,6 +869,27 @@ std::string PulseEffectManager::GetString(const std::string& name, const std::st
     return stream.str();
 }
 
+size_t PulseEffectManager::GetStringLength(const std::string& name, const std::string& id, const PulseEffect& pulseEffect)
+{
+    size_t length = (sizeof("PulseEffect  \"\" 0     \n") - 1) + id.length() + name.length()
+                    + GetValueLength(pulseEffect.pulsePeriod) + GetValueLength(pulseEffect.pulseDuration) + GetValueLength(pulseEffect.numPulses);
+    if (!(pulseEffect.toState.nullState)) {
+        length += GetLampStateLength(pulseEffect.fromState) + GetLampStateLength(pulseEffect.toState);
+    } else {
+        length += pulseEffect.fromPreset.length() + pulseEffect.toPreset.length();
+    }
+    return length;
+}
+
+size_t PulseEffectManager::GetBlobLength(const PulseEffectMap& items)
+{
+    size_t length = 0;
+    for (PulseEffectMap::const_iterator it = items.begin(); it != items.end(); ++it) {
+        length += GetStringLength(it->second.first, it->first, it->second.second) + it->first.length();
+    }
+    return length;
+}
+
 std::string PulseEffectManager::GetString(const PulseEffectMap& items)
 {
     std::ostringstream stream;
@@ -984,7 +1004,7 @@ void PulseEffectManager::ReadWriteFile()
     std::list<ajn::Message> tempUpdateMessageList;
 
     readMutex.Lock();
-    if (read) {
+    if (read && !status) {
         tempMessageList = readBlobMessages;
         readBlobMessages.clear();
         tempUpdateMessageList = readUpdateBlobMessages;
@@ -993,8 +1013,10 @@ void PulseEffectManager::ReadWriteFile()
     }
     readMutex.Unlock();
 
+    ScheduleDeferredReads();
+
     if ((tempMessageList.size() || tempUpdateMessageList.size() || sendUpdate) && !status) {
-        std::istringstream stream;
+        BlobSnapshotStream stream;
         bool fileStatus = ValidateFileAndReadInternal(checksum, timestamp, stream);
         if (fileStatus) {
             output = stream.str();
@@ -1007,7 +1029,7 @@ void PulseEffectManager::ReadWriteFile()
             QCC_LogError(ER_FAIL, ("%s: PulseEffect persistent store corrupted", __func__));
         }
 
-        std::istringstream updateStream;
+        BlobSnapshotStream updateStream;
         bool updateStatus = ValidateUpdateFileAndReadInternal(updateChecksum, updateTimestamp, updateStream);
         if (updateStatus) {
             updates = updateStream.str();
@@ -1029,6 +1051,56 @@ void PulseEffectManager::ReadWriteFile()
     }
 }
 
+void PulseEffectManager::ExportConfiguration(std::ostream& stream)
+{
+    QCC_DbgTrace(("%s", __func__));
+    for (PulseEffectMap::const_iterator it = pulseEffects.begin(); it != pulseEffects.end(); ++it) {
+        stream << GetString(it->second.first, it->first, it->second.second);
+    }
+}
+
+LSFResponseCode PulseEffectManager::StageConfiguration(std::istream& stream, PulseEffectMap& staged, size_t& stagedBlobLength)
+{
+    QCC_DbgTrace(("%s", __func__));
+    /*
+     * ReplaceMap parses into the live map, so swap in an empty one and
+     * put the live pulse effects back once the section has been read
+     */
+    PulseEffectMap live;
+    live.swap(pulseEffects);
+    ReplaceMap(stream);
+    staged.swap(pulseEffects);
+    pulseEffects.swap(live);
+
+    if (staged.size() > OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY) {
+        QCC_LogError(ER_FAIL, ("%s: %d pulse effects exceed the supported number", __func__, staged.size()));
+        return LSF_ERR_NO_SLOT;
+    }
+
+    stagedBlobLength = GetBlobLength(staged);
+    if (stagedBlobLength >= MAX_FILE_LEN) {
+        QCC_LogError(ER_FAIL, ("%s: pulse effects do not fit in the persistent store", __func__));
+        return LSF_ERR_RESOURCES;
+    }
+
+    return LSF_OK;
+}
+
+void PulseEffectManager::CommitConfiguration(PulseEffectMap& staged, size_t stagedBlobLength, ConfigurationChanges& changes)
+{
+    QCC_DbgTrace(("%s", __func__));
+    GetConfigurationChanges(pulseEffects, staged, changes);
+    pulseEffects.swap(staged);
+    blobLength = stagedBlobLength;
+
+    for (LSFStringList::const_iterator it = changes.deleted.begin(); it != changes.deleted.end(); ++it) {
+        pulseEffectUpdates.erase(*it);
+    }
+    pulseEffectUpdates.insert(changes.updated.begin(), changes.updated.end());
+
+    ScheduleFileWrite();
+}
+
 uint32_t PulseEffectManager::GetControllerServicePulseEffectInterfaceVersion(void)
 {
     QCC_DbgPrintf(("%s: controllerPulseEffectInterfaceVersion=%d", __func__, ControllerServicePulseEffectInterfaceVersion));
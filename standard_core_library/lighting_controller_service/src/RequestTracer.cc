@@ -0,0 +1,131 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifdef LSF_BINDINGS
+#include <lsf/controllerservice/RequestTracer.h>
+#else
+#include <RequestTracer.h>
+#endif
+
+#include <qcc/Debug.h>
+#include <qcc/atomic.h>
+
+#include <stdio.h>
+#include <fstream>
+
+using namespace lsf;
+
+#ifdef LSF_BINDINGS
+using namespace controllerservice;
+#endif
+
+#define QCC_MODULE "REQUEST_TRACER"
+
+#if OEM_CS_REQUEST_TRACING
+
+/**
+ * A stage of a request. The stage name is written last so that a record
+ * with a NULL stage is known to be incomplete
+ */
+struct RequestTraceRecord {
+    uint64_t traceId;
+    uint64_t startTimestamp;
+    uint64_t endTimestamp;
+    const char* volatile stage;
+};
+
+static RequestTraceRecord traceBuffer[OEM_CS_REQUEST_TRACE_BUFFER_SIZE];
+
+static volatile int32_t traceIndex = -1;
+
+#endif
+
+uint64_t RequestTracer::GetTraceId(const ajn::Message& msg)
+{
+    /* FNV-1a of the sender's unique name, folded down to 21 bits */
+    uint32_t hash = 2166136261U;
+    for (const char* sender = msg->GetSender(); sender && *sender; sender++) {
+        hash ^= static_cast<uint8_t>(*sender);
+        hash *= 16777619U;
+    }
+    hash = (hash >> 21) ^ (hash & 0x1FFFFF);
+
+    return (static_cast<uint64_t>(hash & 0x1FFFFF) << 32) | msg->GetCallSerial();
+}
+
+void RequestTracer::Record(uint64_t traceId, const char* stage, uint64_t startTimestamp, uint64_t endTimestamp)
+{
+#if OEM_CS_REQUEST_TRACING
+    uint32_t index = static_cast<uint32_t>(qcc::IncrementAndFetch(&traceIndex));
+    RequestTraceRecord& record = traceBuffer[index & (OEM_CS_REQUEST_TRACE_BUFFER_SIZE - 1)];
+
+    record.stage = NULL;
+    record.traceId = traceId;
+    record.startTimestamp = startTimestamp;
+    record.endTimestamp = endTimestamp;
+    record.stage = stage;
+#endif
+}
+
+uint32_t RequestTracer::GetNumRecords(void)
+{
+#if OEM_CS_REQUEST_TRACING
+    return static_cast<uint32_t>(traceIndex + 1);
+#else
+    return 0;
+#endif
+}
+
+QStatus RequestTracer::DumpChromeTrace(const std::string& filePath)
+{
+    QCC_DbgTrace(("%s: filePath=%s", __func__, filePath.c_str()));
+
+    std::string tmpPath = filePath + ".tmp";
+    std::ofstream stream(tmpPath.c_str(), std::ios_base::out);
+    if (!stream.is_open()) {
+        QCC_LogError(ER_OPEN_FAILED, ("%s: File not found: %s", __func__, tmpPath.c_str()));
+        return ER_OPEN_FAILED;
+    }
+
+    stream << "{\"traceEvents\":[";
+
+#if OEM_CS_REQUEST_TRACING
+    bool first = true;
+    for (size_t i = 0; i < OEM_CS_REQUEST_TRACE_BUFFER_SIZE; i++) {
+        const RequestTraceRecord& record = traceBuffer[i];
+        const char* stage = record.stage;
+        if (!stage) {
+            continue;
+        }
+
+        uint64_t duration = (record.endTimestamp > record.startTimestamp) ? (record.endTimestamp - record.startTimestamp) : 0;
+        stream << (first ? "" : ",") << std::endl;
+        stream << "{\"name\":\"" << stage << "\",\"cat\":\"lsf\",\"ph\":\"X\",\"ts\":" << record.startTimestamp
+               << ",\"dur\":" << duration << ",\"pid\":1,\"tid\":" << record.traceId << "}";
+        first = false;
+    }
+#endif
+
+    stream << std::endl << "]}" << std::endl;
+    stream.close();
+
+    if (rename(tmpPath.c_str(), filePath.c_str())) {
+        QCC_LogError(ER_FAIL, ("%s: Failed to rename %s", __func__, tmpPath.c_str()));
+        return ER_FAIL;
+    }
+
+    return ER_OK;
+}
@@ -75,6 +75,8 @@ LSFResponseCode SceneElementManager::Reset(void)
          * Clear the SceneElements
          */
         sceneElements.clear();
+        lampGroupUsers.Clear();
+        effectUsers.Clear();
         blobLength = 0;
 
         ScheduleFileWrite();
@@ -108,11 +110,8 @@ LSFResponseCode SceneElementManager::IsDependentOnLampGroup(LSFString& lampGroup
 
     QStatus status = sceneElementsLock.Lock();
     if (ER_OK == status) {
-        for (SceneElementMap::iterator it = sceneElements.begin(); it != sceneElements.end(); ++it) {
-            responseCode = it->second.second.IsDependentOnLampGroup(lampGroupID);
-            if (LSF_OK != responseCode) {
-                break;
-            }
+        if (lampGroupUsers.IsUsed(lampGroupID)) {
+            responseCode = LSF_ERR_DEPENDENCY;
         }
         status = sceneElementsLock.Unlock();
         if (ER_OK != status) {
@@ -133,11 +132,8 @@ LSFResponseCode SceneElementManager::IsDependentOnEffect(LSFString& effectId)
 
     QStatus status = sceneElementsLock.Lock();
     if (ER_OK == status) {
-        for (SceneElementMap::iterator it = sceneElements.begin(); it != sceneElements.end(); ++it) {
-            responseCode = it->second.second.IsDependentOnEffect(effectId);
-            if (LSF_OK != responseCode) {
-                break;
-            }
+        if (effectUsers.IsUsed(effectId)) {
+            responseCode = LSF_ERR_DEPENDENCY;
         }
         status = sceneElementsLock.Unlock();
         if (ER_OK != status) {
@@ -352,6 +348,117 @@ void SceneElementManager::CreateSceneElement(Message& message)
     }
 }
 
+void SceneElementManager::CreateSceneElements(Message& message)
+{
+    QCC_DbgPrintf(("%s: %s", __func__, message->ToString().c_str()));
+
+    LSFResponseCode responseCode = LSF_OK;
+    LSFStringList sceneElementIDs;
+
+    if (!controllerService.UpdatesAllowed()) {
+        controllerService.SendMethodReplyWithResponseCodeAndListOfIDs(message, LSF_ERR_BUSY, sceneElementIDs);
+        return;
+    }
+
+    const ajn::MsgArg* inputArgs;
+    size_t numInputArgs;
+    message->GetArgs(numInputArgs, inputArgs);
+
+    if (controllerService.CheckNumArgsInMessage(numInputArgs, 2)  != LSF_OK) {
+        return;
+    }
+
+    MsgArg* elementArgs;
+    size_t numElements;
+    inputArgs[0].Get("a(asasss)", &numElements, &elementArgs);
+    LSFString language = static_cast<LSFString>(inputArgs[1].v_string.str);
+
+    /*
+     * Validate every scene element before touching the map so that the
+     * request is applied completely or not at all
+     */
+    std::list<std::pair<LSFString, SceneElement> > newElements;
+
+    if (0 != strcmp("en", language.c_str())) {
+        QCC_LogError(ER_FAIL, ("%s: Language %s not supported", __func__, language.c_str()));
+        responseCode = LSF_ERR_INVALID_ARGS;
+    } else if (numElements == 0) {
+        QCC_LogError(ER_FAIL, ("%s: No scene elements", __func__));
+        responseCode = LSF_ERR_INVALID_ARGS;
+    }
+
+    for (size_t i = 0; (i < numElements) && (LSF_OK == responseCode); i++) {
+        const MsgArg* members = elementArgs[i].v_struct.members;
+        LSFString name = static_cast<LSFString>(members[3].v_string.str);
+
+        newElements.push_back(std::make_pair(name, SceneElement(members[0], members[1], members[2])));
+        const SceneElement& sceneElement = newElements.back().second;
+
+        if (name.empty()) {
+            QCC_LogError(ER_FAIL, ("%s: scene element name is empty", __func__));
+            responseCode = LSF_ERR_EMPTY_NAME;
+        } else if (name.length() > LSF_MAX_NAME_LENGTH) {
+            QCC_LogError(ER_FAIL, ("%s: name length exceeds %d", __func__, LSF_MAX_NAME_LENGTH));
+            responseCode = LSF_ERR_INVALID_ARGS;
+        } else if (sceneElement.lamps.empty() && sceneElement.lampGroups.empty()) {
+            QCC_LogError(ER_FAIL, ("%s: Empty Lamps and LampGroups list", __func__));
+            responseCode = LSF_ERR_INVALID_ARGS;
+        } else if (sceneElement.effectID.empty()) {
+            QCC_LogError(ER_FAIL, ("%s: effect ID is empty", __func__));
+            responseCode = LSF_ERR_INVALID_ARGS;
+        } else {
+            sceneElementIDs.push_back(GenerateUniqueID("SCENE_ELEMENT"));
+        }
+    }
+
+    if (LSF_OK == responseCode) {
+        QStatus status = sceneElementsLock.Lock();
+        if (ER_OK == status) {
+            if ((sceneElements.size() + newElements.size()) <= OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY) {
+                size_t newlen = blobLength;
+                LSFStringList::const_iterator idIt = sceneElementIDs.begin();
+                for (std::list<std::pair<LSFString, SceneElement> >::const_iterator it = newElements.begin(); it != newElements.end(); ++it, ++idIt) {
+                    newlen += GetStringLength(it->first, *idIt, it->second);
+                }
+
+                if (newlen < MAX_FILE_LEN) {
+                    blobLength = newlen;
+                    idIt = sceneElementIDs.begin();
+                    for (std::list<std::pair<LSFString, SceneElement> >::iterator it = newElements.begin(); it != newElements.end(); ++it, ++idIt) {
+                        AddDependencies(*idIt, it->second);
+                        sceneElements[*idIt].first = it->first;
+                        sceneElements[*idIt].second.Swap(it->second);
+                    }
+                    ScheduleFileWrite();
+                } else {
+                    QCC_LogError(ER_FAIL, ("%s: blob too big: %d >= %d", __func__, newlen, MAX_FILE_LEN));
+                    responseCode = LSF_ERR_RESOURCES;
+                }
+            } else {
+                QCC_LogError(ER_FAIL, ("%s: No slot for %u new SceneElements", __func__, newElements.size()));
+                responseCode = LSF_ERR_NO_SLOT;
+            }
+            status = sceneElementsLock.Unlock();
+            if (ER_OK != status) {
+                QCC_LogError(status, ("%s: sceneElementsLock.Unlock() failed", __func__));
+            }
+        } else {
+            responseCode = LSF_ERR_BUSY;
+            QCC_LogError(status, ("%s: sceneElementsLock.Lock() failed", __func__));
+        }
+    }
+
+    if (LSF_OK != responseCode) {
+        sceneElementIDs.clear();
+    }
+
+    controllerService.SendMethodReplyWithResponseCodeAndListOfIDs(message, responseCode, sceneElementIDs);
+
+    if (LSF_OK == responseCode) {
+        SendSceneElementsCreatedSignal(sceneElementIDs);
+    }
+}
+
 void SceneElementManager::UpdateSceneElement(Message& message)
 {
     QCC_DbgPrintf(("%s: %s", __func__, message->ToString().c_str()));
@@ -389,12 +496,14 @@ void SceneElementManager::UpdateSceneElement(Message& message)
 
                 size_t newlen = blobLength;
                 // sub len of old element, add len of new element
-                newlen -= GetString(it->second.first, sceneElementID, it->second.second).length();
-                newlen += GetString(it->second.first, sceneElementID, sceneElement).length();
+                newlen -= GetStringLength(it->second.first, sceneElementID, it->second.second);
+                newlen += GetStringLength(it->second.first, sceneElementID, sceneElement);
 
                 if (newlen < MAX_FILE_LEN) {
                     blobLength = newlen;
-                    it->second.second = sceneElement;
+                    RemoveDependencies(sceneElementID, it->second.second);
+                    AddDependencies(sceneElementID, sceneElement);
+                    it->second.second.Swap(sceneElement);
                     responseCode = LSF_OK;
                     updated = true;
                     ScheduleFileWrite();
@@ -460,6 +569,76 @@ void SceneElementManager::DeleteSceneElement(Message& message)
     }
 }
 
+void SceneElementManager::DeleteSceneElements(Message& message)
+{
+    QCC_DbgPrintf(("%s: %s", __func__, message->ToString().c_str()));
+    LSFResponseCode responseCode = LSF_OK;
+
+    size_t numArgs;
+    const MsgArg* args;
+    message->GetArgs(numArgs, args);
+
+    if (controllerService.CheckNumArgsInMessage(numArgs, 1)  != LSF_OK) {
+        return;
+    }
+
+    MsgArg* idsArray;
+    size_t idsSize;
+    args[0].Get("as", &idsSize, &idsArray);
+
+    LSFStringList sceneElementIDs;
+    CreateUniqueList(sceneElementIDs, idsArray, idsSize);
+
+    if (!controllerService.UpdatesAllowed()) {
+        controllerService.SendMethodReplyWithResponseCodeAndListOfIDs(message, LSF_ERR_BUSY, sceneElementIDs);
+        return;
+    }
+
+    if (sceneElementIDs.empty()) {
+        QCC_LogError(ER_FAIL, ("%s: No scene elements", __func__));
+        responseCode = LSF_ERR_INVALID_ARGS;
+    }
+
+    for (LSFStringList::iterator it = sceneElementIDs.begin(); (it != sceneElementIDs.end()) && (LSF_OK == responseCode); ++it) {
+        responseCode = sceneManagerPtr->IsDependentOnSceneElement(*it);
+    }
+
+    if (LSF_OK == responseCode) {
+        QStatus status = sceneElementsLock.Lock();
+        if (ER_OK == status) {
+            for (LSFStringList::const_iterator it = sceneElementIDs.begin(); (it != sceneElementIDs.end()) && (LSF_OK == responseCode); ++it) {
+                if (sceneElements.find(*it) == sceneElements.end()) {
+                    responseCode = LSF_ERR_NOT_FOUND;
+                }
+            }
+
+            if (LSF_OK == responseCode) {
+                for (LSFStringList::const_iterator it = sceneElementIDs.begin(); it != sceneElementIDs.end(); ++it) {
+                    SceneElementMap::iterator sit = sceneElements.find(*it);
+                    blobLength -= GetStringLength(sit->second.first, *it, sit->second.second);
+                    RemoveDependencies(*it, sit->second.second);
+                    sceneElements.erase(sit);
+                }
+                ScheduleFileWrite();
+            }
+
+            status = sceneElementsLock.Unlock();
+            if (ER_OK != status) {
+                QCC_LogError(status, ("%s: sceneElementsLock.Unlock() failed", __func__));
+            }
+        } else {
+            responseCode = LSF_ERR_BUSY;
+            QCC_LogError(status, ("%s: sceneElementsLock.Lock() failed", __func__));
+        }
+    }
+
+    controllerService.SendMethodReplyWithResponseCodeAndListOfIDs(message, responseCode, sceneElementIDs);
+
+    if (LSF_OK == responseCode) {
+        controllerService.SendSignal(ControllerServiceSceneElementInterfaceName, "SceneElementsDeleted", sceneElementIDs);
+    }
+}
+
 void SceneElementManager::GetSceneElement(Message& message)
 {
     QCC_DbgPrintf(("%s: %s", __func__, message->ToString().c_str()));
@@ -527,6 +706,7 @@ void SceneElementManager::ApplySceneElement(ajn::Message& message)
 LSFResponseCode SceneElementManager::ApplySceneElementInternal(ajn::Message& message, LSFStringList& sceneElementIDs, LSFString sceneOrMasterSceneId)
 {
     QCC_DbgPrintf(("%s: sceneElementIDs.size() = %d", __func__, sceneElementIDs.size()));
+    LSF_TRACE_SCOPE(LSF_TRACE_ID(message), "SceneElementResolution");
     LSFResponseCode responseCode = LSF_ERR_NOT_FOUND;
     std::list<SceneElement> sceneElementList;
     uint8_t notfound = 0;
@@ -577,7 +757,8 @@ LSFResponseCode SceneElementManager::ApplySceneElementInternal(ajn::Message& mes
             CreateUniqueList(lampGroups, sceneElementList.front().lampGroups);
 
             QCC_DbgPrintf(("%s: Applying sceneElementID with effectID=%s", __func__, sceneElementList.front().effectID.c_str()));
-            if (sceneElementList.front().effectID.find("TRANSITION_EFFECT") != std::string::npos) {
+            switch (sceneElementList.front().effectType) {
+            case LSF_EFFECT_TRANSITION:
                 if (transitionEffectManagerPtr->GetTransitionEffectInternal(sceneElementList.front().effectID, transitionEffect) == LSF_OK) {
                     if (transitionEffect.state.nullState) {
                         TransitionLampsLampGroupsToPreset component(lamps, lampGroups, transitionEffect.presetID, transitionEffect.transitionPeriod);
@@ -589,7 +770,9 @@ LSFResponseCode SceneElementManager::ApplySceneElementInternal(ajn::Message& mes
                 } else {
                     notFoundCount++;
                 }
-            } else if (sceneElementList.front().effectID.find("PULSE_EFFECT") != std::string::npos) {
+                break;
+
+            case LSF_EFFECT_PULSE:
                 if (pulseEffectManagerPtr->GetPulseEffectInternal(sceneElementList.front().effectID, pulseEffect) == LSF_OK) {
                     if (pulseEffect.toState.nullState) {
                         PulseLampsLampGroupsWithPreset component(lamps, lampGroups, pulseEffect.fromPreset, pulseEffect.toPreset, pulseEffect.pulsePeriod, pulseEffect.pulseDuration, pulseEffect.numPulses);
@@ -601,7 +784,9 @@ LSFResponseCode SceneElementManager::ApplySceneElementInternal(ajn::Message& mes
                 } else {
                     notFoundCount++;
                 }
-            } else if (sceneElementList.front().effectID.find("PRESET") != std::string::npos) {
+                break;
+
+            case LSF_EFFECT_PRESET: {
                 const LSFString presetID = sceneElementList.front().effectID;
                 if (controllerService.GetPresetManager().GetPresetInternal(presetID, preset) == LSF_OK) {
                     TransitionLampsLampGroupsToPreset component(lamps, lampGroups, sceneElementList.front().effectID);
@@ -609,6 +794,11 @@ LSFResponseCode SceneElementManager::ApplySceneElementInternal(ajn::Message& mes
                 } else {
                     notFoundCount++;
                 }
+                break;
+            }
+
+            default:
+                break;
             }
 
             sceneElementList.pop_front();
@@ -655,15 +845,17 @@ void SceneElementManager::ReadWriteFile()
     std::list<ajn::Message> tempMessageList;
 
     readMutex.Lock();
-    if (read) {
+    if (read && !status) {
         tempMessageList = readBlobMessages;
         readBlobMessages.clear();
         read = false;
     }
     readMutex.Unlock();
 
+    ScheduleDeferredReads();
+
     if ((tempMessageList.size() || sendUpdate) && !status) {
-        std::istringstream stream;
+        BlobSnapshotStream stream;
         status = ValidateFileAndReadInternal(checksum, timestamp, stream);
         if (status) {
             output = stream.str();
@@ -690,7 +882,7 @@ void SceneElementManager::ReadWriteFile()
 void SceneElementManager::ReadSavedData()
 {
     QCC_DbgTrace(("%s", __func__));
-    std::istringstream stream;
+    BlobSnapshotStream stream;
     if (!ValidateFileAndRead(stream)) {
         /*
          * If there is no file present / CRC check failed on the file create a new
@@ -702,8 +894,9 @@ void SceneElementManager::ReadSavedData()
         return;
     }
 
-    blobLength = stream.str().size();
     ReplaceMap(stream);
+    blobLength = GetBlobLength(sceneElements);
+    RebuildDependencyIndex();
 }
 
 LSFResponseCode SceneElementManager::CreateSceneElementInternal(SceneElement& sceneElement, LSFString& name, LSFString& language, LSFString& sceneElementID)
@@ -733,12 +926,12 @@ LSFResponseCode SceneElementManager::CreateSceneElementInternal(SceneElement& sc
         QStatus status = sceneElementsLock.Lock();
         if (ER_OK == status) {
             if (sceneElements.size() < OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY) {
-                std::string newElementStr = GetString(name, sceneElementID, sceneElement);
-                size_t newlen = blobLength + newElementStr.length();
+                size_t newlen = blobLength + GetStringLength(name, sceneElementID, sceneElement);
                 if (newlen < MAX_FILE_LEN) {
                     blobLength = newlen;
+                    AddDependencies(sceneElementID, sceneElement);
                     sceneElements[sceneElementID].first = name;
-                    sceneElements[sceneElementID].second = sceneElement;
+                    sceneElements[sceneElementID].second.Swap(sceneElement);
                     created = true;
                     ScheduleFileWrite();
                 } else {
@@ -784,7 +977,8 @@ LSFResponseCode SceneElementManager::DeleteSceneElementInternal(LSFString& scene
         if (ER_OK == status) {
             SceneElementMap::iterator it = sceneElements.find(sceneElementID);
             if (it != sceneElements.end()) {
-                blobLength -= GetString(it->second.first, sceneElementID, it->second.second).length();
+                blobLength -= GetStringLength(it->second.first, sceneElementID, it->second.second);
+                RemoveDependencies(sceneElementID, it->second.second);
 
                 sceneElements.erase(it);
                 ScheduleFileWrite();
@@ -828,7 +1022,7 @@ LSFResponseCode SceneElementManager::GetSceneElementInternal(LSFString& sceneEle
     return responseCode;
 }
 
-void SceneElementManager::ReplaceMap(std::istringstream& stream)
+void SceneElementManager::ReplaceMap(std::istream& stream)
 {
     QCC_DbgTrace(("%s", __func__));
     bool firstIteration = true;
@@ -868,22 +1062,47 @@ void SceneElementManager::ReplaceMap(std::istringstream& stream)
                         break;
                     }
                 } while (token != "EndSceneElement");
+                sceneElement.effectType = SceneElement::GetEffectType(sceneElement.effectID);
 
-                std::pair<LSFString, SceneElement> thePair(name, sceneElement);
-                sceneElements[id] = thePair;
+                sceneElements[id].first = name;
+                sceneElements[id].second.Swap(sceneElement);
             }
         }
     }
 }
 
-void SceneElementManager::HandleReceivedBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp)
+void SceneElementManager::AddDependencies(const LSFString& sceneElementID, const SceneElement& sceneElement)
+{
+    lampGroupUsers.Add(sceneElementID, sceneElement.lampGroups);
+    effectUsers.Add(sceneElementID, sceneElement.effectID);
+}
+
+void SceneElementManager::RemoveDependencies(const LSFString& sceneElementID, const SceneElement& sceneElement)
+{
+    lampGroupUsers.Remove(sceneElementID, sceneElement.lampGroups);
+    effectUsers.Remove(sceneElementID, sceneElement.effectID);
+}
+
+void SceneElementManager::RebuildDependencyIndex(void)
+{
+    QCC_DbgTrace(("%s", __func__));
+    lampGroupUsers.Clear();
+    effectUsers.Clear();
+    for (SceneElementMap::const_iterator it = sceneElements.begin(); it != sceneElements.end(); ++it) {
+        AddDependencies(it->first, it->second.second);
+    }
+}
+
+void SceneElementManager::HandleReceivedBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp)
 {
     QCC_DbgPrintf(("%s", __func__));
     uint64_t currentTimestamp = GetTimestampInMs();
     sceneElementsLock.Lock();
     if (((timeStamp == 0) || ((currentTimestamp - timeStamp) > timestamp)) && (checkSum != checksum)) {
-        std::istringstream stream(blob.c_str());
+        BlobInputStream stream(blob, length);
         ReplaceMap(stream);
+        blobLength = GetBlobLength(sceneElements);
+        RebuildDependencyIndex();
         timeStamp = currentTimestamp;
         checkSum = checksum;
         ScheduleFileWrite(true);
@@ -891,6 +1110,51 @@ void SceneElementManager::HandleReceivedBlob(const std::string& blob, uint32_t c
     sceneElementsLock.Unlock();
 }
 
+void SceneElementManager::ExportConfiguration(std::ostream& stream)
+{
+    QCC_DbgTrace(("%s", __func__));
+    for (SceneElementMap::const_iterator it = sceneElements.begin(); it != sceneElements.end(); ++it) {
+        stream << GetString(it->second.first, it->first, it->second.second);
+    }
+}
+
+LSFResponseCode SceneElementManager::StageConfiguration(std::istream& stream, SceneElementMap& staged, size_t& stagedBlobLength)
+{
+    QCC_DbgTrace(("%s", __func__));
+    /*
+     * ReplaceMap parses into the live map, so swap in an empty one and
+     * put the live scene elements back once the section has been read
+     */
+    SceneElementMap live;
+    live.swap(sceneElements);
+    ReplaceMap(stream);
+    staged.swap(sceneElements);
+    sceneElements.swap(live);
+
+    if (staged.size() > OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY) {
+        QCC_LogError(ER_FAIL, ("%s: %d scene elements exceed the supported number", __func__, staged.size()));
+        return LSF_ERR_NO_SLOT;
+    }
+
+    stagedBlobLength = GetBlobLength(staged);
+    if (stagedBlobLength >= MAX_FILE_LEN) {
+        QCC_LogError(ER_FAIL, ("%s: scene elements do not fit in the persistent store", __func__));
+        return LSF_ERR_RESOURCES;
+    }
+
+    return LSF_OK;
+}
+
+void SceneElementManager::CommitConfiguration(SceneElementMap& staged, size_t stagedBlobLength, ConfigurationChanges& changes)
+{
+    QCC_DbgTrace(("%s", __func__));
+    GetConfigurationChanges(sceneElements, staged, changes);
+    sceneElements.swap(staged);
+    blobLength = stagedBlobLength;
+    RebuildDependencyIndex();
+    ScheduleFileWrite();
+}
+
 uint32_t SceneElementManager::GetControllerServiceSceneElementInterfaceVersion(void)
 {
     QCC_DbgPrintf(("%s: controllerSceneElementInterfaceVersion=%d", __func__, ControllerServiceSceneElementInterfaceVersion));
@@ -987,6 +1251,23 @@ std::string SceneElementManager::GetString(const std::string& name, const std::s
     return stream.str();
 }
 
+size_t SceneElementManager::GetStringLength(const std::string& name, const std::string& id, const SceneElement& sceneElement)
+{
+    return (sizeof("SceneElement  \"\" Effect  EndSceneElement\n") - 1) + id.length() + name.length()
+           + GetIDListLength(sceneElement.lamps, sizeof(" Lamp ") - 1)
+           + GetIDListLength(sceneElement.lampGroups, sizeof(" LampGroup ") - 1)
+           + sceneElement.effectID.length();
+}
+
+size_t SceneElementManager::GetBlobLength(const SceneElementMap& items)
+{
+    size_t length = 0;
+    for (SceneElementMap::const_iterator it = items.begin(); it != items.end(); ++it) {
+        length += GetStringLength(it->second.first, it->first, it->second.second);
+    }
+    return length;
+}
+
 void SceneElementManager::SendSceneElementAppliedSignal(LSFString& sceneElementId)
 {
     QCC_DbgPrintf(("%s: %s", __func__, sceneElementId.c_str()));
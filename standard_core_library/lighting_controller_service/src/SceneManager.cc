@@ -162,15 +162,30 @@ void SceneObject::ObjectRegistered(void)
 }
 
 SceneFileManager::SceneFileManager(ControllerService& controllerSvc, const std::string& filePathToManager, const std::string& scene2filePath) :
-    Manager(controllerSvc, filePathToManager), scene2FilePath(scene2filePath), scene2CheckSum(0), scene2TimeStamp(0)
+    Manager(controllerSvc, filePathToManager), scene2FilePath(scene2filePath), scene2CheckSum(0), scene2TimeStamp(0), scene2BlobSnapshot(NULL)
 {
     QCC_DbgPrintf(("%s", __func__));
     readScene2BlobMessages.clear();
 }
 
+SceneFileManager::~SceneFileManager()
+{
+    QCC_DbgPrintf(("%s", __func__));
+    blobSnapshotMutex.Lock();
+    if (scene2BlobSnapshot) {
+        scene2BlobSnapshot->Release();
+        scene2BlobSnapshot = NULL;
+    }
+    blobSnapshotMutex.Unlock();
+}
+
 void SceneFileManager::ScheduleScene2FileRead(ajn::Message& message)
 {
     QCC_DbgPrintf(("%s", __func__));
+    if (SendBlobSnapshot(message, scene2BlobSnapshot)) {
+        return;
+    }
+
     readMutex.Lock();
     readScene2BlobMessages.push_back(message);
     read = true;
@@ -178,7 +193,7 @@ void SceneFileManager::ScheduleScene2FileRead(ajn::Message& message)
     readMutex.Unlock();
 }
 
-bool SceneFileManager::ValidateScene2FileAndRead(std::istringstream& filestream)
+bool SceneFileManager::ValidateScene2FileAndRead(BlobSnapshotStream& filestream)
 {
     QCC_DbgTrace(("%s", __func__));
     uint32_t checksum;
@@ -194,7 +209,7 @@ bool SceneFileManager::ValidateScene2FileAndRead(std::istringstream& filestream)
     return b;
 }
 
-bool SceneFileManager::ValidateScene2FileAndReadInternal(uint32_t& checksum, uint64_t& timestamp, std::istringstream& filestream)
+bool SceneFileManager::ValidateScene2FileAndReadInternal(uint32_t& checksum, uint64_t& timestamp, BlobSnapshotStream& filestream)
 {
     QCC_DbgPrintf(("%s: scene2FilePath=%s", __func__, scene2FilePath.c_str()));
 
@@ -202,6 +217,11 @@ bool SceneFileManager::ValidateScene2FileAndReadInternal(uint32_t& checksum, uin
         return false;
     }
 
+    // The snapshot holds what was last written to or read from the file
+    if (ReadBlobSnapshot(scene2BlobSnapshot, checksum, timestamp, filestream)) {
+        return true;
+    }
+
     std::ifstream stream(scene2FilePath.c_str());
 
     if (!stream.is_open()) {
@@ -212,8 +232,8 @@ bool SceneFileManager::ValidateScene2FileAndReadInternal(uint32_t& checksum, uin
     stream >> timestamp;
 
     uint64_t currenttime = GetTimestampInMs();
-    QCC_DbgPrintf(("%s: timestamp=%llu", __func__, timestamp));
-    QCC_DbgPrintf(("%s: Updated %llu ticks ago", __func__, (currenttime - timestamp)));
+    QCC_DbgPrintf(("%s: timestamp=%llu", __func__, static_cast<unsigned long long>(timestamp)));
+    QCC_DbgPrintf(("%s: Updated %llu ticks ago", __func__, static_cast<unsigned long long>(currenttime - timestamp)));
 
     stream >> checksum;
 
@@ -224,13 +244,18 @@ bool SceneFileManager::ValidateScene2FileAndReadInternal(uint32_t& checksum, uin
     stream >> &rest;
     std::string data = rest.str();
     data.erase(std::remove(data.begin(), ++data.begin(), '\n'), ++data.begin());
-    filestream.str(data);
 
     // check the adler checksum
     uint32_t adler = GetChecksum(data);
 
     stream.close();
-    return adler == checksum;
+
+    if (adler != checksum) {
+        return false;
+    }
+
+    SetBlobSnapshot(scene2BlobSnapshot, data, checksum, timestamp, false);
+    return ReadBlobSnapshot(scene2BlobSnapshot, checksum, timestamp, filestream);
 }
 
 void SceneFileManager::GetScene2BlobInfoInternal(uint32_t& checksum, uint64_t& time)
@@ -253,6 +278,8 @@ void SceneFileManager::WriteScene2FileWithChecksumAndTimestamp(const std::string
     fstream << checksum << std::endl;
     fstream << str;
     fstream.close();
+
+    SetBlobSnapshot(scene2BlobSnapshot, str, checksum, timestamp, false);
 }
 
 SceneManager::SceneManager(ControllerService& controllerSvc, SceneElementManager* sceneElementMgr, MasterSceneManager* masterSceneMgr, const std::string& sceneFile, const std::string& sceneWithSceneElementsFile) :
@@ -273,6 +300,7 @@ void SceneManager::UnregisterSceneEventActionObjects(void)
             delete it->second;
         }
         scenes.clear();
+        sceneElementUsers.Clear();
         status = scenesLock.Unlock();
         if (ER_OK != status) {
             QCC_LogError(status, ("%s: scenesLock.Unlock() failed", __func__));
@@ -335,6 +363,7 @@ LSFResponseCode SceneManager::Reset(void)
         scenes.clear();
         sceneUpdates.clear();
         oldSceneMap.clear();
+        sceneElementUsers.Clear();
         blobLength = 0;
         ScheduleFileWrite();
         tempStatus = scenesLock.Unlock();
@@ -374,11 +403,8 @@ LSFResponseCode SceneManager::IsDependentOnSceneElement(LSFString& sceneElementI
 
     QStatus status = scenesLock.Lock();
     if (ER_OK == status) {
-        for (SceneObjectMap::iterator it = scenes.begin(); it != scenes.end(); ++it) {
-            responseCode = it->second->IsDependentOnSceneElement(sceneElementID);
-            if (LSF_OK != responseCode) {
-                break;
-            }
+        if (sceneElementUsers.IsUsed(sceneElementID)) {
+            responseCode = LSF_ERR_DEPENDENCY;
         }
         status = scenesLock.Unlock();
         if (ER_OK != status) {
@@ -633,6 +659,124 @@ void SceneManager::CreateSceneWithSceneElements(ajn::Message& message)
     }
 }
 
+void SceneManager::CreateScenesWithSceneElements(ajn::Message& message)
+{
+    QCC_DbgPrintf(("%s: %s", __func__, message->ToString().c_str()));
+
+    LSFResponseCode responseCode = LSF_OK;
+    LSFStringList sceneIDs;
+
+    if (!controllerService.UpdatesAllowed()) {
+        controllerService.SendMethodReplyWithResponseCodeAndListOfIDs(message, LSF_ERR_BUSY, sceneIDs);
+        return;
+    }
+
+    const ajn::MsgArg* inputArgs;
+    size_t numInputArgs;
+    message->GetArgs(numInputArgs, inputArgs);
+
+    if (controllerService.CheckNumArgsInMessage(numInputArgs, 2) != LSF_OK) {
+        return;
+    }
+
+    MsgArg* sceneArgs;
+    size_t numScenes;
+    inputArgs[0].Get("a(ass)", &numScenes, &sceneArgs);
+    LSFString language = static_cast<LSFString>(inputArgs[1].v_string.str);
+
+    /*
+     * Validate every scene before touching the map so that the request is
+     * applied completely or not at all
+     */
+    LSFStringList names;
+    std::list<SceneWithSceneElements> newScenes;
+    std::list<Scene> newSceneComponents;
+
+    if (0 != strcmp("en", language.c_str())) {
+        QCC_LogError(ER_FAIL, ("%s: Language %s not supported", __func__, language.c_str()));
+        responseCode = LSF_ERR_INVALID_ARGS;
+    } else if (numScenes == 0) {
+        QCC_LogError(ER_FAIL, ("%s: No scenes", __func__));
+        responseCode = LSF_ERR_INVALID_ARGS;
+    }
+
+    for (size_t i = 0; (i < numScenes) && (LSF_OK == responseCode); i++) {
+        const MsgArg* members = sceneArgs[i].v_struct.members;
+        names.push_back(static_cast<LSFString>(members[1].v_string.str));
+        newScenes.push_back(SceneWithSceneElements(members[0]));
+        newSceneComponents.push_back(Scene());
+
+        const LSFString& name = names.back();
+        if (name.empty()) {
+            QCC_LogError(ER_FAIL, ("%s: scene name is empty", __func__));
+            responseCode = LSF_ERR_EMPTY_NAME;
+        } else if (name.length() > LSF_MAX_NAME_LENGTH) {
+            QCC_LogError(ER_FAIL, ("%s: name length exceeds %d", __func__, LSF_MAX_NAME_LENGTH));
+            responseCode = LSF_ERR_INVALID_ARGS;
+        } else {
+            responseCode = CreateScene(newSceneComponents.back(), newScenes.back());
+            if ((LSF_OK == responseCode) && newSceneComponents.back().invalidArgs) {
+                QCC_LogError(ER_FAIL, ("%s: Invalid Scene components specified", __func__));
+                responseCode = LSF_ERR_INVALID_ARGS;
+            }
+        }
+
+        if (LSF_OK == responseCode) {
+            sceneIDs.push_back(GenerateUniqueID("SCENE"));
+        }
+    }
+
+    if (LSF_OK == responseCode) {
+        QStatus status = scenesLock.Lock();
+        if (ER_OK == status) {
+            if ((scenes.size() + newScenes.size()) <= OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY) {
+                size_t newlen = blobLength;
+                LSFStringList::iterator idIt = sceneIDs.begin();
+                LSFStringList::iterator nameIt = names.begin();
+                std::list<Scene>::iterator sceneIt = newSceneComponents.begin();
+                for (std::list<SceneWithSceneElements>::iterator it = newScenes.begin(); it != newScenes.end(); ++it, ++idIt, ++nameIt, ++sceneIt) {
+                    newlen += GetStringLength(*nameIt, *idIt, *it) + GetStringLength(*nameIt, *idIt, *sceneIt) + idIt->length();
+                }
+
+                if (newlen < MAX_FILE_LEN) {
+                    blobLength = newlen;
+                    idIt = sceneIDs.begin();
+                    nameIt = names.begin();
+                    sceneIt = newSceneComponents.begin();
+                    for (std::list<SceneWithSceneElements>::iterator it = newScenes.begin(); it != newScenes.end(); ++it, ++idIt, ++nameIt, ++sceneIt) {
+                        SceneObject* newObj = new SceneObject(*this, *idIt, *sceneIt, *it, *nameIt);
+                        sceneElementUsers.Add(*idIt, it->sceneElements);
+                        scenes.insert(std::make_pair(*idIt, newObj));
+                    }
+                    ScheduleFileWrite();
+                } else {
+                    responseCode = LSF_ERR_RESOURCES;
+                }
+            } else {
+                QCC_LogError(ER_FAIL, ("%s: No slot for %u new Scenes", __func__, newScenes.size()));
+                responseCode = LSF_ERR_NO_SLOT;
+            }
+            status = scenesLock.Unlock();
+            if (ER_OK != status) {
+                QCC_LogError(status, ("%s: scenesLock.Unlock() failed", __func__));
+            }
+        } else {
+            responseCode = LSF_ERR_BUSY;
+            QCC_LogError(status, ("%s: scenesLock.Lock() failed", __func__));
+        }
+    }
+
+    if (LSF_OK != responseCode) {
+        sceneIDs.clear();
+    }
+
+    controllerService.SendMethodReplyWithResponseCodeAndListOfIDs(message, responseCode, sceneIDs);
+
+    if (LSF_OK == responseCode) {
+        controllerService.SendSignal(ControllerServiceSceneInterfaceName, "ScenesCreated", sceneIDs);
+    }
+}
+
 void SceneManager::UpdateScene(Message& message)
 {
     QCC_DbgPrintf(("%s: %s", __func__, message->ToString().c_str()));
@@ -749,8 +893,9 @@ void SceneManager::DeleteScene(Message& message)
         if (ER_OK == status) {
             SceneObjectMap::iterator it = scenes.find(sceneId);
             if (it != scenes.end()) {
-                blobLength -= (GetString(it->second->sceneName, sceneId, it->second->sceneWithSceneElements).length() + GetString(it->second->sceneName, sceneId, it->second->scene).length());
+                blobLength -= (GetStringLength(it->second->sceneName, sceneId, it->second->sceneWithSceneElements) + GetStringLength(it->second->sceneName, sceneId, it->second->scene));
                 sceneObjPtr = it->second;
+                sceneElementUsers.Remove(sceneID, it->second->sceneWithSceneElements.sceneElements);
                 scenes.erase(it);
                 deleted = true;
                 ScheduleFileWrite();
@@ -779,6 +924,83 @@ void SceneManager::DeleteScene(Message& message)
     }
 }
 
+void SceneManager::DeleteScenes(Message& message)
+{
+    QCC_DbgPrintf(("%s: %s", __func__, message->ToString().c_str()));
+    LSFResponseCode responseCode = LSF_OK;
+
+    size_t numArgs;
+    const MsgArg* args;
+    message->GetArgs(numArgs, args);
+
+    if (controllerService.CheckNumArgsInMessage(numArgs, 1)  != LSF_OK) {
+        return;
+    }
+
+    MsgArg* idsArray;
+    size_t idsSize;
+    args[0].Get("as", &idsSize, &idsArray);
+
+    LSFStringList sceneIDs;
+    CreateUniqueList(sceneIDs, idsArray, idsSize);
+
+    if (!controllerService.UpdatesAllowed()) {
+        controllerService.SendMethodReplyWithResponseCodeAndListOfIDs(message, LSF_ERR_BUSY, sceneIDs);
+        return;
+    }
+
+    if (sceneIDs.empty()) {
+        QCC_LogError(ER_FAIL, ("%s: No scenes", __func__));
+        responseCode = LSF_ERR_INVALID_ARGS;
+    }
+
+    for (LSFStringList::iterator it = sceneIDs.begin(); (it != sceneIDs.end()) && (LSF_OK == responseCode); ++it) {
+        responseCode = masterSceneManager->IsDependentOnScene(*it);
+    }
+
+    if (LSF_OK == responseCode) {
+        std::list<SceneObject*> deletedObjects;
+        QStatus status = scenesLock.Lock();
+        if (ER_OK == status) {
+            for (LSFStringList::const_iterator it = sceneIDs.begin(); (it != sceneIDs.end()) && (LSF_OK == responseCode); ++it) {
+                if (scenes.find(*it) == scenes.end()) {
+                    responseCode = LSF_ERR_NOT_FOUND;
+                }
+            }
+
+            if (LSF_OK == responseCode) {
+                for (LSFStringList::const_iterator it = sceneIDs.begin(); it != sceneIDs.end(); ++it) {
+                    SceneObjectMap::iterator sit = scenes.find(*it);
+                    blobLength -= (GetStringLength(sit->second->sceneName, *it, sit->second->sceneWithSceneElements) + GetStringLength(sit->second->sceneName, *it, sit->second->scene));
+                    sceneElementUsers.Remove(*it, sit->second->sceneWithSceneElements.sceneElements);
+                    deletedObjects.push_back(sit->second);
+                    scenes.erase(sit);
+                }
+                ScheduleFileWrite();
+            }
+
+            status = scenesLock.Unlock();
+            if (ER_OK != status) {
+                QCC_LogError(status, ("%s: scenesLock.Unlock() failed", __func__));
+            }
+
+            while (!deletedObjects.empty()) {
+                delete deletedObjects.front();
+                deletedObjects.pop_front();
+            }
+        } else {
+            responseCode = LSF_ERR_BUSY;
+            QCC_LogError(status, ("%s: scenesLock.Lock() failed", __func__));
+        }
+    }
+
+    controllerService.SendMethodReplyWithResponseCodeAndListOfIDs(message, responseCode, sceneIDs);
+
+    if (LSF_OK == responseCode) {
+        controllerService.SendSignal(ControllerServiceSceneInterfaceName, "ScenesDeleted", sceneIDs);
+    }
+}
+
 void SceneManager::GetScene(Message& message)
 {
     QCC_DbgPrintf(("%s: %s", __func__, message->ToString().c_str()));
@@ -915,6 +1137,7 @@ void SceneManager::ApplyScene(Message& message)
 LSFResponseCode SceneManager::ApplySceneNestedInternal(ajn::Message message, LSFStringList& sceneList, LSFString sceneOrMasterSceneId)
 {
     QCC_DbgPrintf(("%s: sceneList.size() = %d", __func__, sceneList.size()));
+    LSF_TRACE_SCOPE(LSF_TRACE_ID(message), "SceneResolution");
     LSFResponseCode responseCode = LSF_OK;
 
     std::list<SceneWithSceneElements> scenesWithSceneElements;
@@ -1089,11 +1312,11 @@ LSFResponseCode SceneManager::CreateScene(Scene& scene, SceneWithSceneElements&
             LSFString sceneElementId(*it);
             responseCode = sceneElementManager->GetSceneElementInternal(sceneElementId, sceneElement);
             if (responseCode == LSF_OK) {
-                if (sceneElement.effectID.find("PRESET") != std::string::npos) {
+                if (sceneElement.effectType == LSF_EFFECT_PRESET) {
                     uint32_t transitionPeriod = 0;
                     TransitionLampsLampGroupsToPreset component(sceneElement.lamps, sceneElement.lampGroups, sceneElement.effectID, transitionPeriod);
                     transitionToPresetComponentList.push_back(component);
-                } else if (sceneElement.effectID.find("TRANSITION_EFFECT") != std::string::npos) {
+                } else if (sceneElement.effectType == LSF_EFFECT_TRANSITION) {
                     TransitionEffect transitionEffect;
                     responseCode = controllerService.GetTransitionEffectManager().GetTransitionEffectInternal(sceneElement.effectID, transitionEffect);
                     if (responseCode == LSF_OK) {
@@ -1105,7 +1328,7 @@ LSFResponseCode SceneManager::CreateScene(Scene& scene, SceneWithSceneElements&
                             transitionToPresetComponentList.push_back(component);
                         }
                     }
-                } else if (sceneElement.effectID.find("PULSE_EFFECT") != std::string::npos) {
+                } else if (sceneElement.effectType == LSF_EFFECT_PULSE) {
                     PulseEffect pulseEffect;
                     responseCode = controllerService.GetPulseEffectManager().GetPulseEffectInternal(sceneElement.effectID, pulseEffect);
                     if (responseCode == LSF_OK) {
@@ -1177,13 +1400,13 @@ LSFResponseCode SceneManager::CreateSceneInternal(Scene& scene, SceneWithSceneEl
         QStatus status = scenesLock.Lock();
         if (ER_OK == status) {
             if (scenes.size() < OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY) {
-                std::string newSceneStr = (GetString(name, sceneID, sceneWithSceneElements) + GetString(name, sceneID, scene));
-                size_t newlen = blobLength + newSceneStr.length() + sceneID.length();
+                size_t newlen = blobLength + GetStringLength(name, sceneID, sceneWithSceneElements) + GetStringLength(name, sceneID, scene) + sceneID.length();
 
                 if (newlen < MAX_FILE_LEN) {
                     SceneObject* newObj = new SceneObject(*this, sceneID, scene, sceneWithSceneElements, name);
                     if (newObj) {
                         blobLength = newlen;
+                        sceneElementUsers.Add(sceneID, sceneWithSceneElements.sceneElements);
                         scenes.insert(std::make_pair(sceneID, newObj));
                         created = true;
                         ScheduleFileWrite();
@@ -1230,11 +1453,13 @@ LSFResponseCode SceneManager::UpdateSceneInternal(Scene& scene, SceneWithSceneEl
             if (it != scenes.end()) {
                 size_t newlen = blobLength;
                 // sub len of old scene, add len of new scene
-                newlen -= (GetString(it->second->sceneName, sceneID, it->second->sceneWithSceneElements).length() + GetString(it->second->sceneName, sceneID, it->second->scene).length());
-                newlen += (GetString(it->second->sceneName, sceneID, sceneWithSceneElements).length() + GetString(it->second->sceneName, sceneID, scene).length());
+                newlen -= (GetStringLength(it->second->sceneName, sceneID, it->second->sceneWithSceneElements) + GetStringLength(it->second->sceneName, sceneID, it->second->scene));
+                newlen += (GetStringLength(it->second->sceneName, sceneID, sceneWithSceneElements) + GetStringLength(it->second->sceneName, sceneID, scene));
 
                 if (newlen < MAX_FILE_LEN) {
                     blobLength = newlen;
+                    sceneElementUsers.Remove(sceneID, it->second->sceneWithSceneElements.sceneElements);
+                    sceneElementUsers.Add(sceneID, sceneWithSceneElements.sceneElements);
                     it->second->scene = scene;
                     it->second->sceneWithSceneElements = sceneWithSceneElements;
                     responseCode = LSF_OK;
@@ -1260,7 +1485,7 @@ void SceneManager::ReadSavedData()
 {
     QCC_DbgTrace(("%s", __func__));
 
-    std::istringstream stream1;
+    BlobSnapshotStream stream1;
     stream1.clear();
     if (ValidateScene2FileAndRead(stream1)) {
         ReplaceScene2List(stream1);
@@ -1271,7 +1496,7 @@ void SceneManager::ReadSavedData()
         WriteScene2FileWithChecksumAndTimestamp(stream.str(), GetChecksum(stream.str()), 0UL);
     }
 
-    std::istringstream stream2;
+    BlobSnapshotStream stream2;
     stream2.clear();
     if (ValidateFileAndRead(stream2)) {
         ReplaceMap(stream2);
@@ -1282,7 +1507,7 @@ void SceneManager::ReadSavedData()
         WriteFileWithChecksumAndTimestamp(stream.str(), GetChecksum(stream.str()), 0UL);
     }
 
-    std::istringstream stream3;
+    BlobSnapshotStream stream3;
     stream3.clear();
     if (ValidateUpdateFileAndRead(stream3)) {
         ReplaceUpdatesList(stream3);
@@ -1295,7 +1520,7 @@ void SceneManager::ReadSavedData()
     SyncSceneData();
 }
 
-void SceneManager::ReplaceMap(std::istringstream& stream)
+void SceneManager::ReplaceMap(std::istream& stream)
 {
     QCC_DbgTrace(("%s", __func__));
     while (!stream.eof()) {
@@ -1465,6 +1690,16 @@ static void OutputLamps(std::ostream& stream, const std::string& name, const LSF
     }
 }
 
+static size_t GetLampsLength(const std::string& name, const LSFStringList& list)
+{
+    return GetIDListLength(list, (sizeof("\t\t \n") - 1) + name.length());
+}
+
+static size_t GetStateLength(const std::string& name, const LampState& state)
+{
+    return (sizeof("\t\t \n") - 1) + name.length() + (state.nullState ? 1 : GetLampStateLength(state));
+}
+
 static void OutputState(std::ostream& stream, const std::string& name, const LampState& state)
 {
     if (!state.nullState) {
@@ -1479,7 +1714,7 @@ static void OutputState(std::ostream& stream, const std::string& name, const Lam
     }
 }
 
-void SceneManager::ReplaceUpdatesList(std::istringstream& stream)
+void SceneManager::ReplaceUpdatesList(std::istream& stream)
 {
     QCC_DbgTrace(("%s", __func__));
     while (!stream.eof()) {
@@ -1497,12 +1732,26 @@ void SceneManager::ReplaceUpdatesList(std::istringstream& stream)
     }
 }
 
-void SceneManager::ReplaceScene2List(std::istringstream& stream)
+void SceneManager::ReplaceScene2List(std::istream& stream)
 {
     QCC_DbgTrace(("%s", __func__));
 
     sceneWithSceneElementsMap.clear();
 
+    if (ParseScene2List(stream, sceneWithSceneElementsMap)) {
+        QCC_DbgPrintf(("The file has a reset entry. Clearing the map"));
+        for (SceneObjectMap::iterator it = scenes.begin(); it != scenes.end(); ++it) {
+            delete it->second;
+        }
+        scenes.clear();
+    }
+}
+
+bool SceneManager::ParseScene2List(std::istream& stream, SceneWithSceneElementsMap& sceneMap)
+{
+    QCC_DbgTrace(("%s", __func__));
+    bool reset = false;
+
     while (!stream.eof()) {
         std::string token;
         std::string id;
@@ -1519,11 +1768,7 @@ void SceneManager::ReplaceScene2List(std::istringstream& stream)
             name = ParseString(stream);
 
             if (0 == strcmp(id.c_str(), resetID.c_str())) {
-                QCC_DbgPrintf(("The file has a reset entry. Clearing the map"));
-                for (SceneObjectMap::iterator it = scenes.begin(); it != scenes.end(); ++it) {
-                    delete it->second;
-                }
-                scenes.clear();
+                reset = true;
             } else if (0 == strcmp(id.c_str(), initialStateID.c_str())) {
                 QCC_DbgPrintf(("The file has a initialState entry. So we ignore it"));
             } else {
@@ -1531,16 +1776,21 @@ void SceneManager::ReplaceScene2List(std::istringstream& stream)
                     token = ParseString(stream);
                     if (token == "SceneElements") {
                         std::string id = ParseString(stream);
-                        while (id != "EndSceneElements") {
+                        while ((id != "EndSceneElements") && !stream.eof()) {
                             sceneWithSceneElements.sceneElements.push_back(id);
                             id = ParseString(stream);
                         }
                     }
-                } while (token != "EndScene");
-                sceneWithSceneElementsMap.insert(std::make_pair(id, std::make_pair(name, sceneWithSceneElements)));
+                } while ((token != "EndScene") && !stream.eof());
+                std::pair<SceneWithSceneElementsMap::iterator, bool> entry = sceneMap.insert(std::make_pair(id, std::make_pair(name, SceneWithSceneElements())));
+                if (entry.second) {
+                    entry.first->second.second.Swap(sceneWithSceneElements);
+                }
             }
         }
     }
+
+    return reset;
 }
 
 void SceneManager::SyncSceneData(bool isLeader)
@@ -1641,11 +1891,26 @@ void SceneManager::SyncSceneData(bool isLeader)
     }
 
     sceneWithSceneElementsMap.clear();
+    RebuildDependencyIndex();
 
-    std::string output;
-    std::string scene2;
-    GetString(output, scene2, scenes);
-    blobLength = scene2.size() + output.size();
+    if (scenes.empty()) {
+        // both files hold a reset entry
+        blobLength = GetStringLength(resetID, resetID, Scene()) + GetStringLength(resetID, resetID, SceneWithSceneElements());
+    } else {
+        blobLength = 0;
+        for (SceneObjectMap::const_iterator it = scenes.begin(); it != scenes.end(); ++it) {
+            blobLength += GetStringLength(it->second->sceneName, it->first, it->second->sceneWithSceneElements) + GetStringLength(it->second->sceneName, it->first, it->second->scene);
+        }
+    }
+}
+
+void SceneManager::RebuildDependencyIndex(void)
+{
+    QCC_DbgTrace(("%s", __func__));
+    sceneElementUsers.Clear();
+    for (SceneObjectMap::const_iterator it = scenes.begin(); it != scenes.end(); ++it) {
+        sceneElementUsers.Add(it->first, it->second->sceneWithSceneElements.sceneElements);
+    }
 }
 
 std::string SceneManager::GetString(const std::string& name, const std::string& id, const Scene& scene)
@@ -1715,6 +1980,47 @@ std::string SceneManager::GetString(const std::string& name, const std::string&
     return stream.str();
 }
 
+size_t SceneManager::GetStringLength(const std::string& name, const std::string& id, const Scene& scene)
+{
+    size_t length = (sizeof("Scene  \"\"\nEndScene\n") - 1) + id.length() + name.length();
+
+    if (!scene.transitionToStateComponent.empty()) {
+        length += (sizeof("\tTransitionLampsLampGroupsToState\n\tEndTransitionLampsLampGroupsToState\n") - 1);
+        for (TransitionLampsLampGroupsToStateList::const_iterator cit = scene.transitionToStateComponent.begin(); cit != scene.transitionToStateComponent.end(); ++cit) {
+            length += GetLampsLength("Lamp", cit->lamps) + GetLampsLength("LampGroup", cit->lampGroups) + GetStateLength("LampState", cit->state);
+            length += (sizeof("\t\tPeriod \n") - 1) + GetValueLength(cit->transitionPeriod);
+        }
+    }
+
+    if (!scene.transitionToPresetComponent.empty()) {
+        length += (sizeof("\tTransitionLampsLampGroupsToPreset\n\tEndTransitionLampsLampGroupsToPreset\n") - 1);
+        for (TransitionLampsLampGroupsToPresetList::const_iterator cit = scene.transitionToPresetComponent.begin(); cit != scene.transitionToPresetComponent.end(); ++cit) {
+            length += GetLampsLength("Lamp", cit->lamps) + GetLampsLength("LampGroup", cit->lampGroups);
+            length += (sizeof("\t\tLampState \n\t\tPeriod \n") - 1) + cit->presetID.length() + GetValueLength(cit->transitionPeriod);
+        }
+    }
+
+    if (!scene.pulseWithStateComponent.empty()) {
+        length += (sizeof("\tPulseLampsLampGroupsWithState\n\tEndPulseLampsLampGroupsWithState\n") - 1);
+        for (PulseLampsLampGroupsWithStateList::const_iterator cit = scene.pulseWithStateComponent.begin(); cit != scene.pulseWithStateComponent.end(); ++cit) {
+            length += GetLampsLength("Lamp", cit->lamps) + GetLampsLength("LampGroup", cit->lampGroups);
+            length += GetStateLength("FromState", cit->fromState) + GetStateLength("ToState", cit->toState);
+            length += (sizeof("\t\tPeriod \n\t\tDuration \n\t\tPulses \n") - 1) + GetValueLength(cit->pulsePeriod) + GetValueLength(cit->pulseDuration) + GetValueLength(cit->numPulses);
+        }
+    }
+
+    if (!scene.pulseWithPresetComponent.empty()) {
+        length += (sizeof("\tPulseLampsLampGroupsWithPreset\n\tEndPulseLampsLampGroupsWithPreset\n") - 1);
+        for (PulseLampsLampGroupsWithPresetList::const_iterator cit = scene.pulseWithPresetComponent.begin(); cit != scene.pulseWithPresetComponent.end(); ++cit) {
+            length += GetLampsLength("Lamp", cit->lamps) + GetLampsLength("LampGroup", cit->lampGroups);
+            length += (sizeof("\t\tFromState \n\t\tToState \n\t\tPeriod \n\t\tDuration \n\t\tPulses \n") - 1) + cit->fromPreset.length() + cit->toPreset.length();
+            length += GetValueLength(cit->pulsePeriod) + GetValueLength(cit->pulseDuration) + GetValueLength(cit->numPulses);
+        }
+    }
+
+    return length;
+}
+
 std::string SceneManager::GetString(const std::string& name, const std::string& id, const SceneWithSceneElements& sceneWithSceneElements)
 {
     std::ostringstream stream;
@@ -1734,6 +2040,17 @@ std::string SceneManager::GetString(const std::string& name, const std::string&
     return stream.str();
 }
 
+size_t SceneManager::GetStringLength(const std::string& name, const std::string& id, const SceneWithSceneElements& sceneWithSceneElements)
+{
+    size_t length = (sizeof("Scene  \"\"\nEndScene\n") - 1) + id.length() + name.length();
+
+    if (!sceneWithSceneElements.sceneElements.empty()) {
+        length += (sizeof("\tSceneElements\n\t\t\n\tEndSceneElements\n") - 1) + GetIDListLength(sceneWithSceneElements.sceneElements, 1);
+    }
+
+    return length;
+}
+
 void SceneManager::GetString(std::string& scenes, std::string& scene2, const SceneObjectMap& items)
 {
     std::ostringstream stream1;
@@ -1824,27 +2141,28 @@ bool SceneManager::GetString(std::string& output, std::string& updates, std::str
     return ret;
 }
 
-void SceneManager::HandleReceivedBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp)
+void SceneManager::HandleReceivedBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp)
 {
     QCC_DbgPrintf(("%s", __func__));
     uint64_t currentTimestamp = GetTimestampInMs();
     scenesLock.Lock();
     if (((timeStamp == 0) || ((currentTimestamp - timeStamp) > timestamp)) && (checkSum != checksum)) {
-        std::istringstream stream(blob.c_str());
+        BlobInputStream stream(blob, length);
         ReplaceMap(stream);
+        RebuildDependencyIndex();
         timeStamp = currentTimestamp;
         checkSum = checksum;
     }
     scenesLock.Unlock();
 }
 
-void SceneManager::HandleReceivedUpdateBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp)
+void SceneManager::HandleReceivedUpdateBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp)
 {
     QCC_DbgPrintf(("%s", __func__));
     uint64_t currentTimestamp = GetTimestampInMs();
     scenesLock.Lock();
     if (((updatesTimeStamp == 0) || ((currentTimestamp - updatesTimeStamp) > timestamp)) && (updatesCheckSum != checksum)) {
-        std::istringstream stream(blob.c_str());
+        BlobInputStream stream(blob, length);
         ReplaceUpdatesList(stream);
         updatesTimeStamp = currentTimestamp;
         updatesCheckSum = checksum;
@@ -1852,14 +2170,15 @@ void SceneManager::HandleReceivedUpdateBlob(const std::string& blob, uint32_t ch
     scenesLock.Unlock();
 }
 
-void SceneManager::HandleReceivedScene2Blob(const std::string& blob, uint32_t checksum, uint64_t timestamp)
+void SceneManager::HandleReceivedScene2Blob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp)
 {
     QCC_DbgPrintf(("%s", __func__));
     uint64_t currentTimestamp = GetTimestampInMs();
     scenesLock.Lock();
     if (((scene2TimeStamp == 0) || ((currentTimestamp - scene2TimeStamp) > timestamp)) && (scene2CheckSum != checksum)) {
-        std::istringstream stream(blob.c_str());
+        BlobInputStream stream(blob, length);
         ReplaceScene2List(stream);
+        RebuildDependencyIndex();
         scene2TimeStamp = currentTimestamp;
         scene2CheckSum = checksum;
     }
@@ -1916,7 +2235,7 @@ void SceneManager::ReadWriteFile()
     std::list<ajn::Message> tempScene2MessageList;
 
     readMutex.Lock();
-    if (read) {
+    if (read && !status) {
         tempMessageList = readBlobMessages;
         readBlobMessages.clear();
         tempUpdateMessageList = readUpdateBlobMessages;
@@ -1927,8 +2246,10 @@ void SceneManager::ReadWriteFile()
     }
     readMutex.Unlock();
 
+    ScheduleDeferredReads();
+
     if ((tempMessageList.size() || tempUpdateMessageList.size() || tempScene2MessageList.size() || sendUpdate) && !status) {
-        std::istringstream stream;
+        BlobSnapshotStream stream;
         bool fileStatus = ValidateFileAndReadInternal(checksum, timestamp, stream);
         if (fileStatus) {
             output = stream.str();
@@ -1941,7 +2262,7 @@ void SceneManager::ReadWriteFile()
             QCC_LogError(ER_FAIL, ("%s: Scene persistent store corrupted", __func__));
         }
 
-        std::istringstream updateStream;
+        BlobSnapshotStream updateStream;
         bool updateStatus = ValidateUpdateFileAndReadInternal(updateChecksum, updateTimestamp, updateStream);
         if (updateStatus) {
             updates = updateStream.str();
@@ -1954,7 +2275,7 @@ void SceneManager::ReadWriteFile()
             QCC_LogError(ER_FAIL, ("%s: Scene Update persistent store corrupted", __func__));
         }
 
-        std::istringstream scene2Stream;
+        BlobSnapshotStream scene2Stream;
         bool scene2Status = ValidateScene2FileAndReadInternal(scene2Checksum, scene2Timestamp, scene2Stream);
         if (scene2Status) {
             scene2 = scene2Stream.str();
@@ -1977,6 +2298,65 @@ void SceneManager::ReadWriteFile()
     }
 }
 
+void SceneManager::ExportConfiguration(std::ostream& stream)
+{
+    QCC_DbgTrace(("%s", __func__));
+    for (SceneObjectMap::const_iterator it = scenes.begin(); it != scenes.end(); ++it) {
+        stream << GetString(it->second->sceneName, it->first, it->second->sceneWithSceneElements);
+    }
+}
+
+LSFResponseCode SceneManager::StageConfiguration(std::istream& stream, SceneWithSceneElementsMap& staged)
+{
+    QCC_DbgTrace(("%s", __func__));
+    staged.clear();
+    ParseScene2List(stream, staged);
+
+    if (staged.size() > OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY) {
+        QCC_LogError(ER_FAIL, ("%s: %d scenes exceed the supported number", __func__, staged.size()));
+        return LSF_ERR_NO_SLOT;
+    }
+
+    /*
+     * The scene file is only known once the scene elements of the snapshot
+     * have been committed, so only the scene2 file is checked here
+     */
+    size_t stagedBlobLength = 0;
+    for (SceneWithSceneElementsMap::const_iterator it = staged.begin(); it != staged.end(); ++it) {
+        stagedBlobLength += GetStringLength(it->second.first, it->first, it->second.second);
+    }
+    if (stagedBlobLength >= MAX_FILE_LEN) {
+        QCC_LogError(ER_FAIL, ("%s: scenes do not fit in the persistent store", __func__));
+        return LSF_ERR_RESOURCES;
+    }
+
+    return LSF_OK;
+}
+
+void SceneManager::CommitConfiguration(SceneWithSceneElementsMap& staged, ConfigurationChanges& changes)
+{
+    QCC_DbgTrace(("%s", __func__));
+    GetConfigurationChanges(scenes, staged, changes);
+
+    /*
+     * SyncSceneData keeps the current scenes when it is handed an empty
+     * map, so an empty snapshot has to clear them here
+     */
+    if (staged.empty()) {
+        for (SceneObjectMap::iterator it = scenes.begin(); it != scenes.end(); ++it) {
+            delete it->second;
+        }
+        scenes.clear();
+    }
+
+    sceneWithSceneElementsMap.swap(staged);
+    staged.clear();
+    sceneUpdates.clear();
+    oldSceneMap.clear();
+    SyncSceneData();
+    ScheduleFileWrite();
+}
+
 uint32_t SceneManager::GetControllerServiceSceneInterfaceVersion(void)
 {
     QCC_DbgPrintf(("%s: controllerSceneInterfaceVersion=%d", __func__, ControllerServiceSceneInterfaceVersion));
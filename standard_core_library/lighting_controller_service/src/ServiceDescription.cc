@@ -195,6 +195,9 @@ const std::string ControllerServiceLampDescription =
     "      <arg name='lampID' type='s' direction='out'/>"
     "      <arg name='lampState' type='a{sv}' direction='out'/>"
     "    </signal>"
+    "    <signal name='LampsStateChanged'>"
+    "      <arg name='lampStates' type='a(sa{sv})' direction='out'/>"
+    "    </signal>"
     "    <signal name='LampsFound'>"
     "      <arg name='lampIDs' type='as' direction='out'/>"
     "    </signal>"
@@ -236,6 +239,12 @@ const std::string ControllerServiceLampGroupDescription =
     "      <arg name='responseCode' type='u' direction='out'/>"
     "      <arg name='lampGroupID' type='s' direction='out'/>"
     "    </method>"
+    "    <method name='CreateLampGroups'>"
+    "      <arg name='lampGroups' type='a(asass)' direction='in'/>"
+    "      <arg name='language' type='s' direction='in'/>"
+    "      <arg name='responseCode' type='u' direction='out'/>"
+    "      <arg name='lampGroupIDs' type='as' direction='out'/>"
+    "    </method>"
     "    <method name='UpdateLampGroup'>"
     "      <arg name='lampGroupID' type='s' direction='in'/>"
     "      <arg name='lampIDs' type='as' direction='in'/>"
@@ -248,6 +257,11 @@ const std::string ControllerServiceLampGroupDescription =
     "      <arg name='responseCode' type='u' direction='out'/>"
     "      <arg name='lampGroupID' type='s' direction='out'/>"
     "    </method>"
+    "    <method name='DeleteLampGroups'>"
+    "      <arg name='lampGroupIDs' type='as' direction='in'/>"
+    "      <arg name='responseCode' type='u' direction='out'/>"
+    "      <arg name='lampGroupIDs' type='as' direction='out'/>"
+    "    </method>"
     "    <method name='GetLampGroup'>"
     "      <arg name='lampGroupID' type='s' direction='in'/>"
     "      <arg name='responseCode' type='u' direction='out'/>"
@@ -364,17 +378,33 @@ const std::string ControllerServicePresetDescription =
     "      <arg name='responseCode' type='u' direction='out'/>"
     "      <arg name='presetID' type='s' direction='out'/>"
     "    </method>"
+    "    <method name='CreatePresets'>"
+    "      <arg name='presets' type='a(a{sv}s)' direction='in'/>"
+    "      <arg name='language' type='s' direction='in'/>"
+    "      <arg name='responseCode' type='u' direction='out'/>"
+    "      <arg name='presetIDs' type='as' direction='out'/>"
+    "    </method>"
     "    <method name='UpdatePreset'>"
     "      <arg name='presetID' type='s' direction='in'/>"
     "      <arg name='lampState' type='a{sv}' direction='in'/>"
     "      <arg name='responseCode' type='u' direction='out'/>"
     "      <arg name='presetID' type='s' direction='out'/>"
     "    </method>"
+    "    <method name='UpdatePresets'>"
+    "      <arg name='presets' type='a(sa{sv})' direction='in'/>"
+    "      <arg name='responseCode' type='u' direction='out'/>"
+    "      <arg name='presetIDs' type='as' direction='out'/>"
+    "    </method>"
     "    <method name='DeletePreset'>"
     "      <arg name='presetID' type='s' direction='in'/>"
     "      <arg name='responseCode' type='u' direction='out'/>"
     "      <arg name='presetID' type='s' direction='out'/>"
     "    </method>"
+    "    <method name='DeletePresets'>"
+    "      <arg name='presetIDs' type='as' direction='in'/>"
+    "      <arg name='responseCode' type='u' direction='out'/>"
+    "      <arg name='presetIDs' type='as' direction='out'/>"
+    "    </method>"
     "    <method name='GetPreset'>"
     "      <arg name='presetID' type='s' direction='in'/>"
     "      <arg name='responseCode' type='u' direction='out'/>"
@@ -660,6 +690,11 @@ const std::string ControllerServiceSceneDescription =
     "      <arg name='responseCode' type='u' direction='out'/>"
     "      <arg name='sceneID' type='s' direction='out'/>"
     "    </method>"
+    "    <method name='DeleteScenes'>"
+    "      <arg name='sceneIDs' type='as' direction='in'/>"
+    "      <arg name='responseCode' type='u' direction='out'/>"
+    "      <arg name='sceneIDs' type='as' direction='out'/>"
+    "    </method>"
     "    <method name='GetScene'>"
     "      <arg name='sceneID' type='s' direction='in'/>"
     "      <arg name='responseCode' type='u' direction='out'/>"
@@ -709,6 +744,13 @@ const std::string ControllerServiceSceneWithSceneElementsDescription =
     "      <arg name='responseCode' type='u' direction='out'/>"
     "      <arg name='sceneID' type='s' direction='out'/>"
     "    </method>"
+    "    <method name='CreateScenesWithSceneElements'>"
+    "      <description language=\"en\">This method allows the LSF Controller Clients to create several Scenes with Scene Elements at once.</description>"
+    "      <arg name='scenes' type='a(ass)' direction='in'/>"
+    "      <arg name='language' type='s' direction='in'/>"
+    "      <arg name='responseCode' type='u' direction='out'/>"
+    "      <arg name='sceneIDs' type='as' direction='out'/>"
+    "    </method>"
     "    <method name='UpdateSceneWithSceneElements'>"
     "      <description language=\"en\">This method allows the LSF Controller Clients to update a Scene with Scene Elements.</description>"
     "      <arg name='sceneID' type='s' direction='in'/>"
@@ -766,6 +808,13 @@ const std::string ControllerServiceSceneElementDescription =
     "      <arg name='responseCode' type='u' direction='out'/>"
     "      <arg name='sceneElementID' type='s' direction='out'/>"
     "    </method>"
+    "    <method name='CreateSceneElements'>"
+    "      <description language=\"en\">This method allows the LSF Controller Clients to create several Scene Elements at once.</description>"
+    "      <arg name='sceneElements' type='a(asasss)' direction='in'/>"
+    "      <arg name='language' type='s' direction='in'/>"
+    "      <arg name='responseCode' type='u' direction='out'/>"
+    "      <arg name='sceneElementIDs' type='as' direction='out'/>"
+    "    </method>"
     "    <method name='UpdateSceneElement'>"
     "      <description language=\"en\">This method allows the LSF Controller Clients to update a Scene Element.</description>"
     "      <arg name='sceneElementID' type='s' direction='in'/>"
@@ -779,6 +828,12 @@ const std::string ControllerServiceSceneElementDescription =
     "      <arg name='responseCode' type='u' direction='out'/>"
     "      <arg name='sceneElementID' type='s' direction='out'/>"
     "    </method>"
+    "    <method name='DeleteSceneElements'>"
+    "      <description language=\"en\">This method allows the LSF Controller Clients to delete several Scene Elements at once.</description>"
+    "      <arg name='sceneElementIDs' type='as' direction='in'/>"
+    "      <arg name='responseCode' type='u' direction='out'/>"
+    "      <arg name='sceneElementIDs' type='as' direction='out'/>"
+    "    </method>"
     "    <method name='GetSceneElement'>"
     "      <description language=\"en\">This method allows the LSF Controller Clients to fetch a Scene Element.</description>"
     "      <arg name='sceneElementID' type='s' direction='in'/>"
@@ -900,6 +955,14 @@ const std::string LeaderElectionAndStateSyncDescription =
     "      <arg name='checksum' type='u' direction='out'/>"
     "      <arg name='timestamp' type='t' direction='out'/>"
     "    </method>"
+    "    <method name='GetCompressedBlob'>"
+    "      <arg name='blobType' type='u' direction='in'/>"
+    "      <arg name='blobType' type='u' direction='out'/>"
+    "      <arg name='blob' type='ay' direction='out'/>"
+    "      <arg name='uncompressedLength' type='u' direction='out'/>"
+    "      <arg name='checksum' type='u' direction='out'/>"
+    "      <arg name='timestamp' type='t' direction='out'/>"
+    "    </method>"
     "    <method name='Overthrow'>"
     "      <arg name='success' type='b' direction='out'/>"
     "    </method>"
@@ -909,6 +972,13 @@ const std::string LeaderElectionAndStateSyncDescription =
     "      <arg name='checksum' type='u' direction='out'/>"
     "      <arg name='timestamp' type='t' direction='out'/>"
     "    </signal>"
+    "    <signal name='CompressedBlobChanged'>"
+    "      <arg name='blobType' type='u' direction='out'/>"
+    "      <arg name='blob' type='ay' direction='out'/>"
+    "      <arg name='uncompressedLength' type='u' direction='out'/>"
+    "      <arg name='checksum' type='u' direction='out'/>"
+    "      <arg name='timestamp' type='t' direction='out'/>"
+    "    </signal>"
     "  </interface>"
     "</node>";
 
@@ -936,6 +1006,23 @@ const std::string ControllerServiceDataSetDescription =
     "  </interface>"
     "</node>";
 
+const std::string ControllerServiceStatisticsDescription =
+    "<node xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" xsi:noNamespaceSchemaLocation=\"http://www.allseenalliance.org/schemas/introspect.xsd\">"
+    "  <interface name='org.allseen.LSF.ControllerService.Statistics'>"
+    "    <description language=\"en\">This interface is provided by the LSF Controller Service to enable monitoring of its runtime performance.</description>"
+    "    <annotation name=\"org.alljoyn.Bus.Secure\" value=\"off\"/>"
+    "    <property name='Version' type='u' access='read'>"
+    "        <description language=\"en\">Interface version</description>"
+    "        <annotation name=\"org.freedesktop.DBus.Property.EmitsChangedSignal\" value=\"true\"/>"
+    "    </property>"
+    "    <method name='GetControllerServiceStatistics'>"
+    "      <description language=\"en\">This method returns the counters, gauges and histograms of the Controller Service. Each entry holds the name, the type (0 = counter, 1 = gauge, 2 = histogram), the value or number of samples, and the 50th percentile, 99th percentile and maximum of a histogram.</description>"
+    "      <arg name='responseCode' type='u' direction='out'/>"
+    "      <arg name='statistics' type='a(suxuuu)' direction='out'/>"
+    "    </method>"
+    "  </interface>"
+    "</node>";
+
 OPTIONAL_NAMESPACE_CLOSE
 
 }
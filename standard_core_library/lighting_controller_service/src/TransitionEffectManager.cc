@@ -362,8 +362,8 @@ void TransitionEffectManager::UpdateTransitionEffect(Message& msg)
             if (it != transitionEffects.end()) {
                 size_t newlen = blobLength;
                 // sub len of old group, add len of new group
-                newlen -= GetString(it->second.first, transitionEffectID, it->second.second).length();
-                newlen += GetString(it->second.first, transitionEffectID, transitionEffect).length();
+                newlen -= GetStringLength(it->second.first, transitionEffectID, it->second.second);
+                newlen += GetStringLength(it->second.first, transitionEffectID, transitionEffect);
 
                 if (newlen < MAX_FILE_LEN) {
                     blobLength = newlen;
@@ -588,7 +588,7 @@ void TransitionEffectManager::GetTransitionEffect(Message& msg)
 void TransitionEffectManager::ReadSavedData(void)
 {
     QCC_DbgTrace(("%s", __func__));
-    std::istringstream stream;
+    BlobSnapshotStream stream;
     if (!ValidateFileAndRead(stream)) {
         /*
          * If there is no file present / CRC check failed on the file create a new
@@ -600,23 +600,24 @@ void TransitionEffectManager::ReadSavedData(void)
         return;
     }
 
-    blobLength = stream.str().size();
     ReplaceMap(stream);
+    blobLength = GetBlobLength(transitionEffects);
 
-    std::istringstream updateStream;
+    BlobSnapshotStream updateStream;
     if (ValidateUpdateFileAndRead(updateStream)) {
         ReplaceUpdatesList(updateStream);
     }
 }
 
-void TransitionEffectManager::HandleReceivedBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp)
+void TransitionEffectManager::HandleReceivedBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp)
 {
     QCC_DbgPrintf(("%s", __func__));
     uint64_t currentTimestamp = GetTimestampInMs();
     transitionEffectsLock.Lock();
     if (((timeStamp == 0) || ((currentTimestamp - timeStamp) > timestamp)) && (checkSum != checksum)) {
-        std::istringstream stream(blob.c_str());
+        BlobInputStream stream(blob, length);
         ReplaceMap(stream);
+        blobLength = GetBlobLength(transitionEffects);
         timeStamp = currentTimestamp;
         checkSum = checksum;
         ScheduleFileWrite(true);
@@ -624,13 +625,13 @@ void TransitionEffectManager::HandleReceivedBlob(const std::string& blob, uint32
     transitionEffectsLock.Unlock();
 }
 
-void TransitionEffectManager::HandleReceivedUpdateBlob(const std::string& blob, uint32_t checksum, uint64_t timestamp)
+void TransitionEffectManager::HandleReceivedUpdateBlob(const char* blob, size_t length, uint32_t checksum, uint64_t timestamp)
 {
     QCC_DbgPrintf(("%s", __func__));
     uint64_t currentTimestamp = GetTimestampInMs();
     transitionEffectsLock.Lock();
     if (((updatesTimeStamp == 0) || ((currentTimestamp - updatesTimeStamp) > timestamp)) && (updatesCheckSum != checksum)) {
-        std::istringstream stream(blob.c_str());
+        BlobInputStream stream(blob, length);
         ReplaceUpdatesList(stream);
         updatesTimeStamp = currentTimestamp;
         updatesCheckSum = checksum;
@@ -639,7 +640,7 @@ void TransitionEffectManager::HandleReceivedUpdateBlob(const std::string& blob,
     transitionEffectsLock.Unlock();
 }
 
-void TransitionEffectManager::ReplaceMap(std::istringstream& stream)
+void TransitionEffectManager::ReplaceMap(std::istream& stream)
 {
     QCC_DbgTrace(("%s", __func__));
     bool firstIteration = true;
@@ -666,7 +667,6 @@ void TransitionEffectManager::ReplaceMap(std::istringstream& stream)
                     transitionEffects.clear();
                     firstIteration = false;
                 }
-                blobLength += transitionEffectId.length();
                 bool containsLampState = ParseValue<bool>(stream);
 
                 LampState state;
@@ -695,7 +695,7 @@ void TransitionEffectManager::ReplaceMap(std::istringstream& stream)
     }
 }
 
-void TransitionEffectManager::ReplaceUpdatesList(std::istringstream& stream)
+void TransitionEffectManager::ReplaceUpdatesList(std::istream& stream)
 {
     QCC_DbgTrace(("%s", __func__));
     bool firstIteration = true;
@@ -742,8 +742,7 @@ LSFResponseCode TransitionEffectManager::CreateTransitionEffectInternal(Transiti
         QStatus status = transitionEffectsLock.Lock();
         if (ER_OK == status) {
             if (transitionEffects.size() < OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY) {
-                std::string newTransitionEffectStr = GetString(name, transitionEffectID, transitionEffect);
-                size_t newlen = blobLength + newTransitionEffectStr.length() + transitionEffectID.length();
+                size_t newlen = blobLength + GetStringLength(name, transitionEffectID, transitionEffect) + transitionEffectID.length();
                 if (newlen < MAX_FILE_LEN) {
                     blobLength = newlen;
                     transitionEffects[transitionEffectID].first = name;
@@ -792,7 +791,7 @@ LSFResponseCode TransitionEffectManager::DeleteTransitionEffectInternal(LSFStrin
         if (ER_OK == status) {
             TransitionEffectMap::iterator it = transitionEffects.find(transitionEffectID);
             if (it != transitionEffects.end()) {
-                blobLength -= ((GetString(it->second.first, transitionEffectID, it->second.second).length()) + transitionEffectID.length());
+                blobLength -= (GetStringLength(it->second.first, transitionEffectID, it->second.second) + transitionEffectID.length());
                 transitionEffects.erase(it);
                 if (transitionEffectUpdates.find(transitionEffectID) != transitionEffectUpdates.end()) {
                     transitionEffectUpdates.erase(transitionEffectID);
@@ -853,6 +852,26 @@ std::string TransitionEffectManager::GetString(const std::string& name, const st
     return stream.str();
 }
 
+size_t TransitionEffectManager::GetStringLength(const std::string& name, const std::string& id, const TransitionEffect& transitionEffect)
+{
+    size_t length = (sizeof("TransitionEffect  \"\" 0  \n") - 1) + id.length() + name.length() + GetValueLength(transitionEffect.transitionPeriod);
+    if (!(transitionEffect.state.nullState)) {
+        length += GetLampStateLength(transitionEffect.state);
+    } else {
+        length += transitionEffect.presetID.length();
+    }
+    return length;
+}
+
+size_t TransitionEffectManager::GetBlobLength(const TransitionEffectMap& items)
+{
+    size_t length = 0;
+    for (TransitionEffectMap::const_iterator it = items.begin(); it != items.end(); ++it) {
+        length += GetStringLength(it->second.first, it->first, it->second.second) + it->first.length();
+    }
+    return length;
+}
+
 std::string TransitionEffectManager::GetString(const TransitionEffectMap& items)
 {
     std::ostringstream stream;
@@ -967,7 +986,7 @@ void TransitionEffectManager::ReadWriteFile()
     std::list<ajn::Message> tempUpdateMessageList;
 
     readMutex.Lock();
-    if (read) {
+    if (read && !status) {
         tempMessageList = readBlobMessages;
         readBlobMessages.clear();
         tempUpdateMessageList = readUpdateBlobMessages;
@@ -976,8 +995,10 @@ void TransitionEffectManager::ReadWriteFile()
     }
     readMutex.Unlock();
 
+    ScheduleDeferredReads();
+
     if ((tempMessageList.size() || tempUpdateMessageList.size() || sendUpdate) && !status) {
-        std::istringstream stream;
+        BlobSnapshotStream stream;
         bool fileStatus = ValidateFileAndReadInternal(checksum, timestamp, stream);
         if (fileStatus) {
             output = stream.str();
@@ -990,7 +1011,7 @@ void TransitionEffectManager::ReadWriteFile()
             QCC_LogError(ER_FAIL, ("%s: TransitionEffect persistent store corrupted", __func__));
         }
 
-        std::istringstream updateStream;
+        BlobSnapshotStream updateStream;
         bool updateStatus = ValidateUpdateFileAndReadInternal(updateChecksum, updateTimestamp, updateStream);
         if (updateStatus) {
             updates = updateStream.str();
@@ -1012,6 +1033,56 @@ void TransitionEffectManager::ReadWriteFile()
     }
 }
 
+void TransitionEffectManager::ExportConfiguration(std::ostream& stream)
+{
+    QCC_DbgTrace(("%s", __func__));
+    for (TransitionEffectMap::const_iterator it = transitionEffects.begin(); it != transitionEffects.end(); ++it) {
+        stream << GetString(it->second.first, it->first, it->second.second);
+    }
+}
+
+LSFResponseCode TransitionEffectManager::StageConfiguration(std::istream& stream, TransitionEffectMap& staged, size_t& stagedBlobLength)
+{
+    QCC_DbgTrace(("%s", __func__));
+    /*
+     * ReplaceMap parses into the live map, so swap in an empty one and
+     * put the live transition effects back once the section has been read
+     */
+    TransitionEffectMap live;
+    live.swap(transitionEffects);
+    ReplaceMap(stream);
+    staged.swap(transitionEffects);
+    transitionEffects.swap(live);
+
+    if (staged.size() > OEM_CS_MAX_SUPPORTED_NUM_LSF_ENTITY) {
+        QCC_LogError(ER_FAIL, ("%s: %d transition effects exceed the supported number", __func__, staged.size()));
+        return LSF_ERR_NO_SLOT;
+    }
+
+    stagedBlobLength = GetBlobLength(staged);
+    if (stagedBlobLength >= MAX_FILE_LEN) {
+        QCC_LogError(ER_FAIL, ("%s: transition effects do not fit in the persistent store", __func__));
+        return LSF_ERR_RESOURCES;
+    }
+
+    return LSF_OK;
+}
+
+void TransitionEffectManager::CommitConfiguration(TransitionEffectMap& staged, size_t stagedBlobLength, ConfigurationChanges& changes)
+{
+    QCC_DbgTrace(("%s", __func__));
+    GetConfigurationChanges(transitionEffects, staged, changes);
+    transitionEffects.swap(staged);
+    blobLength = stagedBlobLength;
+
+    for (LSFStringList::const_iterator it = changes.deleted.begin(); it != changes.deleted.end(); ++it) {
+        transitionEffectUpdates.erase(*it);
+    }
+    transitionEffectUpdates.insert(changes.updated.begin(), changes.updated.end());
+
+    ScheduleFileWrite();
+}
+
 uint32_t TransitionEffectManager::GetControllerServiceTransitionEffectInterfaceVersion(void)
 {
     QCC_DbgPrintf(("%s: controllerTransitionEffectInterfaceVersion=%d", __func__, ControllerServiceTransitionEffectInterfaceVersion));